@@ -60,7 +60,7 @@ DEFINITION_FLAGS =
 
 
 # Warnings
-WARNING_FLAGS = -Wall -Wpedantic
+WARNING_FLAGS = -Wall -Wpedantic -Wvla
 
 
 # Shared library file
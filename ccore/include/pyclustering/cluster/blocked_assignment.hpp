@@ -0,0 +1,145 @@
+/*!
+
+@authors Andrei Novikov (pyclustering@yandex.ru)
+@date 2014-2020
+@copyright BSD-3-Clause
+
+*/
+
+
+#pragma once
+
+
+#include <cstddef>
+#include <vector>
+
+#include <pyclustering/cluster/cluster_data.hpp>
+#include <pyclustering/container/dense_dataset.hpp>
+#include <pyclustering/definitions.hpp>
+#include <pyclustering/utils/metric.hpp>
+
+
+namespace pyclustering {
+
+namespace clst {
+
+
+/*!
+
+@class    blocked_assignment blocked_assignment.hpp pyclustering/cluster/blocked_assignment.hpp
+
+@brief    Assigns points to the nearest centers in line with Euclidean distance using GEMM-style blocking.
+@details  Square Euclidean distance is expanded as \f$\left \| x \right \|^{2} - 2x \cdot c + \left \| c \right \|^{2}\f$
+           where norms are calculated once, therefore the main work is a product of a block of points and a
+           panel of centers. Centers are packed into panels where coordinates of several centers are interleaved,
+           and each panel is multiplied by a small tile of points that is accumulated in registers. Points are
+           processed by blocks that stay in cache while all panels of centers are applied to them.
+
+           The engine is used by K-Means (and therefore by X-Means, G-Means and Elbow) when its metric is
+           Euclidean or square Euclidean, and by Fuzzy C-Means. Other metrics that have vectorized kernels (see
+           `utils::simd`) are processed by one-to-many distance calculation, the rest metrics point by point.
+
+           Distances that are calculated by the expansion might differ from the direct calculation in the last
+           digits. Results of `distances` that are close to zero (where the expansion loses precision) are
+           calculated directly. Assignment compares distances with bounds of their rounding error, distances
+           to centers that are not distinguished by the bounds (near-ties or data that is far from the origin)
+           are calculated directly.
+
+*/
+class blocked_assignment {
+public:
+    static constexpr std::size_t    POINT_BLOCK     = 64;   /**< Amount of points that are processed together against all centers (recommended amount of points per call). */
+
+private:
+    static constexpr std::size_t    TILE_POINTS     = 4;    /* points that are multiplied by a panel at once */
+    static constexpr std::size_t    TILE_CENTERS    = 4;    /* centers in a panel */
+
+private:
+    std::size_t             m_amount_centers    = 0;
+    std::size_t             m_dimension         = 0;
+    std::vector<double>     m_panels            = { };  /* centers that are packed by panels */
+    std::vector<double>     m_center_norms      = { };  /* square norms of centers, padding centers have infinite norms */
+    dataset                 m_centers           = { };
+
+public:
+    /*!
+
+    @brief    Constructor of the engine that packs centers.
+
+    @param[in] p_centers: centers of clusters, all of them should have the same dimension.
+
+    */
+    explicit blocked_assignment(const dataset & p_centers);
+
+public:
+    /*!
+
+    @brief    Checks whether the engine might be used instead of the metric to find the nearest centers.
+
+    @param[in] p_metric: metric that is used by an algorithm.
+
+    @return   `true` if the metric is Euclidean or square Euclidean.
+
+    */
+    static bool is_applicable(const utils::metric::distance_metric<point> & p_metric);
+
+    /*!
+
+    @brief    Finds the nearest center for each point in range `[p_begin; p_end)`.
+
+    @param[in]  p_data: input data whose dimension is the same as dimension of centers.
+    @param[in]  p_begin: index of the first point that should be assigned.
+    @param[in]  p_end: index of the point after the last point that should be assigned.
+    @param[out] p_labels: container where index of the nearest center is stored for each point (by index of
+                 the point), it should be allocated by the caller.
+
+    */
+    void assign(const container::dense_dataset_view & p_data, const std::size_t p_begin, const std::size_t p_end, index_sequence & p_labels) const;
+
+    /*!
+
+    @brief    Finds the nearest center for points `p_indexes[p_begin]`, ..., `p_indexes[p_end - 1]`.
+
+    @param[in]  p_data: input data whose dimension is the same as dimension of centers.
+    @param[in]  p_indexes: indexes of points in the data.
+    @param[in]  p_begin: position of the first index that should be processed.
+    @param[in]  p_end: position after the last index that should be processed.
+    @param[out] p_labels: container where index of the nearest center is stored for each point (by index of
+                 the point), it should be allocated by the caller.
+
+    */
+    void assign(const container::dense_dataset_view & p_data, const index_sequence & p_indexes, const std::size_t p_begin, const std::size_t p_end, index_sequence & p_labels) const;
+
+    /*!
+
+    @brief    Calculates square Euclidean distances from each point in range `[p_begin; p_end)` to each center.
+
+    @param[in]  p_data: input data whose dimension is the same as dimension of centers.
+    @param[in]  p_begin: index of the first point.
+    @param[in]  p_end: index of the point after the last point.
+    @param[out] p_result: row-major buffer for `(p_end - p_begin) x size()` distances.
+
+    */
+    void distances(const container::dense_dataset_view & p_data, const std::size_t p_begin, const std::size_t p_end, double * p_result) const;
+
+    /*!
+
+    @brief    Returns amount of centers.
+
+    @return   Amount of centers.
+
+    */
+    std::size_t size() const;
+
+private:
+    template <typename TypeConsumer>
+    void process_block(const double * const * p_rows, const std::size_t p_amount, TypeConsumer & p_consumer) const;
+
+    template <std::size_t Rows>
+    void multiply_tile(const double * const * p_rows, const double * p_panel, double (&p_products)[Rows][TILE_CENTERS]) const;
+};
+
+
+}
+
+}
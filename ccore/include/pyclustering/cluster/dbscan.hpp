@@ -12,10 +12,17 @@
 #include <cmath>
 #include <algorithm>
 
-#include <pyclustering/container/kdtree_balanced.hpp>
+#include <pyclustering/container/ball_tree.hpp>
+#include <pyclustering/container/kdtree_flat.hpp>
 
 #include <pyclustering/cluster/data_type.hpp>
 #include <pyclustering/cluster/dbscan_data.hpp>
+#include <pyclustering/cluster/dbscan_grid.hpp>
+
+#include <pyclustering/utils/metric.hpp>
+
+
+using namespace pyclustering::utils::metric;
 
 
 namespace pyclustering {
@@ -23,6 +30,18 @@ namespace pyclustering {
 namespace clst {
 
 
+/*!
+
+@brief    Defines how DBSCAN finds neighbors of points.
+
+*/
+enum class dbscan_engine {
+    TREE = 0,       /**< Neighborhoods of all points are found by KD-tree (Euclidean distance), by ball tree (other metrics that satisfy the triangle inequality) or by brute force. */
+    GRID = 1,       /**< Points are processed by grid of cells (see `dbscan_grid`) if the metric is Euclidean and dimension is not greater than `dbscan_grid::MAXIMUM_DIMENSION`, otherwise by tree. */
+    PARALLEL = 2    /**< Neighborhoods are found like by `TREE` (or by rows of distance matrix), core points are merged into clusters in parallel by lock-free union-find instead of sequential expansion of clusters. */
+};
+
+
 /*!
 
 @class    dbscan dbscan.hpp pyclustering/cluster/dbscan.hpp
@@ -35,7 +54,7 @@ Implementation based on paper @cite inproceedings::dbscan::1.
 */
 class dbscan {
 private:
-    const dataset *            m_data_ptr      = nullptr;  /* temporary pointer to input data that is used only during processing */
+    container::dense_dataset_view m_data       = { };      /* temporary view of input data that is used only during processing */
 
     dbscan_data *              m_result_ptr    = nullptr;  /* temporary pointer to clustering result that is used only during processing */
 
@@ -43,13 +62,25 @@ private:
 
     std::vector<bool>          m_belong          = { };
 
+    std::vector<std::size_t>   m_stamps          = { };    /* the first point of the cluster whose expansion queue has contained the point (plus one) */
+
+    std::vector<std::size_t>   m_neighbor_buffer = { };    /* reusable buffer for neighbors of a point that is reached by expansion */
+
     double                     m_initial_radius  = 0.0;    /* original radius that was specified by user */
 
     size_t                     m_neighbors       = 0;
 
     data_t                     m_type            = data_t::POINTS;
 
-    container::kdtree_balanced m_kdtree = container::kdtree_balanced();
+    distance_metric<point>     m_metric          = distance_metric_factory<point>::euclidean();
+
+    dbscan_engine              m_engine          = dbscan_engine::TREE;
+
+    container::kdtree_flat m_kdtree = container::kdtree_flat();
+
+    container::ball_tree       m_ball_tree       = { };    /* index of points that is used instead of KD-tree for other metrics that satisfy the triangle inequality */
+
+    container::neighbor_graph  m_neighborhoods   = { };    /* temporary neighborhoods of points (without distances) that are found in parallel before processing */
 
 public:
     /*!
@@ -67,9 +98,14 @@ public:
     @param[in] p_radius_connectivity: connectivity radius between objects.
     @param[in] p_minimum_neighbors: minimum amount of shared neighbors that is require to connect
                 two object (if distance between them is less than connectivity radius).
+    @param[in] p_metric: metric that is used to calculate distance between points, neighbors are found by KD-tree
+                for Euclidean distance, by ball tree for other metrics that satisfy the triangle inequality
+                (see `container::ball_tree::is_applicable`) and by brute force otherwise.
+    @param[in] p_engine: defines how neighbors are found and clusters are formed, grid is recommended for large
+                low-dimensional data, parallel engine - for large data of higher dimension on multi-core systems.
     
     */
-    dbscan(const double p_radius_connectivity, const size_t p_minimum_neighbors);
+    dbscan(const double p_radius_connectivity, const size_t p_minimum_neighbors, const distance_metric<point> & p_metric = distance_metric_factory<point>::euclidean(), const dbscan_engine p_engine = dbscan_engine::TREE);
 
     /*!
     
@@ -100,6 +136,21 @@ public:
     */
     void process(const dataset & p_data, const data_t p_type, dbscan_data & p_result);
 
+    /*!
+
+    @brief    Performs cluster analysis of an input data of specific type that is stored contiguously.
+    @details  Clusters and noise are the same for each engine: clusters are ordered by their smallest core point
+               and a border point belongs to the first cluster that reaches it. Points of a cluster are ordered by
+               indexes if they are processed by grid or by the parallel engine, otherwise in order of expansion of
+               the cluster.
+
+    @param[in]  p_data: input data for cluster analysis.
+    @param[in]  p_type: type of an input data that should be clustered.
+    @param[out] p_result: clustering result of an input data.
+
+    */
+    void process(const container::dense_dataset_view & p_data, const data_t p_type, dbscan_data & p_result);
+
 private:
     /*!
     
@@ -115,9 +166,13 @@ private:
 
     void get_neighbors_from_distance_matrix(const size_t p_index, std::vector<size_t> & p_neighbors);
 
-    void create_kdtree(const dataset & p_data);
+    void create_neighborhoods(const container::dense_dataset_view & p_data);
+
+    void create_neighborhoods_from_distance_matrix(const container::dense_dataset_view & p_data);
 
     void expand_cluster(const std::size_t p_index, cluster & allocated_cluster);
+
+    void allocate_clusters_parallel();
 };
 
 
@@ -0,0 +1,148 @@
+/*!
+
+@authors Andrei Novikov (pyclustering@yandex.ru)
+@date 2014-2020
+@copyright BSD-3-Clause
+
+*/
+
+
+#pragma once
+
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <pyclustering/cluster/dbscan_data.hpp>
+#include <pyclustering/container/dense_dataset.hpp>
+#include <pyclustering/container/disjoint_set.hpp>
+
+
+namespace pyclustering {
+
+namespace clst {
+
+
+/*!
+
+@class    dbscan_grid dbscan_grid.hpp pyclustering/cluster/dbscan_grid.hpp
+
+@brief    Performs DBSCAN cluster analysis of low-dimensional points in line with Euclidean distance using grid.
+@details  The space is divided into cells with side \f$\varepsilon / \sqrt{d}\f$, so the diameter of a cell is the
+           connectivity radius and neighbors of a point are located in a fixed set of cells around its cell. Only
+           non-empty cells exist, they are sorted by coordinates, so cells that differ only by the last coordinate
+           (row) are stored one after another. Rows are stored in a hash table, therefore neighbor cells are found
+           by a search of rows around the cell and by binary search of the range of cells in each row.
+
+           A cell that contains more points than the minimum amount of neighbors consists of core points only, so
+           distances are calculated only for points of sparse cells. Two cells that contain core points are merged
+           (union-find) if there is a pair of their core points that are neighbors, cells that are already merged
+           are not checked. Border points are assigned to the cluster of the nearest (in order of clusters) core
+           point neighbor.
+
+           The result is the same as the result of `dbscan` that uses KD-tree: clusters are ordered by their
+           smallest core point and a border point belongs to the first cluster that reaches it, points of each
+           cluster and noise are ordered by indexes.
+
+*/
+class dbscan_grid {
+public:
+    const static std::size_t    MAXIMUM_DIMENSION;  /**< Maximum dimension of data that is processed by the grid, amount of neighbor cells grows exponentially with the dimension. */
+
+private:
+    const static std::size_t    NO_CELL;            /* marker of an empty slot of the table of rows and of a missing cell or row */
+
+    const static double         MAXIMUM_CELL_COORDINATE;    /* maximum coordinate of a cell that is represented by an integer exactly */
+
+private:
+    double                          m_radius            = 0.0;
+    std::size_t                     m_neighbors         = 0;
+
+    container::dense_dataset_view   m_data              = { };  /* temporary view of input data that is used only during processing */
+    std::vector<std::size_t>        m_order             = { };  /* indexes of points that are sorted by their cells */
+    std::vector<std::size_t>        m_point_cells       = { };  /* cell of each point */
+    std::vector<std::size_t>        m_cell_begin        = { };  /* position of the first point of each cell in the order, the last value is amount of points */
+    std::vector<std::int64_t>       m_cell_coordinates  = { };  /* coordinates of cells one after another */
+    std::vector<std::size_t>        m_row_begin         = { };  /* first cell of each row, the last value is amount of cells */
+    std::vector<std::size_t>        m_table             = { };  /* hash table (open addressing) of rows */
+    std::vector<std::int64_t>       m_offsets           = { };  /* offsets of rows that might contain neighbors of a point of a cell, each of them is followed by the maximum offset in the row */
+    std::vector<char>               m_core              = { };  /* `1` for each core point */
+
+public:
+    /*!
+
+    @brief    Default constructor of the engine.
+
+    */
+    dbscan_grid() = default;
+
+    /*!
+
+    @brief    Constructor of the engine with parameters of DBSCAN.
+
+    @param[in] p_radius_connectivity: connectivity radius between points (Euclidean distance).
+    @param[in] p_minimum_neighbors: minimum amount of neighbors (except the point itself) of a core point.
+
+    */
+    dbscan_grid(const double p_radius_connectivity, const std::size_t p_minimum_neighbors);
+
+    /*!
+
+    @brief    Default destructor of the engine.
+
+    */
+    ~dbscan_grid() = default;
+
+public:
+    /*!
+
+    @brief    Checks whether points might be processed by the grid.
+
+    @param[in] p_data: points that should be processed.
+    @param[in] p_radius_connectivity: connectivity radius between points.
+
+    @return   `true` if dimension of points is not greater than `MAXIMUM_DIMENSION`, the radius is positive and
+               coordinates of cells are represented by integers exactly.
+
+    */
+    static bool is_applicable(const container::dense_dataset_view & p_data, const double p_radius_connectivity);
+
+    /*!
+
+    @brief    Performs cluster analysis of points.
+
+    @param[in]  p_data: points for cluster analysis, they should be applicable for the grid (see `is_applicable`).
+    @param[out] p_result: clustering result of the points.
+
+    */
+    void process(const container::dense_dataset_view & p_data, dbscan_data & p_result);
+
+private:
+    void create_cells();
+
+    void create_table();
+
+    void create_offsets();
+
+    std::size_t find_row(const std::int64_t * p_coordinates) const;
+
+    void find_neighbor_cells(const std::size_t p_cell, std::vector<std::size_t> & p_cells) const;
+
+    void find_core_points();
+
+    void connect_core_cells(container::disjoint_set & p_cells) const;
+
+    bool has_core_neighbor(const std::size_t p_index, const std::size_t p_cell) const;
+
+    void allocate_clusters(container::disjoint_set & p_cells, dbscan_data & p_result) const;
+
+    double square_distance(const std::size_t p_index1, const std::size_t p_index2) const;
+
+    static std::uint64_t hash(const std::int64_t * p_coordinates, const std::size_t p_dimension);
+};
+
+
+}
+
+}
@@ -0,0 +1,187 @@
+/*!
+
+@authors Andrei Novikov (pyclustering@yandex.ru)
+@date 2014-2020
+@copyright BSD-3-Clause
+
+*/
+
+
+#pragma once
+
+
+#include <cstddef>
+#include <vector>
+
+#include <pyclustering/cluster/dbscan_data.hpp>
+#include <pyclustering/container/disjoint_set.hpp>
+#include <pyclustering/container/kdtree.hpp>
+#include <pyclustering/definitions.hpp>
+
+
+namespace pyclustering {
+
+namespace clst {
+
+
+/*!
+
+@class    dbscan_incremental dbscan_incremental.hpp pyclustering/cluster/dbscan_incremental.hpp
+
+@brief    Represents DBSCAN that maintains clusters while points are inserted and removed (Euclidean distance).
+@details  Points are stored in dynamic KD-tree, neighbors (except the point itself) of each point are stored and
+           updated on each change, so only neighbors of an inserted point are searched in the tree. Each core point
+           refers to its cluster, clusters are merged by union-find when new core points connect them.
+
+           A removed point and neighbors that lose core status might split their clusters. Components of core points
+           are traversed simultaneously from core neighbors of lost core points and traversal stops as soon as only
+           one of them is not finished, so a cluster that is not split is not traversed entirely and only small
+           separated components are relabeled.
+
+           Border points are assigned on request of clusters: clusters are ordered by their smallest core point and
+           a border point belongs to the first cluster that has a core point in its neighborhood, so the result is the
+           same as the result of `dbscan` for points that remain (points of each cluster and noise are ordered by
+           indexes).
+
+*/
+class dbscan_incremental {
+private:
+    const static std::size_t    NO_INDEX;       /* marker of a point that does not belong to any cluster */
+
+private:
+    double                                  m_radius        = 0.0;
+    std::size_t                             m_neighbors     = 0;
+
+    container::kdtree                       m_tree          = { };
+    std::vector<container::kdnode::ptr>     m_nodes         = { };  /* node of each point in the tree, `nullptr` for removed points */
+    std::vector<std::vector<std::size_t>>   m_adjacency     = { };  /* neighbors of each point except the point itself */
+    std::vector<std::size_t>                m_free          = { };  /* indexes of removed points that are reused by insertions */
+    std::size_t                             m_size          = 0;
+    std::size_t                             m_dimension     = 0;
+
+    std::vector<std::size_t>                m_labels        = { };  /* cluster of each core point (element of the union-find) */
+    container::disjoint_set                 m_clusters      = { };  /* clusters that have been merged */
+
+    std::vector<std::size_t>                m_stamps        = { };  /* the last traversal that has reached each point */
+    std::vector<std::size_t>                m_owners        = { };  /* the traversal from a seed that has reached each point */
+    std::size_t                             m_epoch         = 0;
+
+public:
+    /*!
+
+    @brief    Default constructor of the algorithm.
+
+    */
+    dbscan_incremental() = default;
+
+    /*!
+
+    @brief    Constructor of the algorithm with parameters of DBSCAN.
+
+    @param[in] p_radius_connectivity: connectivity radius between points.
+    @param[in] p_minimum_neighbors: minimum amount of neighbors (except the point itself) of a core point.
+
+    */
+    dbscan_incremental(const double p_radius_connectivity, const std::size_t p_minimum_neighbors);
+
+    /*!
+
+    @brief    Default destructor of the algorithm.
+
+    */
+    ~dbscan_incremental() = default;
+
+public:
+    /*!
+
+    @brief    Inserts point and updates clusters.
+
+    @param[in] p_point: point that should be inserted, its dimension should be the same as dimension of points
+                that are stored.
+
+    @return   Index of the point, indexes of removed points are reused.
+
+    */
+    std::size_t insert(const point & p_point);
+
+    /*!
+
+    @brief    Inserts points one by one and updates clusters.
+    @details  Dimensions of all points are checked before insertion, so nothing is inserted if any of them is
+               not consistent.
+
+    @param[in] p_points: points that should be inserted.
+
+    @return   Indexes of the points.
+
+    */
+    std::vector<std::size_t> insert(const dataset & p_points);
+
+    /*!
+
+    @brief    Removes point and updates clusters.
+
+    @param[in] p_index: index of the point that has been returned by insertion.
+
+    */
+    void remove(const std::size_t p_index);
+
+    /*!
+
+    @brief    Removes points one by one and updates clusters.
+    @details  All indexes are checked before removal, so nothing is removed if any of them does not exist or
+               is specified more than once.
+
+    @param[in] p_indexes: indexes of the points that have been returned by insertion.
+
+    */
+    void remove(const std::vector<std::size_t> & p_indexes);
+
+    /*!
+
+    @brief    Returns clusters and noise of points that are stored.
+
+    @param[out] p_result: clustering result where points are represented by their indexes.
+
+    */
+    void get_clusters(dbscan_data & p_result);
+
+    /*!
+
+    @brief    Returns point with the specified index.
+
+    @param[in] p_index: index of the point that has been returned by insertion.
+
+    */
+    const point & get_point(const std::size_t p_index) const;
+
+    /*!
+
+    @brief    Returns `true` if there is a point with the specified index.
+
+    @param[in] p_index: index of a point.
+
+    */
+    bool contains(const std::size_t p_index) const;
+
+    /*!
+
+    @brief    Returns amount of points that are stored.
+
+    */
+    std::size_t size() const;
+
+private:
+    bool is_core(const std::size_t p_index) const;
+
+    void connect(const std::vector<std::size_t> & p_cores);
+
+    void separate(const std::vector<std::size_t> & p_seeds);
+
+    void compress_clusters();
+};
+
+
+}
+
+}
@@ -159,7 +159,8 @@ private:
 
     std::vector<double> m_elbow  = { };
 
-    const dataset * m_data       = nullptr;
+    const dataset * m_data       = nullptr;      /* temporary pointer to input data that is used for center initialization */
+    container::dense_dataset_view m_dense_data = { };   /* temporary view of input data that is used by K-Means */
     elbow_data    * m_result     = nullptr;      /* temporary pointer to output result   */
 
 public:
@@ -246,13 +247,33 @@ public:
 
     */
     void process(const dataset & p_data, elbow_data & p_result) {
+        const container::dense_dataset dense_data(p_data);     /* K-Means is performed for each K using the same data */
+        process(p_data, dense_data, p_result);
+    }
+
+    /*!
+
+    @brief    Performs cluster analysis of an input data that is stored contiguously.
+    @details  Center initializers work with `dataset`, therefore points are copied once for them.
+
+    @param[in]  p_data: an input data that should be clusted.
+    @param[out] p_result: elbow input data processing result.
+
+    */
+    void process(const container::dense_dataset_view & p_data, elbow_data & p_result) {
+        process(p_data.to_dataset(), p_data, p_result);
+    }
+
+private:
+    void process(const dataset & p_data, const container::dense_dataset_view & p_dense_data, elbow_data & p_result) {
         if (p_data.size() < m_kmax) {
             throw std::invalid_argument("K max value '" + std::to_string(m_kmax) 
               + "' is greater than amount of data points '" + std::to_string(p_data.size()) + "'.");
         }
 
-        m_data   = &p_data;
-        m_result = &p_result;
+        m_data       = &p_data;
+        m_dense_data = p_dense_data;
+        m_result     = &p_result;
 
         m_result->get_wce().resize(m_kamount);
 
@@ -262,9 +283,11 @@ public:
 
         calculate_elbows();
         m_result->set_amount(find_optimal_kvalue());
+
+        m_data       = nullptr;
+        m_dense_data = { };
     }
 
-private:
     template<class CenterInitializer = TypeInitializer>
     typename std::enable_if<std::is_same<CenterInitializer, kmeans_plus_plus>::value, void>::type
     static prepare_centers(const std::size_t p_amount, const dataset & p_data, const long long p_random_state, dataset & p_initial_centers) {
@@ -283,7 +306,7 @@ private:
 
         kmeans_data result;
         kmeans instance(initial_centers, kmeans::DEFAULT_TOLERANCE);
-        instance.process(*m_data, result);
+        instance.process(m_dense_data, result);
 
         m_result->get_wce().at((p_kvalue - m_kmin) / m_kstep) = result.wce();
     }
@@ -11,6 +11,8 @@
 
 #include <pyclustering/cluster/fcm_data.hpp>
 
+#include <pyclustering/container/dense_dataset.hpp>
+
 
 namespace pyclustering {
 
@@ -109,7 +111,7 @@ private:
 
     fcm_data        * m_ptr_result          = nullptr;      /* temporary pointer to output result */
 
-    const dataset   * m_ptr_data            = nullptr;      /* used only during processing */
+    container::dense_dataset_view m_data    = { };          /* used only during processing */
 
 public:
     /*!
@@ -153,6 +155,16 @@ public:
     */
     void process(const dataset & p_data, fcm_data & p_result);
 
+    /*!
+
+    @brief    Performs cluster analysis of an input data that is stored contiguously.
+
+    @param[in]  p_data: input data for cluster analysis.
+    @param[out] p_result: FCM clustering result of an input data.
+
+    */
+    void process(const container::dense_dataset_view & p_data, fcm_data & p_result);
+
 private:
     void verify() const;
 
@@ -162,7 +174,7 @@ private:
 
     void update_membership();
 
-    void update_point_membership(const std::size_t p_index);
+    void update_point_membership(const std::size_t p_index, const double * p_differences);
 
     void extract_clusters(cluster_sequence & p_clusters);
 };
@@ -14,6 +14,8 @@
 
 #include <pyclustering/cluster/gmeans_data.hpp>
 
+#include <pyclustering/container/dense_dataset.hpp>
+
 #include <pyclustering/utils/metric.hpp>
 
 
@@ -116,6 +118,8 @@ private:
 
     const dataset           * m_ptr_data            = nullptr;      /* used only during processing */
 
+    container::dense_dataset m_dense_data           = { };          /* contiguous copy of input data for K-Means, used only during processing */
+
 public:
     /*!
     
@@ -0,0 +1,135 @@
+/*!
+
+@authors Andrei Novikov (pyclustering@yandex.ru)
+@date 2014-2020
+@copyright BSD-3-Clause
+
+*/
+
+
+#pragma once
+
+
+#include <cstddef>
+#include <vector>
+
+#include <pyclustering/container/dense_dataset.hpp>
+#include <pyclustering/container/kdtree_flat.hpp>
+
+#include <pyclustering/cluster/hdbscan_data.hpp>
+
+#include <pyclustering/definitions.hpp>
+
+
+namespace pyclustering {
+
+namespace clst {
+
+
+/*!
+
+@class    hdbscan hdbscan.hpp pyclustering/cluster/hdbscan.hpp
+
+@brief    Represents HDBSCAN (Hierarchical DBSCAN) clustering algorithm (Euclidean distance).
+@details  Core distance of each point is found by KD-tree. Minimum spanning tree of mutual reachability distance
+           `max(core distance of the first point, core distance of the second point, distance)` is built by Boruvka
+           algorithm: on each iteration the nearest point of another component is found for all points in parallel by
+           KD-tree whose sub-trees that belong to the same component are skipped, then components are merged by their
+           shortest edges. The spanning tree forms the single-linkage hierarchy that is condensed by the minimum
+           cluster size, clusters with the largest sum of stability (excess of mass) are selected from the condensed
+           tree. The root of the hierarchy is not selected, so there are at least two clusters or only noise.
+
+           Clusters are ordered by their smallest point, points of clusters and noise are ordered by indexes.
+
+Implementation based on papers @cite inproceedings::hdbscan::1 and @cite inproceedings::hdbscan::2.
+
+*/
+class hdbscan {
+private:
+    struct edge {
+        std::size_t     m_point1    = 0;
+        std::size_t     m_point2    = 0;
+        double          m_distance  = 0.0;      /* mutual reachability distance */
+    };
+
+    struct condensed_edge {
+        std::size_t     m_parent    = 0;        /* cluster */
+        std::size_t     m_child     = 0;        /* point if it is less than amount of points, otherwise cluster */
+        double          m_lambda    = 0.0;      /* inverse distance where the child leaves the parent */
+        std::size_t     m_size      = 0;
+    };
+
+private:
+    std::size_t                     m_neighbors             = 0;
+    std::size_t                     m_minimum_cluster_size  = 2;
+
+    container::dense_dataset_view   m_data                  = { };      /* temporary view of input data that is used only during processing */
+    hdbscan_data *                  m_result_ptr            = nullptr;  /* temporary pointer to clustering result that is used only during processing */
+    container::kdtree_flat          m_tree                  = { };
+    std::vector<double>             m_core_distances        = { };      /* square core distances */
+
+public:
+    /*!
+
+    @brief    Default constructor of the algorithm.
+
+    */
+    hdbscan() = default;
+
+    /*!
+
+    @brief    Constructor of the algorithm with its parameters.
+
+    @param[in] p_minimum_neighbors: amount of neighbors (except the point itself) that defines core distance of a
+                point.
+    @param[in] p_minimum_cluster_size: minimum amount of points in a cluster, it should be greater than 1.
+
+    */
+    hdbscan(const std::size_t p_minimum_neighbors, const std::size_t p_minimum_cluster_size);
+
+    /*!
+
+    @brief    Default destructor of the algorithm.
+
+    */
+    ~hdbscan() = default;
+
+public:
+    /*!
+
+    @brief    Performs cluster analysis of an input data.
+
+    @param[in]  p_data: input data (points) for cluster analysis.
+    @param[out] p_result: clustering result of an input data.
+
+    @throw  `std::invalid_argument` if the minimum cluster size is less than 2 or any coordinate is infinite or NaN.
+
+    */
+    void process(const dataset & p_data, hdbscan_data & p_result);
+
+    /*!
+
+    @brief    Performs cluster analysis of an input data that is stored contiguously.
+
+    @param[in]  p_data: input data (points) for cluster analysis.
+    @param[out] p_result: clustering result of an input data.
+
+    @throw  `std::invalid_argument` if the minimum cluster size is less than 2 or any coordinate is infinite or NaN.
+
+    */
+    void process(const container::dense_dataset_view & p_data, hdbscan_data & p_result);
+
+private:
+    void calculate_core_distances();
+
+    void create_spanning_tree(std::vector<edge> & p_spanning_tree) const;
+
+    void condense_tree(std::vector<edge> & p_spanning_tree, std::vector<condensed_edge> & p_condensed_tree, std::size_t & p_amount_clusters) const;
+
+    void extract_clusters(const std::vector<condensed_edge> & p_condensed_tree, const std::size_t p_amount_clusters);
+};
+
+
+}
+
+}
@@ -0,0 +1,103 @@
+/*!
+
+@authors Andrei Novikov (pyclustering@yandex.ru)
+@date 2014-2020
+@copyright BSD-3-Clause
+
+*/
+
+
+#pragma once
+
+
+#include <vector>
+
+#include <pyclustering/cluster/dbscan_data.hpp>
+
+
+namespace pyclustering {
+
+namespace clst {
+
+
+/*!
+
+@class    hdbscan_data hdbscan_data.hpp pyclustering/cluster/hdbscan_data.hpp
+
+@brief    Clustering results of HDBSCAN algorithm that consists of allocated clusters, noise, stability of each
+           cluster and core distance of each point.
+
+*/
+class hdbscan_data : public dbscan_data {
+private:
+    std::vector<double>     m_stability         = { };
+    std::vector<double>     m_core_distances    = { };
+
+public:
+    /*!
+
+    @brief    Default constructor that creates empty clustering data.
+
+    */
+    hdbscan_data() = default;
+
+    /*!
+
+    @brief    Default copy constructor.
+
+    @param[in] p_other: another clustering data.
+
+    */
+    hdbscan_data(const hdbscan_data & p_other) = default;
+
+    /*!
+
+    @brief    Default move constructor.
+
+    @param[in] p_other: another clustering data.
+
+    */
+    hdbscan_data(hdbscan_data && p_other) = default;
+
+    /*!
+
+    @brief    Default destructor that destroys clustering data.
+
+    */
+    virtual ~hdbscan_data() = default;
+
+public:
+    /*!
+
+    @brief    Returns reference to stability of each allocated cluster (excess of mass in the condensed tree).
+
+    */
+    std::vector<double> & stability() { return m_stability; }
+
+    /*!
+
+    @brief    Returns const reference to stability of each allocated cluster (excess of mass in the condensed tree).
+
+    */
+    const std::vector<double> & stability() const { return m_stability; }
+
+    /*!
+
+    @brief    Returns reference to core distance of each point (distance to its farthest neighbor from the minimum
+               amount of neighbors).
+
+    */
+    std::vector<double> & core_distances() { return m_core_distances; }
+
+    /*!
+
+    @brief    Returns const reference to core distance of each point.
+
+    */
+    const std::vector<double> & core_distances() const { return m_core_distances; }
+};
+
+
+}
+
+}
@@ -14,6 +14,8 @@
 
 #include <pyclustering/cluster/kmeans_data.hpp>
 
+#include <pyclustering/container/dense_dataset.hpp>
+
 #include <pyclustering/utils/metric.hpp>
 
 
@@ -24,6 +26,24 @@ namespace pyclustering {
 
 namespace clst {
 
+/*!
+
+@brief    Defines how K-Means avoids calculation of distances between points and centers.
+@details  Accelerated modes keep bounds of distances from each point to centers and update them using drift of
+           centers, therefore distances are calculated only for points that might change their clusters. Bounds are
+           based on triangle inequality and they are used for Euclidean, square Euclidean (where bounds are kept
+           for Euclidean distance), Manhattan and Chebyshev metrics, other metrics are processed without
+           acceleration.
+
+*/
+enum class kmeans_acceleration {
+    NONE = 0,       /**< Distances from all points to all centers are calculated on each iteration. */
+    AUTO = 1,       /**< Hamerly's method is used for small amount of clusters, Elkan's method otherwise (see kmeans::ELKAN_MINIMUM_CLUSTERS). */
+    HAMERLY = 2,    /**< Hamerly's method: one upper bound and one lower bound per point. */
+    ELKAN = 3       /**< Elkan's method: one upper bound and one lower bound per point and center (memory is proportional to amount of points multiplied by amount of clusters). */
+};
+
+
 /*!
 
 @class    kmeans kmeans.hpp pyclustering/cluster/kmeans.hpp
@@ -38,6 +58,8 @@ public:
 
     const static std::size_t        DEFAULT_ITERMAX;    /**< Default value of the step stop condition - maximum number of iterations that is used for clustering process. */
 
+    const static std::size_t        ELKAN_MINIMUM_CLUSTERS; /**< Minimum amount of clusters when Elkan's method is chosen by kmeans_acceleration::AUTO. */
+
 private:
     double                  m_tolerance             = DEFAULT_TOLERANCE;
 
@@ -47,12 +69,14 @@ private:
 
     kmeans_data             * m_ptr_result          = nullptr;      /* temporary pointer to output result */
 
-    const dataset           * m_ptr_data            = nullptr;      /* used only during processing */
+    container::dense_dataset_view m_data            = { };          /* used only during processing */
 
     const index_sequence    * m_ptr_indexes         = nullptr;      /* temporary pointer to indexes */
 
     distance_metric<point>  m_metric;
 
+    kmeans_acceleration     m_acceleration          = kmeans_acceleration::NONE;
+
 public:
     /*!
     
@@ -71,12 +95,14 @@ public:
                 cluster centers is less than tolerance than algorithm will stop processing.
     @param[in] p_itermax: maximum number of iterations (by default kmeans::DEFAULT_ITERMAX).
     @param[in] p_metric: distance metric calculator for two points.
+    @param[in] p_acceleration: defines whether bounds of distances are used to skip distance calculations.
     
     */
     kmeans(const dataset & p_initial_centers, 
            const double p_tolerance = DEFAULT_TOLERANCE,
            const std::size_t p_itermax = DEFAULT_ITERMAX,
-           const distance_metric<point> & p_metric = distance_metric_factory<point>::euclidean_square());
+           const distance_metric<point> & p_metric = distance_metric_factory<point>::euclidean_square(),
+           const kmeans_acceleration p_acceleration = kmeans_acceleration::NONE);
 
     /*!
     
@@ -111,11 +137,47 @@ public:
     */
     void process(const dataset & p_data, const index_sequence & p_indexes, kmeans_data & p_result);
 
+    /*!
+
+    @brief    Performs cluster analysis of an input data that is stored contiguously.
+
+    @param[in]     p_data: input data for cluster analysis.
+    @param[in,out] p_result: clustering result of an input data, it is also considered as an input argument to
+                    where observer parameter can be set to collect changes of clusters and centers on each step of
+                    processing.
+
+    */
+    void process(const container::dense_dataset_view & p_data, kmeans_data & p_result);
+
+    /*!
+
+    @brief    Performs cluster analysis of an input data that is stored contiguously.
+
+    @param[in]     p_data: input data for cluster analysis.
+    @param[in]     p_indexes: specify indexes of objects in 'p_data' that should be used during clustering process.
+    @param[in,out] p_result: clustering result of an input data, it is also considered as an input argument to
+                    where observer parameter can be set to collect changes of clusters and centers on each step of
+                    processing.
+
+    */
+    void process(const container::dense_dataset_view & p_data, const index_sequence & p_indexes, kmeans_data & p_result);
+
 private:
+    kmeans_acceleration get_acceleration() const;
+
+    void process_accelerated(const kmeans_acceleration p_acceleration);
+
+    template <typename TypeDistance>
+    void process_bounded(const kmeans_acceleration p_acceleration, const TypeDistance & p_distance);
+
     void update_clusters(const dataset & p_centers, cluster_sequence & p_clusters);
 
     double update_centers(const cluster_sequence & clusters, dataset & centers);
 
+    void assign_points_blocked(const dataset & p_centers, cluster_sequence & p_clusters);
+
+    void assign_points_vectorized(const dataset & p_centers, cluster_sequence & p_clusters);
+
     void assign_point_to_cluster(const std::size_t p_index_point, const dataset & p_centers, index_sequence & p_clusters);
 
     /*!
@@ -13,6 +13,8 @@
 
 #include <pyclustering/cluster/kmedians_data.hpp>
 
+#include <pyclustering/container/dense_dataset.hpp>
+
 #include <pyclustering/utils/metric.hpp>
 
 
@@ -48,7 +50,7 @@ private:
 
     kmedians_data         * m_ptr_result        = nullptr;   /* temporary pointer to output result */
 
-    const dataset         * m_ptr_data          = nullptr;     /* used only during processing */
+    container::dense_dataset_view m_data        = { };         /* used only during processing */
 
     distance_metric<point>  m_metric;
 
@@ -95,6 +97,16 @@ public:
     */
     void process(const dataset & p_data, kmedians_data & p_output_result);
 
+    /**
+    *
+    * @brief    Performs cluster analysis of an input data that is stored contiguously.
+    *
+    * @param[in]  p_data: input data for cluster analysis.
+    * @param[out] p_output_result: clustering result of an input data.
+    *
+    */
+    void process(const container::dense_dataset_view & p_data, kmedians_data & p_output_result);
+
 private:
     /**
     *
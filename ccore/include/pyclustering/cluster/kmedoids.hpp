@@ -14,6 +14,8 @@
 #include <pyclustering/cluster/data_type.hpp>
 #include <pyclustering/cluster/kmedoids_data.hpp>
 
+#include <pyclustering/container/dense_dataset.hpp>
+
 #include <pyclustering/utils/metric.hpp>
 
 
@@ -48,6 +50,8 @@ private:
 
     static const double      NOTHING_TO_SWAP;
 
+    static constexpr std::size_t DISTANCE_BLOCK = 256;  /* amount of distances from a candidate that are calculated together */
+
 private:
     using distance_calculator = std::function<double(const std::size_t, const std::size_t)>;
 
@@ -63,7 +67,7 @@ private:
     };
 
 private:
-    const dataset                   * m_data_ptr      = nullptr;    /* temporary pointer to input data that is used only during processing */
+    container::dense_dataset_view   m_data            = { };        /* temporary view of input data that is used only during processing */
 
     kmedoids_data                   * m_result_ptr    = nullptr;    /* temporary pointer to clustering result that is used only during processing */
 
@@ -83,6 +87,8 @@ private:
 
     distance_calculator             m_calculator;
 
+    bool                            m_vectorized      = false;      /* distances between points are calculated by vectorized kernels */
+
 public:
     /*!
     
@@ -137,6 +143,17 @@ public:
     */
     void process(const dataset & p_data, const data_t p_type, kmedoids_data & p_result);
 
+    /*!
+
+    @brief    Performs cluster analysis of an input data that is stored contiguously.
+
+    @param[in]  p_data: input data for cluster analysis.
+    @param[in]  p_type: data type (points or distance matrix).
+    @param[out] p_result: clustering result of an input data.
+
+    */
+    void process(const container::dense_dataset_view & p_data, const data_t p_type, kmedoids_data & p_result);
+
 private:
     /*!
     
@@ -192,6 +209,20 @@ private:
 
     /*!
 
+    @brief  Calculates distances from the point `p_index` to points `p_begin`, ..., `p_begin + p_amount - 1`.
+    @details Distances are calculated by vectorized kernels (one-to-many) if input data is represented by points
+              and the metric is supported by `utils::simd`, otherwise by the distance calculator.
+
+    @param[in]  p_index: index of the point whose distances are calculated.
+    @param[in]  p_begin: index of the first point of the range.
+    @param[in]  p_amount: amount of points in the range.
+    @param[out] p_result: buffer for `p_amount` distances.
+
+    */
+    void calculate_distances(const std::size_t p_index, const std::size_t p_begin, const std::size_t p_amount, double * p_result) const;
+
+    /*!
+
     @brief      Erase empty clusters and their medoids.
     @details    Data might have identical points and a lot of identical points and as a result medoids might correspond
                   to points that are totally identical.
@@ -0,0 +1,264 @@
+/*!
+
+@authors Andrei Novikov (pyclustering@yandex.ru)
+@date 2014-2020
+@copyright BSD-3-Clause
+
+*/
+
+
+#pragma once
+
+
+#include <functional>
+#include <random>
+#include <vector>
+
+#include <pyclustering/cluster/kmeans_data.hpp>
+#include <pyclustering/container/dense_dataset.hpp>
+#include <pyclustering/definitions.hpp>
+#include <pyclustering/utils/metric.hpp>
+
+
+using namespace pyclustering::utils::metric;
+
+
+namespace pyclustering {
+
+namespace clst {
+
+
+/*!
+
+@class    minibatch_kmeans minibatch_kmeans.hpp pyclustering/cluster/minibatch_kmeans.hpp
+
+@brief    Represents Mini-Batch K-Means clustering algorithm for data that is processed by batches.
+@details  Each batch of points is assigned to the nearest centers and then each center is moved towards each of its
+           points with its own learning rate that is inversely proportional to the amount of points that have been
+           assigned to the center so far. Therefore the algorithm does not store processed points and it can be fed
+           continuously by `partial_fit` or by a batch source.
+
+           Centers are seeded by K-Means++ on a reservoir sample: each point that is received before initialization
+           is offered to the reservoir (algorithm R), so the reservoir is a uniform sample of all of them. Centers
+           are initialized when the warm-up amount of points has been offered (or when `process` reaches the end of
+           the input), after that the reservoir is used as the first batch.
+
+           Implementation based on paper @cite inproceedings::minibatch_kmeans::1.
+
+*/
+class minibatch_kmeans {
+public:
+    /*!
+
+    @brief    Source of batches for cluster analysis of data that does not fit into memory.
+    @details  The source fills the output batch by next points and returns `false` if there are no more points (the
+               batch that is returned together with `false` is ignored).
+
+    */
+    using batch_source = std::function<bool(dataset &)>;
+
+public:
+    const static double             DEFAULT_TOLERANCE;          /**< Default value of the tolerance stop condition for in-memory data: if maximum change of centers after a batch is less than tolerance then algorithm stops processing. */
+
+    const static std::size_t        DEFAULT_ITERMAX;            /**< Default maximum number of batches that are processed for in-memory data. */
+
+    const static std::size_t        DEFAULT_BATCH_SIZE;         /**< Default amount of points in a batch that is sampled from in-memory data. */
+
+    const static std::size_t        DEFAULT_RESERVOIR_SIZE;     /**< Default amount of points in the reservoir that is used for initialization of centers. */
+
+    const static std::size_t        DEFAULT_WARM_UP_SIZE;       /**< Default amount of points that are offered to the reservoir before initialization of centers. */
+
+private:
+    std::size_t             m_amount_clusters   = 0;
+
+    std::size_t             m_batch_size        = DEFAULT_BATCH_SIZE;
+
+    std::size_t             m_reservoir_size    = DEFAULT_RESERVOIR_SIZE;
+
+    std::size_t             m_warm_up_size      = DEFAULT_WARM_UP_SIZE;
+
+    double                  m_tolerance         = DEFAULT_TOLERANCE;
+
+    std::size_t             m_itermax           = DEFAULT_ITERMAX;
+
+    distance_metric<point>  m_metric;
+
+    long long               m_random_state      = RANDOM_STATE_CURRENT_TIME;
+
+    std::mt19937            m_generator;
+
+    dataset                 m_centers           = { };
+
+    std::vector<std::size_t> m_counts           = { };      /* amount of points that have been assigned to each center */
+
+    dataset                 m_reservoir         = { };      /* sample of points that have been received before initialization */
+
+    std::size_t             m_amount_seen       = 0;        /* amount of points that have been offered to the reservoir */
+
+public:
+    /*!
+
+    @brief    Default constructor of clustering algorithm.
+
+    */
+    minibatch_kmeans() = default;
+
+    /*!
+
+    @brief    Constructor of clustering algorithm that seeds centers by K-Means++.
+
+    @param[in] p_amount_clusters: amount of clusters that should be allocated.
+    @param[in] p_batch_size: amount of points in a batch that is sampled from in-memory data.
+    @param[in] p_reservoir_size: amount of points that are sampled to initialize centers, it should not be less
+                than amount of clusters.
+    @param[in] p_warm_up_size: amount of points that are offered to the reservoir by `partial_fit` before centers
+                are initialized, it should not be less than the reservoir size.
+    @param[in] p_tolerance: stop condition for in-memory data, when maximum change of centers after a batch is
+                less than tolerance then algorithm stops processing.
+    @param[in] p_itermax: maximum amount of batches that are processed for in-memory data.
+    @param[in] p_metric: distance metric calculator for two points.
+    @param[in] p_random_state: seed for random state (by default is `RANDOM_STATE_CURRENT_TIME`, current system
+                time is used).
+
+    */
+    minibatch_kmeans(const std::size_t p_amount_clusters,
+                     const std::size_t p_batch_size = DEFAULT_BATCH_SIZE,
+                     const std::size_t p_reservoir_size = DEFAULT_RESERVOIR_SIZE,
+                     const std::size_t p_warm_up_size = DEFAULT_WARM_UP_SIZE,
+                     const double p_tolerance = DEFAULT_TOLERANCE,
+                     const std::size_t p_itermax = DEFAULT_ITERMAX,
+                     const distance_metric<point> & p_metric = distance_metric_factory<point>::euclidean_square(),
+                     const long long p_random_state = RANDOM_STATE_CURRENT_TIME);
+
+    /*!
+
+    @brief    Constructor of clustering algorithm that starts from the specified centers.
+
+    @param[in] p_initial_centers: initial centers, the reservoir and the warm-up are not used in this case.
+    @param[in] p_batch_size: amount of points in a batch that is sampled from in-memory data.
+    @param[in] p_tolerance: stop condition for in-memory data.
+    @param[in] p_itermax: maximum amount of batches that are processed for in-memory data.
+    @param[in] p_metric: distance metric calculator for two points.
+    @param[in] p_random_state: seed for random state that is used to sample batches from in-memory data.
+
+    */
+    minibatch_kmeans(const dataset & p_initial_centers,
+                     const std::size_t p_batch_size = DEFAULT_BATCH_SIZE,
+                     const double p_tolerance = DEFAULT_TOLERANCE,
+                     const std::size_t p_itermax = DEFAULT_ITERMAX,
+                     const distance_metric<point> & p_metric = distance_metric_factory<point>::euclidean_square(),
+                     const long long p_random_state = RANDOM_STATE_CURRENT_TIME);
+
+    /*!
+
+    @brief    Default destructor of the algorithm.
+
+    */
+    ~minibatch_kmeans() = default;
+
+public:
+    /*!
+
+    @brief    Performs cluster analysis of in-memory data by batches that are sampled from it.
+    @details  Clusters, centers and total within-cluster errors are calculated for all points when batches are
+               processed. Centers of empty clusters are removed. All points are offered to the reservoir if centers
+               are not initialized.
+
+    @param[in]     p_data: input data for cluster analysis.
+    @param[in,out] p_result: clustering result, if it is observed then initial centers and clusters and then
+                    centers and clusters after each batch are collected.
+
+    */
+    void process(const dataset & p_data, kmeans_data & p_result);
+
+    /*!
+
+    @brief    Performs cluster analysis of in-memory data that is stored contiguously.
+
+    @param[in]     p_data: input data for cluster analysis.
+    @param[in,out] p_result: clustering result, if it is observed then initial centers and clusters and then
+                    centers and clusters after each batch are collected.
+
+    */
+    void process(const container::dense_dataset_view & p_data, kmeans_data & p_result);
+
+    /*!
+
+    @brief    Performs cluster analysis of all batches that are provided by the source.
+    @details  Points are not stored, therefore only centers are returned by the result, clusters are empty and
+               points might be assigned to centers by `predict`.
+
+    @param[in]     p_source: source of batches that is called until it returns `false`.
+    @param[in,out] p_result: clustering result, if it is observed then centers are collected after each batch.
+
+    */
+    void process(const batch_source & p_source, kmeans_data & p_result);
+
+    /*!
+
+    @brief    Updates centers by the batch of points.
+    @details  All points are offered to the reservoir until the warm-up amount of points has been reached, then
+               centers are initialized by the reservoir. Next batches update centers.
+
+    @param[in] p_batch: batch of points.
+
+    */
+    void partial_fit(const dataset & p_batch);
+
+    /*!
+
+    @brief    Updates centers by the batch of points that are stored contiguously.
+
+    @param[in] p_batch: batch of points.
+
+    */
+    void partial_fit(const container::dense_dataset_view & p_batch);
+
+    /*!
+
+    @brief    Assigns points to the nearest centers.
+    @details  Labels are not changed if centers are not initialized or dimension of points is not the same as
+               dimension of centers (`std::invalid_argument` is thrown).
+
+    @param[in]  p_data: points that should be assigned.
+    @param[out] p_labels: index of the nearest center for each point.
+
+    */
+    void predict(const container::dense_dataset_view & p_data, index_sequence & p_labels) const;
+
+    /*!
+
+    @brief    Returns current centers, they are empty until the warm-up is over.
+
+    @return   Current centers.
+
+    */
+    const dataset & get_centers() const;
+
+    /*!
+
+    @brief    Checks whether centers have been initialized.
+
+    @return   `true` if centers are initialized.
+
+    */
+    bool is_initialized() const;
+
+private:
+    void verify() const;
+
+    void initialize_random_generator();
+
+    void sample_to_reservoir(const container::dense_dataset_view & p_data, const std::size_t p_begin, const std::size_t p_end);
+
+    void initialize_centers();
+
+    double update_centers(const container::dense_dataset_view & p_batch);
+
+    void extract_clusters(const container::dense_dataset_view & p_data, kmeans_data & p_result) const;
+};
+
+
+}
+
+}
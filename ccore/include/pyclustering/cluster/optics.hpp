@@ -10,15 +10,23 @@
 
 
 #include <list>
-#include <set>
 #include <tuple>
 
-#include <pyclustering/container/kdtree_balanced.hpp>
+#include <pyclustering/container/ball_tree.hpp>
+#include <pyclustering/container/dense_dataset.hpp>
+#include <pyclustering/container/indexed_heap.hpp>
+#include <pyclustering/container/kdtree_flat.hpp>
+#include <pyclustering/container/neighbor_graph.hpp>
 
 #include <pyclustering/cluster/data_type.hpp>
 #include <pyclustering/cluster/optics_data.hpp>
 #include <pyclustering/cluster/optics_descriptor.hpp>
 
+#include <pyclustering/utils/metric.hpp>
+
+
+using namespace pyclustering::utils::metric;
+
 
 namespace pyclustering {
 
@@ -40,30 +48,10 @@ class optics {
 public:
     static const double       NONE_DISTANCE;    /**< Defines no distance value. */
     static const std::size_t  INVALID_INDEX;    /**< Defines incorrect index. */
+    static const std::size_t  NO_GENERATION;    /**< Defines data whose neighborhoods are not kept after processing. */
 
 private:
-    struct neighbor_descriptor {
-    public:
-        std::size_t m_index             = INVALID_INDEX;
-        double m_reachability_distance  = 0;
-
-    public:
-        neighbor_descriptor(const std::size_t p_index, const double p_distance) :
-            m_index(p_index), m_reachability_distance(p_distance)
-        { }
-    };
-
-    struct neighbor_descriptor_less {
-    public:
-        bool operator()(const neighbor_descriptor & p_object1, const neighbor_descriptor & p_object2) const {
-            return p_object1.m_reachability_distance < p_object2.m_reachability_distance;
-        }
-    };
-
-    using neighbors_collection = std::multiset<neighbor_descriptor, neighbor_descriptor_less>;
-
-private:
-    const dataset       * m_data_ptr        = nullptr;
+    container::dense_dataset_view m_data    = { };
 
     optics_data         * m_result_ptr      = nullptr;
 
@@ -75,12 +63,34 @@ private:
 
     data_t              m_type              = data_t::POINTS;
 
-    container::kdtree_balanced      m_kdtree            = container::kdtree_balanced();
+    distance_metric<point>          m_metric            = distance_metric_factory<point>::euclidean();
+
+    container::kdtree_flat          m_kdtree            = container::kdtree_flat();
+
+    container::ball_tree            m_ball_tree         = { };      /* index of points that is used instead of KD-tree for other metrics that satisfy the triangle inequality */
 
     optics_object_sequence *        m_optics_objects    = nullptr;
 
     std::list<optics_descriptor *>  m_ordered_database  = { };
 
+    container::indexed_heap         m_order_seed        = { };      /* seeds of the expanded cluster ordered by reachability distance, elements are indexes of objects */
+
+    container::neighbor_graph       m_neighborhoods     = { };      /* neighbors of each object ordered by distance (square Euclidean distances for points are stored) */
+
+    std::vector<double>             m_core_distances    = { };      /* core distance of each object for the radius of neighborhoods */
+
+    double                          m_neighborhoods_radius  = -1.0; /* radius of neighborhoods, they are reused for the same data and a radius that is not greater */
+
+    data_t                          m_neighborhoods_type    = data_t::POINTS;
+
+    std::size_t                     m_generation            = NO_GENERATION;    /* generation of the processed data that is specified by the caller */
+
+    std::size_t                     m_neighborhoods_generation  = NO_GENERATION;
+
+    std::size_t                     m_neighborhoods_size        = 0;
+
+    std::size_t                     m_neighborhoods_dimension   = 0;
+
 public:
     /*!
     
@@ -110,9 +120,12 @@ public:
     @param[in] p_radius: connectivity radius between objects.
     @param[in] p_neighbors: minimum amount of shared neighbors that is require to connect
                 two object (if distance between them is less than connectivity radius).
+    @param[in] p_metric: metric that is used to calculate distance between points, neighbors are found by KD-tree
+                for Euclidean distance, by ball tree for other metrics that satisfy the triangle inequality
+                (see `container::ball_tree::is_applicable`) and by brute force otherwise.
 
     */
-    optics(const double p_radius, const std::size_t p_neighbors);
+    optics(const double p_radius, const std::size_t p_neighbors, const distance_metric<point> & p_metric = distance_metric_factory<point>::euclidean());
 
     /*!
 
@@ -123,8 +136,9 @@ public:
                 two object (if distance between them is less than connectivity radius).
     @param[in] p_amount_clusters: amount of clusters that should be allocated (in this case
                 connectivity radius may be changed by the algorithm.
+    @param[in] p_metric: metric that is used to calculate distance between points.
     */
-    optics(const double p_radius, const std::size_t p_neighbors, const std::size_t p_amount_clusters);
+    optics(const double p_radius, const std::size_t p_neighbors, const std::size_t p_amount_clusters, const distance_metric<point> & p_metric = distance_metric_factory<point>::euclidean());
 
     /*!
 
@@ -158,6 +172,32 @@ public:
     */
     void process(const dataset & p_data, const data_t p_type, optics_data & p_result);
 
+    /*!
+
+    @brief    Performs cluster analysis of specific input data (points or distance matrix) that is stored
+               contiguously.
+    @details  Neighborhoods of all objects are found in parallel once, so they are reused when the radius is adjusted
+               for the required amount of clusters. If the caller specifies generation of the data then neighborhoods
+               are kept after processing and they are reused by the next call with the same generation and a radius
+               that is not greater. The caller is responsible for a new generation when the data is changed.
+
+    @param[in]  p_data: input data for cluster analysis.
+    @param[in]  p_type: type of input data (points or distance matrix).
+    @param[out] p_result: clustering result of an input data (consists of allocated clusters,
+                 cluster-ordering, noise and proper connectivity radius).
+    @param[in]  p_generation: generation of the data that identifies it for the next calls, neighborhoods are not
+                 kept if it is `NO_GENERATION`.
+
+    */
+    void process(const container::dense_dataset_view & p_data, const data_t p_type, optics_data & p_result, const std::size_t p_generation = NO_GENERATION);
+
+    /*!
+
+    @brief    Releases neighborhoods that are kept for the generation of data, so they are found again by the next call.
+
+    */
+    void clear_neighborhoods();
+
 private:
     void initialize();
 
@@ -167,21 +207,25 @@ private:
 
     void extract_clusters();
 
-    void get_neighbors(const std::size_t p_index, neighbors_collection & p_neighbors);
+    void create_neighborhoods();
+
+    bool has_neighborhoods() const;
+
+    void find_neighbors(const std::size_t p_index, std::vector<std::size_t> & p_neighbors, std::vector<double> & p_values) const;
 
-    void get_neighbors_from_points(const std::size_t p_index, neighbors_collection & p_neighbors);
+    double get_bound(const double p_radius) const;
 
-    void get_neighbors_from_distance_matrix(const std::size_t p_index, neighbors_collection & p_neighbors);
+    double get_distance(const double p_value) const;
 
-    double get_core_distance(const neighbors_collection & p_neighbors) const;
+    double get_core_distance(const std::size_t p_index, const double p_radius) const;
 
-    void update_order_seed(const optics_descriptor & p_object, const neighbors_collection & p_neighbors, std::multiset<optics_descriptor *, optics_pointer_descriptor_less> & order_seed);
+    void update_order_seed(const optics_descriptor & p_object);
 
     void calculate_ordering();
 
     void calculate_cluster_result();
 
-    void create_kdtree();
+    void create_tree();
 };
 
 
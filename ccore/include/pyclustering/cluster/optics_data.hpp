@@ -48,6 +48,7 @@ private:
     ordering                m_ordering = { };
     double                  m_radius   = 0;
     optics_object_sequence  m_optics_objects = { };
+    index_sequence          m_object_ordering = { };
 
 public:
     /*!
@@ -119,6 +120,28 @@ public:
     */
     const optics_object_sequence & optics_objects() const { return m_optics_objects; }
 
+    /*!
+
+    @brief    Returns reference to indexes of objects in order of their processing (cluster-ordering of all objects
+               including noise).
+    @details  Reachability distances of objects in this order form reachability plot that corresponds to optics
+               objects, so it is used for extraction of clusters without processing of the data.
+
+    @return   Reference to indexes of objects in order of their processing.
+
+    */
+    index_sequence & object_ordering() { return m_object_ordering; }
+
+    /*!
+
+    @brief    Returns const reference to indexes of objects in order of their processing (cluster-ordering of all
+               objects including noise).
+
+    @return   Const reference to indexes of objects in order of their processing.
+
+    */
+    const index_sequence & object_ordering() const { return m_object_ordering; }
+
     /*!
     
     @brief    Returns connectivity radius that can be differ from input parameter.
@@ -0,0 +1,140 @@
+/*!
+
+@authors Andrei Novikov (pyclustering@yandex.ru)
+@date 2014-2020
+@copyright BSD-3-Clause
+
+*/
+
+
+#pragma once
+
+
+#include <cstddef>
+#include <vector>
+
+#include <pyclustering/cluster/optics_data.hpp>
+#include <pyclustering/cluster/optics_xi_data.hpp>
+
+
+namespace pyclustering {
+
+namespace clst {
+
+
+/*!
+
+@class    optics_xi optics_xi.hpp pyclustering/cluster/optics_xi.hpp
+
+@brief    Extracts hierarchy of clusters from reachability plot of OPTICS by Xi method.
+@details  A cluster starts with a steep down area of the reachability plot (reachability decreases at least by
+           `xi` fraction between neighboring objects) and ends with a steep up area. Steep down areas are kept in a
+           stack while the plot is scanned once, each steep up area is matched with steep down areas that are still
+           valid and forms nested clusters. Conditions of a cluster are the same as in paper @cite article::optics::1
+           with corrections of cluster boundaries that are used by scikit-learn (without predecessor correction, because
+           predecessors are not stored by OPTICS).
+
+           The extraction uses only result of OPTICS, so several granularities are explored without processing of the
+           data again.
+
+*/
+class optics_xi {
+public:
+    static const std::size_t    NO_PARENT;      /**< Parent of clusters that are not contained by other clusters. */
+
+private:
+    double          m_xi                    = 0.05;
+    std::size_t     m_minimum_samples       = 5;
+    std::size_t     m_minimum_cluster_size  = 5;
+
+public:
+    /*!
+
+    @brief    Default constructor of the extractor.
+
+    */
+    optics_xi() = default;
+
+    /*!
+
+    @brief    Constructor of the extractor where minimum size of cluster is equal to the minimum amount of samples.
+
+    @param[in] p_xi: minimum steepness of reachability plot that bounds clusters, value in range (0, 1).
+    @param[in] p_minimum_samples: maximum amount of consecutive objects in a steep area that are not steep
+                (normally minimum amount of neighbors that is used by OPTICS).
+
+    */
+    optics_xi(const double p_xi, const std::size_t p_minimum_samples);
+
+    /*!
+
+    @brief    Constructor of the extractor.
+
+    @param[in] p_xi: minimum steepness of reachability plot that bounds clusters, value in range (0, 1).
+    @param[in] p_minimum_samples: maximum amount of consecutive objects in a steep area that are not steep
+                (normally minimum amount of neighbors that is used by OPTICS).
+    @param[in] p_minimum_cluster_size: minimum amount of objects in a cluster.
+
+    */
+    optics_xi(const double p_xi, const std::size_t p_minimum_samples, const std::size_t p_minimum_cluster_size);
+
+    /*!
+
+    @brief    Default destructor of the extractor.
+
+    */
+    ~optics_xi() = default;
+
+public:
+    /*!
+
+    @brief    Extracts hierarchy of clusters from result of OPTICS.
+
+    @param[in]  p_optics_result: result of OPTICS with cluster-ordering of objects and their reachability distances.
+    @param[out] p_result: hierarchy of clusters.
+
+    */
+    void process(const optics_data & p_optics_result, optics_xi_data & p_result) const;
+
+    /*!
+
+    @brief    Extracts hierarchy of clusters from reachability plot.
+
+    @param[in]  p_object_ordering: indexes of objects in order of their processing by OPTICS.
+    @param[in]  p_reachability: reachability distance of each object (object index is used to access it),
+                 `optics_descriptor::NONE_DISTANCE` for undefined distance.
+    @param[out] p_result: hierarchy of clusters.
+
+    */
+    void process(const index_sequence & p_object_ordering, const std::vector<double> & p_reachability, optics_xi_data & p_result) const;
+
+private:
+    struct steep_area {
+        std::size_t     m_start = 0;
+        std::size_t     m_end   = 0;
+        double          m_mib   = 0.0;      /* maximum reachability between the area and the current position */
+    };
+
+    struct interval {
+        std::size_t     m_start = 0;
+        std::size_t     m_end   = 0;
+    };
+
+private:
+    std::vector<interval> extract_intervals(const std::vector<double> & p_plot) const;
+
+    std::size_t extend_area(const std::vector<double> & p_plot, const std::size_t p_start, const bool p_upward) const;
+
+    void filter_areas(std::vector<steep_area> & p_areas, const double p_mib, const std::vector<double> & p_plot) const;
+
+    bool is_steep_down(const std::vector<double> & p_plot, const std::size_t p_index) const;
+
+    bool is_steep_up(const std::vector<double> & p_plot, const std::size_t p_index) const;
+
+    static void build_hierarchy(const std::vector<interval> & p_intervals, const index_sequence & p_object_ordering, optics_xi_data & p_result);
+};
+
+
+}
+
+}
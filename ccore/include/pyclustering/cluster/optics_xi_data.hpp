@@ -0,0 +1,92 @@
+/*!
+
+@authors Andrei Novikov (pyclustering@yandex.ru)
+@date 2014-2020
+@copyright BSD-3-Clause
+
+*/
+
+
+#pragma once
+
+
+#include <pyclustering/cluster/dbscan_data.hpp>
+
+
+namespace pyclustering {
+
+namespace clst {
+
+
+/*!
+
+@class    optics_xi_data optics_xi_data.hpp pyclustering/cluster/optics_xi_data.hpp
+
+@brief    Hierarchy of clusters that are extracted from reachability plot by OPTICS-Xi method.
+@details  Clusters are nested: each cluster consists of objects of a contiguous interval of cluster-ordering and it
+           is placed before clusters that contain it. Noise consists of objects that do not belong to any cluster.
+
+*/
+class optics_xi_data : public dbscan_data {
+private:
+    index_sequence      m_hierarchy = { };
+
+public:
+    /*!
+
+    @brief    Default constructor that creates empty clustering data.
+
+    */
+    optics_xi_data() = default;
+
+    /*!
+
+    @brief    Default copy constructor.
+
+    @param[in] p_other: another clustering data.
+
+    */
+    optics_xi_data(const optics_xi_data & p_other) = default;
+
+    /*!
+
+    @brief    Default move constructor.
+
+    @param[in] p_other: another clustering data.
+
+    */
+    optics_xi_data(optics_xi_data && p_other) = default;
+
+    /*!
+
+    @brief    Default destructor that destroys clustering data.
+
+    */
+    virtual ~optics_xi_data() = default;
+
+public:
+    /*!
+
+    @brief    Returns reference to parents of clusters.
+    @details  Parent of a cluster is the smallest cluster that contains it, `optics_xi::NO_PARENT` is used for
+               clusters that are not contained by other clusters.
+
+    @return   Reference to index of parent cluster of each cluster.
+
+    */
+    index_sequence & hierarchy() { return m_hierarchy; }
+
+    /*!
+
+    @brief    Returns const reference to parents of clusters.
+
+    @return   Const reference to index of parent cluster of each cluster.
+
+    */
+    const index_sequence & hierarchy() const { return m_hierarchy; }
+};
+
+
+}
+
+}
@@ -13,6 +13,8 @@
 #include <pyclustering/cluster/data_type.hpp>
 #include <pyclustering/cluster/silhouette_data.hpp>
 
+#include <pyclustering/container/dense_dataset.hpp>
+
 #include <pyclustering/definitions.hpp>
 
 #include <pyclustering/utils/metric.hpp>
@@ -97,7 +99,7 @@ Implementation based on paper @cite article::cluster::silhouette::1.
 */
 class silhouette {
 private:
-    const dataset *           m_data      = nullptr;  /* temporary object, exists during processing */
+    container::dense_dataset_view m_data  = { };      /* temporary object, exists during processing */
     const cluster_sequence *  m_clusters  = nullptr;  /* temporary object, exists during processing */
     silhouette_data *         m_result    = nullptr;  /* temporary object, exists during processing */
 
@@ -168,6 +170,18 @@ public:
     */
     void process(const dataset & p_data, const cluster_sequence & p_clusters, const data_t & p_type, silhouette_data & p_result);
 
+    /*!
+
+    @brief    Performs analysis of an input data that is stored contiguously in order to calculate score for each point.
+
+    @param[in]  p_data: input data for analysis.
+    @param[in]  p_clusters: clusters that have been obtained after cluster analysis.
+    @param[in]  p_type: data type of input sample `p_data` that is processed by the method (`POINTS`, `DISTANCE_MATRIX`).
+    @param[out] p_result: silhouette input data processing result.
+
+    */
+    void process(const container::dense_dataset_view & p_data, const cluster_sequence & p_clusters, const data_t & p_type, silhouette_data & p_result);
+
 private:
     double calculate_score(const std::size_t p_index_point, const std::size_t p_index_cluster) const;
 
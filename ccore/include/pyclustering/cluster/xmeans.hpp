@@ -14,6 +14,8 @@
 
 #include <pyclustering/cluster/xmeans_data.hpp>
 
+#include <pyclustering/container/dense_dataset.hpp>
+
 #include <pyclustering/utils/metric.hpp>
 
 
@@ -68,6 +70,8 @@ private:
 
     const dataset           * m_ptr_data          = nullptr;     /* used only during processing */
 
+    container::dense_dataset m_dense_data         = { };         /* contiguous copy of input data for K-Means, used only during processing */
+
     double                  m_alpha               = DEFAULT_MNDL_ALPHA_PROBABILISTIC_VALUE;
 
     double                  m_beta                = DEFAULT_MNDL_BETA_PROBABILISTIC_VALUE;
@@ -0,0 +1,363 @@
+/*!
+
+@authors Andrei Novikov (pyclustering@yandex.ru)
+@date 2014-2020
+@copyright BSD-3-Clause
+
+*/
+
+
+#pragma once
+
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+#include <pyclustering/container/dense_dataset.hpp>
+#include <pyclustering/container/neighbor_graph.hpp>
+#include <pyclustering/definitions.hpp>
+#include <pyclustering/utils/metric.hpp>
+#include <pyclustering/utils/simd.hpp>
+
+
+namespace pyclustering {
+
+namespace container {
+
+
+/*!
+
+@class   ball_tree ball_tree.hpp pyclustering/container/ball_tree.hpp
+
+@brief   Represents static ball tree that is able to find neighbors in line with any distance metric.
+@details Each node of the tree is a ball: center of the node is the mean of its points and radius of the node is
+          the largest distance from the center to its points. A node is skipped if the distance from the query
+          point to its center minus its radius is greater than the radius of the search, therefore the metric
+          should satisfy the triangle inequality (Euclidean, Manhattan, Chebyshev, Canberra, Gower, Minkowski with
+          degree not less than 1 and user-defined metrics that satisfy it). Square Euclidean distance is supported
+          as well: the tree is searched by Euclidean distance and the radius of the search and found distances
+          are square. Algorithms check the metric by `is_applicable` and find neighbors without the tree if
+          it might lose them.
+
+          The tree is stored like `kdtree_flat`: points are copied contiguously in tree order, each leaf refers to
+          a range of points and each internal node refers to its right child by index (the left child is the next
+          node). Points are split by the median of the dimension with the widest spread, so the tree is balanced.
+
+@code
+    #include <iostream>
+
+    #include <pyclustering/container/ball_tree.hpp>
+
+    using namespace pyclustering;
+    using namespace pyclustering::container;
+    using namespace pyclustering::utils::metric;
+
+    int main() {
+        const dataset points = { { 30, 59 },{ 5, 51 },{ 4, 52 },{ 12, 41 },{ 12, 45 } };
+        const ball_tree tree(points, distance_metric_factory<point>::manhattan());
+
+        // Points whose Manhattan distance to (5, 51) is less than or equal to 10.
+        const point center = { 5, 51 };
+        tree.find_nearest(center.data(), 10.0, [](const std::size_t p_index, const double p_distance) {
+            std::cout << p_index << ": " << p_distance << std::endl;
+        });
+
+        return 0;
+    }
+@endcode
+
+*/
+class ball_tree {
+public:
+    const static std::size_t    DEFAULT_LEAF_SIZE;      /**< Default maximum amount of points in a leaf. */
+
+private:
+    struct node {
+        double          m_radius        = 0.0;  /* largest distance from the center (row of centers with the same index) to points of the node */
+        std::size_t     m_begin         = 0;    /* first point of the node in tree order */
+        std::size_t     m_end           = 0;    /* point after the last point of the node in tree order */
+        std::size_t     m_right         = 0;    /* index of the right child, zero for leaves */
+    };
+
+    static constexpr std::size_t    MAXIMUM_DEPTH = 64; /* bound for the traversal stack, the depth of the balanced tree is not greater than log2 of amount of points */
+
+    const static std::size_t    PARALLEL_BUILD_SIZE;    /* minimum amount of points in a node whose sub-trees are built in parallel */
+
+    const static double         DISTANCE_TOLERANCE;     /* relative error of the distance to a center, so that rounding errors do not exclude points on the border of the search */
+
+    static constexpr std::size_t    DISTANCE_BLOCK = 64;    /* amount of distances to points of a leaf that are calculated together */
+
+private:
+    std::vector<node>           m_nodes         = { };
+    dense_dataset               m_centers       = { };  /* center of each node */
+    dense_dataset               m_points        = { };
+    std::vector<std::size_t>    m_indexes       = { };  /* index in the input data for each point in tree order */
+    std::vector<std::size_t>    m_positions     = { };  /* position in tree order for each point of the input data */
+    std::size_t                 m_leaf_size     = DEFAULT_LEAF_SIZE;
+    utils::metric::distance_metric<point>   m_metric = utils::metric::distance_metric_factory<point>::euclidean();
+    bool                        m_square        = false;    /* the metric is square Euclidean distance that is searched as Euclidean distance */
+    bool                        m_vectorized    = false;    /* distances to points of leaves are calculated by vectorized kernels */
+
+public:
+    /*!
+
+    @brief Default constructor of empty ball tree.
+
+    */
+    ball_tree() = default;
+
+    /*!
+
+    @brief Constructor of ball tree that is built for the data.
+
+    @param[in] p_data: data that should be stored in the tree.
+    @param[in] p_metric: metric that is used to calculate distances between points.
+    @param[in] p_leaf_size: maximum amount of points in a leaf (bucket), it should be greater than 0.
+
+    */
+    ball_tree(const dataset & p_data, const utils::metric::distance_metric<point> & p_metric, const std::size_t p_leaf_size = DEFAULT_LEAF_SIZE);
+
+    /*!
+
+    @brief Constructor of ball tree that is built for contiguously stored data.
+
+    @param[in] p_data: data that should be stored in the tree.
+    @param[in] p_metric: metric that is used to calculate distances between points.
+    @param[in] p_leaf_size: maximum amount of points in a leaf (bucket), it should be greater than 0.
+
+    */
+    ball_tree(const dense_dataset_view & p_data, const utils::metric::distance_metric<point> & p_metric, const std::size_t p_leaf_size = DEFAULT_LEAF_SIZE);
+
+    /*!
+
+    @brief Default copy constructor of ball tree.
+
+    @param[in] p_other: another tree that is copied.
+
+    */
+    ball_tree(const ball_tree & p_other) = default;
+
+    /*!
+
+    @brief Default move constructor of ball tree.
+
+    @param[in,out] p_other: another tree that is moved.
+
+    */
+    ball_tree(ball_tree && p_other) = default;
+
+    /*!
+
+    @brief Default destructor of ball tree.
+
+    */
+    ~ball_tree() = default;
+
+public:
+    /*!
+
+    @brief   Checks whether the tree finds all neighbors in line with the metric.
+    @details The metric should satisfy the triangle inequality, therefore Chi square metric, Minkowski metric
+              with degree less than 1 and user-defined metrics (that are not checked) are not applicable.
+
+    @param[in] p_metric: metric that is used to calculate distances between points.
+
+    @return  `true` if the tree might be used to find neighbors in line with the metric.
+
+    */
+    static bool is_applicable(const utils::metric::distance_metric<point> & p_metric);
+
+    /*!
+
+    @brief   Finds points whose distance to the specified point is less than or equal to the radius.
+    @details The visitor is called as `p_visitor(index, distance)` for each found point, where `index` is an index
+              of the point in the input data.
+
+    @param[in] p_point: coordinates of the point, their amount is equal to the dimension of the tree.
+    @param[in] p_radius: radius of the search.
+    @param[in] p_visitor: callable object that receives found points.
+
+    */
+    template <typename TypeVisitor>
+    void find_nearest(const double * p_point, const double p_radius, TypeVisitor && p_visitor) const;
+
+    /*!
+
+    @brief   Finds points whose distance to the specified point is less than or equal to the radius.
+
+    @param[in]  p_point: coordinates of the point.
+    @param[in]  p_radius: radius of the search.
+    @param[out] p_indexes: indexes of found points in the input data.
+    @param[out] p_distances: distances to found points.
+
+    */
+    void find_nearest(const point & p_point, const double p_radius, std::vector<std::size_t> & p_indexes, std::vector<double> & p_distances) const;
+
+    /*!
+
+    @brief   Finds k nearest points to the specified point whose distance is not greater than the radius.
+    @details Nodes are visited from the nearest one and a node is skipped if its ball is farther than the current
+              k-th nearest point. Found points are ordered by distance, points with the same distance are ordered
+              by index.
+
+    @param[in]  p_point: coordinates of the point, their amount is equal to the dimension of the tree.
+    @param[in]  p_k: maximum amount of points that should be found.
+    @param[in]  p_max_radius: maximum distance to found points.
+    @param[out] p_indexes: indexes of found points in the input data.
+    @param[out] p_distances: distances to found points.
+
+    */
+    void find_k_nearest(const double * p_point, const std::size_t p_k, const double p_max_radius, std::vector<std::size_t> & p_indexes, std::vector<double> & p_distances) const;
+
+    /*!
+
+    @brief   Finds neighborhoods of the specified points of the tree in parallel.
+    @details Each neighborhood contains points whose distance to the query point is less than or equal to the
+              radius, including the query point itself.
+
+    @param[in]  p_queries: indexes of query points in the input data.
+    @param[in]  p_radius: radius of the search.
+    @param[out] p_graph: neighborhood of each query point (in order of queries).
+    @param[in]  p_store_distances: if `false` then only indexes of neighbors are stored by the graph.
+
+    */
+    void find_nearest(const std::vector<std::size_t> & p_queries, const double p_radius, neighbor_graph & p_graph, const bool p_store_distances = true) const;
+
+    /*!
+
+    @brief   Finds neighborhoods of all points of the tree in parallel.
+
+    @param[in]  p_radius: radius of the search.
+    @param[out] p_graph: neighborhood of each point of the input data.
+    @param[in]  p_store_distances: if `false` then only indexes of neighbors are stored by the graph.
+
+    */
+    void find_nearest(const double p_radius, neighbor_graph & p_graph, const bool p_store_distances = true) const;
+
+    /*!
+
+    @brief   Returns amount of points in the tree.
+
+    */
+    std::size_t size() const;
+
+    /*!
+
+    @brief   Returns dimension of points in the tree.
+
+    */
+    std::size_t dimension() const;
+
+    /*!
+
+    @brief   Returns `true` if the tree does not contain points.
+
+    */
+    bool empty() const;
+
+    /*!
+
+    @brief   Returns maximum amount of points in a leaf.
+
+    */
+    std::size_t get_leaf_size() const;
+
+public:
+    /*!
+
+    @brief   Default copy assignment operator.
+
+    @param[in] p_other: another tree that is copied.
+
+    @return  Reference to the tree.
+
+    */
+    ball_tree & operator=(const ball_tree & p_other) = default;
+
+    /*!
+
+    @brief   Default move assignment operator.
+
+    @param[in,out] p_other: another tree that is moved.
+
+    @return  Reference to the tree.
+
+    */
+    ball_tree & operator=(ball_tree && p_other) = default;
+
+private:
+    void build(const dense_dataset_view & p_data);
+
+    std::size_t create_node(const dense_dataset_view & p_data, const std::size_t p_begin, const std::size_t p_end, std::vector<node> & p_nodes);
+
+    void create_balls();
+
+    template <typename TypeDistance>
+    void calculate_distances(const point_view & p_query, const std::size_t p_begin, const std::size_t p_amount, const TypeDistance & p_distance, double * p_result) const;
+};
+
+
+template <typename TypeVisitor>
+void ball_tree::find_nearest(const double * p_point, const double p_radius, TypeVisitor && p_visitor) const {
+    if (m_nodes.empty()) {
+        return;
+    }
+
+    const point_view query(p_point, m_points.dimension());
+    const double radius = m_square ? std::sqrt(p_radius) : p_radius;
+
+    utils::metric::visit(m_metric, [this, &query, radius, &p_visitor](const auto & p_distance) {
+        std::size_t stack[MAXIMUM_DEPTH + 1];
+        std::size_t stack_size = 0;
+        stack[stack_size++] = 0;
+
+        while (stack_size > 0) {
+            const std::size_t index_node = stack[--stack_size];
+            const node & current = m_nodes[index_node];
+
+            if (p_distance(query, m_centers[index_node]) / (1.0 + DISTANCE_TOLERANCE) - current.m_radius > radius) {
+                continue;
+            }
+
+            if (current.m_right != 0) {
+                stack[stack_size++] = current.m_right;
+                stack[stack_size++] = index_node + 1;
+                continue;
+            }
+
+            double distances[DISTANCE_BLOCK];
+            for (std::size_t block_begin = current.m_begin; block_begin < current.m_end; block_begin += DISTANCE_BLOCK) {
+                const std::size_t amount = std::min(DISTANCE_BLOCK, current.m_end - block_begin);
+                calculate_distances(query, block_begin, amount, p_distance, distances);
+
+                for (std::size_t i = 0; i < amount; i++) {
+                    const double distance = distances[i];
+                    if (distance <= radius) {
+                        p_visitor(m_indexes[block_begin + i], m_square ? distance * distance : distance);
+                    }
+                }
+            }
+        }
+    });
+}
+
+
+template <typename TypeDistance>
+void ball_tree::calculate_distances(const point_view & p_query, const std::size_t p_begin, const std::size_t p_amount, const TypeDistance & p_distance, double * p_result) const {
+    if (m_vectorized) {
+        utils::simd::distance(m_metric.kind(), p_query.data(), m_points.row(p_begin), p_amount, m_points.dimension(), m_points.stride(), p_result);
+    }
+    else {
+        for (std::size_t i = 0; i < p_amount; i++) {
+            p_result[i] = p_distance(p_query, m_points[p_begin + i]);
+        }
+    }
+}
+
+
+}
+
+}
@@ -0,0 +1,108 @@
+/*!
+
+@authors Andrei Novikov (pyclustering@yandex.ru)
+@date 2014-2020
+@copyright BSD-3-Clause
+
+*/
+
+
+#pragma once
+
+
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+
+namespace pyclustering {
+
+namespace container {
+
+
+/*!
+
+@class    concurrent_disjoint_set concurrent_disjoint_set.hpp pyclustering/container/concurrent_disjoint_set.hpp
+
+@brief    Represents disjoint sets of elements `[0; size)` that are merged by several threads without locks.
+@details  Parent of each element is atomic. A root is linked to a smaller root by compare-and-swap that fails if the
+           root has been linked by another thread, in that case roots are searched again. Therefore the parent of an
+           element is never greater than the element, the representative of a set is its smallest element (like in
+           `disjoint_set`) and it does not depend on order of unions. Paths to representatives are halved on each
+           search by compare-and-swap as well.
+
+           Searches and unions might be called concurrently, results of searches are final only when all unions are
+           finished.
+
+*/
+class concurrent_disjoint_set {
+private:
+    std::vector<std::atomic<std::size_t>>   m_parents;
+
+public:
+    /*!
+
+    @brief    Constructor of the structure where each element forms its own set.
+
+    @param[in] p_size: amount of elements.
+
+    */
+    explicit concurrent_disjoint_set(const std::size_t p_size);
+
+    /*!
+
+    @brief    Copying is not supported because parents are atomic.
+
+    */
+    concurrent_disjoint_set(const concurrent_disjoint_set & p_other) = delete;
+
+    /*!
+
+    @brief    Default destructor of the structure.
+
+    */
+    ~concurrent_disjoint_set() = default;
+
+public:
+    /*!
+
+    @brief    Returns representative (the smallest element) of the set that contains the element.
+
+    @param[in] p_element: element whose set is searched.
+
+    */
+    std::size_t find(const std::size_t p_element);
+
+    /*!
+
+    @brief    Merges sets that contain the specified elements.
+
+    @param[in] p_element1: element of the first set.
+    @param[in] p_element2: element of the second set.
+
+    @return   `true` if the sets have been merged by the call, `false` if the elements already belonged to the
+               same set.
+
+    */
+    bool unite(const std::size_t p_element1, const std::size_t p_element2);
+
+    /*!
+
+    @brief    Returns amount of elements.
+
+    */
+    std::size_t size() const;
+
+public:
+    /*!
+
+    @brief    Copying is not supported because parents are atomic.
+
+    */
+    concurrent_disjoint_set & operator=(const concurrent_disjoint_set & p_other) = delete;
+};
+
+
+}
+
+}
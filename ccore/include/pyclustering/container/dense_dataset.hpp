@@ -0,0 +1,373 @@
+/*!
+
+@authors Andrei Novikov (pyclustering@yandex.ru)
+@date 2014-2020
+@copyright BSD-3-Clause
+
+*/
+
+
+#pragma once
+
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <new>
+#include <vector>
+
+#include <pyclustering/definitions.hpp>
+
+
+namespace pyclustering {
+
+namespace container {
+
+
+/*!
+
+@class   aligned_allocator dense_dataset.hpp pyclustering/container/dense_dataset.hpp
+
+@brief   Allocator that returns memory aligned to the specified boundary.
+
+*/
+template <typename TypeValue, std::size_t Alignment>
+class aligned_allocator {
+public:
+    using value_type = TypeValue;   /**< Type of allocated objects. */
+
+    /*!
+
+    @brief   Rebinds the allocator to another type of objects with the same alignment.
+
+    */
+    template <typename TypeOther>
+    struct rebind {
+        using other = aligned_allocator<TypeOther, Alignment>;  /**< Allocator for another type. */
+    };
+
+public:
+    aligned_allocator() = default;
+
+    template <typename TypeOther>
+    aligned_allocator(const aligned_allocator<TypeOther, Alignment> &) { }
+
+public:
+    /*!
+
+    @brief   Allocates aligned memory for the specified amount of objects.
+
+    @param[in] p_amount: amount of objects.
+
+    @return  Pointer to the aligned memory.
+
+    */
+    TypeValue * allocate(const std::size_t p_amount) {
+        if (p_amount > (std::numeric_limits<std::size_t>::max() - Alignment - sizeof(void *)) / sizeof(TypeValue)) {
+            throw std::bad_alloc();
+        }
+
+        /* The original pointer is stored right before the aligned block to release it later. */
+        char * raw = static_cast<char *>(::operator new(p_amount * sizeof(TypeValue) + Alignment + sizeof(void *)));
+        const std::uintptr_t address = reinterpret_cast<std::uintptr_t>(raw + sizeof(void *));
+        char * aligned = raw + sizeof(void *) + (Alignment - address % Alignment) % Alignment;
+
+        reinterpret_cast<void **>(aligned)[-1] = raw;
+        return reinterpret_cast<TypeValue *>(aligned);
+    }
+
+    /*!
+
+    @brief   Releases memory that has been allocated by `allocate`.
+
+    @param[in] p_pointer: pointer to the aligned memory.
+
+    */
+    void deallocate(TypeValue * p_pointer, const std::size_t) noexcept {
+        if (p_pointer != nullptr) {
+            ::operator delete(reinterpret_cast<void **>(p_pointer)[-1]);
+        }
+    }
+
+    template <typename TypeOther>
+    bool operator==(const aligned_allocator<TypeOther, Alignment> &) const { return true; }
+
+    template <typename TypeOther>
+    bool operator!=(const aligned_allocator<TypeOther, Alignment> &) const { return false; }
+};
+
+
+/*!
+
+@class   point_view dense_dataset.hpp pyclustering/container/dense_dataset.hpp
+
+@brief   Non-owning read-only view of point coordinates that are stored contiguously.
+@details The view provides the same iteration interface as `point`, therefore it can be used with metric
+          functions from `pyclustering::utils::metric`. The view is implicitly constructed from `point`.
+
+*/
+class point_view {
+public:
+    using value_type        = double;           /**< Type of coordinates. */
+    using size_type         = std::size_t;      /**< Type of size. */
+    using const_iterator    = const double *;   /**< Type of iterator over coordinates. */
+    using iterator          = const_iterator;   /**< Type of iterator over coordinates (read-only). */
+
+private:
+    const double *  m_data  = nullptr;
+    std::size_t     m_size  = 0;
+
+public:
+    /*!
+
+    @brief   Default constructor of an empty view.
+
+    */
+    point_view() = default;
+
+    /*!
+
+    @brief   Constructor of the view over contiguous coordinates.
+
+    @param[in] p_data: pointer to the first coordinate.
+    @param[in] p_size: amount of coordinates.
+
+    */
+    point_view(const double * p_data, const std::size_t p_size) :
+        m_data(p_data), m_size(p_size)
+    { }
+
+    /*!
+
+    @brief   Constructor of the view over coordinates of the point.
+
+    @param[in] p_point: point whose coordinates are viewed, it should live longer than the view.
+
+    */
+    point_view(const point & p_point) :
+        m_data(p_point.data()), m_size(p_point.size())
+    { }
+
+public:
+    const_iterator begin() const { return m_data; }
+
+    const_iterator end() const { return m_data + m_size; }
+
+    const_iterator cbegin() const { return m_data; }
+
+    const_iterator cend() const { return m_data + m_size; }
+
+    const double * data() const { return m_data; }
+
+    std::size_t size() const { return m_size; }
+
+    bool empty() const { return m_size == 0; }
+
+    const double & operator[](const std::size_t p_index) const { return m_data[p_index]; }
+
+    /*!
+
+    @brief   Copies coordinates to the point.
+
+    @return  Point with the same coordinates.
+
+    */
+    point to_point() const { return point(m_data, m_data + m_size); }
+};
+
+
+/*!
+
+@class   dense_dataset_view dense_dataset.hpp pyclustering/container/dense_dataset.hpp
+
+@brief   Non-owning read-only view of row-major points that are stored in a single buffer.
+@details Point `i` starts from `data() + i * stride()` and has `dimension()` coordinates. Stride might be bigger
+          than dimension when rows are padded, for example, for alignment.
+
+*/
+class dense_dataset_view {
+private:
+    const double *  m_data      = nullptr;
+    std::size_t     m_size      = 0;
+    std::size_t     m_dimension = 0;
+    std::size_t     m_stride    = 0;
+
+public:
+    /*!
+
+    @brief   Default constructor of an empty view.
+
+    */
+    dense_dataset_view() = default;
+
+    /*!
+
+    @brief   Constructor of the view over row-major buffer.
+
+    @param[in] p_data: pointer to the first coordinate of the first point.
+    @param[in] p_size: amount of points.
+    @param[in] p_dimension: amount of coordinates of each point.
+    @param[in] p_stride: distance in elements between beginnings of two neighbour points, if it is `0` then it
+                is equal to the dimension.
+
+    */
+    dense_dataset_view(const double * p_data, const std::size_t p_size, const std::size_t p_dimension, const std::size_t p_stride = 0);
+
+public:
+    /*!
+
+    @brief   Returns view of the specified point.
+
+    @param[in] p_index: index of the point.
+
+    @return  View of the point.
+
+    */
+    point_view operator[](const std::size_t p_index) const {
+        return point_view(m_data + p_index * m_stride, m_dimension);
+    }
+
+    /*!
+
+    @brief   Returns pointer to coordinates of the specified point.
+
+    @param[in] p_index: index of the point.
+
+    @return  Pointer to the first coordinate of the point.
+
+    */
+    const double * row(const std::size_t p_index) const { return m_data + p_index * m_stride; }
+
+    const double * data() const { return m_data; }
+
+    std::size_t size() const { return m_size; }
+
+    std::size_t dimension() const { return m_dimension; }
+
+    std::size_t stride() const { return m_stride; }
+
+    bool empty() const { return m_size == 0; }
+
+    /*!
+
+    @brief   Copies points to the dataset.
+
+    @return  Dataset with the same points.
+
+    */
+    dataset to_dataset() const;
+};
+
+
+/*!
+
+@class   dense_dataset dense_dataset.hpp pyclustering/container/dense_dataset.hpp
+
+@brief   Owning container of row-major points that are stored in a single buffer.
+@details In contrast to `dataset` where each point is a separate allocation, points of the dense dataset are
+          stored one after another, therefore loops over points do not chase pointers. When aligned layout is
+          requested each point starts at `ROW_ALIGNMENT` boundary (rows are padded with zeros).
+
+          The dense dataset is implicitly converted to `dense_dataset_view` that is accepted by algorithms.
+
+*/
+class dense_dataset {
+public:
+    static const std::size_t ROW_ALIGNMENT;     /**< Alignment of points in bytes when aligned layout is requested. */
+
+private:
+    using buffer = std::vector<double, aligned_allocator<double, 64>>;
+
+private:
+    buffer          m_buffer    = { };
+    std::size_t     m_size      = 0;
+    std::size_t     m_dimension = 0;
+    std::size_t     m_stride    = 0;
+
+public:
+    /*!
+
+    @brief   Default constructor of an empty dataset.
+
+    */
+    dense_dataset() = default;
+
+    /*!
+
+    @brief   Constructor of dataset with zero coordinates.
+
+    @param[in] p_size: amount of points.
+    @param[in] p_dimension: amount of coordinates of each point.
+    @param[in] p_aligned: if `true` then each point starts at `ROW_ALIGNMENT` boundary.
+
+    */
+    dense_dataset(const std::size_t p_size, const std::size_t p_dimension, const bool p_aligned = false);
+
+    /*!
+
+    @brief   Constructor of dataset that copies points from the dataset.
+    @details All points should have the same dimension, otherwise `std::invalid_argument` is thrown.
+
+    @param[in] p_data: points that should be copied.
+    @param[in] p_aligned: if `true` then each point starts at `ROW_ALIGNMENT` boundary.
+
+    */
+    explicit dense_dataset(const dataset & p_data, const bool p_aligned = false);
+
+    /*!
+
+    @brief   Constructor of dataset that copies points from the view.
+
+    @param[in] p_data: points that should be copied.
+    @param[in] p_aligned: if `true` then each point starts at `ROW_ALIGNMENT` boundary.
+
+    */
+    explicit dense_dataset(const dense_dataset_view & p_data, const bool p_aligned = false);
+
+public:
+    point_view operator[](const std::size_t p_index) const {
+        return point_view(m_buffer.data() + p_index * m_stride, m_dimension);
+    }
+
+    const double * row(const std::size_t p_index) const { return m_buffer.data() + p_index * m_stride; }
+
+    double * row(const std::size_t p_index) { return m_buffer.data() + p_index * m_stride; }
+
+    const double * data() const { return m_buffer.data(); }
+
+    std::size_t size() const { return m_size; }
+
+    std::size_t dimension() const { return m_dimension; }
+
+    std::size_t stride() const { return m_stride; }
+
+    bool empty() const { return m_size == 0; }
+
+    /*!
+
+    @brief   Returns non-owning view of the dataset.
+
+    @return  View that is valid while the dataset is alive and is not modified.
+
+    */
+    dense_dataset_view view() const { return dense_dataset_view(m_buffer.data(), m_size, m_dimension, m_stride); }
+
+    operator dense_dataset_view() const { return view(); }
+
+    /*!
+
+    @brief   Copies points to the dataset.
+
+    @return  Dataset with the same points.
+
+    */
+    dataset to_dataset() const { return view().to_dataset(); }
+
+private:
+    void allocate(const std::size_t p_size, const std::size_t p_dimension, const bool p_aligned);
+};
+
+
+}
+
+}
@@ -0,0 +1,142 @@
+/*!
+
+@authors Andrei Novikov (pyclustering@yandex.ru)
+@date 2014-2020
+@copyright BSD-3-Clause
+
+*/
+
+
+#pragma once
+
+
+#include <cstddef>
+#include <vector>
+
+
+namespace pyclustering {
+
+namespace container {
+
+
+/*!
+
+@class    disjoint_set disjoint_set.hpp pyclustering/container/disjoint_set.hpp
+
+@brief    Represents disjoint sets of elements `[0; size)` (union-find structure).
+@details  Each set is identified by its representative that is the smallest element of the set, so representatives
+           do not depend on order of unions. Paths to representatives are halved on each search.
+
+*/
+class disjoint_set {
+private:
+    std::vector<std::size_t>    m_parents       = { };
+
+public:
+    /*!
+
+    @brief    Default constructor of empty structure.
+
+    */
+    disjoint_set() = default;
+
+    /*!
+
+    @brief    Constructor of the structure where each element forms its own set.
+
+    @param[in] p_size: amount of elements.
+
+    */
+    explicit disjoint_set(const std::size_t p_size);
+
+    /*!
+
+    @brief    Default copy constructor of the structure.
+
+    @param[in] p_other: another structure that is copied.
+
+    */
+    disjoint_set(const disjoint_set & p_other) = default;
+
+    /*!
+
+    @brief    Default move constructor of the structure.
+
+    @param[in,out] p_other: another structure that is moved.
+
+    */
+    disjoint_set(disjoint_set && p_other) = default;
+
+    /*!
+
+    @brief    Default destructor of the structure.
+
+    */
+    ~disjoint_set() = default;
+
+public:
+    /*!
+
+    @brief    Returns representative (the smallest element) of the set that contains the element.
+
+    @param[in] p_element: element whose set is searched.
+
+    */
+    std::size_t find(const std::size_t p_element);
+
+    /*!
+
+    @brief    Merges sets that contain the specified elements.
+
+    @param[in] p_element1: element of the first set.
+    @param[in] p_element2: element of the second set.
+
+    @return   `true` if the elements belonged to different sets.
+
+    */
+    bool unite(const std::size_t p_element1, const std::size_t p_element2);
+
+    /*!
+
+    @brief    Adds new element that forms its own set.
+
+    @return   The new element (previous amount of elements).
+
+    */
+    std::size_t append();
+
+    /*!
+
+    @brief    Returns amount of elements.
+
+    */
+    std::size_t size() const;
+
+public:
+    /*!
+
+    @brief    Default copy assignment operator.
+
+    @param[in] p_other: another structure that is copied.
+
+    @return   Reference to the structure.
+
+    */
+    disjoint_set & operator=(const disjoint_set & p_other) = default;
+
+    /*!
+
+    @brief    Default move assignment operator.
+
+    @param[in,out] p_other: another structure that is moved.
+
+    @return   Reference to the structure.
+
+    */
+    disjoint_set & operator=(disjoint_set && p_other) = default;
+};
+
+
+}
+
+}
@@ -0,0 +1,147 @@
+/*!
+
+@authors Andrei Novikov (pyclustering@yandex.ru)
+@date 2014-2020
+@copyright BSD-3-Clause
+
+*/
+
+
+#pragma once
+
+
+#include <cstddef>
+#include <vector>
+
+
+namespace pyclustering {
+
+namespace container {
+
+
+/*!
+
+@class    indexed_heap indexed_heap.hpp pyclustering/container/indexed_heap.hpp
+
+@brief    Represents d-ary min-heap of elements `[0; capacity)` with keys that supports decrease of a key.
+@details  Position of each element in the heap is stored, so an element is found in constant time and its key is
+           decreased in logarithmic time. Elements with equal keys are extracted in order of their last insertion or
+           decrease of key (like from `std::multiset` where an element is erased and inserted again).
+
+*/
+class indexed_heap {
+public:
+    const static std::size_t    ARITY;              /**< Amount of children of each node of the heap. */
+
+private:
+    const static std::size_t    NO_POSITION;        /* marker of an element that is not contained by the heap */
+
+    struct entry {
+        double          m_key       = 0.0;
+        std::size_t     m_sequence  = 0;            /* number of the insertion that is used to order equal keys */
+        std::size_t     m_element   = 0;
+    };
+
+private:
+    std::vector<entry>          m_entries           = { };
+    std::vector<std::size_t>    m_positions         = { };
+    std::size_t                 m_sequence          = 0;
+
+public:
+    /*!
+
+    @brief    Default constructor of empty heap without elements.
+
+    */
+    indexed_heap() = default;
+
+    /*!
+
+    @brief    Constructor of empty heap that might contain elements `[0; capacity)`.
+
+    @param[in] p_capacity: amount of elements that might be contained.
+
+    */
+    explicit indexed_heap(const std::size_t p_capacity);
+
+    /*!
+
+    @brief    Default destructor of the heap.
+
+    */
+    ~indexed_heap() = default;
+
+public:
+    /*!
+
+    @brief    Inserts element that is not contained by the heap.
+
+    @param[in] p_element: element that should be inserted.
+    @param[in] p_key: key of the element.
+
+    */
+    void push(const std::size_t p_element, const double p_key);
+
+    /*!
+
+    @brief    Decreases key of element that is contained by the heap.
+
+    @param[in] p_element: element whose key is changed.
+    @param[in] p_key: new key that is not greater than the current key of the element.
+
+    */
+    void decrease(const std::size_t p_element, const double p_key);
+
+    /*!
+
+    @brief    Extracts element with the smallest key.
+
+    @return   The extracted element.
+
+    */
+    std::size_t pop();
+
+    /*!
+
+    @brief    Returns element with the smallest key.
+
+    */
+    std::size_t top() const;
+
+    /*!
+
+    @brief    Returns `true` if the element is contained by the heap.
+
+    @param[in] p_element: element that is checked.
+
+    */
+    bool contains(const std::size_t p_element) const;
+
+    /*!
+
+    @brief    Returns `true` if there are no elements in the heap.
+
+    */
+    bool empty() const;
+
+    /*!
+
+    @brief    Returns amount of elements in the heap.
+
+    */
+    std::size_t size() const;
+
+private:
+    bool less(const entry & p_entry1, const entry & p_entry2) const;
+
+    void place(const std::size_t p_position, const entry & p_entry);
+
+    void sift_up(std::size_t p_position);
+
+    void sift_down(std::size_t p_position);
+};
+
+
+}
+
+}
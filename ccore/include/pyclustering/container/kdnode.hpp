@@ -44,6 +44,8 @@ private:
 
     std::size_t m_discriminator = 0;
 
+    bool     m_removed = false;     /* node is removed from the tree, but it is still used to split the space */
+
 public:
     /*!
 
@@ -142,6 +144,16 @@ public:
     */
     void set_discriminator(const std::size_t disc);
 
+    /*!
+
+    @brief   Marks the node as removed (tombstone) or restores it.
+    @details Removed node still splits the space of its sub-tree, but it is not found by searches.
+
+    @param[in] p_removed: `true` if the node is removed.
+
+    */
+    void set_removed(const bool p_removed);
+
 public:
     /*!
 
@@ -150,7 +162,7 @@ public:
     @return  Left child node.
 
     */
-    kdnode::ptr get_left() const;
+    const kdnode::ptr & get_left() const;
 
     /*!
 
@@ -159,7 +171,7 @@ public:
     @return  Right child node.
 
     */
-    kdnode::ptr get_right() const;
+    const kdnode::ptr & get_right() const;
 
     /*!
 
@@ -253,6 +265,13 @@ public:
 
     /*!
 
+    @brief   Returns `true` if the node is removed from the tree and it is kept only to split the space.
+
+    */
+    bool is_removed() const;
+
+    /*!
+
     @brief   Return dimension - amount of coordinates that represents the current node.
 
     @return  Dimension - amount of coordinates that represents the current node.
@@ -29,29 +29,69 @@ namespace container {
  *
  */
 class kdtree : public kdtree_balanced {
+public:
+    const static double REBALANCE_FACTOR;   /**< Weight balance factor (alpha) of the tree: a node is rebuilt if one of its sub-trees contains more than this part of its nodes. */
+
 private:
+    std::size_t m_removed = 0;      /* amount of removed nodes (tombstones) that are still used to split the space */
+
+private:
+    /**
+    *
+    * @brief   Links new node to the tree as a leaf.
+    *
+    * @param[in] p_node: node that should be inserted.
+    *
+    * @return  Depth of the inserted node.
+    *
+    */
+    std::size_t link(const kdnode::ptr & p_node);
+
     /**
     *
-    * @brief   Recursive remove of node in tree.
+    * @brief   Marks node as removed, removed leaves are unlinked from the tree immediately.
     *
     * @param[in] p_node: node that should be removed.
     *
-    * @return  Node that should replace removed node (if it's not leaf).
+    */
+    void erase(const kdnode::ptr & p_node);
+
+    /**
+    *
+    * @brief   Finds the highest unbalanced ancestor of the node (scapegoat) and rebuilds its sub-tree.
+    *
+    * @param[in] p_node: node that has been inserted too deep.
+    *
+    */
+    void rebalance(const kdnode::ptr & p_node);
+
+    /**
+    *
+    * @brief   Rebuilds sub-tree to balanced one without removed nodes.
+    *
+    * @param[in] p_node: root of the sub-tree, the whole tree is rebuilt if it is the root of the tree.
+    * @param[in] p_appended: nodes that should be added to the sub-tree.
+    *
+    */
+    void rebuild(const kdnode::ptr & p_node, std::vector<kdnode::ptr> && p_appended = { });
+
+    /**
+    *
+    * @brief   Returns maximum depth of a node in the tree that is not considered as unbalanced.
     *
     */
-    kdnode::ptr recursive_remove(kdnode::ptr & p_node);
+    std::size_t get_maximum_depth() const;
 
     /**
     *
-    * @brief   Find minimal node in subtree in line with specified discriminator.
+    * @brief   Counts nodes (including removed) in the sub-tree.
     *
-    * @param[in] p_cur_node: root of subtree where searching should be performed.
-    * @param[in] p_discriminator: discriminator that is used for comparison of nodes.
+    * @param[in] p_node: root of the sub-tree.
     *
-    * @return  Return the smallest node in specified subtree in line with discriminator.
+    * @return  Amount of nodes in the sub-tree.
     *
     */
-    static kdnode::ptr find_minimal_node(const kdnode::ptr & p_cur_node, const std::size_t p_discriminator);
+    static std::size_t count_nodes(const kdnode::ptr & p_node);
 
 public:
     kdtree() = default;
@@ -68,6 +108,9 @@ public:
     /**
     *
     * @brief   Insert new node in the tree.
+    * @details If the node is inserted deeper than the depth of a balanced tree with the same amount of nodes
+    *           allows then the sub-tree of its unbalanced ancestor is rebuilt (scapegoat tree), therefore the
+    *           height of the tree is logarithmic regardless of order of insertion.
     *
     * @param[in] p_point: coordinates that describe node in tree.
     * @param[in] p_payload: payloads of node (can be nullptr if it's not required).
@@ -77,6 +120,20 @@ public:
     */
     kdnode::ptr insert(const std::vector<double> & p_point, void * p_payload = nullptr);
 
+    /**
+    *
+    * @brief   Insert new nodes in the tree.
+    * @details If the amount of inserted points is not less than the amount of points in the tree then the
+    *           whole tree is rebuilt with new points, otherwise they are inserted one by one.
+    *
+    * @param[in] p_points: coordinates of new nodes.
+    * @param[in] p_payloads: payload for each point (can be empty if it's not required).
+    *
+    * @return  Pointers to added nodes in the tree.
+    *
+    */
+    std::vector<kdnode::ptr> insert(const dataset & p_points, const std::vector<void *> & p_payloads = { });
+
     /**
     *
     * @brief   Remove point with specified coordinates.
@@ -102,12 +159,23 @@ public:
     /**
     *
     * @brief   Remove node from the tree.
+    * @details The node is marked as removed (tombstone) and it is still used to split the space. When there are
+    *           more removed nodes than nodes in the tree, the tree is rebuilt without removed nodes.
     *
     * @param[in] p_node_for_remove: pointer to node that is located in tree.
     *
     */
     void remove(kdnode::ptr & p_node_for_remove);
 
+    /**
+    *
+    * @brief   Remove nodes from the tree, the tree is rebuilt (if it is required) only once.
+    *
+    * @param[in] p_nodes: pointers to nodes that are located in the tree.
+    *
+    */
+    void remove(const std::vector<kdnode::ptr> & p_nodes);
+
 public:
     /*!
 
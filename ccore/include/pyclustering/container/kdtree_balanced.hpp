@@ -11,6 +11,8 @@
 
 #include "kdnode.hpp"
 
+#include <pyclustering/container/dense_dataset.hpp>
+
 #include <functional>
 #include <memory>
 #include <vector>
@@ -90,6 +92,9 @@ Implementation based on paper @cite book::the_design_and_analysis.
 
 */
 class kdtree_balanced {
+protected:
+    const static std::size_t    PARALLEL_BUILD_SIZE;    /**< Minimum amount of nodes in a sub-tree whose children are built in parallel. */
+
 protected:
     kdnode::ptr     m_root = nullptr;
 
@@ -117,6 +122,16 @@ public:
 
     /*!
 
+    @brief Parameterized constructor of balanced KD-tree that is built for contiguously stored data.
+
+    @param[in] p_data: data that should be stored in the tree.
+    @param[in] p_payloads: payload for each point in `p_data`.
+
+    */
+    kdtree_balanced(const dense_dataset_view & p_data, const std::vector<void *> & p_payloads = { });
+
+    /*!
+
     @brief Default copy constructor of balanced KD-tree.
 
     @param[in] p_other: another tree that is used as a copy for constructed tree.
@@ -186,6 +201,8 @@ protected:
     /*!
 
     @brief   Creates sub-tree of KD-tree from node `p_parent`.
+    @details The median node is selected in linear time, therefore the tree is built in O(n log n). Children of
+              large sub-trees are built in parallel.
 
     @param[in] p_begin: iterator to the beginning of the collection that should be used to build KD-tree.
     @param[in] p_end: iterator to the end of the collection that should be used to build KD-tree.
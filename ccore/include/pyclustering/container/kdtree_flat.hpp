@@ -0,0 +1,404 @@
+/*!
+
+@authors Andrei Novikov (pyclustering@yandex.ru)
+@date 2014-2020
+@copyright BSD-3-Clause
+
+*/
+
+
+#pragma once
+
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+#include <pyclustering/container/dense_dataset.hpp>
+#include <pyclustering/container/neighbor_graph.hpp>
+#include <pyclustering/definitions.hpp>
+
+
+namespace pyclustering {
+
+namespace container {
+
+
+/*!
+
+@class   kdtree_flat kdtree_flat.hpp pyclustering/container/kdtree_flat.hpp
+
+@brief   Represents static KD-tree that is stored in arrays without pointers between nodes.
+@details Points are copied contiguously in tree order, each leaf refers to a range of points (bucket) and each
+          internal node refers to its right child by index (the left child is the next node). The space is split by
+          median of the dimension with the widest spread of points, therefore the tree is balanced.
+
+          In contrast to `kdtree_balanced` the tree does not create a node with its own copy of coordinates for each
+          point, points are identified by their indexes in the input data. `kdtree_balanced` and `kdtree` are still
+          available for code that works with `kdnode`.
+
+@code
+    #include <iostream>
+
+    #include <pyclustering/container/kdtree_flat.hpp>
+
+    using namespace pyclustering;
+    using namespace pyclustering::container;
+
+    int main() {
+        const dataset points = { { 30, 59 },{ 5, 51 },{ 4, 52 },{ 12, 41 },{ 12, 45 } };
+        const kdtree_flat tree(points);
+
+        // Points whose distance to (5, 51) is less than or equal to 10.
+        const point center = { 5, 51 };
+        tree.find_nearest(center.data(), 10.0, [](const std::size_t p_index, const double p_square_distance) {
+            std::cout << p_index << ": " << p_square_distance << std::endl;
+        });
+
+        return 0;
+    }
+@endcode
+
+*/
+class kdtree_flat {
+public:
+    const static std::size_t    DEFAULT_LEAF_SIZE;      /**< Default maximum amount of points in a leaf. */
+
+    const static std::size_t    NO_LABEL;               /**< Label of a node whose points have different labels. */
+
+private:
+    struct node {
+        double          m_value         = 0.0;  /* value of the splitting plane */
+        std::size_t     m_begin         = 0;    /* first point of the node in tree order */
+        std::size_t     m_end           = 0;    /* point after the last point of the node in tree order */
+        std::size_t     m_right         = 0;    /* index of the right child, zero for leaves */
+        std::size_t     m_discriminator = 0;    /* dimension of the splitting plane */
+    };
+
+    static constexpr std::size_t    MAXIMUM_DEPTH = 64; /* bound for the traversal stack, the depth of the balanced tree is not greater than log2 of amount of points */
+
+    const static std::size_t    PARALLEL_BUILD_SIZE;    /* minimum amount of points in a node whose sub-trees are built in parallel */
+
+private:
+    std::vector<node>           m_nodes         = { };
+    dense_dataset               m_points        = { };
+    std::vector<std::size_t>    m_indexes       = { };  /* index in the input data for each point in tree order */
+    std::vector<std::size_t>    m_positions     = { };  /* position in tree order for each point of the input data */
+    std::size_t                 m_leaf_size     = DEFAULT_LEAF_SIZE;
+
+public:
+    /*!
+
+    @brief Default constructor of empty KD-tree.
+
+    */
+    kdtree_flat() = default;
+
+    /*!
+
+    @brief Constructor of KD-tree that is built for the data.
+
+    @param[in] p_data: data that should be stored in the tree.
+    @param[in] p_leaf_size: maximum amount of points in a leaf (bucket), it should be greater than 0.
+
+    */
+    explicit kdtree_flat(const dataset & p_data, const std::size_t p_leaf_size = DEFAULT_LEAF_SIZE);
+
+    /*!
+
+    @brief Constructor of KD-tree that is built for contiguously stored data.
+
+    @param[in] p_data: data that should be stored in the tree.
+    @param[in] p_leaf_size: maximum amount of points in a leaf (bucket), it should be greater than 0.
+
+    */
+    explicit kdtree_flat(const dense_dataset_view & p_data, const std::size_t p_leaf_size = DEFAULT_LEAF_SIZE);
+
+    /*!
+
+    @brief Default copy constructor of KD-tree.
+
+    @param[in] p_other: another tree that is copied.
+
+    */
+    kdtree_flat(const kdtree_flat & p_other) = default;
+
+    /*!
+
+    @brief Default move constructor of KD-tree.
+
+    @param[in,out] p_other: another tree that is moved.
+
+    */
+    kdtree_flat(kdtree_flat && p_other) = default;
+
+    /*!
+
+    @brief Default destructor of KD-tree.
+
+    */
+    ~kdtree_flat() = default;
+
+public:
+    /*!
+
+    @brief   Finds points whose Euclidean distance to the specified point is less than or equal to the radius.
+    @details The visitor is called as `p_visitor(index, square_distance)` for each found point, where `index` is
+              an index of the point in the input data.
+
+    @param[in] p_point: coordinates of the point, their amount is equal to the dimension of the tree.
+    @param[in] p_radius: radius of the search (Euclidean distance).
+    @param[in] p_visitor: callable object that receives found points.
+
+    */
+    template <typename TypeVisitor>
+    void find_nearest(const double * p_point, const double p_radius, TypeVisitor && p_visitor) const;
+
+    /*!
+
+    @brief   Finds points whose Euclidean distance to the specified point is less than or equal to the radius.
+
+    @param[in]  p_point: coordinates of the point.
+    @param[in]  p_radius: radius of the search (Euclidean distance).
+    @param[out] p_indexes: indexes of found points in the input data.
+    @param[out] p_square_distances: square Euclidean distances to found points.
+
+    */
+    void find_nearest(const point & p_point, const double p_radius, std::vector<std::size_t> & p_indexes, std::vector<double> & p_square_distances) const;
+
+    /*!
+
+    @brief   Finds k nearest points to the specified point whose Euclidean distance is not greater than the radius.
+    @details Sub-trees are visited from the nearest one and a sub-tree is skipped if its splitting plane is farther
+              than the current k-th nearest point. Found points are ordered by distance, points with the same
+              distance are ordered by index.
+
+    @param[in]  p_point: coordinates of the point, their amount is equal to the dimension of the tree.
+    @param[in]  p_k: maximum amount of points that should be found.
+    @param[in]  p_max_radius: maximum Euclidean distance to found points.
+    @param[out] p_indexes: indexes of found points in the input data.
+    @param[out] p_square_distances: square Euclidean distances to found points.
+
+    */
+    void find_k_nearest(const double * p_point, const std::size_t p_k, const double p_max_radius, std::vector<std::size_t> & p_indexes, std::vector<double> & p_square_distances) const;
+
+    /*!
+
+    @brief   Finds neighborhoods of the specified points of the tree in parallel.
+    @details Each neighborhood contains points whose Euclidean distance to the query point is less than or equal
+              to the radius, including the query point itself.
+
+    @param[in]  p_queries: indexes of query points in the input data.
+    @param[in]  p_radius: radius of the search (Euclidean distance).
+    @param[out] p_graph: neighborhood of each query point (in order of queries), distances are Euclidean.
+    @param[in]  p_store_distances: if `false` then only indexes of neighbors are stored by the graph.
+
+    */
+    void find_nearest(const std::vector<std::size_t> & p_queries, const double p_radius, neighbor_graph & p_graph, const bool p_store_distances = true) const;
+
+    /*!
+
+    @brief   Finds neighborhoods of all points of the tree in parallel.
+
+    @param[in]  p_radius: radius of the search (Euclidean distance).
+    @param[out] p_graph: neighborhood of each point of the input data, distances are Euclidean.
+    @param[in]  p_store_distances: if `false` then only indexes of neighbors are stored by the graph.
+
+    */
+    void find_nearest(const double p_radius, neighbor_graph & p_graph, const bool p_store_distances = true) const;
+
+    /*!
+
+    @brief   Calculates label of each node of the tree that is shared by all points of the node.
+    @details Labels of nodes are used by the search that skips points with a specific label, they should be
+              calculated again when labels of points are changed.
+
+    @param[in]  p_labels: label of each point of the input data.
+    @param[out] p_node_labels: label of each node, `NO_LABEL` if points of the node have different labels.
+
+    */
+    void label_nodes(const std::vector<std::size_t> & p_labels, std::vector<std::size_t> & p_node_labels) const;
+
+    /*!
+
+    @brief   Finds nearest points except points with the excluded label, the radius of the search is bounded by the
+              visitor.
+    @details Sub-trees are visited from the nearest one, a sub-tree is skipped if its splitting plane is farther than
+              the bound or if all its points have the excluded label. The visitor is called as
+              `p_visitor(index, square_distance)` for each point whose square distance is not greater than the bound
+              and it may decrease the bound, so it is a branch-and-bound search for a point that minimizes any
+              criterion that is not less than the distance. Points of leaves with different labels are not filtered,
+              the visitor should check their labels.
+
+    @param[in]     p_point: coordinates of the point, their amount is equal to the dimension of the tree.
+    @param[in,out] p_square_bound: square Euclidean distance to points that might be visited.
+    @param[in]     p_node_labels: labels of nodes that are calculated by `label_nodes`.
+    @param[in]     p_excluded_label: label of points that are skipped.
+    @param[in]     p_visitor: callable object that receives found points.
+
+    */
+    template <typename TypeVisitor>
+    void find_nearest_excluding(const double * p_point, double & p_square_bound, const std::vector<std::size_t> & p_node_labels, const std::size_t p_excluded_label, TypeVisitor && p_visitor) const;
+
+    /*!
+
+    @brief   Returns amount of points in the tree.
+
+    */
+    std::size_t size() const;
+
+    /*!
+
+    @brief   Returns dimension of points in the tree.
+
+    */
+    std::size_t dimension() const;
+
+    /*!
+
+    @brief   Returns `true` if the tree does not contain points.
+
+    */
+    bool empty() const;
+
+    /*!
+
+    @brief   Returns maximum amount of points in a leaf.
+
+    */
+    std::size_t get_leaf_size() const;
+
+public:
+    /*!
+
+    @brief   Default copy assignment operator.
+
+    @param[in] p_other: another tree that is copied.
+
+    @return  Reference to the tree.
+
+    */
+    kdtree_flat & operator=(const kdtree_flat & p_other) = default;
+
+    /*!
+
+    @brief   Default move assignment operator.
+
+    @param[in,out] p_other: another tree that is moved.
+
+    @return  Reference to the tree.
+
+    */
+    kdtree_flat & operator=(kdtree_flat && p_other) = default;
+
+private:
+    void build(const dense_dataset_view & p_data);
+
+    std::size_t create_node(const dense_dataset_view & p_data, const std::size_t p_begin, const std::size_t p_end, std::vector<node> & p_nodes);
+};
+
+
+template <typename TypeVisitor>
+void kdtree_flat::find_nearest(const double * p_point, const double p_radius, TypeVisitor && p_visitor) const {
+    if (m_nodes.empty()) {
+        return;
+    }
+
+    const double square_radius = p_radius * p_radius;
+    const std::size_t dimension = m_points.dimension();
+
+    std::size_t stack[MAXIMUM_DEPTH + 1];
+    std::size_t stack_size = 0;
+    stack[stack_size++] = 0;
+
+    while (stack_size > 0) {
+        const node & current = m_nodes[stack[--stack_size]];
+
+        if (current.m_right == 0) {
+            for (std::size_t index_point = current.m_begin; index_point < current.m_end; index_point++) {
+                const double * candidate = m_points.row(index_point);
+
+                double square_distance = 0.0;
+                for (std::size_t index_dimension = 0; index_dimension < dimension; index_dimension++) {
+                    const double difference = p_point[index_dimension] - candidate[index_dimension];
+                    square_distance += difference * difference;
+                }
+
+                if (square_distance <= square_radius) {
+                    p_visitor(m_indexes[index_point], square_distance);
+                }
+            }
+
+            continue;
+        }
+
+        const double coordinate = p_point[current.m_discriminator];
+        if (coordinate + p_radius >= current.m_value) {
+            stack[stack_size++] = current.m_right;
+        }
+
+        if (coordinate - p_radius <= current.m_value) {
+            stack[stack_size++] = static_cast<std::size_t>(&current - m_nodes.data()) + 1;
+        }
+    }
+}
+
+
+template <typename TypeVisitor>
+void kdtree_flat::find_nearest_excluding(const double * p_point, double & p_square_bound, const std::vector<std::size_t> & p_node_labels, const std::size_t p_excluded_label, TypeVisitor && p_visitor) const {
+    if (m_nodes.empty()) {
+        return;
+    }
+
+    const std::size_t dimension = m_points.dimension();
+
+    /* each entry is a node and square distance to its splitting plane that is a lower bound for its points */
+    std::pair<std::size_t, double> stack[MAXIMUM_DEPTH + 1];
+    std::size_t stack_size = 0;
+    stack[stack_size++] = { 0, 0.0 };
+
+    while (stack_size > 0) {
+        const auto entry = stack[--stack_size];
+        if ((entry.second > p_square_bound) || (p_node_labels[entry.first] == p_excluded_label)) {
+            continue;
+        }
+
+        const node & current = m_nodes[entry.first];
+        if (current.m_right == 0) {
+            for (std::size_t index_point = current.m_begin; index_point < current.m_end; index_point++) {
+                const double * candidate = m_points.row(index_point);
+
+                double square_distance = 0.0;
+                for (std::size_t index_dimension = 0; index_dimension < dimension; index_dimension++) {
+                    const double difference = p_point[index_dimension] - candidate[index_dimension];
+                    square_distance += difference * difference;
+                }
+
+                if (square_distance <= p_square_bound) {
+                    p_visitor(m_indexes[index_point], square_distance);
+                }
+            }
+
+            continue;
+        }
+
+        /* the farthest child is pushed first, so the nearest child is visited first */
+        const std::size_t index_left = entry.first + 1;
+        const double difference = p_point[current.m_discriminator] - current.m_value;
+        const double plane_distance = difference * difference;
+
+        if (difference < 0.0) {
+            stack[stack_size++] = { current.m_right, plane_distance };
+            stack[stack_size++] = { index_left, entry.second };
+        }
+        else {
+            stack[stack_size++] = { index_left, plane_distance };
+            stack[stack_size++] = { current.m_right, entry.second };
+        }
+    }
+}
+
+
+}
+
+}
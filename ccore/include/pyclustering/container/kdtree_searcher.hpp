@@ -8,12 +8,18 @@
 
 #pragma once
 
+#include <algorithm>
+#include <cmath>
 #include <functional>
+#include <limits>
+#include <utility>
 #include <vector>
 
 #include <pyclustering/container/kdnode.hpp>
 #include <pyclustering/definitions.hpp>
 
+#include <pyclustering/utils/metric.hpp>
+
 
 namespace pyclustering {
 
@@ -23,6 +29,11 @@ namespace container {
 /*!
 
 @brief   Searcher in KD Tree provides services related to searching in KD Tree.
+@details The tree is traversed by an explicit stack, therefore deep trees (for example, trees that are built by
+          insertion of sorted points) do not overflow the call stack. A sub-tree is skipped if the distance from
+          the point to the cell of the sub-tree (the box that is bounded by splitting planes of its ancestors) is
+          greater than the current search radius. Internal buffers are reused by subsequent requests of the
+          searcher, so the searcher might be re-initialized by `initialize` for each next point.
 
 */
 class kdtree_searcher {
@@ -30,15 +41,23 @@ public:
     using rule_store = std::function<void(const kdnode::ptr, const double)>;
 
 private:
-    using proc_store = std::function<void(const kdnode::ptr)>;
+    using neighbor_heap = std::vector<std::pair<double, std::size_t>>;
 
-private:
-    mutable std::vector<double>        m_nodes_distance     = { };
-    mutable std::vector<kdnode::ptr>   m_nearest_nodes      = { };
-    mutable dataset                    m_nearest_points     = { };
+    struct search_entry {
+        const kdnode::ptr * m_node              = nullptr;  /* node whose cell should be visited */
+        double              m_cell_distance     = 0.0;      /* square distance from the point to the cell of the node */
+        std::size_t         m_trail_size        = 0;        /* size of the trail when the parent cell was current */
+        std::size_t         m_discriminator     = 0;        /* dimension where cell offset differs from the parent cell */
+        double              m_offset            = 0.0;      /* offset from the point to the cell in the dimension */
+    };
 
-    mutable rule_store                 m_user_rule          = nullptr;
-    mutable proc_store                 m_proc               = nullptr;
+    using offset_change = std::pair<std::size_t, double>;
+
+private:
+    mutable std::vector<search_entry>   m_stack             = { };
+    mutable std::vector<double>         m_offsets           = { };  /* offsets from the point to the current cell in each dimension */
+    mutable std::vector<offset_change>  m_trail             = { };  /* previous offsets that are restored when the search returns to another cell */
+    mutable neighbor_heap               m_heap              = { };
 
     double                  m_distance            = -1;
     double                  m_sqrt_distance       = -1;
@@ -72,16 +91,24 @@ public:
     ~kdtree_searcher() = default;
 
 public:
+    /**
+    *
+    * @brief   Initialization of new request for searching, buffers of the previous request are reused.
+    *
+    * @param[in] point: point for which nearest nodes should be found.
+    * @param[in] node: initial node in tree from which searching should started.
+    * @param[in] radius_search: allowable distance for searching from the point.
+    *
+    */
+    void initialize(const std::vector<double> & point, const kdnode::ptr & node, const double radius_search);
+
     /**
     *
     * @brief   Search nodes that are located in specified distance from specified point.
     *
-    * @param[out] p_distances: distances from the point to nodes in the location (that are radius-reachable).
+    * @param[out] p_distances: square distances from the point to nodes in the location (that are radius-reachable).
     * @param[out] p_nearest_nodes: nodes in the location (radius-reachable).
     *
-    * @return  Return vector of found nodes in kd tree that satisfy the request. If distances are
-    *          specified then it will be filled by corresponding distances.
-    *
     */
     void find_nearest_nodes(std::vector<double> & p_distances, std::vector<kdnode::ptr> & p_nearest_nodes) const;
 
@@ -89,7 +116,8 @@ public:
     *
     * @brief   Search the nearest node in specified location for specified point in the request.
     *
-    * @return  Return pointer to the nearest node in kd tree that satisfy the request.
+    * @return  Return pointer to the nearest node in kd tree that satisfy the request, `nullptr` if there is
+    *          no node in the location.
     *
     */
     kdnode::ptr find_nearest_node() const;
@@ -98,68 +126,123 @@ public:
     *
     * @brief   Search the nearest nodes and store information about found node using user-defined way.
     *
-    * @param[in]  p_store_rule: defines how to store KD-node.
+    * @param[in]  p_store_rule: defines how to store KD-node, it is called as `p_store_rule(node, square_distance)`
+    *              where `node` is `const kdnode::ptr &`.
     *
     */
-    void find_nearest(const rule_store & p_store_rule) const;
+    template <typename TypeStoreRule>
+    void find_nearest(const TypeStoreRule & p_store_rule) const;
 
-private:
     /**
     *
-    * @brief   Initialization of new request for searching.
-    *
-    * @param[in] point: point for which nearest nodes should be found.
-    * @param[in] node: initial node in tree from which searching should started.
-    * @param[in] radius_search: allowable distance for searching from the point.
-    *
-    */
-    void initialize(const std::vector<double> & point, const kdnode::ptr & node, const double radius_search);
-
-    /**
+    * @brief   Search k nearest nodes to the point in the request whose distance is not greater than the radius.
+    * @details The payload of each node is considered as an index of its point (as it is done by DBSCAN and OPTICS).
+    *          Nodes are ordered by distance, nodes with the same distance are ordered by the index. The radius of
+    *          the request is not used, the search is limited only by `p_max_radius`.
     *
-    * @brief   Clear internal temporary structures.
+    * @param[in]  p_k: maximum amount of nodes that should be found.
+    * @param[in]  p_max_radius: maximum distance from the point to found nodes.
+    * @param[out] p_indexes: indexes (payloads) of found nodes.
+    * @param[out] p_distances: square Euclidean distances from the point to found nodes.
     *
     */
-    void clear() const;
+    void find_k_nearest(const std::size_t p_k,
+                        const double p_max_radius,
+                        std::vector<std::size_t> & p_indexes,
+                        std::vector<double> & p_distances) const;
 
+private:
     /**
     *
-    * @brief   Recursive method for searching nodes that satisfy the request.
+    * @brief   Visits nodes whose square distance to the point is not greater than the bound.
+    * @details Children are visited from the nearest one. The bound is requested before each step, therefore it
+    *          might be decreased by the visitor.
     *
-    * @param[in] node: initial node in tree from which searching should performed.
+    * @param[in] p_bound: callable object that returns current square radius of the search.
+    * @param[in] p_visitor: callable object that is called as `p_visitor(node, square_distance)`.
     *
     */
-    void recursive_nearest_nodes(const kdnode::ptr & node) const;
+    template <typename TypeBound, typename TypeVisitor>
+    void traverse(const TypeBound & p_bound, TypeVisitor && p_visitor) const;
 
     /**
     *
-    * @brief   Append to storage reachable node and distance to it.
-    *
-    * @param[in] node: node that should be added to best collection if it is reachable.
+    * @brief   Returns square distance from the point to the current cell where the offset in the specified
+    *          dimension is replaced.
     *
     */
-    void store_if_reachable(const kdnode::ptr & node) const;
+    double cell_distance(const std::size_t p_dimension, const double p_offset) const;
+};
 
-    /**
-    *
-    * @brief   Store only one node in collection if it the best node.
-    *
-    * @param[in] node: node that should be added to best collection if it is reachable.
-    *
-    */
-    void store_best_if_reachable(const kdnode::ptr & node) const;
 
-    /**
-    *
-    * @brief   Store nodes using user-defined rule.
-    *
-    * @param[in] node: node that should be added to best collection if it is reachable.
-    *
-    */
-    void store_user_nodes_if_reachable(const kdnode::ptr & node) const;
-};
+template <typename TypeStoreRule>
+void kdtree_searcher::find_nearest(const TypeStoreRule & p_store_rule) const {
+    const double square_radius = m_sqrt_distance;
+    traverse([square_radius]() { return square_radius; }, p_store_rule);
+}
+
+
+template <typename TypeBound, typename TypeVisitor>
+void kdtree_searcher::traverse(const TypeBound & p_bound, TypeVisitor && p_visitor) const {
+    if (m_initial_node == nullptr) {
+        return;
+    }
+
+    m_offsets.assign(m_search_point.size(), 0.0);
+    m_trail.clear();
 
+    m_stack.clear();
+    m_stack.push_back({ &m_initial_node, 0.0, 0, 0, 0.0 });
 
+    while (!m_stack.empty()) {
+        const search_entry entry = m_stack.back();
+        m_stack.pop_back();
+
+        if (entry.m_cell_distance > p_bound()) {
+            continue;
+        }
+
+        /* offsets are restored to the parent cell, the cell of the entry differs from it only in one dimension */
+        for (; m_trail.size() > entry.m_trail_size; m_trail.pop_back()) {
+            m_offsets[m_trail.back().first] = m_trail.back().second;
+        }
+
+        m_trail.emplace_back(entry.m_discriminator, m_offsets[entry.m_discriminator]);
+        m_offsets[entry.m_discriminator] = entry.m_offset;
+
+        /* the nearest child has the same distance to the point as its parent, so it is visited without the stack */
+        for (const kdnode::ptr * current = entry.m_node; current != nullptr; ) {
+            const kdnode::ptr & node = *current;
+
+            if (!node->is_removed()) {
+                const double square_distance = utils::metric::euclidean_distance_square(m_search_point, node->get_data());
+                if (square_distance <= p_bound()) {
+                    p_visitor(node, square_distance);
+                }
+            }
+
+            /* left sub-tree contains points that are less than the node on the discriminator, right - greater or equal */
+            const std::size_t discriminator = node->get_discriminator();
+            const double difference = m_search_point[discriminator] - node->get_value();
+
+            const kdnode::ptr & nearest_child = (difference < 0.0) ? node->get_left() : node->get_right();
+            const kdnode::ptr & farthest_child = (difference < 0.0) ? node->get_right() : node->get_left();
+
+            if (farthest_child != nullptr) {
+                const double farthest_offset = std::max(m_offsets[discriminator], std::abs(difference));
+                const double farthest_distance = cell_distance(discriminator, farthest_offset);
+
+                if (farthest_distance <= p_bound()) {
+                    m_stack.push_back({ &farthest_child, farthest_distance, m_trail.size(), discriminator, farthest_offset });
+                }
+            }
+
+            current = (nearest_child != nullptr) ? &nearest_child : nullptr;
+        }
+    }
 }
 
-}
\ No newline at end of file
+
+}
+
+}
@@ -0,0 +1,257 @@
+/*!
+
+@authors Andrei Novikov (pyclustering@yandex.ru)
+@date 2014-2020
+@copyright BSD-3-Clause
+
+*/
+
+
+#pragma once
+
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+#include <pyclustering/parallel/parallel.hpp>
+
+
+namespace pyclustering {
+
+namespace container {
+
+
+/*!
+
+@class    neighbor_graph neighbor_graph.hpp pyclustering/container/neighbor_graph.hpp
+
+@brief    Represents neighborhoods of points in compressed sparse row (CSR) format.
+@details  Neighbors of all points are stored in one array one after another, neighbors of point `i` are located
+           in range `[offsets()[i]; offsets()[i + 1])` of arrays `neighbors()` and `distances()`. Distances are
+           optional, they are not stored if an algorithm needs only indexes of neighbors.
+
+*/
+class neighbor_graph {
+private:
+    const static std::size_t    QUERY_BLOCK_SIZE;       /* amount of queries that are processed by a task with the same result buffers */
+
+private:
+    std::vector<std::size_t>    m_offsets       = { 0 };
+    std::vector<std::size_t>    m_neighbors     = { };
+    std::vector<double>         m_distances     = { };
+
+public:
+    /*!
+
+    @brief    Default constructor of empty graph.
+
+    */
+    neighbor_graph() = default;
+
+    /*!
+
+    @brief    Default copy constructor of the graph.
+
+    @param[in] p_other: another graph that is copied.
+
+    */
+    neighbor_graph(const neighbor_graph & p_other) = default;
+
+    /*!
+
+    @brief    Default move constructor of the graph.
+
+    @param[in,out] p_other: another graph that is moved.
+
+    */
+    neighbor_graph(neighbor_graph && p_other) = default;
+
+    /*!
+
+    @brief    Default destructor of the graph.
+
+    */
+    ~neighbor_graph() = default;
+
+public:
+    /*!
+
+    @brief    Returns amount of points whose neighborhoods are stored.
+
+    */
+    std::size_t size() const;
+
+    /*!
+
+    @brief    Returns `true` if the graph does not contain neighborhoods.
+
+    */
+    bool empty() const;
+
+    /*!
+
+    @brief    Returns amount of neighbors of the specified point.
+
+    @param[in] p_index: index of the point in the graph.
+
+    */
+    std::size_t amount_neighbors(const std::size_t p_index) const;
+
+    /*!
+
+    @brief    Returns pointer to the first neighbor of the specified point.
+
+    @param[in] p_index: index of the point in the graph.
+
+    */
+    const std::size_t * neighbors(const std::size_t p_index) const;
+
+    /*!
+
+    @brief    Returns `true` if distances to neighbors are stored.
+
+    */
+    bool has_distances() const;
+
+    /*!
+
+    @brief    Returns pointer to the distance to the first neighbor of the specified point.
+    @details  The graph should contain distances (see `has_distances`).
+
+    @param[in] p_index: index of the point in the graph.
+
+    */
+    const double * distances(const std::size_t p_index) const;
+
+    /*!
+
+    @brief    Returns reference to offsets of neighborhoods, its size is greater than amount of points by one.
+
+    */
+    std::vector<std::size_t> & offsets();
+
+    /*!
+
+    @brief    Returns constant reference to offsets of neighborhoods.
+
+    */
+    const std::vector<std::size_t> & offsets() const;
+
+    /*!
+
+    @brief    Returns reference to neighbors of all points.
+
+    */
+    std::vector<std::size_t> & neighbors();
+
+    /*!
+
+    @brief    Returns constant reference to neighbors of all points.
+
+    */
+    const std::vector<std::size_t> & neighbors() const;
+
+    /*!
+
+    @brief    Returns reference to distances to neighbors of all points.
+
+    */
+    std::vector<double> & distances();
+
+    /*!
+
+    @brief    Returns constant reference to distances to neighbors of all points.
+
+    */
+    const std::vector<double> & distances() const;
+
+    /*!
+
+    @brief    Removes all neighborhoods from the graph.
+
+    */
+    void clear();
+
+    /*!
+
+    @brief    Fills the graph by neighborhoods that are found in parallel.
+    @details  Queries are processed by blocks, each block collects neighbors to its own buffers that are copied to the
+               graph when all queries are processed.
+
+    @param[in] p_amount_queries: amount of queries (points of the graph).
+    @param[in] p_search: callable object that is called as `p_search(index_query, neighbors, distances)` and appends
+                neighbors of the query and distances to them to the specified vectors, if the search does not
+                append distances at all then the graph does not store them.
+
+    */
+    template <typename TypeSearch>
+    void assign(const std::size_t p_amount_queries, const TypeSearch & p_search);
+
+public:
+    /*!
+
+    @brief    Default copy assignment operator.
+
+    @param[in] p_other: another graph that is copied.
+
+    @return   Reference to the graph.
+
+    */
+    neighbor_graph & operator=(const neighbor_graph & p_other) = default;
+
+    /*!
+
+    @brief    Default move assignment operator.
+
+    @param[in,out] p_other: another graph that is moved.
+
+    @return   Reference to the graph.
+
+    */
+    neighbor_graph & operator=(neighbor_graph && p_other) = default;
+};
+
+
+template <typename TypeSearch>
+void neighbor_graph::assign(const std::size_t p_amount_queries, const TypeSearch & p_search) {
+    m_offsets.assign(p_amount_queries + 1, 0);
+
+    const std::size_t amount_blocks = (p_amount_queries + QUERY_BLOCK_SIZE - 1) / QUERY_BLOCK_SIZE;
+    std::vector<std::vector<std::size_t>> block_neighbors(amount_blocks);
+    std::vector<std::vector<double>> block_distances(amount_blocks);
+
+    /* the amount of neighbors of each query is stored after its offset, offsets are accumulated later */
+    parallel::parallel_for(std::size_t(0), amount_blocks, [this, p_amount_queries, &p_search, &block_neighbors, &block_distances](const std::size_t p_block) {
+        std::vector<std::size_t> & neighbors = block_neighbors[p_block];
+        std::vector<double> & distances = block_distances[p_block];
+
+        const std::size_t end = std::min(p_amount_queries, (p_block + 1) * QUERY_BLOCK_SIZE);
+        for (std::size_t index_query = p_block * QUERY_BLOCK_SIZE; index_query < end; index_query++) {
+            const std::size_t begin_size = neighbors.size();
+            p_search(index_query, neighbors, distances);
+            m_offsets[index_query + 1] = neighbors.size() - begin_size;
+        }
+    });
+
+    for (std::size_t index_query = 0; index_query < p_amount_queries; index_query++) {
+        m_offsets[index_query + 1] += m_offsets[index_query];
+    }
+
+    const bool has_distances = std::any_of(block_distances.begin(), block_distances.end(),
+        [](const std::vector<double> & p_distances) { return !p_distances.empty(); });
+
+    m_neighbors.resize(m_offsets.back());
+    m_distances.resize(has_distances ? m_offsets.back() : 0);
+
+    parallel::parallel_for(std::size_t(0), amount_blocks, [this, &block_neighbors, &block_distances](const std::size_t p_block) {
+        const std::size_t begin = m_offsets[p_block * QUERY_BLOCK_SIZE];
+        std::copy(block_neighbors[p_block].begin(), block_neighbors[p_block].end(), m_neighbors.begin() + begin);
+        std::copy(block_distances[p_block].begin(), block_distances[p_block].end(), m_distances.begin() + begin);
+    });
+}
+
+
+}
+
+}
@@ -26,13 +26,78 @@
  * @param[in] p_minumum_neighbors: minimum number of shared neighbors that is required for
  *             establish links between points.
  * @param[in] p_data_type: defines data type that is used for clustering process ('0' - points, '1' - distance matrix).
+ * @param[in] p_engine: defines how neighbors of points are found ('dbscan_engine': '0' - tree, '1' - grid, '2' - parallel).
  *
  * @return  Returns result of clustering - array of allocated clusters. The last cluster in the
- *          array is noise.
+ *          array is noise. If the engine is unknown or arguments are incorrect then message of the error is returned.
  *
  */
 extern "C" DECLARATION pyclustering_package * dbscan_algorithm(const pyclustering_package * const p_sample, 
                                                                const double p_radius, 
                                                                const size_t p_minumum_neighbors,
-                                                               const size_t p_data_type);
+                                                               const size_t p_data_type,
+                                                               const unsigned int p_engine);
+
+
+/**
+ *
+ * @brief   Creates incremental DBSCAN that maintains clusters while points are inserted and removed.
+ * @details Caller should destroy returned object by 'dbscan_incremental_destroy'.
+ *
+ * @param[in] p_radius: connectivity radius between points.
+ * @param[in] p_minumum_neighbors: minimum number of neighbors of a core point.
+ *
+ * @return  Returns pointer to incremental DBSCAN.
+ *
+ */
+extern "C" DECLARATION void * dbscan_incremental_create(const double p_radius, const size_t p_minumum_neighbors);
+
+/**
+ *
+ * @brief   Destroys incremental DBSCAN.
+ *
+ * @param[in] p_pointer: pointer to incremental DBSCAN.
+ *
+ */
+extern "C" DECLARATION void dbscan_incremental_destroy(const void * p_pointer);
+
+/**
+ *
+ * @brief   Inserts points into incremental DBSCAN and updates clusters.
+ * @details Caller should destroy returned result by 'free_pyclustering_package'.
+ *
+ * @param[in] p_pointer: pointer to incremental DBSCAN.
+ * @param[in] p_sample: points that should be inserted.
+ *
+ * @return  Returns indexes of inserted points, indexes of removed points are reused. If dimension of any point
+ *          is not consistent then nothing is inserted and message of the error is returned.
+ *
+ */
+extern "C" DECLARATION pyclustering_package * dbscan_incremental_insert(const void * p_pointer, const pyclustering_package * const p_sample);
 
+/**
+ *
+ * @brief   Removes points from incremental DBSCAN and updates clusters.
+ * @details Caller should destroy returned error by 'free_pyclustering_package'.
+ *
+ * @param[in] p_pointer: pointer to incremental DBSCAN.
+ * @param[in] p_indexes: indexes of points that should be removed.
+ *
+ * @return  Returns `nullptr` if points are removed, otherwise message of the error (nothing is removed if any
+ *          index does not exist or is specified more than once).
+ *
+ */
+extern "C" DECLARATION pyclustering_package * dbscan_incremental_remove(const void * p_pointer, const pyclustering_package * const p_indexes);
+
+/**
+ *
+ * @brief   Returns clusters and noise of points that are stored by incremental DBSCAN.
+ * @details Caller should destroy returned result by 'free_pyclustering_package'.
+ *
+ * @param[in] p_pointer: pointer to incremental DBSCAN.
+ *
+ * @return  Returns array of clusters where points are represented by their indexes. The last cluster in the
+ *          array is noise.
+ *
+ */
+extern "C" DECLARATION pyclustering_package * dbscan_incremental_get_clusters(const void * p_pointer);
@@ -0,0 +1,33 @@
+/*!
+
+@authors Andrei Novikov (pyclustering@yandex.ru)
+@date 2014-2020
+@copyright BSD-3-Clause
+
+*/
+
+#pragma once
+
+
+#include <pyclustering/interface/pyclustering_package.hpp>
+
+#include <pyclustering/definitions.hpp>
+
+
+/**
+ *
+ * @brief   Clustering algorithm HDBSCAN returns allocated clusters and noise that are consisted
+ *          from input data.
+ * @details Caller should destroy returned result by 'free_pyclustering_package'.
+ *
+ * @param[in] p_sample: input data (points) for clustering.
+ * @param[in] p_minimum_neighbors: amount of neighbors (except the point itself) that defines core distance of a point.
+ * @param[in] p_minimum_cluster_size: minimum amount of points in a cluster, it should be greater than 1.
+ *
+ * @return  Returns result of clustering - array of allocated clusters. The last cluster in the
+ *          array is noise. Message of the error is returned if arguments are not correct.
+ *
+ */
+extern "C" DECLARATION pyclustering_package * hdbscan_algorithm(const pyclustering_package * const p_sample,
+                                                                const size_t p_minimum_neighbors,
+                                                                const size_t p_minimum_cluster_size);
@@ -41,6 +41,7 @@ enum kmeans_package_indexer {
  * @param[in] p_itermax: maximum number of iterations for cluster analysis.
  * @param[in] p_observe: if 'true' then evolution of cluster and center changes are collected to result.
  * @param[in] p_metric: pointer to distance metric 'distance_metric' that is used for distance calculation between two points.
+ * @param[in] p_acceleration: defines whether bounds of distances are used to skip distance calculations ('kmeans_acceleration').
  *
  * @return  Returns result of clustering - array of allocated clusters, if 'p_observe' is 'true' then package contains
  *           evolution of cluster and center changes.
@@ -51,4 +52,5 @@ extern "C" DECLARATION pyclustering_package * kmeans_algorithm(const pyclusterin
                                                                const double p_tolerance,
                                                                const std::size_t p_itermax,
                                                                const bool p_observe,
-                                                               const void * const p_metric);
+                                                               const void * const p_metric,
+                                                               const unsigned int p_acceleration);
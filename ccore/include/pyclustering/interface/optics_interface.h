@@ -29,10 +29,25 @@ enum optics_package_indexer {
     OPTICS_PACKAGE_INDEX_OPTICS_OBJECTS_INDEX,
     OPTICS_PACKAGE_INDEX_OPTICS_OBJECTS_CORE_DISTANCE,
     OPTICS_PACKAGE_INDEX_OPTICS_OBJECTS_REACHABILITY_DISTANCE,
+    OPTICS_PACKAGE_INDEX_OBJECT_ORDERING,
     OPTICS_PACKAGE_SIZE
 };
 
 
+/**
+ *
+ * @brief   OPTICS-Xi result is returned by pyclustering_package that consist sub-packages and this enumerator provides
+ *           named indexes for sub-packages.
+ *
+ */
+enum optics_xi_package_indexer {
+    OPTICS_XI_PACKAGE_INDEX_CLUSTERS = 0,
+    OPTICS_XI_PACKAGE_INDEX_NOISE,
+    OPTICS_XI_PACKAGE_INDEX_HIERARCHY,
+    OPTICS_XI_PACKAGE_SIZE
+};
+
+
 /**
  *
  * @brief   Clustering algorithm OPTICS returns allocated clusters, noise, ordering and proper connectivity radius.
@@ -48,7 +63,8 @@ enum optics_package_indexer {
  *
  * @return  Returns result of clustering - array that consists of four general clustering results that are represented by arrays too:
  *          [ [allocated clusters], [noise], [ordering], [connectivity radius], [optics objects indexes], [ optics objects core distances ], 
- *          [ optics objects reachability distances ] ]. It is important to note that connectivity radius is also placed into array.
+ *          [ optics objects reachability distances ], [ indexes of objects in order of processing ] ]. It is important to note that
+ *          connectivity radius is also placed into array.
  *
  */
 extern "C" DECLARATION pyclustering_package * optics_algorithm(const pyclustering_package * const p_sample, 
@@ -56,3 +72,26 @@ extern "C" DECLARATION pyclustering_package * optics_algorithm(const pyclusterin
                                                                const size_t p_minumum_neighbors, 
                                                                const size_t p_amount_clusters,
                                                                const size_t p_data_type);
+
+
+/**
+ *
+ * @brief   Extracts hierarchy of clusters from existing result of OPTICS by Xi method, the data is not processed again.
+ * @details Caller should destroy returned result in 'pyclustering_package'.
+ *
+ * @param[in] p_object_ordering: indexes of objects in order of processing that are returned by OPTICS.
+ * @param[in] p_reachability_distances: reachability distances of optics objects that are returned by OPTICS.
+ * @param[in] p_xi: minimum steepness of reachability plot that bounds clusters, value in range (0, 1).
+ * @param[in] p_minimum_samples: maximum amount of consecutive objects in a steep area that are not steep.
+ * @param[in] p_minimum_cluster_size: minimum amount of objects in a cluster.
+ *
+ * @return  Returns result of extraction - array that consists of three arrays: [ [nested clusters], [noise],
+ *          [index of parent cluster of each cluster] ], clusters are placed before clusters that contain them.
+ *          Message of the error is returned if arguments are not correct.
+ *
+ */
+extern "C" DECLARATION pyclustering_package * optics_xi_extract(const pyclustering_package * const p_object_ordering,
+                                                                const pyclustering_package * const p_reachability_distances,
+                                                                const double p_xi,
+                                                                const size_t p_minimum_samples,
+                                                                const size_t p_minimum_cluster_size);
@@ -10,6 +10,9 @@
 #pragma once
 
 
+#include <cstddef>
+#include <cstdint>
+
 #include <pyclustering/interface/pyclustering_package.hpp>
 
 
@@ -22,3 +25,35 @@
  */
 extern "C" DECLARATION void free_pyclustering_package(pyclustering_package * package);
 
+
+
+/**
+ *
+ * @brief   Sets amount of threads that are used by parallel algorithms of the library.
+ * @details By default the amount of threads is equal to the amount of processors that are available for the process
+ *           (the CPU affinity and the cgroup CPU quota are taken into account on Linux).
+ *
+ * @param[in] p_threads: amount of threads including the calling thread, '0' means automatic detection.
+ *
+ */
+extern "C" DECLARATION void pyclustering_set_threads(const std::size_t p_threads);
+
+/**
+ *
+ * @brief   Returns amount of threads that are used by parallel algorithms of the library.
+ *
+ * @return  Amount of threads including the calling thread.
+ *
+ */
+extern "C" DECLARATION std::size_t pyclustering_get_threads();
+
+/**
+ *
+ * @brief   Binds worker threads of parallel algorithms of the library to processors that are specified by the mask.
+ *
+ * @param[in] p_mask: processor mask where bit 'i' corresponds to processor 'i', '0' means any available processor.
+ *
+ * @return  Returns 'true' if the affinity is supported by the system and has been applied.
+ *
+ */
+extern "C" DECLARATION bool pyclustering_set_affinity(const std::uint64_t p_mask);
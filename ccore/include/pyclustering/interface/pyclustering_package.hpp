@@ -17,6 +17,7 @@
 #include <vector>
 
 #include <pyclustering/definitions.hpp>
+#include <pyclustering/container/dense_dataset.hpp>
 #include <pyclustering/utils/traits.hpp>
 
 
@@ -37,7 +38,26 @@ enum pyclustering_data_t {
     PYCLUSTERING_TYPE_LIST              = 6,    /**< Represents `pyclustering_package` type. */
     PYCLUSTERING_TYPE_SIZE_T            = 7,    /**< Represents basic `std::size_t` type. */
     PYCLUSTERING_TYPE_WCHAR_T           = 8,    /**< Represents basic `wchar_t` type. */
-    PYCLUSTERING_TYPE_UNDEFINED         = 9     /**< Indicates incorrect type. */
+    PYCLUSTERING_TYPE_UNDEFINED         = 9,    /**< Indicates incorrect type. */
+    PYCLUSTERING_TYPE_DOUBLE_MATRIX     = 10    /**< Represents two-dimensional row-major array of `double` that is described by `pyclustering_matrix`. */
+};
+
+
+/*!
+
+@brief  Describes two-dimensional row-major array of `double` that is referenced by `PYCLUSTERING_TYPE_DOUBLE_MATRIX` package.
+@details The package owns the descriptor, but it does not own the array, therefore data that is provided by the caller (for
+          example, a buffer of numpy array) is used by algorithms without copying.
+
+@see    pyclustering_package
+
+*/
+struct DECLARATION pyclustering_matrix {
+public:
+    std::size_t     rows      = 0;          /**< Amount of rows (points) in the array. */
+    std::size_t     columns   = 0;          /**< Amount of columns (coordinates of each point) in the array. */
+    std::size_t     stride    = 0;          /**< Distance in elements between beginnings of two neighbour rows. */
+    double          * data    = nullptr;    /**< Pointer to the first element of the array. */
 };
 
 
@@ -102,22 +122,32 @@ public:
 
     /*!
 
-    @brief  Returns reference to package element at the specified position like in case of two-dimensional array or vector.
+    @brief  Returns package element at the specified position like in case of two-dimensional array or vector.
+    @details Elements of a matrix package are stored as `double` values that are converted to the required type.
 
     @param[in] index_row: row index in the package where required element is located.
     @param[in] index_column: column index in the package where required element is located.
 
-    @return Reference to the element in the package.
+    @return Value of the element in the package.
 
     @throw  `std::out_of_range` if the package does not have row with index `index_row` or does not have column with index `index_column`.
 
     */
     template <class TypeValue>
-    auto & at(const std::size_t index_row, const std::size_t index_column) const {
+    TypeValue at(const std::size_t index_row, const std::size_t index_column) const {
         if (size <= index_row) {
             throw std::out_of_range("pyclustering_package::at() [" + std::to_string(__LINE__) + "]: index '" + std::to_string(index_row) + "' out of range (size: '" + std::to_string(size) + "').");
         }
 
+        if (type == PYCLUSTERING_TYPE_DOUBLE_MATRIX) {
+            const pyclustering_matrix * matrix = (const pyclustering_matrix *) data;
+            if (matrix->columns <= index_column) {
+                throw std::out_of_range("pyclustering_package::at() [" + std::to_string(__LINE__) + "]: index '" + std::to_string(index_column) + "' out of range (size: '" + std::to_string(matrix->columns) + "').");
+            }
+
+            return static_cast<TypeValue>(matrix->data[index_row * matrix->stride + index_column]);
+        }
+
         pyclustering_package * package = at<pyclustering_package *>(index_row);
         return ((TypeValue *) package->data)[index_column];
     }
@@ -145,6 +175,16 @@ public:
     */
     template <class TypeValue>
     void extract(std::vector<std::vector<TypeValue>> & container) const {
+        if (type == PYCLUSTERING_TYPE_DOUBLE_MATRIX) {
+            const pyclustering_matrix * matrix = (const pyclustering_matrix *) data;
+            for (std::size_t i = 0; i < matrix->rows; i++) {
+                const double * row = matrix->data + i * matrix->stride;
+                container.emplace_back(row, row + matrix->columns);
+            }
+
+            return;
+        }
+
         if (type != PYCLUSTERING_TYPE_LIST) {
             throw std::invalid_argument("pyclustering_package::extract() [" + std::to_string(__LINE__) + "]: argument is not 'PYCLUSTERING_TYPE_LIST').");
         }
@@ -156,6 +196,21 @@ public:
         }
     }
 
+    /*!
+
+    @brief   Provides access to two-dimensional content of the package as to contiguous points.
+    @details Content of `PYCLUSTERING_TYPE_DOUBLE_MATRIX` package is not copied - the view refers to the array of the
+              package. Content of `PYCLUSTERING_TYPE_LIST` package with `double` elements is copied to the storage.
+
+    @param[out] storage: storage that is used for the content of list package, it should live longer than the view.
+
+    @return  View of points that are contained by the package.
+
+    @throw  `std::invalid_argument` if the package is not two-dimensional or rows have different sizes.
+
+    */
+    pyclustering::container::dense_dataset_view view(pyclustering::container::dense_dataset & storage) const;
+
 private:
     /*!
 
@@ -187,6 +242,35 @@ private:
 pyclustering_package * create_package_container(const std::size_t p_size);
 
 
+/*!
+
+@brief   Create pyclustering package that refers to two-dimensional row-major array of `double` without copying it.
+
+@param[in] p_data: pointer to the first element of the array, the array should live longer than the package.
+@param[in] p_rows: amount of rows (points) in the array.
+@param[in] p_columns: amount of columns (coordinates of each point) in the array.
+@param[in] p_stride: distance in elements between beginnings of two neighbour rows, if it is `0` then it is equal
+            to the amount of columns.
+
+@return  Pointer to created pyclustering package.
+
+*/
+pyclustering_package * create_package_matrix(const double * p_data, const std::size_t p_rows, const std::size_t p_columns, const std::size_t p_stride = 0);
+
+
+/*!
+
+@brief   Create pyclustering package of density-based clustering result where the last element is noise.
+
+@param[in] p_clusters: allocated clusters where points are represented by their indexes.
+@param[in] p_noise: indexes of points that do not belong to any cluster.
+
+@return  Pointer to created pyclustering package - array of clusters followed by noise.
+
+*/
+pyclustering_package * create_package_clusters(const std::vector<std::vector<std::size_t>> & p_clusters, const std::vector<std::size_t> & p_noise);
+
+
 /*!
 
 @brief   Returns data type of the pyclustering package.
@@ -0,0 +1,115 @@
+/*!
+
+@authors Andrei Novikov (pyclustering@yandex.ru)
+@date 2014-2020
+@copyright BSD-3-Clause
+
+*/
+
+
+#pragma once
+
+
+#include <cstddef>
+#include <cstdint>
+
+
+namespace pyclustering {
+
+namespace parallel {
+
+
+/*!
+
+@brief   Returns amount of processors that are available for the current process.
+@details On Linux the amount of processors is limited by the CPU affinity of the process and by the CPU quota
+          of its control group and of its parent groups (cgroup v1 and v2 are supported), on other systems it is equal to
+          `std::thread::hardware_concurrency()`. The value is calculated once.
+
+@return  Amount of available processors (at least one).
+
+*/
+std::size_t get_available_processors();
+
+
+/*!
+
+@brief   Returns amount of threads that is used by parallel algorithms by default.
+@details If the amount of threads is not set by `set_amount_threads` then it is equal to the amount of available
+          processors or to the amount of processors in the affinity mask set by `set_affinity`.
+
+@return  Amount of threads including the calling thread (at least one).
+
+*/
+std::size_t get_amount_threads();
+
+
+/*!
+
+@brief   Returns amount of threads that help the calling thread by default.
+
+@return  Amount of threads except the calling thread, it is equal to `get_amount_threads() - 1`.
+
+*/
+std::size_t get_amount_workers();
+
+
+/*!
+
+@brief   Sets amount of threads that is used by parallel algorithms by default.
+@details The value is applied to all subsequent `parallel_for`, `parallel_for_each` calls and to the default size
+          of the `thread_pool`. Worker threads are started on demand, so the amount of threads can be increased at any
+          time; it is limited only by the capacity of the process-wide executor that is not less than
+          `work_stealing_executor::MINIMUM_THREADS`.
+
+@param[in] p_threads: amount of threads including the calling thread, `0` means automatic detection.
+
+*/
+void set_amount_threads(const std::size_t p_threads);
+
+
+/*!
+
+@brief   Binds worker threads of parallel algorithms to processors that are specified by the mask.
+@details Bit `i` of the mask corresponds to processor `i`. The affinity is applied to already running and to future
+          worker threads, the thread that calls an algorithm is not affected.
+
+@param[in] p_mask: processor mask, `0` means that worker threads can be run on any available processor.
+
+@return  `true` if the affinity is supported by the system and has been applied.
+
+*/
+bool set_affinity(const std::uint64_t p_mask);
+
+
+/*!
+
+@brief   Returns processor mask of worker threads that has been set by `set_affinity`.
+
+@return  Processor mask, `0` if the affinity is not specified.
+
+*/
+std::uint64_t get_affinity();
+
+
+/*!
+
+@brief   Amount that is read from a function each time when it is converted to `std::size_t`.
+@details It is used by deprecated constants that have been replaced by functions, so code that reads them is
+          compiled and gets the current value.
+
+*/
+template <std::size_t (*TypeFunction)()>
+struct runtime_amount {
+    /*!
+
+    @brief   Returns the current value of the amount.
+
+    */
+    operator std::size_t() const { return TypeFunction(); }
+};
+
+
+}
+
+}
@@ -14,13 +14,15 @@
 #include <cstddef>
 #include <functional>
 #include <future>
+#include <stdexcept>
+#include <string>
+#include <thread>
 #include <vector>
 
 
-#if defined(WIN32) || (_WIN32) || (_WIN64)
-#define PARALLEL_IMPLEMENTATION_ASYNC_POOL  /* 'PARALLEL_IMPLEMENTATION_ASYNC_POOL' demostrates more efficiency than 'PARALLEL_IMPLEMENTATION_PPL' in scope of the pyclustering library. */
-#else
-#define PARALLEL_IMPLEMENTATION_ASYNC_POOL
+#if !defined(PARALLEL_IMPLEMENTATION_WORK_STEALING) && !defined(PARALLEL_IMPLEMENTATION_ASYNC_POOL) && \
+    !defined(PARALLEL_IMPLEMENTATION_PPL) && !defined(PARALLEL_IMPLEMENTATION_OPENMP) && !defined(PARALLEL_IMPLEMENTATION_NONE)
+#define PARALLEL_IMPLEMENTATION_WORK_STEALING   /* Persistent workers demonstrate more efficiency than 'PARALLEL_IMPLEMENTATION_ASYNC_POOL' and 'PARALLEL_IMPLEMENTATION_PPL' in scope of the pyclustering library. */
 #endif
 
 
@@ -29,38 +31,84 @@
 #endif
 
 
+#include <pyclustering/parallel/concurrency.hpp>
+#include <pyclustering/parallel/work_stealing_executor.hpp>
+
+
 namespace pyclustering {
 
 namespace parallel {
 
 
-/* Pool of threads is used to prevent overhead in case of nested loop */
-const std::size_t AMOUNT_HARDWARE_THREADS = std::thread::hardware_concurrency();
-const std::size_t AMOUNT_THREADS = (AMOUNT_HARDWARE_THREADS > 1) ? (AMOUNT_HARDWARE_THREADS - 1) : 0;
+/* Amount of chunks per thread that are created by the work-stealing implementation to balance load between workers. */
+const std::size_t AMOUNT_CHUNKS_PER_THREAD = 4;
+
+/* Deprecated amount of hardware threads, the value is equal to `get_available_processors()`. */
+[[deprecated("use get_available_processors()")]]
+const runtime_amount<get_available_processors> AMOUNT_HARDWARE_THREADS = { };
+
+/* Deprecated default amount of threads of parallel algorithms except the calling thread, the value is equal to
+   `get_amount_workers()` like the amount of hardware threads minus one was used before. */
+[[deprecated("use get_amount_threads() or get_amount_workers()")]]
+const runtime_amount<get_amount_workers> AMOUNT_THREADS = { };
 
 
 /*!
 
 @brief Parallelizes for-loop using all available cores.
-@details `parallel_for` uses PPL in case of Windows operating system and own implemention that is based
-          on pure C++ functionality for concurency such as `std::future` and `std::async`.
+@details `parallel_for` splits the loop into chunks that are processed by the process-wide work-stealing executor,
+          the calling thread takes part in processing.
 
 Advanced uses might use one of the define to use specific implementation of the `parallel_for` loop:
-1. PARALLEL_IMPLEMENTATION_ASYNC_POOL - own parallel implementation based on `std::async` pool.
-2. PARALLEL_IMPLEMENTATION_NONE       - parallel implementation is not used.
-3. PARALLEL_IMPLEMENTATION_PPL        - parallel PPL implementation (windows system only).
-4. PARALLEL_IMPLEMENTATION_OPENMP     - parallel OpenMP implementation.
+1. PARALLEL_IMPLEMENTATION_WORK_STEALING - own parallel implementation based on persistent work-stealing executor (default).
+2. PARALLEL_IMPLEMENTATION_ASYNC_POOL    - own parallel implementation based on `std::async` pool.
+3. PARALLEL_IMPLEMENTATION_NONE          - parallel implementation is not used.
+4. PARALLEL_IMPLEMENTATION_PPL           - parallel PPL implementation (windows system only).
+5. PARALLEL_IMPLEMENTATION_OPENMP        - parallel OpenMP implementation.
 
 @param[in] p_start: initial value for the loop.
 @param[in] p_end: final value of the loop - calculations are performed until the current counter value is less than the final value `i < p_end`.
 @param[in] p_step: step that is used to iterate over the loop.
 @param[in] p_task: body of the loop that defines actions that should be done on each iteration.
-@param[in] p_threads: amount of threads that are going to be used for processing (by default the efficient amount of threads).
+@param[in] p_threads: amount of threads that are going to be used for processing (by default `get_amount_threads()`),
+            in case of nested loops the amount of threads is limited by the outermost loop.
+
+@throw  `std::invalid_argument` if the step is less than 1 or the start index is greater than the end index.
 
 */
 template <typename TypeIndex, typename TypeAction>
-void parallel_for(const TypeIndex p_start, const TypeIndex p_end, const TypeIndex p_step, const TypeAction & p_task, const std::size_t p_threads = AMOUNT_THREADS) {
-#if defined(PARALLEL_IMPLEMENTATION_ASYNC_POOL)
+void parallel_for(const TypeIndex p_start, const TypeIndex p_end, const TypeIndex p_step, const TypeAction & p_task, const std::size_t p_threads = get_amount_threads()) {
+    if (p_step < static_cast<TypeIndex>(1)) {
+        throw std::invalid_argument("Step '" + std::to_string(p_step) + "' is less than 1.");
+    }
+
+#if defined(PARALLEL_IMPLEMENTATION_WORK_STEALING)
+    if (p_end < p_start) {
+        throw std::invalid_argument("Start index '" + std::to_string(p_start) + "' is greater than end '" + std::to_string(p_end) + "'.");
+    }
+
+    const std::size_t interval_length = static_cast<std::size_t>(p_end - p_start);
+    const std::size_t step = static_cast<std::size_t>(p_step);
+    const std::size_t amount_iterations = (interval_length + step - 1) / step;
+
+    if (amount_iterations == 0) {
+        return;
+    }
+
+    /* Nested loops reuse threads of the outer loop and share its concurrency budget (see `work_stealing_executor::execute`). */
+    const std::size_t amount_threads = std::max(p_threads, std::size_t(1));
+    const std::size_t amount_chunks = std::min(amount_iterations, amount_threads * AMOUNT_CHUNKS_PER_THREAD);
+
+    work_stealing_executor::instance().execute(amount_chunks, [&p_task, p_start, p_step, amount_iterations, amount_chunks](const std::size_t p_chunk) {
+        const std::size_t chunk_begin = amount_iterations * p_chunk / amount_chunks;
+        const std::size_t chunk_end = amount_iterations * (p_chunk + 1) / amount_chunks;
+
+        TypeIndex index = p_start + static_cast<TypeIndex>(chunk_begin) * p_step;
+        for (std::size_t i = chunk_begin; i < chunk_end; i++, index += p_step) {
+            p_task(index);
+        }
+    }, amount_threads);
+#elif defined(PARALLEL_IMPLEMENTATION_ASYNC_POOL)
     /*
 
     Microsoft `concurrency::parallel_for` implementation does not support negative step. The cite from the documentation about `concurrency::parallel_for`.
@@ -144,14 +192,15 @@ void parallel_for(const TypeIndex p_start, const TypeIndex p_end, const TypeInde
 /*!
 
 @brief Parallelizes for-loop using all available cores.
-@details `parallel_for` uses PPL in case of Windows operating system and own implemention that is based
-on pure C++ functionality for concurency such as `std::future` and `std::async`.
+@details `parallel_for` splits the loop into chunks that are processed by the process-wide work-stealing executor,
+          the calling thread takes part in processing.
 
 Advanced uses might use one of the define to use specific implementation of the `parallel_for` loop:
-1. PARALLEL_IMPLEMENTATION_ASYNC_POOL - own parallel implementation based on `std::async` pool.
-2. PARALLEL_IMPLEMENTATION_NONE       - parallel implementation is not used.
-3. PARALLEL_IMPLEMENTATION_PPL        - parallel PPL implementation (windows system only).
-4. PARALLEL_IMPLEMENTATION_OPENMP     - parallel OpenMP implementation.
+1. PARALLEL_IMPLEMENTATION_WORK_STEALING - own parallel implementation based on persistent work-stealing executor (default).
+2. PARALLEL_IMPLEMENTATION_ASYNC_POOL    - own parallel implementation based on `std::async` pool.
+3. PARALLEL_IMPLEMENTATION_NONE          - parallel implementation is not used.
+4. PARALLEL_IMPLEMENTATION_PPL           - parallel PPL implementation (windows system only).
+5. PARALLEL_IMPLEMENTATION_OPENMP        - parallel OpenMP implementation.
 
 @param[in] p_start: initial value for the loop.
 @param[in] p_end: final value of the loop - calculations are performed until current counter value is less than final value `i < p_end`.
@@ -167,24 +216,45 @@ void parallel_for(const TypeIndex p_start, const TypeIndex p_end, const TypeActi
 /*!
 
 @brief Parallelizes for-each-loop using all available cores.
-@details `parallel_each` uses PPL in case of Windows operating system and own implemention that is based
-          on pure C++ functionality for concurency such as `std::future` and `std::async`.
+@details `parallel_for_each` splits the range into chunks that are processed by the process-wide work-stealing executor,
+          the calling thread takes part in processing.
 
 Advanced uses might use one of the define to use specific implementation of the `parallel_for_each` loop:
-1. PARALLEL_IMPLEMENTATION_ASYNC_POOL - own parallel implementation based on `std::async` pool.
-2. PARALLEL_IMPLEMENTATION_NONE       - parallel implementation is not used.
-3. PARALLEL_IMPLEMENTATION_PPL        - parallel PPL implementation (windows system only).
-4. PARALLEL_IMPLEMENTATION_OPENMP     - parallel OpenMP implementation.
+1. PARALLEL_IMPLEMENTATION_WORK_STEALING - own parallel implementation based on persistent work-stealing executor (default).
+2. PARALLEL_IMPLEMENTATION_ASYNC_POOL    - own parallel implementation based on `std::async` pool.
+3. PARALLEL_IMPLEMENTATION_NONE          - parallel implementation is not used.
+4. PARALLEL_IMPLEMENTATION_PPL           - parallel PPL implementation (windows system only).
+5. PARALLEL_IMPLEMENTATION_OPENMP        - parallel OpenMP implementation.
 
 @param[in] p_begin: initial iterator from that the loop starts.
 @param[in] p_end: end iterator that defines when the loop should stop `iter != p_end`.
 @param[in] p_task: body of the loop that defines actions that should be done for each element.
-@param[in] p_threads: amount of threads that are going to be used for processing (by default the efficient amount of threads).
+@param[in] p_threads: amount of threads that are going to be used for processing (by default `get_amount_threads()`),
+            in case of nested loops the amount of threads is limited by the outermost loop.
 
 */
 template <typename TypeIter, typename TypeAction>
-void parallel_for_each(const TypeIter p_begin, const TypeIter p_end, const TypeAction & p_task, const std::size_t p_threads = AMOUNT_THREADS) {
-#if defined(PARALLEL_IMPLEMENTATION_ASYNC_POOL)
+void parallel_for_each(const TypeIter p_begin, const TypeIter p_end, const TypeAction & p_task, const std::size_t p_threads = get_amount_threads()) {
+#if defined(PARALLEL_IMPLEMENTATION_WORK_STEALING)
+    const std::size_t interval_length = std::distance(p_begin, p_end);
+
+    if (interval_length == 0) {
+        return;
+    }
+
+    const std::size_t amount_threads = std::max(p_threads, std::size_t(1));
+    const std::size_t amount_chunks = std::min(interval_length, amount_threads * AMOUNT_CHUNKS_PER_THREAD);
+
+    work_stealing_executor::instance().execute(amount_chunks, [&p_task, p_begin, interval_length, amount_chunks](const std::size_t p_chunk) {
+        const std::size_t chunk_begin = interval_length * p_chunk / amount_chunks;
+        const std::size_t chunk_end = interval_length * (p_chunk + 1) / amount_chunks;
+
+        auto iter = p_begin + chunk_begin;
+        for (std::size_t i = chunk_begin; i < chunk_end; i++, ++iter) {
+            p_task(*iter);
+        }
+    }, amount_threads);
+#elif defined(PARALLEL_IMPLEMENTATION_ASYNC_POOL)
     const std::size_t interval_length = std::distance(p_begin, p_end);
 
     if (interval_length == 0) {
@@ -245,8 +315,8 @@ void parallel_for_each(const TypeIter p_begin, const TypeIter p_end, const TypeA
 /*!
 
 @brief Parallelizes for-each-loop using all available cores.
-@details `parallel_each` uses PPL in case of Windows operating system and own implemention that is based
-          on pure C++ functionality for concurency such as `std::future` and `std::async`.
+@details `parallel_for_each` splits the range into chunks that are processed by the process-wide work-stealing executor,
+          the calling thread takes part in processing.
 
 @param[in] p_container: iterable container that should be processed.
 @param[in] p_task: body of the loop that defines actions that should be done for each element.
@@ -13,6 +13,7 @@
 #include <deque>
 #include <vector>
 
+#include <pyclustering/parallel/concurrency.hpp>
 #include <pyclustering/parallel/thread_executor.hpp>
 
 
@@ -41,8 +42,11 @@ private:
     using thread_container = std::vector<thread_executor::ptr>;
 
 public:
-    static const std::size_t        DEFAULT_AMOUNT_THREADS;     /**< Default amount of threads. */
-    static const std::size_t        DEFAULT_POOL_SIZE;          /**< Default size of the thread pool. */
+    [[deprecated("use thread_pool::default_size()")]]
+    static const std::size_t                            DEFAULT_AMOUNT_THREADS;     /**< Deprecated amount of threads that was used when the amount of hardware threads is unknown. */
+
+    [[deprecated("use thread_pool::default_size()")]]
+    static const runtime_amount<get_amount_threads>     DEFAULT_POOL_SIZE;          /**< Deprecated default size of the thread pool, the value is equal to `default_size()`. */
 
 private:
     thread_container                m_pool  = { };
@@ -61,6 +65,7 @@ public:
     /*!
 
     @brief  Default constructor of the thread pool.
+    @details Size of the pool is equal to `default_size()`.
 
     */
     thread_pool();
@@ -95,6 +100,18 @@ public:
     */
     ~thread_pool();
 
+public:
+    /*!
+
+    @brief  Returns default size of the thread pool that is equal to the amount of threads of parallel algorithms.
+
+    @return Default size of the thread pool.
+
+    @see get_amount_threads
+
+    */
+    static std::size_t default_size();
+
 public:
     /*!
 
@@ -0,0 +1,241 @@
+/*!
+
+@authors Andrei Novikov (pyclustering@yandex.ru)
+@date 2014-2020
+@copyright BSD-3-Clause
+
+*/
+
+
+#pragma once
+
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <pyclustering/parallel/spinlock.hpp>
+
+
+namespace pyclustering {
+
+namespace parallel {
+
+
+/*!
+
+@class      work_stealing_executor work_stealing_executor.hpp pyclustering/parallel/work_stealing_executor.hpp
+
+@brief      Process-wide executor that runs chunks of parallel loops on persistent worker threads.
+@details    Each worker owns a double-ended queue of jobs: it takes jobs from the back of its own queue and
+             steals from the front of queues of other workers when its own queue is empty. Threads that are
+             not workers of the executor (for example, the thread that calls an algorithm) put jobs to the
+             shared injection queue. The thread that submits jobs does not block - it executes jobs itself
+             until all of them are completed, therefore nested parallel loops never wait for a free thread.
+             Jobs of regions whose concurrency budget is exhausted stay in queues and are skipped, so they do not
+             delay jobs of other regions that are placed behind them.
+             Worker threads are started on demand by `execute` (up to the concurrency that is requested by the
+             top-level call) and live until the executor is destroyed.
+
+@see parallel_for
+@see parallel_for_each
+
+*/
+class work_stealing_executor {
+public:
+    /*!
+
+    @brief  Defines a body of the chunked task with signature `void(const std::size_t)` where the argument is an index of a chunk.
+
+    */
+    using chunk_task = std::function<void(const std::size_t)>;
+
+public:
+    const static std::size_t    MINIMUM_THREADS;    /**< Lower bound of the amount of threads (including the calling thread) that the process-wide executor is able to run, it is used even if there are less hardware threads. */
+
+private:
+    struct concurrency_budget {
+        std::size_t                 m_limit     = 1;
+        std::atomic<std::size_t>    m_active    = { 1 };
+    };
+
+    struct job_group {
+        const chunk_task *          m_task      = nullptr;
+        concurrency_budget *        m_budget    = nullptr;
+        std::atomic<std::size_t>    m_pending   = { 0 };
+        std::exception_ptr          m_error     = nullptr;
+        spinlock                    m_error_lock;
+    };
+
+    struct job {
+        job_group *     m_group     = nullptr;
+        std::size_t     m_index     = 0;
+        bool            m_acquired  = false;
+    };
+
+    struct job_queue {
+        std::deque<job>     m_jobs;
+        spinlock            m_lock;
+    };
+
+    using job_queue_ptr = std::unique_ptr<job_queue>;
+
+private:
+    std::size_t                 m_capacity      = 0;
+    std::vector<job_queue_ptr>  m_queues        = { };
+    std::vector<std::thread>    m_workers       = { };
+    std::atomic<std::size_t>    m_started       = { 0 };
+    std::uint64_t               m_affinity      = 0;
+    std::mutex                  m_workers_mutex;
+
+    std::atomic<bool>           m_stop          = { false };
+    std::atomic<std::size_t>    m_queued        = { 0 };
+    std::atomic<std::size_t>    m_epoch         = { 0 };
+
+    std::mutex                  m_sleep_mutex;
+    std::condition_variable     m_sleep_cond;
+
+    static thread_local concurrency_budget *    s_budget;       /* budget of the region that is processed by the current thread */
+
+public:
+    /*!
+
+    @brief  Constructor of the executor with specific maximum amount of worker threads.
+    @details Worker threads are not started until they are required by `execute`.
+
+    @param[in] p_capacity: maximum amount of worker threads, the thread that calls `execute` is not counted.
+
+    */
+    explicit work_stealing_executor(const std::size_t p_capacity);
+
+    /*!
+
+    @brief  Default copy constructor of the executor.
+
+    */
+    work_stealing_executor(const work_stealing_executor & p_other) = delete;
+
+    /*!
+
+    @brief  Default move constructor of the executor.
+
+    */
+    work_stealing_executor(work_stealing_executor && p_other) = delete;
+
+    /*!
+
+    @brief  Destructor of the executor that stops and joins worker threads.
+
+    */
+    ~work_stealing_executor();
+
+public:
+    /*!
+
+    @brief  Returns process-wide instance of the executor that is used by `parallel_for` and `parallel_for_each`.
+    @details Capacity of the executor is equal to the maximum of the amount of hardware threads and `MINIMUM_THREADS`
+              (minus the calling thread), workers are started when they are required by the concurrency of a call,
+              therefore the amount of threads can be increased by `set_amount_threads` at any time.
+
+    @return Reference to the process-wide executor.
+
+    */
+    static work_stealing_executor & instance();
+
+public:
+    /*!
+
+    @brief  Executes chunks `[0; p_amount_chunks)` in parallel and returns when all of them are processed.
+    @details The calling thread takes part in processing. If any chunk throws an exception then the first
+              caught exception is rethrown after completion of the rest chunks.
+
+              The top-level call (that is performed outside of any parallel region) defines concurrency budget
+              that is shared by all nested calls made from its chunks: nested calls reuse threads that already
+              process the region, and no more than `p_concurrency` threads (including the calling thread)
+              process chunks of the region and of its nested regions at the same time. The argument is
+              ignored by nested calls. The top-level call starts worker threads that are required to reach the
+              concurrency if they have not been started yet.
+
+    @param[in] p_amount_chunks: amount of chunks that should be processed.
+    @param[in] p_task: body that is called for each chunk index.
+    @param[in] p_concurrency: maximum amount of threads that may process the region, by default it is limited only by the executor size.
+
+    */
+    void execute(const std::size_t p_amount_chunks, const chunk_task & p_task, const std::size_t p_concurrency = std::numeric_limits<std::size_t>::max());
+
+    /*!
+
+    @brief  Returns maximum amount of worker threads of the executor.
+
+    @return Maximum amount of worker threads.
+
+    */
+    std::size_t size() const;
+
+    /*!
+
+    @brief  Binds running and future worker threads of the executor to processors that are specified by the mask.
+
+    @param[in] p_mask: processor mask where bit `i` corresponds to processor `i`, `0` means any processor.
+
+    @return `true` if the affinity is supported by the system and has been applied.
+
+    */
+    bool set_affinity(const std::uint64_t p_mask);
+
+public:
+    /*!
+
+    @brief  Checks whether the current thread processes a chunk of any parallel region.
+
+    @return `true` if the current thread is inside of a parallel region.
+
+    */
+    static bool in_parallel_region();
+
+    /*!
+
+    @brief  Returns maximum amount of threads that may process the parallel region of the current thread.
+
+    @return Concurrency budget of the current parallel region, or `0` if the current thread is not inside of a parallel region.
+
+    */
+    static std::size_t region_concurrency();
+
+private:
+    void reserve(const std::size_t p_workers);
+
+    void run(const std::size_t p_worker);
+
+    bool try_get_job(const std::size_t p_queue, job & p_job);
+
+    bool try_pop_back(job_queue & p_queue, job & p_job);
+
+    bool try_pop_front(job_queue & p_queue, job & p_job);
+
+    static bool try_acquire(job & p_job, const concurrency_budget * & p_saturated);
+
+    void execute_job(const job & p_job);
+
+    void wake_up_workers();
+
+    static void execute_sequentially(const std::size_t p_amount_chunks, const chunk_task & p_task);
+
+    std::size_t get_current_queue() const;
+
+    static bool bind_thread(std::thread & p_thread, const std::uint64_t p_mask);
+};
+
+
+}
+
+}
@@ -11,6 +11,7 @@
 
 
 #include <pyclustering/definitions.hpp>
+#include <pyclustering/container/dense_dataset.hpp>
 
 #include <algorithm>
 #include <cmath>
@@ -172,13 +173,14 @@ double canberra_distance(const TypeContainer & point1, const TypeContainer & poi
     for (const auto & dim_point2 : point2) {
         const auto dim_point1 = *iter_point1;
 
+        ++iter_point1;
+
         const double divider = std::abs(dim_point1) + std::abs(dim_point2);
         if (divider == 0) {
             continue;
         }
 
         distance += std::abs(dim_point1 - dim_point2) / divider;
-        ++iter_point1;
     }
 
     return distance;
@@ -203,13 +205,14 @@ double chi_square_distance(const TypeContainer & point1, const TypeContainer & p
     for (const auto & dim_point2 : point2) {
         const auto dim_point1 = *iter_point1;
 
+        ++iter_point1;
+
         const double divider = std::abs(dim_point1) + std::abs(dim_point2);
         if (divider == 0) {
             continue;
         }
 
         distance += std::pow(dim_point1 - dim_point2, 2) / divider;
-        ++iter_point1;
     }
 
     return distance;
@@ -222,16 +225,16 @@ double chi_square_distance(const TypeContainer & point1, const TypeContainer & p
 
 @param[in] p_point1: point #1 that is represented by coordinates.
 @param[in] p_point2: point #2 that is represented by coordinates.
-@param[in] p_max_range: max range in each data dimension.
+@param[in] p_max_range: max range in each data dimension, it might be represented by another container type.
 
 @return  Returns Gower distance between points.
 
 */
-template <typename TypeContainer>
-double gower_distance(const TypeContainer & p_point1, const TypeContainer & p_point2, const TypeContainer & p_max_range) {
+template <typename TypeContainer, typename TypeRange = TypeContainer>
+double gower_distance(const TypeContainer & p_point1, const TypeContainer & p_point2, const TypeRange & p_max_range) {
     double distance = 0.0;
     typename TypeContainer::const_iterator iter_point1 = p_point1.begin();
-    typename TypeContainer::const_iterator iter_range  = p_max_range.begin();
+    typename TypeRange::const_iterator iter_range  = p_max_range.begin();
 
     for (const auto & dim_point2 : p_point2) {
         if (*iter_range != 0.0) {
@@ -246,6 +249,136 @@ double gower_distance(const TypeContainer & p_point1, const TypeContainer & p_po
 }
 
 
+/*!
+
+@brief   Defines kind of distance metric that is used to select inlined implementation of the metric.
+
+@see visit
+
+*/
+enum class metric_kind {
+    EUCLIDEAN,          /**< Euclidean distance. */
+    EUCLIDEAN_SQUARE,   /**< Square Euclidean distance. */
+    MANHATTAN,          /**< Manhattan distance. */
+    CHEBYSHEV,          /**< Chebyshev distance. */
+    MINKOWSKI,          /**< Minkowski distance. */
+    CANBERRA,           /**< Canberra distance. */
+    CHI_SQUARE,         /**< Chi square distance. */
+    GOWER,              /**< Gower distance. */
+    USER_DEFINED        /**< User-defined function that is called through `distance_functor`. */
+};
+
+
+/*!
+
+@brief   Kernel of Euclidean distance that is called directly (without `distance_functor`) and might be inlined.
+
+*/
+struct euclidean_kernel {
+    template <typename TypeContainer>
+    double operator()(const TypeContainer & p_point1, const TypeContainer & p_point2) const {
+        return euclidean_distance(p_point1, p_point2);
+    }
+};
+
+
+/*!
+
+@brief   Kernel of square Euclidean distance that is called directly and might be inlined.
+
+*/
+struct euclidean_square_kernel {
+    template <typename TypeContainer>
+    double operator()(const TypeContainer & p_point1, const TypeContainer & p_point2) const {
+        return euclidean_distance_square(p_point1, p_point2);
+    }
+};
+
+
+/*!
+
+@brief   Kernel of Manhattan distance that is called directly and might be inlined.
+
+*/
+struct manhattan_kernel {
+    template <typename TypeContainer>
+    double operator()(const TypeContainer & p_point1, const TypeContainer & p_point2) const {
+        return manhattan_distance(p_point1, p_point2);
+    }
+};
+
+
+/*!
+
+@brief   Kernel of Chebyshev distance that is called directly and might be inlined.
+
+*/
+struct chebyshev_kernel {
+    template <typename TypeContainer>
+    double operator()(const TypeContainer & p_point1, const TypeContainer & p_point2) const {
+        return chebyshev_distance(p_point1, p_point2);
+    }
+};
+
+
+/*!
+
+@brief   Kernel of Minkowski distance that is called directly and might be inlined.
+
+*/
+struct minkowski_kernel {
+    double m_degree = 2.0;    /**< Degree of Minkowski equation. */
+
+    template <typename TypeContainer>
+    double operator()(const TypeContainer & p_point1, const TypeContainer & p_point2) const {
+        return minkowski_distance(p_point1, p_point2, m_degree);
+    }
+};
+
+
+/*!
+
+@brief   Kernel of Canberra distance that is called directly and might be inlined.
+
+*/
+struct canberra_kernel {
+    template <typename TypeContainer>
+    double operator()(const TypeContainer & p_point1, const TypeContainer & p_point2) const {
+        return canberra_distance(p_point1, p_point2);
+    }
+};
+
+
+/*!
+
+@brief   Kernel of Chi square distance that is called directly and might be inlined.
+
+*/
+struct chi_square_kernel {
+    template <typename TypeContainer>
+    double operator()(const TypeContainer & p_point1, const TypeContainer & p_point2) const {
+        return chi_square_distance(p_point1, p_point2);
+    }
+};
+
+
+/*!
+
+@brief   Kernel of Gower distance that is called directly and might be inlined.
+@details The kernel refers to max ranges, therefore it should not outlive the container of ranges.
+
+*/
+template <typename TypeRange>
+struct gower_kernel {
+    const TypeRange * m_max_range = nullptr;    /**< Max range in each data dimension. */
+
+    template <typename TypeContainer>
+    double operator()(const TypeContainer & p_point1, const TypeContainer & p_point2) const {
+        return gower_distance(p_point1, p_point2, *m_max_range);
+    }
+};
+
+
 /*!
 
 @class   distance_metric metric.hpp pyclustering/utils/metric.hpp
@@ -258,6 +391,10 @@ template <typename TypeContainer>
 class distance_metric {
 protected:
     distance_functor<TypeContainer> m_functor = nullptr;    /**< Function that defines metric calculation. */
+    distance_functor<container::point_view> m_view_functor = nullptr;   /**< Function that defines metric calculation for views of points, it is not specified for user-defined metrics. */
+    metric_kind     m_kind      = metric_kind::USER_DEFINED;    /**< Kind of the metric that is used to call its kernel directly. */
+    double          m_degree    = 0.0;                          /**< Degree of Minkowski metric. */
+    TypeContainer   m_max_range = { };                          /**< Max range in each data dimension that is used by Gower metric. */
 
 public:
     /*!
@@ -278,6 +415,35 @@ public:
 
     /*!
     
+    @brief  Parameterized constructor of distance metric that is able to calculate metric for views of points
+             without copying coordinates.
+    
+    @param[in] p_functor: function that defines how to calculate distance metric.
+    @param[in] p_view_functor: function that defines how to calculate the same distance metric for views of points.
+
+    */
+    distance_metric(const distance_functor<TypeContainer> & p_functor, const distance_functor<container::point_view> & p_view_functor) :
+        m_functor(p_functor), m_view_functor(p_view_functor)
+    { }
+
+protected:
+    /*!
+
+    @brief  Constructor of built-in distance metric that is defined by its kernel.
+
+    @param[in] p_kind: kind of the metric.
+    @param[in] p_kernel: kernel that calculates the metric for points and for views of points.
+
+    */
+    template <typename TypeKernel>
+    distance_metric(const metric_kind p_kind, const TypeKernel & p_kernel) :
+        m_functor(p_kernel), m_view_functor(p_kernel), m_kind(p_kind)
+    { }
+
+public:
+
+    /*!
+    
     @brief  Default copy constructor of distance metric.
 
     @param[in] p_other: other distance metric that should be copied.
@@ -316,6 +482,59 @@ public:
         return m_functor(p_point1, p_point2);
     }
 
+    /*!
+
+    @brief   Performs calculation of distance metric between two views of points (for example, points of `dense_dataset`).
+    @details Views are passed through to the function for views of points. If the metric is user-defined without such
+              function then coordinates of both points are copied to temporary containers on each call, therefore
+              KD-tree, ball tree and grid searches never use user-defined metrics, they are applied by brute force.
+
+    @param[in] p_point1: the first point view.
+    @param[in] p_point2: the second point view.
+
+    @return  Calculated distance between two points.
+
+    */
+    double operator()(const container::point_view & p_point1, const container::point_view & p_point2) const {
+        if (m_view_functor) {
+            return m_view_functor(p_point1, p_point2);
+        }
+
+        static thread_local TypeContainer point1, point2;
+        point1.assign(p_point1.begin(), p_point1.end());
+        point2.assign(p_point2.begin(), p_point2.end());
+
+        return m_functor(point1, point2);
+    }
+
+public:
+    /*!
+
+    @brief  Returns kind of the distance metric.
+
+    @return Kind of the metric, `metric_kind::USER_DEFINED` if the metric is defined by a user function.
+
+    */
+    metric_kind kind() const { return m_kind; }
+
+    /*!
+
+    @brief  Returns degree of Minkowski distance metric.
+
+    @return Degree of the metric if it is Minkowski metric, otherwise `0`.
+
+    */
+    double degree() const { return m_degree; }
+
+    /*!
+
+    @brief  Returns max range in each data dimension of Gower distance metric.
+
+    @return Max ranges if it is Gower metric, otherwise an empty container.
+
+    */
+    const TypeContainer & max_range() const { return m_max_range; }
+
 public:
     /*!
     
@@ -341,6 +560,10 @@ public:
     distance_metric<TypeContainer>& operator=(const distance_metric<TypeContainer>& p_other) {
         if (this != &p_other) {
             m_functor = p_other.m_functor;
+            m_view_functor = p_other.m_view_functor;
+            m_kind = p_other.m_kind;
+            m_degree = p_other.m_degree;
+            m_max_range = p_other.m_max_range;
         }
 
         return *this;
@@ -366,7 +589,7 @@ public:
     
     */
     euclidean_distance_metric() :
-        distance_metric<TypeContainer>(std::bind(euclidean_distance<TypeContainer>, std::placeholders::_1, std::placeholders::_2))
+        distance_metric<TypeContainer>(metric_kind::EUCLIDEAN, euclidean_kernel())
     { }
 };
 
@@ -389,7 +612,7 @@ public:
 
     */
     euclidean_distance_square_metric() :
-        distance_metric<TypeContainer>(std::bind(euclidean_distance_square<TypeContainer>, std::placeholders::_1, std::placeholders::_2))
+        distance_metric<TypeContainer>(metric_kind::EUCLIDEAN_SQUARE, euclidean_square_kernel())
     { }
 };
 
@@ -412,7 +635,7 @@ public:
 
     */
     manhattan_distance_metric() :
-        distance_metric<TypeContainer>(std::bind(manhattan_distance<TypeContainer>, std::placeholders::_1, std::placeholders::_2))
+        distance_metric<TypeContainer>(metric_kind::MANHATTAN, manhattan_kernel())
     { }
 };
 
@@ -438,7 +661,7 @@ public:
     
     */
     chebyshev_distance_metric() :
-        distance_metric<TypeContainer>(std::bind(chebyshev_distance<TypeContainer>, std::placeholders::_1, std::placeholders::_2))
+        distance_metric<TypeContainer>(metric_kind::CHEBYSHEV, chebyshev_kernel())
     { }
 };
 
@@ -463,8 +686,10 @@ public:
 
     */
     explicit minkowski_distance_metric(const double p_degree) :
-        distance_metric<TypeContainer>(std::bind(minkowski_distance<TypeContainer>, std::placeholders::_1, std::placeholders::_2, p_degree))
-    { }
+        distance_metric<TypeContainer>(metric_kind::MINKOWSKI, minkowski_kernel{ p_degree })
+    {
+        this->m_degree = p_degree;
+    }
 };
 
 
@@ -486,7 +711,7 @@ public:
 
     */
     canberra_distance_metric() :
-        distance_metric<TypeContainer>(std::bind(canberra_distance<TypeContainer>, std::placeholders::_1, std::placeholders::_2))
+        distance_metric<TypeContainer>(metric_kind::CANBERRA, canberra_kernel())
     { }
 };
 
@@ -509,7 +734,7 @@ public:
 
     */
     chi_square_distance_metric() :
-        distance_metric<TypeContainer>(std::bind(chi_square_distance<TypeContainer>, std::placeholders::_1, std::placeholders::_2))
+        distance_metric<TypeContainer>(metric_kind::CHI_SQUARE, chi_square_kernel())
     { }
 };
 
@@ -543,8 +768,12 @@ public:
 
     */
     explicit gower_distance_metric(const TypeContainer & p_max_range) :
-        distance_metric<TypeContainer>(std::bind(gower_distance<TypeContainer>, std::placeholders::_1, std::placeholders::_2, p_max_range))
-    { }
+        distance_metric<TypeContainer>(metric_kind::GOWER, [p_max_range](const auto & p_point1, const auto & p_point2) {
+            return gower_distance(p_point1, p_point2, p_max_range);
+        })
+    {
+        this->m_max_range = p_max_range;
+    }
 };
 
 
@@ -662,9 +891,89 @@ public:
     static distance_metric<TypeContainer> user_defined(const distance_functor<TypeContainer> & p_functor) {
         return distance_metric<TypeContainer>(p_functor);
     }
+
+    /*!
+
+    @brief   Creates user-defined distance metric that is able to calculate distance between views of points without copying them.
+
+    @param[in] p_functor: user-defined metric for calculation distance between two points.
+    @param[in] p_view_functor: the same user-defined metric for calculation distance between two views of points.
+
+    @return  User-defined distance metric.
+
+    */
+    static distance_metric<TypeContainer> user_defined(const distance_functor<TypeContainer> & p_functor, const distance_functor<container::point_view> & p_view_functor) {
+        return distance_metric<TypeContainer>(p_functor, p_view_functor);
+    }
 };
 
 
+/*!
+
+@brief   Kernel of user-defined distance metric that calls the metric through its function.
+
+*/
+template <typename TypeMetricContainer>
+struct user_defined_kernel {
+    const distance_metric<TypeMetricContainer> * m_metric = nullptr;    /**< Metric that is called. */
+
+    template <typename TypeContainer>
+    double operator()(const TypeContainer & p_point1, const TypeContainer & p_point2) const {
+        return (*m_metric)(p_point1, p_point2);
+    }
+};
+
+
+/*!
+
+@brief   Calls the visitor with the kernel that corresponds to the kind of the distance metric.
+@details The kernel of a built-in metric is a plain function object, therefore if the visitor is a template
+          (for example, a generic lambda) then distance calculation is inlined into the body of the visitor.
+          The dispatch is performed once per call, so it should be placed outside of loops over points:
+@code
+    const double total = visit(metric, [&points](const auto & p_distance) {
+        double sum = 0.0;
+        for (std::size_t i = 1; i < points.size(); i++) {
+            sum += p_distance(points[i - 1], points[i]);
+        }
+        return sum;
+    });
+@endcode
+
+          User-defined metrics are called through `distance_functor` by `user_defined_kernel`. Kernels that are
+          provided for Gower and user-defined metrics refer to the metric, therefore they should not outlive it.
+
+@param[in] p_metric: distance metric whose kernel should be passed to the visitor.
+@param[in] p_visitor: callable object that accepts any kernel.
+
+@return  Value that is returned by the visitor.
+
+*/
+template <typename TypeContainer, typename TypeVisitor>
+auto visit(const distance_metric<TypeContainer> & p_metric, TypeVisitor && p_visitor) -> decltype(p_visitor(euclidean_kernel())) {
+    switch (p_metric.kind()) {
+    case metric_kind::EUCLIDEAN:
+        return p_visitor(euclidean_kernel());
+    case metric_kind::EUCLIDEAN_SQUARE:
+        return p_visitor(euclidean_square_kernel());
+    case metric_kind::MANHATTAN:
+        return p_visitor(manhattan_kernel());
+    case metric_kind::CHEBYSHEV:
+        return p_visitor(chebyshev_kernel());
+    case metric_kind::MINKOWSKI:
+        return p_visitor(minkowski_kernel{ p_metric.degree() });
+    case metric_kind::CANBERRA:
+        return p_visitor(canberra_kernel());
+    case metric_kind::CHI_SQUARE:
+        return p_visitor(chi_square_kernel());
+    case metric_kind::GOWER:
+        return p_visitor(gower_kernel<TypeContainer>{ &p_metric.max_range() });
+    default:
+        return p_visitor(user_defined_kernel<TypeContainer>{ &p_metric });
+    }
+}
+
+
 /*!
 
 @brief   Returns average distance for establish links between specified number of neighbors.
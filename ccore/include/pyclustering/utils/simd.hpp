@@ -0,0 +1,176 @@
+/*!
+
+@authors Andrei Novikov (pyclustering@yandex.ru)
+@date 2014-2020
+@copyright BSD-3-Clause
+
+*/
+
+
+#pragma once
+
+
+#include <cstddef>
+
+#include <pyclustering/container/dense_dataset.hpp>
+#include <pyclustering/utils/metric.hpp>
+
+
+namespace pyclustering {
+
+namespace utils {
+
+namespace simd {
+
+
+/*!
+
+@brief   Defines instruction set that is used by vectorized distance kernels.
+
+*/
+enum class instruction_set {
+    SCALAR,     /**< Portable implementation without explicit vector instructions. */
+    NEON,       /**< ARM Advanced SIMD (AArch64). */
+    AVX2,       /**< x86 AVX2 with FMA. */
+    AVX512      /**< x86 AVX-512 Foundation. */
+};
+
+
+/*!
+
+@brief   Returns the best instruction set that is supported by the processor and by the library build.
+@details The processor is examined once (using CPUID on x86), therefore the same library binary might be used
+          on processors with different instruction sets.
+
+@return  The best supported instruction set.
+
+*/
+instruction_set get_supported_instruction_set();
+
+
+/*!
+
+@brief   Returns instruction set that is currently used by distance kernels.
+
+@return  Instruction set of distance kernels, by default it is the best supported one.
+
+*/
+instruction_set get_instruction_set();
+
+
+/*!
+
+@brief   Changes instruction set that is used by distance kernels, for example, to compare implementations.
+
+@param[in] p_set: instruction set that should be used.
+
+@return  `true` if the instruction set is supported and has been applied, otherwise the current one is not changed.
+
+*/
+bool set_instruction_set(const instruction_set p_set);
+
+
+/*!
+
+@brief   Checks whether the metric has vectorized kernels.
+@details Vectorized kernels are provided for Euclidean, square Euclidean, Manhattan, Chebyshev and Canberra metrics.
+
+@param[in] p_kind: kind of distance metric.
+
+@return  `true` if the metric is supported by functions of this module.
+
+*/
+bool is_supported(const metric::metric_kind p_kind);
+
+
+/*!
+
+@brief   Calculates distance between two points.
+
+@param[in] p_kind: kind of distance metric, `std::invalid_argument` is thrown if it is not supported.
+@param[in] p_point1: coordinates of the first point.
+@param[in] p_point2: coordinates of the second point.
+@param[in] p_dimension: amount of coordinates of each point.
+
+@return  Distance between points.
+
+*/
+template <typename TypeValue>
+TypeValue distance(const metric::metric_kind p_kind, const TypeValue * p_point1, const TypeValue * p_point2, const std::size_t p_dimension);
+
+
+/*!
+
+@brief   Calculates distances from the point to each of row-major points (one-to-many).
+
+@param[in]  p_kind: kind of distance metric, `std::invalid_argument` is thrown if it is not supported.
+@param[in]  p_point: coordinates of the point.
+@param[in]  p_points: coordinates of the first of other points.
+@param[in]  p_amount: amount of other points.
+@param[in]  p_dimension: amount of coordinates of each point.
+@param[in]  p_stride: distance in elements between beginnings of two neighbour points.
+@param[out] p_result: buffer for `p_amount` distances.
+
+*/
+template <typename TypeValue>
+void distance(const metric::metric_kind p_kind, const TypeValue * p_point, const TypeValue * p_points, const std::size_t p_amount,
+    const std::size_t p_dimension, const std::size_t p_stride, TypeValue * p_result);
+
+
+/*!
+
+@brief   Calculates distances between each point of the first set and each point of the second set (many-to-many).
+
+@param[in]  p_kind: kind of distance metric, `std::invalid_argument` is thrown if it is not supported.
+@param[in]  p_points1: coordinates of the first point of the first set.
+@param[in]  p_amount1: amount of points in the first set.
+@param[in]  p_stride1: distance in elements between beginnings of two neighbour points of the first set.
+@param[in]  p_points2: coordinates of the first point of the second set.
+@param[in]  p_amount2: amount of points in the second set.
+@param[in]  p_stride2: distance in elements between beginnings of two neighbour points of the second set.
+@param[in]  p_dimension: amount of coordinates of each point.
+@param[out] p_result: row-major buffer for `p_amount1 x p_amount2` distances.
+
+*/
+template <typename TypeValue>
+void distance_matrix(const metric::metric_kind p_kind,
+    const TypeValue * p_points1, const std::size_t p_amount1, const std::size_t p_stride1,
+    const TypeValue * p_points2, const std::size_t p_amount2, const std::size_t p_stride2,
+    const std::size_t p_dimension, TypeValue * p_result);
+
+
+/*!
+
+@brief   Calculates distances from the point to each point of the dense dataset (one-to-many).
+
+@param[in]  p_kind: kind of distance metric, `std::invalid_argument` is thrown if it is not supported.
+@param[in]  p_point: point whose dimension is equal to the dimension of the dataset.
+@param[in]  p_data: points of the dataset.
+@param[out] p_result: buffer for `p_data.size()` distances.
+
+*/
+inline void distance(const metric::metric_kind p_kind, const container::point_view & p_point, const container::dense_dataset_view & p_data, double * p_result) {
+    distance(p_kind, p_point.data(), p_data.data(), p_data.size(), p_data.dimension(), p_data.stride(), p_result);
+}
+
+
+/*!
+
+@brief   Calculates distances between each point of the first dense dataset and each point of the second (many-to-many).
+
+@param[in]  p_kind: kind of distance metric, `std::invalid_argument` is thrown if it is not supported.
+@param[in]  p_data1: points of the first dataset.
+@param[in]  p_data2: points of the second dataset with the same dimension.
+@param[out] p_result: row-major buffer for `p_data1.size() x p_data2.size()` distances.
+
+*/
+inline void distance_matrix(const metric::metric_kind p_kind, const container::dense_dataset_view & p_data1, const container::dense_dataset_view & p_data2, double * p_result) {
+    distance_matrix(p_kind, p_data1.data(), p_data1.size(), p_data1.stride(), p_data2.data(), p_data2.size(), p_data2.stride(), p_data1.dimension(), p_result);
+}
+
+
+}
+
+}
+
+}
@@ -0,0 +1,260 @@
+/*!
+
+@authors Andrei Novikov (pyclustering@yandex.ru)
+@date 2014-2020
+@copyright BSD-3-Clause
+
+*/
+
+
+#include <pyclustering/cluster/blocked_assignment.hpp>
+
+#include <algorithm>
+#include <limits>
+
+
+using namespace pyclustering::utils::metric;
+
+
+namespace pyclustering {
+
+namespace clst {
+
+
+constexpr std::size_t blocked_assignment::POINT_BLOCK;
+constexpr std::size_t blocked_assignment::TILE_POINTS;
+constexpr std::size_t blocked_assignment::TILE_CENTERS;
+
+
+/* Distances that are less than this part of sum of square norms are calculated directly, because the expansion
+   loses precision for points that are close to centers. */
+static const double DIRECT_DISTANCE_RATIO = 1e-8;
+
+
+/* Bound of rounding error of the expansion for each coordinate relatively to sum of square norms. */
+static const double EXPANSION_ERROR_RATIO = 4.0 * std::numeric_limits<double>::epsilon();
+
+
+blocked_assignment::blocked_assignment(const dataset & p_centers) :
+    m_amount_centers(p_centers.size()),
+    m_dimension(p_centers.empty() ? 0 : p_centers.front().size()),
+    m_centers(p_centers)
+{
+    const std::size_t amount_panels = (m_amount_centers + TILE_CENTERS - 1) / TILE_CENTERS;
+
+    m_panels.assign(amount_panels * TILE_CENTERS * m_dimension, 0.0);
+    m_center_norms.assign(amount_panels * TILE_CENTERS, std::numeric_limits<double>::infinity());
+
+    for (std::size_t index_center = 0; index_center < m_amount_centers; index_center++) {
+        const point & center = p_centers[index_center];
+        double * panel = m_panels.data() + (index_center / TILE_CENTERS) * TILE_CENTERS * m_dimension;
+
+        double norm = 0.0;
+        for (std::size_t dimension = 0; dimension < m_dimension; dimension++) {
+            panel[dimension * TILE_CENTERS + index_center % TILE_CENTERS] = center[dimension];
+            norm += center[dimension] * center[dimension];
+        }
+
+        m_center_norms[index_center] = norm;
+    }
+}
+
+
+bool blocked_assignment::is_applicable(const distance_metric<point> & p_metric) {
+    return (p_metric.kind() == metric_kind::EUCLIDEAN) || (p_metric.kind() == metric_kind::EUCLIDEAN_SQUARE);
+}
+
+
+/* Keeps the nearest center for each point of the block, the first center wins in case of equal distances.
+   Distances are compared with their error bounds, centers that could not be distinguished by the expansion
+   (for example, points that are far from the origin) are compared by direct calculation. */
+struct nearest_center_consumer {
+    const dataset &         m_centers;
+    const double * const *  m_rows;
+    std::size_t             m_dimension;
+    double                  m_error_ratio;
+
+    double          m_distance[blocked_assignment::POINT_BLOCK];
+    double          m_error[blocked_assignment::POINT_BLOCK];
+    std::size_t     m_center[blocked_assignment::POINT_BLOCK];
+
+    nearest_center_consumer(const dataset & p_centers, const double * const * p_rows, const std::size_t p_amount, const std::size_t p_dimension) :
+        m_centers(p_centers),
+        m_rows(p_rows),
+        m_dimension(p_dimension),
+        m_error_ratio(EXPANSION_ERROR_RATIO * static_cast<double>(p_dimension + 2))
+    {
+        std::fill(m_distance, m_distance + p_amount, std::numeric_limits<double>::max());
+        std::fill(m_error, m_error + p_amount, 0.0);
+        std::fill(m_center, m_center + p_amount, std::size_t(0));
+    }
+
+    void operator()(const std::size_t p_index_point, const std::size_t p_index_center, const double p_distance, const double p_scale) {
+        const double error = m_error_ratio * p_scale;
+        const double best_distance = m_distance[p_index_point];
+        const double best_error = m_error[p_index_point];
+
+        if (p_distance - error >= best_distance + best_error) {
+            return;     /* the center is not closer even if both distances have maximum error */
+        }
+
+        if (p_distance + error < best_distance - best_error) {
+            m_distance[p_index_point] = p_distance;
+            m_error[p_index_point] = error;
+            m_center[p_index_point] = p_index_center;
+            return;
+        }
+
+        const container::point_view point(m_rows[p_index_point], m_dimension);
+        const double distance = euclidean_distance_square(point, container::point_view(m_centers[p_index_center]));
+        if (best_error > 0.0) {
+            m_distance[p_index_point] = euclidean_distance_square(point, container::point_view(m_centers[m_center[p_index_point]]));
+            m_error[p_index_point] = 0.0;
+        }
+
+        if (distance < m_distance[p_index_point]) {
+            m_distance[p_index_point] = distance;
+            m_center[p_index_point] = p_index_center;
+        }
+    }
+};
+
+
+void blocked_assignment::assign(const container::dense_dataset_view & p_data, const std::size_t p_begin, const std::size_t p_end, index_sequence & p_labels) const {
+    const double * rows[POINT_BLOCK];
+
+    for (std::size_t block_begin = p_begin; block_begin < p_end; block_begin += POINT_BLOCK) {
+        const std::size_t amount = std::min(POINT_BLOCK, p_end - block_begin);
+        for (std::size_t i = 0; i < amount; i++) {
+            rows[i] = p_data.row(block_begin + i);
+        }
+
+        nearest_center_consumer consumer(m_centers, rows, amount, m_dimension);
+        process_block(rows, amount, consumer);
+
+        std::copy(consumer.m_center, consumer.m_center + amount, p_labels.begin() + block_begin);
+    }
+}
+
+
+void blocked_assignment::assign(const container::dense_dataset_view & p_data, const index_sequence & p_indexes, const std::size_t p_begin, const std::size_t p_end, index_sequence & p_labels) const {
+    const double * rows[POINT_BLOCK];
+
+    for (std::size_t block_begin = p_begin; block_begin < p_end; block_begin += POINT_BLOCK) {
+        const std::size_t amount = std::min(POINT_BLOCK, p_end - block_begin);
+        for (std::size_t i = 0; i < amount; i++) {
+            rows[i] = p_data.row(p_indexes[block_begin + i]);
+        }
+
+        nearest_center_consumer consumer(m_centers, rows, amount, m_dimension);
+        process_block(rows, amount, consumer);
+
+        for (std::size_t i = 0; i < amount; i++) {
+            p_labels[p_indexes[block_begin + i]] = consumer.m_center[i];
+        }
+    }
+}
+
+
+void blocked_assignment::distances(const container::dense_dataset_view & p_data, const std::size_t p_begin, const std::size_t p_end, double * p_result) const {
+    const double * rows[POINT_BLOCK];
+
+    for (std::size_t block_begin = p_begin; block_begin < p_end; block_begin += POINT_BLOCK) {
+        const std::size_t amount = std::min(POINT_BLOCK, p_end - block_begin);
+        for (std::size_t i = 0; i < amount; i++) {
+            rows[i] = p_data.row(block_begin + i);
+        }
+
+        double * block_result = p_result + (block_begin - p_begin) * m_amount_centers;
+
+        auto consumer = [this, &rows, block_result](const std::size_t p_index_point, const std::size_t p_index_center, const double p_distance, const double p_scale) {
+            double distance = p_distance;
+            if (distance <= DIRECT_DISTANCE_RATIO * p_scale) {
+                distance = euclidean_distance_square(container::point_view(rows[p_index_point], m_dimension), container::point_view(m_centers[p_index_center]));
+            }
+
+            block_result[p_index_point * m_amount_centers + p_index_center] = distance;
+        };
+
+        process_block(rows, amount, consumer);
+    }
+}
+
+
+std::size_t blocked_assignment::size() const {
+    return m_amount_centers;
+}
+
+
+template <typename TypeConsumer>
+void blocked_assignment::process_block(const double * const * p_rows, const std::size_t p_amount, TypeConsumer & p_consumer) const {
+    double point_norms[POINT_BLOCK];
+    for (std::size_t i = 0; i < p_amount; i++) {
+        double norm = 0.0;
+        for (std::size_t dimension = 0; dimension < m_dimension; dimension++) {
+            norm += p_rows[i][dimension] * p_rows[i][dimension];
+        }
+
+        point_norms[i] = norm;
+    }
+
+    const std::size_t amount_panels = (m_amount_centers + TILE_CENTERS - 1) / TILE_CENTERS;
+    for (std::size_t index_panel = 0; index_panel < amount_panels; index_panel++) {
+        const double * panel = m_panels.data() + index_panel * TILE_CENTERS * m_dimension;
+        const std::size_t center_begin = index_panel * TILE_CENTERS;
+        const std::size_t center_amount = std::min(TILE_CENTERS, m_amount_centers - center_begin);
+
+        const auto consume_products = [this, &p_consumer, &point_norms, center_begin, center_amount](const std::size_t p_index_point, const double * p_products) {
+            for (std::size_t j = 0; j < center_amount; j++) {
+                const double center_norm = m_center_norms[center_begin + j];
+                const double distance = point_norms[p_index_point] - 2.0 * p_products[j] + center_norm;
+
+                p_consumer(p_index_point, center_begin + j, std::max(distance, 0.0), point_norms[p_index_point] + center_norm);
+            }
+        };
+
+        std::size_t index_point = 0;
+        for (; index_point + TILE_POINTS <= p_amount; index_point += TILE_POINTS) {
+            double products[TILE_POINTS][TILE_CENTERS];
+            multiply_tile<TILE_POINTS>(p_rows + index_point, panel, products);
+
+            for (std::size_t i = 0; i < TILE_POINTS; i++) {
+                consume_products(index_point + i, products[i]);
+            }
+        }
+
+        for (; index_point < p_amount; index_point++) {
+            double products[1][TILE_CENTERS];
+            multiply_tile<1>(p_rows + index_point, panel, products);
+
+            consume_products(index_point, products[0]);
+        }
+    }
+}
+
+
+template <std::size_t Rows>
+void blocked_assignment::multiply_tile(const double * const * p_rows, const double * p_panel, double (&p_products)[Rows][TILE_CENTERS]) const {
+    /* micro-kernel: `Rows x TILE_CENTERS` accumulators are kept in registers while the panel is streamed */
+    double accumulators[Rows][TILE_CENTERS] = { };
+
+    for (std::size_t dimension = 0; dimension < m_dimension; dimension++) {
+        const double * centers = p_panel + dimension * TILE_CENTERS;
+
+        for (std::size_t i = 0; i < Rows; i++) {
+            const double coordinate = p_rows[i][dimension];
+            for (std::size_t j = 0; j < TILE_CENTERS; j++) {
+                accumulators[i][j] += coordinate * centers[j];
+            }
+        }
+    }
+
+    for (std::size_t i = 0; i < Rows; i++) {
+        std::copy(accumulators[i], accumulators[i] + TILE_CENTERS, p_products[i]);
+    }
+}
+
+
+}
+
+}
@@ -299,12 +299,13 @@ void cure_queue::merge(cure_cluster * cluster1, cure_cluster * cluster2, const s
                     cure_cluster * nearest_cluster = nullptr;
                     double nearest_distance = std::numeric_limits<double>::max();
 
+                    kdtree_searcher searcher;
+                    std::vector<double> nearest_node_distances;
+                    std::vector<kdnode::ptr> nearest_nodes;
+
                     for (auto & point : *(cluster->rep)) {
                         /* we are using Eucliean Square metric, but kdtree searcher requires common Eucliean distance (but output results are square) */
-                        kdtree_searcher searcher(*point, tree->get_root(), real_euclidean_distance);
-
-                        std::vector<double> nearest_node_distances;
-                        std::vector<kdnode::ptr> nearest_nodes;
+                        searcher.initialize(*point, tree->get_root(), real_euclidean_distance);
                         searcher.find_nearest_nodes(nearest_node_distances, nearest_nodes);
 
                         for (std::size_t index = 0; index < nearest_nodes.size(); index++) {
@@ -375,9 +376,14 @@ void cure_queue::remove_representative_points(cure_cluster * cluster) {
 
 
 void cure_queue::insert_representative_points(cure_cluster * cluster) {
+    dataset points;
+    points.reserve(cluster->rep->size());
+
     for (auto & point : *(cluster->rep)) {
-        tree->insert(*point, cluster);
+        points.push_back(*point);
     }
+
+    tree->insert(points, std::vector<void *>(points.size(), cluster));
 }
 
 
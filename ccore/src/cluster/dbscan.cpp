@@ -9,10 +9,15 @@
 
 #include <pyclustering/cluster/dbscan.hpp>
 
+#include <pyclustering/container/concurrent_disjoint_set.hpp>
+#include <pyclustering/parallel/parallel.hpp>
+
+#include <limits>
 #include <string>
 #include <unordered_set>
 
-#include <pyclustering/container/kdtree_searcher.hpp>
+
+using namespace pyclustering::parallel;
 
 
 namespace pyclustering {
@@ -20,13 +25,14 @@ namespace pyclustering {
 namespace clst {
 
 
-dbscan::dbscan(const double p_radius_connectivity, const size_t p_minimum_neighbors) :
-        m_data_ptr(nullptr),
+dbscan::dbscan(const double p_radius_connectivity, const size_t p_minimum_neighbors, const distance_metric<point> & p_metric, const dbscan_engine p_engine) :
         m_result_ptr(nullptr),
         m_visited(std::vector<bool>()),
         m_belong(std::vector<bool>()),
         m_initial_radius(p_radius_connectivity),
-        m_neighbors(p_minimum_neighbors)
+        m_neighbors(p_minimum_neighbors),
+        m_metric(p_metric),
+        m_engine(p_engine)
 { }
 
 
@@ -36,41 +42,76 @@ void dbscan::process(const dataset & p_data, dbscan_data & p_result) {
 
 
 void dbscan::process(const dataset & p_data, const data_t p_type, dbscan_data & p_result) {
-    m_data_ptr  = &p_data;
-    m_type      = p_type;
+    process(container::dense_dataset(p_data), p_type, p_result);
+}
 
-    if (m_type == data_t::POINTS) {
-        create_kdtree(*m_data_ptr);
+
+void dbscan::process(const container::dense_dataset_view & p_data, const data_t p_type, dbscan_data & p_result) {
+    const bool is_grid = (p_type == data_t::POINTS) && (m_engine == dbscan_engine::GRID) &&
+        (m_metric.kind() == metric_kind::EUCLIDEAN) && dbscan_grid::is_applicable(p_data, m_initial_radius);
+
+    if (is_grid) {
+        dbscan_grid(m_initial_radius, m_neighbors).process(p_data, p_result);
+        return;
     }
 
-    m_visited = std::vector<bool>(m_data_ptr->size(), false);
-    m_belong = m_visited;
+    m_data      = p_data;
+    m_type      = p_type;
 
     m_result_ptr = &p_result;
 
-    for (size_t i = 0; i < m_data_ptr->size(); i++) {
-        if (m_visited[i]) {
-            continue;
+    if (m_engine == dbscan_engine::PARALLEL) {
+        switch(m_type) {
+        case data_t::POINTS:
+            create_neighborhoods(m_data);
+            break;
+
+        case data_t::DISTANCE_MATRIX:
+            create_neighborhoods_from_distance_matrix(m_data);
+            break;
+
+        default:
+            throw std::invalid_argument("Incorrect input data type is specified '" + std::to_string((unsigned) m_type) + "'");
+        }
+
+        allocate_clusters_parallel();
+    }
+    else {
+        if (m_type == data_t::POINTS) {
+            create_neighborhoods(m_data);
         }
 
-        m_visited[i] = true;
+        m_visited = std::vector<bool>(m_data.size(), false);
+        m_belong = m_visited;
+        m_stamps.assign(m_data.size(), 0);
+
+        for (size_t i = 0; i < m_data.size(); i++) {
+            if (m_visited[i]) {
+                continue;
+            }
+
+            m_visited[i] = true;
 
-        /* expand cluster */
-        cluster allocated_cluster;
-        expand_cluster(i, allocated_cluster);
+            /* expand cluster */
+            cluster allocated_cluster;
+            expand_cluster(i, allocated_cluster);
 
-        if (!allocated_cluster.empty()) {
-            m_result_ptr->clusters().emplace_back(std::move(allocated_cluster));
+            if (!allocated_cluster.empty()) {
+                m_result_ptr->clusters().emplace_back(std::move(allocated_cluster));
+            }
         }
-    }
 
-    for (size_t i = 0; i < m_data_ptr->size(); i++) {
-        if (!m_belong[i]) {
-            m_result_ptr->noise().emplace_back(i);
+        for (size_t i = 0; i < m_data.size(); i++) {
+            if (!m_belong[i]) {
+                m_result_ptr->noise().emplace_back(i);
+            }
         }
     }
 
-    m_data_ptr = nullptr;
+    m_data = { };
+    m_stamps = { };
+    m_neighbor_buffer = { };
+    m_neighborhoods.clear();
     m_result_ptr = nullptr;
 }
 
@@ -83,6 +124,13 @@ void dbscan::expand_cluster(const std::size_t p_index, cluster & allocated_clust
         allocated_cluster.push_back(p_index);
         m_belong[p_index] = true;
 
+        /* the queue is traversed in breadth-first order, stamps of queued points are unique for each expansion */
+        const std::size_t stamp = p_index + 1;
+        m_stamps[p_index] = stamp;
+        for (const auto index_neighbor : index_matrix_neighbors) {
+            m_stamps[index_neighbor] = stamp;
+        }
+
         for (std::size_t k = 0; k < index_matrix_neighbors.size(); k++) {
             std::size_t index_neighbor = index_matrix_neighbors[k];
 
@@ -90,16 +138,14 @@ void dbscan::expand_cluster(const std::size_t p_index, cluster & allocated_clust
                 m_visited[index_neighbor] = true;
 
                 /* check for neighbors of the current neighbor - maybe it's noise */
-                std::vector<size_t> neighbor_neighbor_indexes;
-                get_neighbors(index_neighbor, neighbor_neighbor_indexes);
-                if (neighbor_neighbor_indexes.size() >= m_neighbors) {
-
-                    /* Add neighbors of the neighbor for checking */
-                    for (auto neighbor_index : neighbor_neighbor_indexes) {
-                        /* Check if some of neighbors already in check list */
-                        std::vector<std::size_t>::const_iterator position = std::find(index_matrix_neighbors.begin(), index_matrix_neighbors.end(), neighbor_index);
-                        if (position == index_matrix_neighbors.end()) {
-                            /* Add neighbor if it does not exist in the list */
+                m_neighbor_buffer.clear();
+                get_neighbors(index_neighbor, m_neighbor_buffer);
+                if (m_neighbor_buffer.size() >= m_neighbors) {
+
+                    /* Add neighbors of the neighbor for checking if they have not been queued yet */
+                    for (auto neighbor_index : m_neighbor_buffer) {
+                        if (m_stamps[neighbor_index] != stamp) {
+                            m_stamps[neighbor_index] = stamp;
                             index_matrix_neighbors.push_back(neighbor_index);
                         }
                     }
@@ -111,8 +157,6 @@ void dbscan::expand_cluster(const std::size_t p_index, cluster & allocated_clust
                 m_belong[index_neighbor] = true;
             }
         }
-
-        index_matrix_neighbors.clear();
     }
 }
 
@@ -134,17 +178,17 @@ void dbscan::get_neighbors(const size_t p_index, std::vector<size_t> & p_neighbo
 
 
 void dbscan::get_neighbors_from_points(const size_t p_index, std::vector<size_t> & p_neighbors) {
-    container::kdtree_searcher searcher((*m_data_ptr)[p_index], m_kdtree.get_root(), m_initial_radius);
-    searcher.find_nearest([&p_index, &p_neighbors](const container::kdnode::ptr & node, const double distance) {
-            if (p_index != (std::size_t) node->get_payload()) {
-                p_neighbors.push_back((std::size_t) node->get_payload());
-            }
-        });
+    const std::size_t * neighbors = m_neighborhoods.neighbors(p_index);
+    for (std::size_t i = 0; i < m_neighborhoods.amount_neighbors(p_index); i++) {
+        if (p_index != neighbors[i]) {
+            p_neighbors.push_back(neighbors[i]);
+        }
+    }
 }
 
 
 void dbscan::get_neighbors_from_distance_matrix(const size_t p_index, std::vector<size_t> & p_neighbors) {
-    const auto & distances = m_data_ptr->at(p_index);
+    const container::point_view distances = m_data[p_index];
     for (std::size_t index_neighbor = 0; index_neighbor < distances.size(); index_neighbor++) {
         const double candidate_distance = distances[index_neighbor];
         if ( (candidate_distance <= m_initial_radius) && (index_neighbor != p_index) ) {
@@ -154,13 +198,118 @@ void dbscan::get_neighbors_from_distance_matrix(const size_t p_index, std::vecto
 }
 
 
-void dbscan::create_kdtree(const dataset & p_data) {
-    std::vector<void *> payload(p_data.size());
-    for (std::size_t index = 0; index < p_data.size(); index++) {
-        payload[index] = (void *)index;
+void dbscan::create_neighborhoods(const container::dense_dataset_view & p_data) {
+    /* clusters are formed only by indexes of neighbors, so distances to them are not stored */
+    if (m_metric.kind() == metric_kind::EUCLIDEAN) {
+        m_kdtree = container::kdtree_flat(p_data);
+        m_kdtree.find_nearest(m_initial_radius, m_neighborhoods, false);
+    }
+    else if (container::ball_tree::is_applicable(m_metric)) {
+        m_ball_tree = container::ball_tree(p_data, m_metric);
+        m_ball_tree.find_nearest(m_initial_radius, m_neighborhoods, false);
+    }
+    else {
+        /* the tree might lose neighbors if the metric does not satisfy the triangle inequality */
+        visit(m_metric, [this, &p_data](const auto & p_distance) {
+            m_neighborhoods.assign(p_data.size(), [this, &p_data, &p_distance](const std::size_t p_index, std::vector<std::size_t> & p_neighbors, std::vector<double> &) {
+                const container::point_view point = p_data[p_index];
+                for (std::size_t index_neighbor = 0; index_neighbor < p_data.size(); index_neighbor++) {
+                    if (p_distance(point, p_data[index_neighbor]) <= m_initial_radius) {
+                        p_neighbors.push_back(index_neighbor);
+                    }
+                }
+            });
+        });
+    }
+}
+
+
+void dbscan::create_neighborhoods_from_distance_matrix(const container::dense_dataset_view & p_data) {
+    m_neighborhoods.assign(p_data.size(), [this, &p_data](const std::size_t p_index, std::vector<std::size_t> & p_neighbors, std::vector<double> &) {
+        const container::point_view distances = p_data[p_index];
+        for (std::size_t index_neighbor = 0; index_neighbor < distances.size(); index_neighbor++) {
+            if (distances[index_neighbor] <= m_initial_radius) {
+                p_neighbors.push_back(index_neighbor);
+            }
+        }
+    });
+}
+
+
+void dbscan::allocate_clusters_parallel() {
+    const std::size_t amount_points = m_data.size();
+    const std::size_t noise = std::numeric_limits<std::size_t>::max();
+
+    std::vector<char> core(amount_points, 0);
+    parallel_for(std::size_t(0), amount_points, [this, &core](const std::size_t p_index) {
+        const std::size_t * neighbors = m_neighborhoods.neighbors(p_index);
+        const std::size_t amount_neighbors = m_neighborhoods.amount_neighbors(p_index);
+        const std::size_t amount_itself = static_cast<std::size_t>(std::count(neighbors, neighbors + amount_neighbors, p_index));
+
+        core[p_index] = (amount_neighbors - amount_itself >= m_neighbors) ? 1 : 0;
+    });
+
+    /* neighborhoods are symmetric, so each pair of core neighbors is merged once */
+    container::concurrent_disjoint_set core_sets(amount_points);
+    parallel_for(std::size_t(0), amount_points, [this, &core, &core_sets](const std::size_t p_index) {
+        if (!core[p_index]) {
+            return;
+        }
+
+        const std::size_t * neighbors = m_neighborhoods.neighbors(p_index);
+        for (std::size_t i = 0; i < m_neighborhoods.amount_neighbors(p_index); i++) {
+            if ((neighbors[i] < p_index) && core[neighbors[i]]) {
+                core_sets.unite(p_index, neighbors[i]);
+            }
+        }
+    });
+
+    std::vector<std::size_t> roots(amount_points, noise);
+    parallel_for(std::size_t(0), amount_points, [&core, &core_sets, &roots](const std::size_t p_index) {
+        if (core[p_index]) {
+            roots[p_index] = core_sets.find(p_index);
+        }
+    });
+
+    /* the representative of a set is its smallest core point, so clusters are numbered like by expansion */
+    std::vector<std::size_t> labels(amount_points, noise);
+    std::size_t amount_clusters = 0;
+    for (std::size_t index_point = 0; index_point < amount_points; index_point++) {
+        if (roots[index_point] == index_point) {
+            labels[index_point] = amount_clusters++;
+        }
     }
 
-    m_kdtree = container::kdtree_balanced(p_data, payload);
+    /* a border point belongs to the first cluster that has a core point in its neighborhood */
+    parallel_for(std::size_t(0), amount_points, [this, &core, &roots, &labels](const std::size_t p_index) {
+        if (core[p_index]) {
+            if (roots[p_index] != p_index) {
+                labels[p_index] = labels[roots[p_index]];
+            }
+
+            return;
+        }
+
+        std::size_t label = labels[p_index];
+        const std::size_t * neighbors = m_neighborhoods.neighbors(p_index);
+        for (std::size_t i = 0; i < m_neighborhoods.amount_neighbors(p_index); i++) {
+            if (core[neighbors[i]]) {
+                label = std::min(label, labels[roots[neighbors[i]]]);
+            }
+        }
+
+        labels[p_index] = label;
+    });
+
+    m_result_ptr->clusters().resize(amount_clusters);
+    for (std::size_t index_point = 0; index_point < amount_points; index_point++) {
+        if (labels[index_point] == noise) {
+            m_result_ptr->noise().push_back(index_point);
+        }
+        else {
+            m_result_ptr->clusters()[labels[index_point]].push_back(index_point);
+        }
+    }
 }
 
 
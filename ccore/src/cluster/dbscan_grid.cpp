@@ -0,0 +1,460 @@
+/*!
+
+@authors Andrei Novikov (pyclustering@yandex.ru)
+@date 2014-2020
+@copyright BSD-3-Clause
+
+*/
+
+
+#include <pyclustering/cluster/dbscan_grid.hpp>
+
+#include <pyclustering/parallel/parallel.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+
+
+using namespace pyclustering::container;
+using namespace pyclustering::parallel;
+
+
+namespace pyclustering {
+
+namespace clst {
+
+
+const std::size_t dbscan_grid::MAXIMUM_DIMENSION = 4;
+
+const std::size_t dbscan_grid::NO_CELL = std::numeric_limits<std::size_t>::max();
+
+const double dbscan_grid::MAXIMUM_CELL_COORDINATE = 1e15;
+
+
+dbscan_grid::dbscan_grid(const double p_radius_connectivity, const std::size_t p_minimum_neighbors) :
+    m_radius(p_radius_connectivity),
+    m_neighbors(p_minimum_neighbors)
+{ }
+
+
+bool dbscan_grid::is_applicable(const dense_dataset_view & p_data, const double p_radius_connectivity) {
+    const std::size_t dimension = p_data.dimension();
+    if ((dimension == 0) || (dimension > MAXIMUM_DIMENSION) || !(p_radius_connectivity > 0.0) || std::isinf(p_radius_connectivity)) {
+        return false;
+    }
+
+    const double side = p_radius_connectivity / std::sqrt(static_cast<double>(dimension));
+    for (std::size_t index_dimension = 0; index_dimension < dimension; index_dimension++) {
+        double minimum = std::numeric_limits<double>::max();
+        double maximum = std::numeric_limits<double>::lowest();
+        for (std::size_t index_point = 0; index_point < p_data.size(); index_point++) {
+            const double coordinate = p_data.row(index_point)[index_dimension];
+            minimum = std::min(minimum, coordinate);
+            maximum = std::max(maximum, coordinate);
+        }
+
+        if (!((maximum - minimum) / side <= MAXIMUM_CELL_COORDINATE)) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+
+void dbscan_grid::process(const dense_dataset_view & p_data, dbscan_data & p_result) {
+    m_data = p_data;
+    if (m_data.empty()) {
+        return;
+    }
+
+    create_cells();
+    create_table();
+    create_offsets();
+
+    find_core_points();
+
+    disjoint_set cells(m_cell_begin.size() - 1);
+    connect_core_cells(cells);
+    allocate_clusters(cells, p_result);
+
+    m_data = { };
+    m_order = { };
+    m_point_cells = { };
+    m_cell_begin = { };
+    m_cell_coordinates = { };
+    m_row_begin = { };
+    m_table = { };
+    m_core = { };
+}
+
+
+void dbscan_grid::create_cells() {
+    const std::size_t dimension = m_data.dimension();
+    const double side = m_radius / std::sqrt(static_cast<double>(dimension));
+
+    std::vector<double> minimum(dimension, std::numeric_limits<double>::max());
+    for (std::size_t index_point = 0; index_point < m_data.size(); index_point++) {
+        const double * current_point = m_data.row(index_point);
+        for (std::size_t index_dimension = 0; index_dimension < dimension; index_dimension++) {
+            minimum[index_dimension] = std::min(minimum[index_dimension], current_point[index_dimension]);
+        }
+    }
+
+    std::vector<std::int64_t> coordinates(m_data.size() * dimension);
+    parallel_for(std::size_t(0), m_data.size(), [this, dimension, side, &minimum, &coordinates](const std::size_t p_index) {
+        const double * current_point = m_data.row(p_index);
+        for (std::size_t index_dimension = 0; index_dimension < dimension; index_dimension++) {
+            const double position = std::floor((current_point[index_dimension] - minimum[index_dimension]) / side);
+            coordinates[p_index * dimension + index_dimension] = static_cast<std::int64_t>(position);
+        }
+    });
+
+    /* points of the same cell become neighbours in the order */
+    m_order.resize(m_data.size());
+    std::iota(m_order.begin(), m_order.end(), 0);
+    std::sort(m_order.begin(), m_order.end(), [dimension, &coordinates](const std::size_t p_index1, const std::size_t p_index2) {
+        const std::int64_t * cell1 = coordinates.data() + p_index1 * dimension;
+        const std::int64_t * cell2 = coordinates.data() + p_index2 * dimension;
+        for (std::size_t index_dimension = 0; index_dimension < dimension; index_dimension++) {
+            if (cell1[index_dimension] != cell2[index_dimension]) {
+                return cell1[index_dimension] < cell2[index_dimension];
+            }
+        }
+
+        return p_index1 < p_index2;
+    });
+
+    m_point_cells.resize(m_data.size());
+    for (std::size_t position = 0; position < m_order.size(); position++) {
+        const std::int64_t * cell = coordinates.data() + m_order[position] * dimension;
+        if ((position == 0) || !std::equal(cell, cell + dimension, m_cell_coordinates.end() - dimension)) {
+            /* cells are sorted, so a row starts when coordinates except the last one are changed */
+            if ((position == 0) || !std::equal(cell, cell + dimension - 1, m_cell_coordinates.end() - dimension)) {
+                m_row_begin.push_back(m_cell_begin.size());
+            }
+
+            m_cell_begin.push_back(position);
+            m_cell_coordinates.insert(m_cell_coordinates.end(), cell, cell + dimension);
+        }
+
+        m_point_cells[m_order[position]] = m_cell_begin.size() - 1;
+    }
+
+    m_row_begin.push_back(m_cell_begin.size());
+    m_cell_begin.push_back(m_order.size());
+}
+
+
+void dbscan_grid::create_table() {
+    const std::size_t amount_rows = m_row_begin.size() - 1;
+    const std::size_t dimension = m_data.dimension();
+
+    /* the table is filled by rows at most by half, so chains of the linear probing are short */
+    std::size_t capacity = 1;
+    while (capacity < 2 * amount_rows) {
+        capacity <<= 1;
+    }
+
+    m_table.assign(capacity, NO_CELL);
+    for (std::size_t index_row = 0; index_row < amount_rows; index_row++) {
+        const std::int64_t * row = m_cell_coordinates.data() + m_row_begin[index_row] * dimension;
+
+        std::size_t slot = hash(row, dimension - 1) & (capacity - 1);
+        while (m_table[slot] != NO_CELL) {
+            slot = (slot + 1) & (capacity - 1);
+        }
+
+        m_table[slot] = index_row;
+    }
+}
+
+
+void dbscan_grid::create_offsets() {
+    const std::size_t dimension = m_data.dimension();
+
+    /* the closest points of cells whose offset is `o` are separated by sum of (|o_i| - 1)^2 square sides, so a cell
+       might contain neighbors if the sum is not greater than the dimension (square radius in square sides) */
+    const std::int64_t limit = static_cast<std::int64_t>(dimension);
+    const auto maximum_offset = [](const std::int64_t p_gap) {
+        std::int64_t offset = 1;
+        while (offset * offset <= p_gap) {
+            offset++;
+        }
+
+        return offset;      /* the largest offset whose (offset - 1)^2 is not greater than the gap */
+    };
+
+    const std::int64_t range = maximum_offset(limit);
+
+    m_offsets.clear();
+
+    /* offsets of rows are enumerated, each row is followed by the maximum offset of the last coordinate */
+    std::vector<std::int64_t> offset(dimension - 1, -range);
+    while (true) {
+        std::int64_t gap = 0;
+        for (const auto value : offset) {
+            const std::int64_t distance = std::max(std::abs(value) - 1, std::int64_t(0));
+            gap += distance * distance;
+        }
+
+        if (gap <= limit) {
+            m_offsets.insert(m_offsets.end(), offset.begin(), offset.end());
+            m_offsets.push_back(maximum_offset(limit - gap));
+        }
+
+        std::size_t index_dimension = 0;
+        for (; index_dimension < offset.size(); index_dimension++) {
+            if (offset[index_dimension] < range) {
+                offset[index_dimension]++;
+                break;
+            }
+
+            offset[index_dimension] = -range;
+        }
+
+        if (index_dimension == offset.size()) {
+            break;
+        }
+    }
+}
+
+
+std::size_t dbscan_grid::find_row(const std::int64_t * p_coordinates) const {
+    const std::size_t dimension = m_data.dimension();
+    const std::size_t mask = m_table.size() - 1;
+
+    for (std::size_t slot = hash(p_coordinates, dimension - 1) & mask; ; slot = (slot + 1) & mask) {
+        const std::size_t index_row = m_table[slot];
+        if (index_row == NO_CELL) {
+            return NO_CELL;
+        }
+
+        const std::int64_t * row = m_cell_coordinates.data() + m_row_begin[index_row] * dimension;
+        if (std::equal(p_coordinates, p_coordinates + dimension - 1, row)) {
+            return index_row;
+        }
+    }
+}
+
+
+void dbscan_grid::find_neighbor_cells(const std::size_t p_cell, std::vector<std::size_t> & p_cells) const {
+    const std::size_t dimension = m_data.dimension();
+    const std::size_t index_last = dimension - 1;
+    const std::int64_t * cell = m_cell_coordinates.data() + p_cell * dimension;
+
+    p_cells.clear();
+
+    std::int64_t neighbor[MAXIMUM_DIMENSION];
+    for (std::size_t index_offset = 0; index_offset < m_offsets.size(); index_offset += dimension) {
+        for (std::size_t index_dimension = 0; index_dimension < index_last; index_dimension++) {
+            neighbor[index_dimension] = cell[index_dimension] + m_offsets[index_offset + index_dimension];
+        }
+
+        const std::size_t index_row = find_row(neighbor);
+        if (index_row == NO_CELL) {
+            continue;
+        }
+
+        const std::int64_t first = cell[index_last] - m_offsets[index_offset + index_last];
+        const std::int64_t last = cell[index_last] + m_offsets[index_offset + index_last];
+
+        /* cells of a row are sorted by the last coordinate */
+        std::size_t begin = m_row_begin[index_row];
+        std::size_t end = m_row_begin[index_row + 1];
+        while (begin < end) {
+            const std::size_t middle = begin + (end - begin) / 2;
+            if (m_cell_coordinates[middle * dimension + index_last] < first) {
+                begin = middle + 1;
+            }
+            else {
+                end = middle;
+            }
+        }
+
+        for (std::size_t index_cell = begin; index_cell < m_row_begin[index_row + 1]; index_cell++) {
+            if (m_cell_coordinates[index_cell * dimension + index_last] > last) {
+                break;
+            }
+
+            p_cells.push_back(index_cell);
+        }
+    }
+}
+
+
+void dbscan_grid::find_core_points() {
+    const double square_radius = m_radius * m_radius;
+    const std::size_t amount_cells = m_cell_begin.size() - 1;
+
+    m_core.assign(m_data.size(), 0);
+
+    parallel_for(std::size_t(0), amount_cells, [this, square_radius](const std::size_t p_cell) {
+        const std::size_t begin = m_cell_begin[p_cell];
+        const std::size_t end = m_cell_begin[p_cell + 1];
+
+        /* points of a cell are neighbors of each other, so all of them are core points of a dense cell */
+        if (end - begin > m_neighbors) {
+            for (std::size_t position = begin; position < end; position++) {
+                m_core[m_order[position]] = 1;
+            }
+
+            return;
+        }
+
+        std::vector<std::size_t> neighbor_cells;
+        find_neighbor_cells(p_cell, neighbor_cells);
+
+        for (std::size_t position = begin; position < end; position++) {
+            const std::size_t index_point = m_order[position];
+
+            std::size_t amount_neighbors = 0;
+            for (auto iter_cell = neighbor_cells.begin(); (iter_cell != neighbor_cells.end()) && (amount_neighbors < m_neighbors); iter_cell++) {
+                for (std::size_t candidate = m_cell_begin[*iter_cell]; candidate < m_cell_begin[*iter_cell + 1]; candidate++) {
+                    const std::size_t index_candidate = m_order[candidate];
+                    if ((index_candidate != index_point) && (square_distance(index_point, index_candidate) <= square_radius)) {
+                        amount_neighbors++;
+                    }
+                }
+            }
+
+            m_core[index_point] = (amount_neighbors >= m_neighbors) ? 1 : 0;
+        }
+    });
+}
+
+
+void dbscan_grid::connect_core_cells(disjoint_set & p_cells) const {
+    std::vector<char> core_cells(p_cells.size(), 0);
+    for (std::size_t index_point = 0; index_point < m_data.size(); index_point++) {
+        if (m_core[index_point]) {
+            core_cells[m_point_cells[index_point]] = 1;
+        }
+    }
+
+    std::vector<std::size_t> neighbor_cells;
+    for (std::size_t index_cell = 0; index_cell < p_cells.size(); index_cell++) {
+        if (!core_cells[index_cell]) {
+            continue;
+        }
+
+        find_neighbor_cells(index_cell, neighbor_cells);
+        for (const std::size_t index_neighbor : neighbor_cells) {
+            /* each pair of cells is checked once and only if the cells are not connected yet */
+            if ((index_neighbor <= index_cell) || !core_cells[index_neighbor] || (p_cells.find(index_cell) == p_cells.find(index_neighbor))) {
+                continue;
+            }
+
+            for (std::size_t position = m_cell_begin[index_cell]; position < m_cell_begin[index_cell + 1]; position++) {
+                const std::size_t index_point = m_order[position];
+                if (m_core[index_point] && has_core_neighbor(index_point, index_neighbor)) {
+                    p_cells.unite(index_cell, index_neighbor);
+                    break;
+                }
+            }
+        }
+    }
+}
+
+
+bool dbscan_grid::has_core_neighbor(const std::size_t p_index, const std::size_t p_cell) const {
+    const double square_radius = m_radius * m_radius;
+    for (std::size_t position = m_cell_begin[p_cell]; position < m_cell_begin[p_cell + 1]; position++) {
+        const std::size_t index_candidate = m_order[position];
+        if (m_core[index_candidate] && (square_distance(p_index, index_candidate) <= square_radius)) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+
+void dbscan_grid::allocate_clusters(disjoint_set & p_cells, dbscan_data & p_result) const {
+    /* clusters are numbered in order of their smallest core points like clusters that are expanded by DBSCAN */
+    std::vector<std::size_t> cell_clusters(p_cells.size(), NO_CELL);
+    std::vector<std::size_t> root_clusters(p_cells.size(), NO_CELL);
+    std::size_t amount_clusters = 0;
+
+    for (std::size_t index_point = 0; index_point < m_data.size(); index_point++) {
+        if (m_core[index_point]) {
+            const std::size_t root = p_cells.find(m_point_cells[index_point]);
+            if (root_clusters[root] == NO_CELL) {
+                root_clusters[root] = amount_clusters++;
+            }
+        }
+    }
+
+    for (std::size_t index_cell = 0; index_cell < p_cells.size(); index_cell++) {
+        cell_clusters[index_cell] = root_clusters[p_cells.find(index_cell)];
+    }
+
+    /* a border point belongs to the first cluster that has a core point in its neighborhood */
+    std::vector<std::size_t> labels(m_data.size(), NO_CELL);
+    parallel_for(std::size_t(0), p_cells.size(), [this, &cell_clusters, &labels](const std::size_t p_cell) {
+        std::vector<std::size_t> neighbor_cells;
+
+        for (std::size_t position = m_cell_begin[p_cell]; position < m_cell_begin[p_cell + 1]; position++) {
+            const std::size_t index_point = m_order[position];
+            if (m_core[index_point]) {
+                labels[index_point] = cell_clusters[p_cell];
+                continue;
+            }
+
+            if (neighbor_cells.empty()) {
+                find_neighbor_cells(p_cell, neighbor_cells);
+            }
+
+            std::size_t label = NO_CELL;
+            for (const std::size_t index_neighbor : neighbor_cells) {
+                if ((cell_clusters[index_neighbor] < label) && has_core_neighbor(index_point, index_neighbor)) {
+                    label = cell_clusters[index_neighbor];
+                }
+            }
+
+            labels[index_point] = label;
+        }
+    });
+
+    p_result.clusters().resize(amount_clusters);
+    for (std::size_t index_point = 0; index_point < m_data.size(); index_point++) {
+        if (labels[index_point] == NO_CELL) {
+            p_result.noise().push_back(index_point);
+        }
+        else {
+            p_result.clusters()[labels[index_point]].push_back(index_point);
+        }
+    }
+}
+
+
+double dbscan_grid::square_distance(const std::size_t p_index1, const std::size_t p_index2) const {
+    const double * point1 = m_data.row(p_index1);
+    const double * point2 = m_data.row(p_index2);
+
+    double distance = 0.0;
+    for (std::size_t index_dimension = 0; index_dimension < m_data.dimension(); index_dimension++) {
+        const double difference = point1[index_dimension] - point2[index_dimension];
+        distance += difference * difference;
+    }
+
+    return distance;
+}
+
+
+std::uint64_t dbscan_grid::hash(const std::int64_t * p_coordinates, const std::size_t p_dimension) {
+    std::uint64_t value = 0;
+    for (std::size_t index_dimension = 0; index_dimension < p_dimension; index_dimension++) {
+        value = (value ^ static_cast<std::uint64_t>(p_coordinates[index_dimension])) * 0x9E3779B97F4A7C15ULL;
+        value ^= value >> 29;
+    }
+
+    return value;
+}
+
+
+}
+
+}
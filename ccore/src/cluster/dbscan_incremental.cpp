@@ -0,0 +1,392 @@
+/*!
+
+@authors Andrei Novikov (pyclustering@yandex.ru)
+@date 2014-2020
+@copyright BSD-3-Clause
+
+*/
+
+
+#include <pyclustering/cluster/dbscan_incremental.hpp>
+
+#include <pyclustering/container/kdtree_searcher.hpp>
+
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+
+using namespace pyclustering::container;
+
+
+namespace pyclustering {
+
+namespace clst {
+
+
+const std::size_t dbscan_incremental::NO_INDEX = std::numeric_limits<std::size_t>::max();
+
+
+dbscan_incremental::dbscan_incremental(const double p_radius_connectivity, const std::size_t p_minimum_neighbors) :
+    m_radius(p_radius_connectivity),
+    m_neighbors(p_minimum_neighbors)
+{ }
+
+
+std::size_t dbscan_incremental::insert(const point & p_point) {
+    if (p_point.empty() || ((m_size > 0) && (p_point.size() != m_dimension))) {
+        throw std::invalid_argument("Dimension of the point '" + std::to_string(p_point.size()) +
+            "' is not consistent with dimension of stored points '" + std::to_string(m_dimension) + "'.");
+    }
+
+    compress_clusters();
+
+    m_dimension = p_point.size();
+
+    std::vector<std::size_t> neighbors;
+    if (m_size > 0) {
+        kdtree_searcher searcher(p_point, m_tree.get_root(), m_radius);
+        searcher.find_nearest([&neighbors](const kdnode::ptr & p_node, const double) {
+            neighbors.push_back(reinterpret_cast<std::size_t>(p_node->get_payload()));
+        });
+    }
+
+    std::size_t index = m_nodes.size();
+    if (m_free.empty()) {
+        m_nodes.emplace_back();
+        m_adjacency.emplace_back();
+        m_labels.push_back(NO_INDEX);
+        m_stamps.push_back(0);
+        m_owners.push_back(0);
+    }
+    else {
+        index = m_free.back();
+        m_free.pop_back();
+    }
+
+    m_nodes[index] = m_tree.insert(p_point, reinterpret_cast<void *>(index));
+    m_size++;
+
+    std::vector<std::size_t> cores;
+    for (const auto index_neighbor : neighbors) {
+        m_adjacency[index_neighbor].push_back(index);
+        if (m_adjacency[index_neighbor].size() == m_neighbors) {
+            cores.push_back(index_neighbor);    /* the neighbor has become a core point */
+        }
+    }
+
+    m_adjacency[index] = std::move(neighbors);
+    if (is_core(index)) {
+        cores.push_back(index);
+    }
+
+    connect(cores);
+    return index;
+}
+
+
+std::vector<std::size_t> dbscan_incremental::insert(const dataset & p_points) {
+    if (!p_points.empty()) {
+        const std::size_t dimension = (m_size > 0) ? m_dimension : p_points.front().size();
+        for (const auto & current_point : p_points) {
+            if (current_point.empty() || (current_point.size() != dimension)) {
+                throw std::invalid_argument("Dimension of the point '" + std::to_string(current_point.size()) +
+                    "' is not consistent with dimension of stored points '" + std::to_string(dimension) + "'.");
+            }
+        }
+    }
+
+    std::vector<std::size_t> indexes;
+    indexes.reserve(p_points.size());
+
+    for (const auto & current_point : p_points) {
+        indexes.push_back(insert(current_point));
+    }
+
+    return indexes;
+}
+
+
+void dbscan_incremental::remove(const std::size_t p_index) {
+    if (!contains(p_index)) {
+        throw std::invalid_argument("Point with index '" + std::to_string(p_index) + "' does not exist.");
+    }
+
+    compress_clusters();
+
+    const bool is_core_removed = is_core(p_index);
+
+    std::vector<std::size_t> neighbors = std::move(m_adjacency[p_index]);
+    m_adjacency[p_index].clear();
+
+    m_tree.remove(m_nodes[p_index]);
+    m_nodes[p_index] = nullptr;
+    m_free.push_back(p_index);
+    m_size--;
+
+    /* each component of a split cluster contains a core neighbor of a removed point or of a lost core point */
+    std::vector<std::size_t> seeds;
+    std::vector<std::size_t> lost_cores;
+    for (const auto index_neighbor : neighbors) {
+        std::vector<std::size_t> & neighbor_adjacency = m_adjacency[index_neighbor];
+        *std::find(neighbor_adjacency.begin(), neighbor_adjacency.end(), p_index) = neighbor_adjacency.back();
+        neighbor_adjacency.pop_back();
+
+        if (neighbor_adjacency.size() + 1 == m_neighbors) {
+            lost_cores.push_back(index_neighbor);
+        }
+        else if (is_core_removed && is_core(index_neighbor)) {
+            seeds.push_back(index_neighbor);
+        }
+    }
+
+    for (const auto index_lost : lost_cores) {
+        for (const auto index_neighbor : m_adjacency[index_lost]) {
+            if (is_core(index_neighbor)) {
+                seeds.push_back(index_neighbor);
+            }
+        }
+    }
+
+    /* seeds are grouped by their clusters, each cluster is checked separately */
+    std::vector<std::pair<std::size_t, std::size_t>> cluster_seeds;
+    cluster_seeds.reserve(seeds.size());
+    for (const auto index_seed : seeds) {
+        cluster_seeds.emplace_back(m_clusters.find(m_labels[index_seed]), index_seed);
+    }
+
+    std::sort(cluster_seeds.begin(), cluster_seeds.end());
+    cluster_seeds.erase(std::unique(cluster_seeds.begin(), cluster_seeds.end()), cluster_seeds.end());
+
+    std::vector<std::size_t> group;
+    for (std::size_t begin = 0, end = 0; begin < cluster_seeds.size(); begin = end) {
+        group.clear();
+        for (end = begin; (end < cluster_seeds.size()) && (cluster_seeds[end].first == cluster_seeds[begin].first); end++) {
+            group.push_back(cluster_seeds[end].second);
+        }
+
+        if (group.size() > 1) {
+            separate(group);
+        }
+    }
+}
+
+
+void dbscan_incremental::remove(const std::vector<std::size_t> & p_indexes) {
+    std::vector<bool> is_removed(m_nodes.size(), false);
+    for (const auto index_point : p_indexes) {
+        if (!contains(index_point)) {
+            throw std::invalid_argument("Point with index '" + std::to_string(index_point) + "' does not exist.");
+        }
+
+        if (is_removed[index_point]) {
+            throw std::invalid_argument("Point with index '" + std::to_string(index_point) + "' is specified more than once.");
+        }
+
+        is_removed[index_point] = true;
+    }
+
+    for (const auto index_point : p_indexes) {
+        remove(index_point);
+    }
+}
+
+
+void dbscan_incremental::get_clusters(dbscan_data & p_result) {
+    std::vector<std::size_t> numbers(m_clusters.size(), NO_INDEX);
+    std::vector<std::size_t> labels(m_nodes.size(), NO_INDEX);
+    std::size_t amount_clusters = 0;
+
+    /* clusters are numbered in order of their smallest core points like clusters that are expanded by DBSCAN */
+    for (std::size_t index_point = 0; index_point < m_nodes.size(); index_point++) {
+        if (is_core(index_point)) {
+            const std::size_t root = m_clusters.find(m_labels[index_point]);
+            if (numbers[root] == NO_INDEX) {
+                numbers[root] = amount_clusters++;
+            }
+
+            labels[index_point] = numbers[root];
+        }
+    }
+
+    /* a border point belongs to the first cluster that has a core point in its neighborhood */
+    for (std::size_t index_point = 0; index_point < m_nodes.size(); index_point++) {
+        if ((m_nodes[index_point] == nullptr) || is_core(index_point)) {
+            continue;
+        }
+
+        for (const auto index_neighbor : m_adjacency[index_point]) {
+            if (is_core(index_neighbor)) {
+                labels[index_point] = std::min(labels[index_point], labels[index_neighbor]);
+            }
+        }
+    }
+
+    p_result.clusters().assign(amount_clusters, cluster());
+    p_result.noise().clear();
+
+    for (std::size_t index_point = 0; index_point < m_nodes.size(); index_point++) {
+        if (m_nodes[index_point] == nullptr) {
+            continue;
+        }
+
+        if (labels[index_point] == NO_INDEX) {
+            p_result.noise().push_back(index_point);
+        }
+        else {
+            p_result.clusters()[labels[index_point]].push_back(index_point);
+        }
+    }
+}
+
+
+const point & dbscan_incremental::get_point(const std::size_t p_index) const {
+    if (!contains(p_index)) {
+        throw std::invalid_argument("Point with index '" + std::to_string(p_index) + "' does not exist.");
+    }
+
+    return m_nodes[p_index]->get_data();
+}
+
+
+bool dbscan_incremental::contains(const std::size_t p_index) const {
+    return (p_index < m_nodes.size()) && (m_nodes[p_index] != nullptr);
+}
+
+
+std::size_t dbscan_incremental::size() const {
+    return m_size;
+}
+
+
+bool dbscan_incremental::is_core(const std::size_t p_index) const {
+    return (m_nodes[p_index] != nullptr) && (m_adjacency[p_index].size() >= m_neighbors);
+}
+
+
+void dbscan_incremental::connect(const std::vector<std::size_t> & p_cores) {
+    for (const auto index_core : p_cores) {
+        m_labels[index_core] = m_clusters.append();
+    }
+
+    /* core points that are neighbors belong to the same cluster */
+    for (const auto index_core : p_cores) {
+        for (const auto index_neighbor : m_adjacency[index_core]) {
+            if (is_core(index_neighbor)) {
+                m_clusters.unite(m_labels[index_core], m_labels[index_neighbor]);
+            }
+        }
+    }
+}
+
+
+void dbscan_incremental::separate(const std::vector<std::size_t> & p_seeds) {
+    const std::size_t amount_seeds = p_seeds.size();
+
+    std::vector<std::vector<std::size_t>> frontiers(amount_seeds);
+    std::vector<std::vector<std::size_t>> members(amount_seeds);
+    std::vector<char> finished(amount_seeds, 0);
+    disjoint_set traversals(amount_seeds);
+
+    m_epoch++;
+    for (std::size_t index_seed = 0; index_seed < amount_seeds; index_seed++) {
+        const std::size_t index_point = p_seeds[index_seed];
+
+        m_stamps[index_point] = m_epoch;
+        m_owners[index_point] = index_seed;
+        frontiers[index_seed].push_back(index_point);
+        members[index_seed].push_back(index_point);
+    }
+
+    const auto merge = [](std::vector<std::size_t> & p_target, std::vector<std::size_t> & p_source) {
+        if (p_target.size() < p_source.size()) {
+            std::swap(p_target, p_source);
+        }
+
+        p_target.insert(p_target.end(), p_source.begin(), p_source.end());
+        p_source = { };
+    };
+
+    /* traversals make a step in turn, traversals that meet each other are merged and the last active one is not finished */
+    std::size_t amount_active = amount_seeds;
+    while (amount_active > 1) {
+        for (std::size_t index_seed = 0; (index_seed < amount_seeds) && (amount_active > 1); index_seed++) {
+            if (finished[index_seed] || (traversals.find(index_seed) != index_seed)) {
+                continue;
+            }
+
+            if (frontiers[index_seed].empty()) {
+                /* the component is separated from others, so it forms a new cluster */
+                const std::size_t label = m_clusters.append();
+                for (const auto index_point : members[index_seed]) {
+                    m_labels[index_point] = label;
+                }
+
+                finished[index_seed] = 1;
+                amount_active--;
+                continue;
+            }
+
+            const std::size_t index_point = frontiers[index_seed].back();
+            frontiers[index_seed].pop_back();
+
+            for (const auto index_neighbor : m_adjacency[index_point]) {
+                if (!is_core(index_neighbor)) {
+                    continue;
+                }
+
+                const std::size_t current = traversals.find(index_seed);
+                if (m_stamps[index_neighbor] != m_epoch) {
+                    m_stamps[index_neighbor] = m_epoch;
+                    m_owners[index_neighbor] = current;
+                    frontiers[current].push_back(index_neighbor);
+                    members[current].push_back(index_neighbor);
+                    continue;
+                }
+
+                const std::size_t other = traversals.find(m_owners[index_neighbor]);
+                if (other != current) {
+                    traversals.unite(current, other);
+
+                    const std::size_t target = std::min(current, other);
+                    const std::size_t source = std::max(current, other);
+                    merge(frontiers[target], frontiers[source]);
+                    merge(members[target], members[source]);
+
+                    amount_active--;
+                }
+            }
+        }
+    }
+}
+
+
+void dbscan_incremental::compress_clusters() {
+    /* merged and separated clusters leave unused elements in the union-find, they are dropped when they prevail */
+    if (m_clusters.size() <= 2 * m_size + 1) {
+        return;
+    }
+
+    std::vector<std::size_t> numbers(m_clusters.size(), NO_INDEX);
+    std::size_t amount_clusters = 0;
+
+    for (std::size_t index_point = 0; index_point < m_nodes.size(); index_point++) {
+        if (is_core(index_point)) {
+            const std::size_t root = m_clusters.find(m_labels[index_point]);
+            if (numbers[root] == NO_INDEX) {
+                numbers[root] = amount_clusters++;
+            }
+
+            m_labels[index_point] = numbers[root];
+        }
+    }
+
+    m_clusters = disjoint_set(amount_clusters);
+}
+
+
+}
+
+}
@@ -9,10 +9,14 @@
 
 #include <pyclustering/cluster/fcm.hpp>
 
+#include <pyclustering/cluster/blocked_assignment.hpp>
+
 #include <pyclustering/utils/metric.hpp>
 
 #include <pyclustering/parallel/parallel.hpp>
 
+#include <algorithm>
+
 
 using namespace pyclustering::parallel;
 using namespace pyclustering::utils::metric;
@@ -44,14 +48,19 @@ fcm::fcm(const dataset & p_initial_centers, const double p_m, const double p_tol
 
 
 void fcm::process(const dataset & p_data, fcm_data & p_result) {
-    m_ptr_data = &p_data;
+    process(container::dense_dataset(p_data), p_result);
+}
+
+
+void fcm::process(const container::dense_dataset_view & p_data, fcm_data & p_result) {
+    m_data = p_data;
     m_ptr_result = &p_result;
     
     m_ptr_result->centers().assign(m_initial_centers.begin(), m_initial_centers.end());
 
     if (m_itermax == 0) { return; }
 
-    m_ptr_result->membership().resize(m_ptr_data->size(), point(m_initial_centers.size(), 0.0));
+    m_ptr_result->membership().resize(m_data.size(), point(m_initial_centers.size(), 0.0));
 
     double current_change = std::numeric_limits<double>::max();
 
@@ -65,7 +74,7 @@ void fcm::process(const dataset & p_data, fcm_data & p_result) {
 
 
 void fcm::verify() const {
-    if (m_ptr_data->at(0).size() != m_initial_centers[0].size()) {
+    if (m_data.dimension() != m_initial_centers[0].size()) {
         throw std::invalid_argument("Dimension of the input data and dimension of the initial cluster centers must be the same.");
     }
 }
@@ -85,15 +94,18 @@ double fcm::update_centers() {
 
 
 double fcm::update_center(const std::size_t p_index) {
-    const std::size_t dimensions = m_ptr_data->at(0).size();
-    const std::size_t data_length = m_ptr_data->size();
+    const std::size_t dimensions = m_data.dimension();
+    const std::size_t data_length = m_data.size();
 
     std::vector<double> dividend(dimensions, 0.0);
     std::vector<double> divider(dimensions, 0.0);
     for (std::size_t j = 0; j < data_length; j++) {
+        const double * object = m_data.row(j);
+        const double membership = m_ptr_result->membership()[j][p_index];
+
         for (std::size_t dimension = 0; dimension < dimensions; dimension++) {
-            dividend[dimension] += m_ptr_data->at(j).at(dimension) * m_ptr_result->membership()[j][p_index];
-            divider[dimension] += m_ptr_result->membership()[j][p_index];
+            dividend[dimension] += object[dimension] * membership;
+            divider[dimension] += membership;
         }
     }
 
@@ -111,19 +123,25 @@ double fcm::update_center(const std::size_t p_index) {
 
 void fcm::update_membership() {
     const std::size_t data_size = m_ptr_result->membership().size();
+    const blocked_assignment assignment(m_ptr_result->centers());
 
-    parallel_for(std::size_t(0), data_size, [this](std::size_t p_index) {
-        update_point_membership(p_index);
+    const std::size_t block = blocked_assignment::POINT_BLOCK;
+    parallel_for(std::size_t(0), data_size, block, [this, &assignment, data_size, block](const std::size_t p_begin) {
+        const std::size_t end = std::min(p_begin + block, data_size);
+
+        std::vector<double> differences((end - p_begin) * assignment.size());
+        assignment.distances(m_data, p_begin, end, differences.data());
+
+        for (std::size_t index_point = p_begin; index_point < end; index_point++) {
+            update_point_membership(index_point, differences.data() + (index_point - p_begin) * assignment.size());
+        }
     });
 }
 
 
-void fcm::update_point_membership(const std::size_t p_index) {
+void fcm::update_point_membership(const std::size_t p_index, const double * p_differences) {
     const std::size_t center_amount = m_ptr_result->centers().size();
-    std::vector<double> differences(center_amount, 0.0);
-    for (std::size_t j = 0; j < center_amount; j++) {
-        differences[j] = euclidean_distance_square(m_ptr_data->at(p_index), m_ptr_result->centers().at(j));
-    }
+    const double * differences = p_differences;
 
     for (std::size_t j = 0; j < center_amount; j++) {
         double divider = 0.0;
@@ -145,7 +163,7 @@ void fcm::update_point_membership(const std::size_t p_index) {
 
 void fcm::extract_clusters(cluster_sequence & p_clusters) {
     m_ptr_result->clusters() = cluster_sequence(m_ptr_result->centers().size());
-    for (std::size_t i = 0; i < m_ptr_data->size(); i++) {
+    for (std::size_t i = 0; i < m_data.size(); i++) {
         const auto & membership = m_ptr_result->membership().at(i);
         auto iter = std::max_element(membership.begin(), membership.end());
         std::size_t index_cluster = iter - membership.begin();
@@ -56,6 +56,7 @@ gmeans::gmeans(const std::size_t p_k_initial, const double p_tolerance, const st
 
 void gmeans::process(const dataset & p_data, gmeans_data & p_result) {
     m_ptr_data = &p_data;
+    m_dense_data = container::dense_dataset(p_data);    /* K-Means is performed for the whole data on each step */
     m_ptr_result = &p_result;
 
     search_optimal_parameters(p_data, m_amount, m_ptr_result->clusters(), m_ptr_result->centers());
@@ -70,6 +71,8 @@ void gmeans::process(const dataset & p_data, gmeans_data & p_result) {
 
         perform_clustering();
     }
+
+    m_dense_data = container::dense_dataset();
 }
 
 
@@ -133,7 +136,7 @@ void gmeans::statistical_optimization() {
 
 void gmeans::perform_clustering() {
     kmeans_data result;
-    kmeans(m_ptr_result->centers(), m_tolerance).process(*m_ptr_data, result);
+    kmeans(m_ptr_result->centers(), m_tolerance).process(m_dense_data, result);
 
     m_ptr_result->clusters() = std::move(result.clusters());
     m_ptr_result->centers() = std::move(result.centers());
@@ -0,0 +1,377 @@
+/*!
+
+@authors Andrei Novikov (pyclustering@yandex.ru)
+@date 2014-2020
+@copyright BSD-3-Clause
+
+*/
+
+
+#include <pyclustering/cluster/hdbscan.hpp>
+
+#include <pyclustering/container/disjoint_set.hpp>
+
+#include <pyclustering/parallel/parallel.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <string>
+
+
+using namespace pyclustering::container;
+using namespace pyclustering::parallel;
+
+
+namespace pyclustering {
+
+namespace clst {
+
+
+static const std::size_t NO_INDEX = std::numeric_limits<std::size_t>::max();
+
+
+hdbscan::hdbscan(const std::size_t p_minimum_neighbors, const std::size_t p_minimum_cluster_size) :
+    m_neighbors(p_minimum_neighbors),
+    m_minimum_cluster_size(p_minimum_cluster_size)
+{ }
+
+
+void hdbscan::process(const dataset & p_data, hdbscan_data & p_result) {
+    process(dense_dataset(p_data), p_result);
+}
+
+
+void hdbscan::process(const dense_dataset_view & p_data, hdbscan_data & p_result) {
+    if (m_minimum_cluster_size < 2) {
+        throw std::invalid_argument("Minimum cluster size '" + std::to_string(m_minimum_cluster_size) + "' should be greater than 1.");
+    }
+
+    /* distances to infinite or NaN coordinates are not comparable and the spanning tree cannot be built */
+    for (std::size_t index_point = 0; index_point < p_data.size(); index_point++) {
+        const double * const row = p_data.row(index_point);
+        if (!std::all_of(row, row + p_data.dimension(), [](const double p_value) { return std::isfinite(p_value); })) {
+            throw std::invalid_argument("Point '" + std::to_string(index_point) + "' has coordinate that is not finite.");
+        }
+    }
+
+    m_data = p_data;
+    m_result_ptr = &p_result;
+
+    m_result_ptr->clusters().clear();
+    m_result_ptr->noise().clear();
+    m_result_ptr->stability().clear();
+    m_result_ptr->core_distances().clear();
+
+    if (!m_data.empty()) {
+        m_tree = kdtree_flat(m_data);
+
+        calculate_core_distances();
+
+        std::vector<edge> spanning_tree;
+        create_spanning_tree(spanning_tree);
+
+        std::vector<condensed_edge> condensed_tree;
+        std::size_t amount_clusters = 0;
+        condense_tree(spanning_tree, condensed_tree, amount_clusters);
+
+        extract_clusters(condensed_tree, amount_clusters);
+    }
+
+    m_tree = kdtree_flat();
+    m_core_distances.clear();
+
+    m_data = { };
+    m_result_ptr = nullptr;
+}
+
+
+void hdbscan::calculate_core_distances() {
+    m_core_distances.assign(m_data.size(), 0.0);
+
+    if (m_neighbors > 0) {
+        /* the point itself is found as well, the farthest of found points defines the core distance */
+        parallel_for(std::size_t(0), m_data.size(), [this](const std::size_t p_index) {
+            std::vector<std::size_t> indexes;
+            std::vector<double> square_distances;
+
+            m_tree.find_k_nearest(m_data.row(p_index), m_neighbors + 1, std::numeric_limits<double>::infinity(), indexes, square_distances);
+            m_core_distances[p_index] = square_distances.back();
+        });
+    }
+
+    std::vector<double> & core_distances = m_result_ptr->core_distances();
+    core_distances.resize(m_data.size());
+
+    std::transform(m_core_distances.begin(), m_core_distances.end(), core_distances.begin(), [](const double p_square_distance) {
+        return std::sqrt(p_square_distance);
+    });
+}
+
+
+void hdbscan::create_spanning_tree(std::vector<edge> & p_spanning_tree) const {
+    const std::size_t amount_points = m_data.size();
+
+    p_spanning_tree.clear();
+    p_spanning_tree.reserve(amount_points);
+
+    /* edges are ordered by distance and then by points, so the shortest edge of each component is unique */
+    const auto less = [](const edge & p_edge1, const edge & p_edge2) {
+        if (p_edge1.m_distance != p_edge2.m_distance) {
+            return p_edge1.m_distance < p_edge2.m_distance;
+        }
+
+        const std::size_t first1 = std::min(p_edge1.m_point1, p_edge1.m_point2);
+        const std::size_t first2 = std::min(p_edge2.m_point1, p_edge2.m_point2);
+        if (first1 != first2) {
+            return first1 < first2;
+        }
+
+        return std::max(p_edge1.m_point1, p_edge1.m_point2) < std::max(p_edge2.m_point1, p_edge2.m_point2);
+    };
+
+    disjoint_set components(amount_points);
+
+    std::vector<std::size_t> labels(amount_points);
+    std::vector<std::size_t> node_labels;
+    std::vector<std::size_t> shortest(amount_points);
+    std::vector<edge> candidates(amount_points);
+    std::vector<std::atomic<double>> bounds(amount_points);     /* the shortest edge of each component that has been found */
+
+    while (p_spanning_tree.size() + 1 < amount_points) {
+        const std::size_t amount_edges = p_spanning_tree.size();
+
+        for (std::size_t index_point = 0; index_point < amount_points; index_point++) {
+            labels[index_point] = components.find(index_point);
+            bounds[index_point].store(std::numeric_limits<double>::infinity(), std::memory_order_relaxed);
+        }
+
+        m_tree.label_nodes(labels, node_labels);
+
+        /* the nearest point of another component by square mutual reachability distance is found for each point */
+        parallel_for(std::size_t(0), amount_points, [this, &labels, &node_labels, &candidates, &bounds](const std::size_t p_index) {
+            const std::size_t label = labels[p_index];
+            const double core_distance = m_core_distances[p_index];
+
+            edge & candidate = candidates[p_index];
+            candidate = { p_index, NO_INDEX, std::numeric_limits<double>::infinity() };
+
+            std::atomic<double> & component_bound = bounds[label];
+            double bound = component_bound.load(std::memory_order_relaxed);
+            if (core_distance > bound) {
+                return;     /* edges of the point are not shorter than an edge that has been found for the component */
+            }
+
+            m_tree.find_nearest_excluding(m_data.row(p_index), bound, node_labels, label,
+                [this, label, core_distance, &labels, &candidate, &component_bound, &bound](const std::size_t p_neighbor, const double p_square_distance) {
+                    if (labels[p_neighbor] == label) {
+                        return;
+                    }
+
+                    const double distance = std::max({ p_square_distance, core_distance, m_core_distances[p_neighbor] });
+                    if ((distance < candidate.m_distance) || ((distance == candidate.m_distance) && (p_neighbor < candidate.m_point2))) {
+                        candidate.m_point2 = p_neighbor;
+                        candidate.m_distance = distance;
+
+                        double current = component_bound.load(std::memory_order_relaxed);
+                        while ((distance < current) && !component_bound.compare_exchange_weak(current, distance, std::memory_order_relaxed)) { }
+                    }
+
+                    bound = std::min(candidate.m_distance, component_bound.load(std::memory_order_relaxed));
+                });
+        });
+
+        std::fill(shortest.begin(), shortest.end(), NO_INDEX);
+        for (std::size_t index_point = 0; index_point < amount_points; index_point++) {
+            const std::size_t label = labels[index_point];
+            if ((candidates[index_point].m_point2 != NO_INDEX) && ((shortest[label] == NO_INDEX) || less(candidates[index_point], candidates[shortest[label]]))) {
+                shortest[label] = index_point;
+            }
+        }
+
+        for (const auto index_point : shortest) {
+            if (index_point == NO_INDEX) {
+                continue;
+            }
+
+            const edge & candidate = candidates[index_point];
+            if (components.unite(candidate.m_point1, candidate.m_point2)) {
+                p_spanning_tree.push_back({ candidate.m_point1, candidate.m_point2, std::sqrt(candidate.m_distance) });
+            }
+        }
+
+        if (p_spanning_tree.size() == amount_edges) {
+            throw std::runtime_error("Components of the spanning tree are not connected by any edge.");
+        }
+    }
+
+    std::sort(p_spanning_tree.begin(), p_spanning_tree.end(), less);
+}
+
+
+void hdbscan::condense_tree(std::vector<edge> & p_spanning_tree, std::vector<condensed_edge> & p_condensed_tree, std::size_t & p_amount_clusters) const {
+    const std::size_t amount_points = m_data.size();
+    const std::size_t amount_nodes = 2 * amount_points - 1;
+    const std::size_t root = amount_nodes - 1;
+
+    /* single-linkage hierarchy: node 'amount_points + i' merges two nodes by the i-th shortest edge */
+    std::vector<std::size_t> left(amount_points - 1), right(amount_points - 1), sizes(amount_nodes, 1);
+    std::vector<std::size_t> set_nodes(amount_points);
+    for (std::size_t index_point = 0; index_point < amount_points; index_point++) {
+        set_nodes[index_point] = index_point;
+    }
+
+    disjoint_set sets(amount_points);
+    for (std::size_t index_edge = 0; index_edge < p_spanning_tree.size(); index_edge++) {
+        const std::size_t root1 = sets.find(p_spanning_tree[index_edge].m_point1);
+        const std::size_t root2 = sets.find(p_spanning_tree[index_edge].m_point2);
+        const std::size_t index_node = amount_points + index_edge;
+
+        left[index_edge] = set_nodes[root1];
+        right[index_edge] = set_nodes[root2];
+        sizes[index_node] = sizes[left[index_edge]] + sizes[right[index_edge]];
+
+        sets.unite(root1, root2);
+        set_nodes[sets.find(root1)] = index_node;
+    }
+
+    /* nodes are condensed from the root, children of a node have smaller indexes */
+    std::vector<std::size_t> labels(amount_nodes, 0);
+    std::vector<double> lambdas(amount_nodes, 0.0);
+    std::vector<char> fallen(amount_nodes, 0);
+
+    p_condensed_tree.clear();
+    p_condensed_tree.reserve(amount_points + amount_points / m_minimum_cluster_size * 2);
+
+    std::size_t next_label = amount_points;
+    labels[root] = next_label++;
+
+    const auto fall_out = [amount_points, &labels, &lambdas, &fallen, &p_condensed_tree](const std::size_t p_node, const std::size_t p_parent, const double p_lambda) {
+        if (p_node < amount_points) {
+            p_condensed_tree.push_back({ p_parent, p_node, p_lambda, 1 });
+        }
+        else {
+            fallen[p_node] = 1;
+            labels[p_node] = p_parent;
+            lambdas[p_node] = p_lambda;
+        }
+    };
+
+    for (std::size_t index_node = root; index_node >= amount_points; index_node--) {
+        const std::size_t index_edge = index_node - amount_points;
+        const std::size_t child1 = left[index_edge];
+        const std::size_t child2 = right[index_edge];
+        const std::size_t parent = labels[index_node];
+
+        if (fallen[index_node]) {
+            fall_out(child1, parent, lambdas[index_node]);
+            fall_out(child2, parent, lambdas[index_node]);
+            continue;
+        }
+
+        const double distance = p_spanning_tree[index_edge].m_distance;
+        const double lambda = (distance > 0.0) ? 1.0 / distance : std::numeric_limits<double>::infinity();
+
+        const bool is_cluster1 = (sizes[child1] >= m_minimum_cluster_size);
+        const bool is_cluster2 = (sizes[child2] >= m_minimum_cluster_size);
+
+        if (is_cluster1 && is_cluster2) {
+            for (const auto child : { child1, child2 }) {
+                labels[child] = next_label++;
+                p_condensed_tree.push_back({ parent, labels[child], lambda, sizes[child] });
+            }
+        }
+        else if (is_cluster1) {
+            labels[child1] = parent;        /* the cluster continues and loses points of the small child */
+            fall_out(child2, parent, lambda);
+        }
+        else if (is_cluster2) {
+            labels[child2] = parent;
+            fall_out(child1, parent, lambda);
+        }
+        else {
+            fall_out(child1, parent, lambda);
+            fall_out(child2, parent, lambda);
+        }
+    }
+
+    p_amount_clusters = next_label - amount_points;
+}
+
+
+void hdbscan::extract_clusters(const std::vector<condensed_edge> & p_condensed_tree, const std::size_t p_amount_clusters) {
+    const std::size_t amount_points = m_data.size();
+
+    std::vector<std::size_t> parents(p_amount_clusters, NO_INDEX);
+    std::vector<double> births(p_amount_clusters, 0.0);
+    std::vector<double> stability(p_amount_clusters, 0.0);
+
+    for (const auto & condensed : p_condensed_tree) {
+        if (condensed.m_child >= amount_points) {
+            parents[condensed.m_child - amount_points] = condensed.m_parent - amount_points;
+            births[condensed.m_child - amount_points] = condensed.m_lambda;
+        }
+    }
+
+    for (const auto & condensed : p_condensed_tree) {
+        const std::size_t index_cluster = condensed.m_parent - amount_points;
+        const double birth = births[index_cluster];
+
+        /* lambda of points with zero distance is infinite, they do not change stability of a cluster that is born there */
+        const double excess = (condensed.m_lambda == birth) ? 0.0 : condensed.m_lambda - birth;
+        stability[index_cluster] += excess * condensed.m_size;
+    }
+
+    /* a cluster is selected if it is more stable than its selected descendants, the root is not selected */
+    std::vector<char> chosen(p_amount_clusters, 0);
+    std::vector<double> subtree_stability(p_amount_clusters, 0.0);
+    for (std::size_t index_cluster = p_amount_clusters; index_cluster-- > 1;) {
+        if (subtree_stability[index_cluster] > stability[index_cluster]) {
+            stability[index_cluster] = subtree_stability[index_cluster];
+        }
+        else {
+            chosen[index_cluster] = 1;
+        }
+
+        subtree_stability[parents[index_cluster]] += stability[index_cluster];
+    }
+
+    std::vector<std::size_t> selected(p_amount_clusters, NO_INDEX);     /* selected cluster that contains each cluster */
+    for (std::size_t index_cluster = 1; index_cluster < p_amount_clusters; index_cluster++) {
+        const std::size_t parent_selected = selected[parents[index_cluster]];
+        selected[index_cluster] = (parent_selected != NO_INDEX) ? parent_selected : (chosen[index_cluster] ? index_cluster : NO_INDEX);
+    }
+
+    std::vector<std::size_t> point_clusters(amount_points, NO_INDEX);
+    for (const auto & condensed : p_condensed_tree) {
+        if (condensed.m_child < amount_points) {
+            point_clusters[condensed.m_child] = selected[condensed.m_parent - amount_points];
+        }
+    }
+
+    cluster_sequence & clusters = m_result_ptr->clusters();
+    std::vector<std::size_t> numbers(p_amount_clusters, NO_INDEX);
+
+    for (std::size_t index_point = 0; index_point < amount_points; index_point++) {
+        const std::size_t index_cluster = point_clusters[index_point];
+        if (index_cluster == NO_INDEX) {
+            m_result_ptr->noise().push_back(index_point);
+            continue;
+        }
+
+        if (numbers[index_cluster] == NO_INDEX) {
+            numbers[index_cluster] = clusters.size();
+            clusters.emplace_back();
+            m_result_ptr->stability().push_back(stability[index_cluster]);
+        }
+
+        clusters[numbers[index_cluster]].push_back(index_point);
+    }
+}
+
+
+}
+
+}
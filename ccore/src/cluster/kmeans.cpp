@@ -8,9 +8,14 @@
 
 #include <pyclustering/cluster/kmeans.hpp>
 
+#include <pyclustering/cluster/blocked_assignment.hpp>
+
 #include <pyclustering/parallel/parallel.hpp>
 
+#include <pyclustering/utils/simd.hpp>
+
 #include <algorithm>
+#include <iterator>
 #include <limits>
 #include <unordered_map>
 
@@ -30,14 +35,16 @@ const double             kmeans::DEFAULT_TOLERANCE                       = 0.001
 
 const std::size_t        kmeans::DEFAULT_ITERMAX                         = 100;
 
+const std::size_t        kmeans::ELKAN_MINIMUM_CLUSTERS                  = 32;
+
 
-kmeans::kmeans(const dataset & p_initial_centers, const double p_tolerance, const std::size_t p_itermax, const distance_metric<point> & p_metric) :
+kmeans::kmeans(const dataset & p_initial_centers, const double p_tolerance, const std::size_t p_itermax, const distance_metric<point> & p_metric, const kmeans_acceleration p_acceleration) :
     m_tolerance(p_tolerance),
     m_itermax(p_itermax),
     m_initial_centers(p_initial_centers),
     m_ptr_result(nullptr),
-    m_ptr_data(nullptr),
-    m_metric(p_metric)
+    m_metric(p_metric),
+    m_acceleration(p_acceleration)
 { }
 
 
@@ -47,12 +54,22 @@ void kmeans::process(const dataset & p_data, kmeans_data & p_result) {
 
 
 void kmeans::process(const dataset & p_data, const index_sequence & p_indexes, kmeans_data & p_result) {
-    m_ptr_data = &p_data;
+    process(container::dense_dataset(p_data), p_indexes, p_result);
+}
+
+
+void kmeans::process(const container::dense_dataset_view & p_data, kmeans_data & p_result) {
+    process(p_data, { }, p_result);
+}
+
+
+void kmeans::process(const container::dense_dataset_view & p_data, const index_sequence & p_indexes, kmeans_data & p_result) {
+    m_data = p_data;
     m_ptr_indexes = &p_indexes;
 
     m_ptr_result = &p_result;
 
-    if (p_data[0].size() != m_initial_centers[0].size()) {
+    if (p_data.dimension() != m_initial_centers[0].size()) {
         throw std::invalid_argument("Dimension of the input data and dimension of the initial cluster centers must be the same.");
     }
 
@@ -66,30 +83,319 @@ void kmeans::process(const dataset & p_data, const index_sequence & p_indexes, k
         m_ptr_result->evolution_clusters().push_back(sequence);
     }
 
+    const kmeans_acceleration acceleration = get_acceleration();
+    if (acceleration != kmeans_acceleration::NONE) {
+        process_accelerated(acceleration);
+    }
+    else {
+        double current_change = std::numeric_limits<double>::max();
+
+        for(std::size_t iteration = 0; iteration < m_itermax && current_change > m_tolerance; iteration++) {
+            update_clusters(m_ptr_result->centers(), m_ptr_result->clusters());
+            current_change = update_centers(m_ptr_result->clusters(), m_ptr_result->centers());
+
+            if (m_ptr_result->is_observed()) {
+                m_ptr_result->evolution_centers().push_back(m_ptr_result->centers());
+                m_ptr_result->evolution_clusters().push_back(m_ptr_result->clusters());
+            }
+        }
+    }
+
+    calculate_total_wce();
+}
+
+
+kmeans_acceleration kmeans::get_acceleration() const {
+    switch (m_metric.kind()) {
+    case metric_kind::EUCLIDEAN:
+    case metric_kind::EUCLIDEAN_SQUARE:
+    case metric_kind::MANHATTAN:
+    case metric_kind::CHEBYSHEV:
+        break;
+    default:
+        return kmeans_acceleration::NONE;
+    }
+
+    if (m_acceleration == kmeans_acceleration::AUTO) {
+        return (m_initial_centers.size() < ELKAN_MINIMUM_CLUSTERS) ? kmeans_acceleration::HAMERLY : kmeans_acceleration::ELKAN;
+    }
+
+    return m_acceleration;
+}
+
+
+void kmeans::process_accelerated(const kmeans_acceleration p_acceleration) {
+    /* bounds are kept in metric space, square Euclidean distance is replaced by Euclidean that has the same nearest centers */
+    switch (m_metric.kind()) {
+    case metric_kind::EUCLIDEAN:
+    case metric_kind::EUCLIDEAN_SQUARE:
+        process_bounded(p_acceleration, euclidean_kernel());
+        break;
+    case metric_kind::MANHATTAN:
+        process_bounded(p_acceleration, manhattan_kernel());
+        break;
+    case metric_kind::CHEBYSHEV:
+        process_bounded(p_acceleration, chebyshev_kernel());
+        break;
+    default:
+        throw std::invalid_argument("Bounds are not supported for the metric.");
+    }
+}
+
+
+template <typename TypeDistance>
+void kmeans::process_bounded(const kmeans_acceleration p_acceleration, const TypeDistance & p_distance) {
+    const bool elkan = (p_acceleration == kmeans_acceleration::ELKAN);
+    const std::size_t amount_points = m_ptr_indexes->empty() ? m_data.size() : m_ptr_indexes->size();
+
+    const auto point_index = [this](const std::size_t p_position) {
+        return m_ptr_indexes->empty() ? p_position : (*m_ptr_indexes)[p_position];
+    };
+
+    dataset & centers = m_ptr_result->centers();
+    cluster_sequence & clusters = m_ptr_result->clusters();
+
+    std::size_t amount_centers = centers.size();
+
+    index_sequence labels(amount_points, 0);
+    std::vector<double> upper(amount_points, 0.0);                                    /* upper bound of distance to own center */
+    std::vector<double> lower(elkan ? amount_points * amount_centers : amount_points, 0.0);   /* lower bound(s) of distance to other centers */
+    std::vector<double> half_distances;                                                 /* half distances between centers (Elkan) */
+    std::vector<double> separation;                                                     /* half distance to the nearest other center */
+
     double current_change = std::numeric_limits<double>::max();
 
     for(std::size_t iteration = 0; iteration < m_itermax && current_change > m_tolerance; iteration++) {
-        update_clusters(m_ptr_result->centers(), m_ptr_result->clusters());
-        current_change = update_centers(m_ptr_result->clusters(), m_ptr_result->centers());
+        if (iteration == 0) {
+            /* bounds are initialized by distances to all centers */
+            parallel_for(std::size_t(0), amount_points, [&](const std::size_t p_position) {
+                const container::point_view current_point = m_data[point_index(p_position)];
+
+                double nearest = std::numeric_limits<double>::max(), second = std::numeric_limits<double>::max();
+                std::size_t index_nearest = 0;
+
+                for (std::size_t index_center = 0; index_center < amount_centers; index_center++) {
+                    const double distance = p_distance(current_point, container::point_view(centers[index_center]));
+                    if (elkan) {
+                        lower[p_position * amount_centers + index_center] = distance;
+                    }
+
+                    if (distance < nearest) {
+                        second = nearest;
+                        nearest = distance;
+                        index_nearest = index_center;
+                    }
+                    else if (distance < second) {
+                        second = distance;
+                    }
+                }
+
+                labels[p_position] = index_nearest;
+                upper[p_position] = nearest;
+                if (!elkan) {
+                    lower[p_position] = second;
+                }
+            });
+        }
+        else {
+            half_distances.assign(amount_centers * amount_centers, 0.0);
+            separation.assign(amount_centers, std::numeric_limits<double>::max());
+
+            for (std::size_t i = 0; i < amount_centers; i++) {
+                for (std::size_t j = i + 1; j < amount_centers; j++) {
+                    const double half_distance = 0.5 * p_distance(container::point_view(centers[i]), container::point_view(centers[j]));
+
+                    half_distances[i * amount_centers + j] = half_distance;
+                    half_distances[j * amount_centers + i] = half_distance;
+
+                    separation[i] = std::min(separation[i], half_distance);
+                    separation[j] = std::min(separation[j], half_distance);
+                }
+            }
+
+            parallel_for(std::size_t(0), amount_points, [&](const std::size_t p_position) {
+                std::size_t index_owner = labels[p_position];
+                double bound = upper[p_position];
+
+                if (!elkan) {
+                    const double threshold = std::max(separation[index_owner], lower[p_position]);
+                    if (bound <= threshold) {
+                        return;
+                    }
+
+                    const container::point_view current_point = m_data[point_index(p_position)];
+
+                    bound = p_distance(current_point, container::point_view(centers[index_owner]));
+                    upper[p_position] = bound;
+                    if (bound <= threshold) {
+                        return;
+                    }
+
+                    double nearest = std::numeric_limits<double>::max(), second = std::numeric_limits<double>::max();
+                    for (std::size_t index_center = 0; index_center < amount_centers; index_center++) {
+                        const double distance = (index_center == index_owner) ? bound :
+                            p_distance(current_point, container::point_view(centers[index_center]));
+
+                        if (distance < nearest) {
+                            second = nearest;
+                            nearest = distance;
+                            labels[p_position] = index_center;
+                        }
+                        else if (distance < second) {
+                            second = distance;
+                        }
+                    }
+
+                    upper[p_position] = nearest;
+                    lower[p_position] = second;
+                }
+                else {
+                    if (bound <= separation[index_owner]) {
+                        return;
+                    }
+
+                    const container::point_view current_point = m_data[point_index(p_position)];
+                    double * point_lower = lower.data() + p_position * amount_centers;
+
+                    bool tight = false;
+                    for (std::size_t index_center = 0; index_center < amount_centers; index_center++) {
+                        if (index_center == index_owner) {
+                            continue;
+                        }
+
+                        const double half_distance = half_distances[index_owner * amount_centers + index_center];
+                        if ((bound <= point_lower[index_center]) || (bound <= half_distance)) {
+                            continue;
+                        }
+
+                        if (!tight) {
+                            bound = p_distance(current_point, container::point_view(centers[index_owner]));
+                            point_lower[index_owner] = bound;
+                            tight = true;
+
+                            if ((bound <= point_lower[index_center]) || (bound <= half_distance)) {
+                                continue;
+                            }
+                        }
+
+                        const double distance = p_distance(current_point, container::point_view(centers[index_center]));
+                        point_lower[index_center] = distance;
+
+                        if (distance < bound) {
+                            bound = distance;
+                            index_owner = index_center;
+                        }
+                    }
+
+                    labels[p_position] = index_owner;
+                    upper[p_position] = bound;
+                }
+            });
+        }
+
+        clusters.assign(amount_centers, cluster());
+        for (std::size_t position = 0; position < amount_points; position++) {
+            clusters[labels[position]].push_back(point_index(position));
+        }
+
+        if (std::any_of(clusters.begin(), clusters.end(), [](const cluster & p_cluster) { return p_cluster.empty(); })) {
+            /* centers of empty clusters are removed, labels and bounds are compacted in line with remaining centers */
+            const std::size_t removed = amount_centers;
+            index_sequence new_indexes(amount_centers, removed);
+            std::size_t amount_remaining = 0;
+            for (std::size_t index_center = 0; index_center < amount_centers; index_center++) {
+                if (clusters[index_center].empty()) {
+                    continue;
+                }
+
+                new_indexes[index_center] = amount_remaining;
+                if (amount_remaining != index_center) {
+                    centers[amount_remaining] = std::move(centers[index_center]);
+                    clusters[amount_remaining] = std::move(clusters[index_center]);
+                }
+
+                amount_remaining++;
+            }
+
+            /* lower bounds are only moved towards the beginning of the storage, therefore they are compacted in place */
+            for (std::size_t position = 0; position < amount_points; position++) {
+                if (elkan) {
+                    for (std::size_t index_center = 0; index_center < amount_centers; index_center++) {
+                        if (new_indexes[index_center] != removed) {
+                            lower[position * amount_remaining + new_indexes[index_center]] = lower[position * amount_centers + index_center];
+                        }
+                    }
+                }
+
+                labels[position] = new_indexes[labels[position]];
+            }
+
+            centers.resize(amount_remaining);
+            clusters.resize(amount_remaining);
+            if (elkan) {
+                lower.resize(amount_points * amount_remaining);
+            }
+
+            amount_centers = amount_remaining;
+        }
+
+        const dataset previous_centers = centers;
+        current_change = update_centers(clusters, centers);
+
+        /* bounds are moved in line with drift of centers */
+        std::vector<double> drifts(amount_centers, 0.0);
+        std::size_t index_maximum_drift = 0;
+        for (std::size_t index_center = 0; index_center < amount_centers; index_center++) {
+            drifts[index_center] = p_distance(container::point_view(previous_centers[index_center]), container::point_view(centers[index_center]));
+            if (drifts[index_center] > drifts[index_maximum_drift]) {
+                index_maximum_drift = index_center;
+            }
+        }
+
+        double second_drift = 0.0;
+        for (std::size_t index_center = 0; index_center < amount_centers; index_center++) {
+            if (index_center != index_maximum_drift) {
+                second_drift = std::max(second_drift, drifts[index_center]);
+            }
+        }
+
+        parallel_for(std::size_t(0), amount_points, [&](const std::size_t p_position) {
+            const std::size_t index_owner = labels[p_position];
+            upper[p_position] += drifts[index_owner];
+
+            if (elkan) {
+                double * point_lower = lower.data() + p_position * amount_centers;
+                for (std::size_t index_center = 0; index_center < amount_centers; index_center++) {
+                    point_lower[index_center] = std::max(point_lower[index_center] - drifts[index_center], 0.0);
+                }
+            }
+            else {
+                lower[p_position] -= (index_owner == index_maximum_drift) ? second_drift : drifts[index_maximum_drift];
+            }
+        });
 
         if (m_ptr_result->is_observed()) {
-            m_ptr_result->evolution_centers().push_back(m_ptr_result->centers());
-            m_ptr_result->evolution_clusters().push_back(m_ptr_result->clusters());
+            m_ptr_result->evolution_centers().push_back(centers);
+            m_ptr_result->evolution_clusters().push_back(clusters);
         }
     }
-
-    calculate_total_wce();
 }
 
 
 void kmeans::update_clusters(const dataset & p_centers, cluster_sequence & p_clusters) {
-    const dataset & data = *m_ptr_data;
+    const container::dense_dataset_view & data = m_data;
 
     p_clusters.clear();
     p_clusters.resize(p_centers.size());
 
     /* fill clusters again in line with centers. */
-    if (m_ptr_indexes->empty()) {
+    if (blocked_assignment::is_applicable(m_metric)) {
+        assign_points_blocked(p_centers, p_clusters);
+    }
+    else if (utils::simd::is_supported(m_metric.kind())) {
+        assign_points_vectorized(p_centers, p_clusters);
+    }
+    else if (m_ptr_indexes->empty()) {
         index_sequence winners(data.size(), 0);
         parallel_for(std::size_t(0), data.size(), [this, &p_centers, &winners](std::size_t p_index) {
             assign_point_to_cluster(p_index, p_centers, winners);
@@ -119,20 +425,80 @@ void kmeans::update_clusters(const dataset & p_centers, cluster_sequence & p_clu
 }
 
 
-void kmeans::assign_point_to_cluster(const std::size_t p_index_point, const dataset & p_centers, index_sequence & p_clusters) {
-    double    minimum_distance = std::numeric_limits<double>::max();
-    size_t    suitable_index_cluster = 0;
+void kmeans::assign_points_blocked(const dataset & p_centers, cluster_sequence & p_clusters) {
+    const blocked_assignment assignment(p_centers);
+    index_sequence winners(m_data.size(), 0);
+
+    const std::size_t block = blocked_assignment::POINT_BLOCK;
+    if (m_ptr_indexes->empty()) {
+        parallel_for(std::size_t(0), m_data.size(), block, [this, &assignment, &winners, block](const std::size_t p_begin) {
+            assignment.assign(m_data, p_begin, std::min(p_begin + block, m_data.size()), winners);
+        });
+
+        for (std::size_t index_point = 0; index_point < winners.size(); index_point++) {
+            p_clusters[winners[index_point]].push_back(index_point);
+        }
+    }
+    else {
+        const index_sequence & indexes = *m_ptr_indexes;
+        parallel_for(std::size_t(0), indexes.size(), block, [this, &assignment, &indexes, &winners, block](const std::size_t p_begin) {
+            assignment.assign(m_data, indexes, p_begin, std::min(p_begin + block, indexes.size()), winners);
+        });
+
+        for (std::size_t index_point : indexes) {
+            p_clusters[winners[index_point]].push_back(index_point);
+        }
+    }
+}
+
 
-    for (size_t index_cluster = 0; index_cluster < p_centers.size(); index_cluster++) {
-        double distance = m_metric(p_centers[index_cluster], (*m_ptr_data)[p_index_point]);
+void kmeans::assign_points_vectorized(const dataset & p_centers, cluster_sequence & p_clusters) {
+    /* centers are stored contiguously to calculate distances from a point to all of them by vectorized kernels */
+    const container::dense_dataset centers(p_centers);
+    const index_sequence & indexes = *m_ptr_indexes;
+    const std::size_t amount = indexes.empty() ? m_data.size() : indexes.size();
 
-        if (distance < minimum_distance) {
-            minimum_distance = distance;
-            suitable_index_cluster = index_cluster;
+    index_sequence winners(m_data.size(), 0);
+
+    const std::size_t block = blocked_assignment::POINT_BLOCK;
+    parallel_for(std::size_t(0), amount, block, [this, &centers, &indexes, &winners, amount, block](const std::size_t p_begin) {
+        std::vector<double> distances(centers.size());
+
+        for (std::size_t i = p_begin; i < std::min(p_begin + block, amount); i++) {
+            const std::size_t index_point = indexes.empty() ? i : indexes[i];
+            utils::simd::distance(m_metric.kind(), m_data[index_point], centers, distances.data());
+
+            /* the first center wins in case of equal distances as in the point by point assignment */
+            winners[index_point] = std::distance(distances.begin(), std::min_element(distances.begin(), distances.end()));
         }
+    });
+
+    for (std::size_t i = 0; i < amount; i++) {
+        const std::size_t index_point = indexes.empty() ? i : indexes[i];
+        p_clusters[winners[index_point]].push_back(index_point);
     }
+}
+
+
+void kmeans::assign_point_to_cluster(const std::size_t p_index_point, const dataset & p_centers, index_sequence & p_clusters) {
+    const container::point_view current_point = m_data[p_index_point];
+
+    /* the metric is dispatched once per point, distances to centers are calculated by the inlined kernel */
+    p_clusters[p_index_point] = visit(m_metric, [&p_centers, &current_point](const auto & p_distance) {
+        double    minimum_distance = std::numeric_limits<double>::max();
+        size_t    suitable_index_cluster = 0;
 
-    p_clusters[p_index_point] = suitable_index_cluster;
+        for (size_t index_cluster = 0; index_cluster < p_centers.size(); index_cluster++) {
+            const double distance = p_distance(container::point_view(p_centers[index_cluster]), current_point);
+
+            if (distance < minimum_distance) {
+                minimum_distance = distance;
+                suitable_index_cluster = index_cluster;
+            }
+        }
+
+        return suitable_index_cluster;
+    });
 }
 
 
@@ -146,8 +512,7 @@ void kmeans::erase_empty_clusters(cluster_sequence & p_clusters) {
 
 
 double kmeans::update_centers(const cluster_sequence & clusters, dataset & centers) {
-    const dataset & data = *m_ptr_data;
-    const size_t dimension = data[0].size();
+    const size_t dimension = m_data.dimension();
 
     dataset calculated_clusters(clusters.size(), point(dimension, 0.0));
     std::vector<double> changes(clusters.size(), 0.0);
@@ -168,9 +533,11 @@ double kmeans::update_center(const cluster & p_cluster, point & p_center) {
 
     /* for each object in cluster */
     for (auto object_index : p_cluster) {
+        const double * object = m_data.row(object_index);
+
         /* for each dimension */
         for (size_t dimension = 0; dimension < total.size(); dimension++) {
-            total[dimension] += (*m_ptr_data)[object_index][dimension];
+            total[dimension] += object[dimension];
         }
     }
 
@@ -193,7 +560,7 @@ void kmeans::calculate_total_wce() {
         const auto & cluster_center = m_ptr_result->centers().at(i);
 
         for (const auto & cluster_point : current_cluster) {
-            wce += m_metric(m_ptr_data->at(cluster_point), cluster_center);
+            wce += m_metric(m_data[cluster_point], cluster_center);
         }
     }
 }
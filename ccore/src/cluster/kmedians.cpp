@@ -35,16 +35,20 @@ kmedians::kmedians(const dataset & p_initial_medians, const double p_tolerance,
     m_max_iter(p_max_iter),
     m_initial_medians(p_initial_medians),
     m_ptr_result(nullptr),
-    m_ptr_data(nullptr),
     m_metric(p_metric)
 { }
 
 
 void kmedians::process(const dataset & p_data, kmedians_data & p_output_result) {
-    m_ptr_data = &p_data;
+    process(container::dense_dataset(p_data), p_output_result);
+}
+
+
+void kmedians::process(const container::dense_dataset_view & p_data, kmedians_data & p_output_result) {
+    m_data = p_data;
     m_ptr_result = &p_output_result;
 
-    if (p_data[0].size() != m_initial_medians[0].size()) {
+    if (p_data.dimension() != m_initial_medians[0].size()) {
         throw std::invalid_argument("kmedians: dimension of the input data and dimension of the initial medians must be equal.");
     }
 
@@ -71,13 +75,13 @@ void kmedians::process(const dataset & p_data, kmedians_data & p_output_result)
         prev_changes = changes;
     }
 
-    m_ptr_data = nullptr;
+    m_data = { };
     m_ptr_result = nullptr;
 }
 
 
 void kmedians::update_clusters(const dataset & p_medians, cluster_sequence & p_clusters) {
-    const dataset & data = *m_ptr_data;
+    const container::dense_dataset_view & data = m_data;
 
     p_clusters.clear();
     p_clusters.resize(p_medians.size());
@@ -98,18 +102,22 @@ void kmedians::update_clusters(const dataset & p_medians, cluster_sequence & p_c
 
 
 void kmedians::assign_point_to_cluster(const std::size_t p_index_point, const dataset & p_medians, index_sequence & p_lables) {
-    size_t index_cluster_optim = 0;
-    double distance_optim = std::numeric_limits<double>::max();
-
-    for (size_t index_cluster = 0; index_cluster < p_medians.size(); index_cluster++) {
-        double distance = m_metric((*m_ptr_data)[p_index_point], p_medians[index_cluster]);
-        if (distance < distance_optim) {
-            index_cluster_optim = index_cluster;
-            distance_optim = distance;
+    const container::point_view current_point = m_data[p_index_point];
+
+    p_lables[p_index_point] = visit(m_metric, [&p_medians, &current_point](const auto & p_distance) {
+        size_t index_cluster_optim = 0;
+        double distance_optim = std::numeric_limits<double>::max();
+
+        for (size_t index_cluster = 0; index_cluster < p_medians.size(); index_cluster++) {
+            const double distance = p_distance(current_point, container::point_view(p_medians[index_cluster]));
+            if (distance < distance_optim) {
+                index_cluster_optim = index_cluster;
+                distance_optim = distance;
+            }
         }
-    }
 
-    p_lables[p_index_point] = index_cluster_optim;
+        return index_cluster_optim;
+    });
 }
 
 
@@ -123,8 +131,7 @@ void kmedians::erase_empty_clusters(cluster_sequence & p_clusters) {
 
 
 double kmedians::update_medians(cluster_sequence & clusters, dataset & medians) {
-    const dataset & data = *m_ptr_data;
-    const std::size_t dimension = data[0].size();
+    const std::size_t dimension = m_data.dimension();
 
     std::vector<point> prev_medians(medians);
 
@@ -143,14 +150,16 @@ double kmedians::update_medians(cluster_sequence & clusters, dataset & medians)
 
 
 void kmedians::calculate_median(cluster & current_cluster, point & median) {
-    const dataset & data = *m_ptr_data;
-    const std::size_t dimension = data[0].size();
+    const container::dense_dataset_view & data = m_data;
+    const std::size_t dimension = data.dimension();
 
     for (size_t index_dimension = 0; index_dimension < dimension; index_dimension++) {
         std::sort(current_cluster.begin(), current_cluster.end(), 
             [this](std::size_t index_object1, std::size_t index_object2) 
         {
-            return (*m_ptr_data)[index_object1] > (*m_ptr_data)[index_object2];
+            const container::point_view object1 = m_data[index_object1];
+            const container::point_view object2 = m_data[index_object2];
+            return std::lexicographical_compare(object2.begin(), object2.end(), object1.begin(), object1.end());
         });
 
         std::size_t relative_index_median = (std::size_t) (current_cluster.size() - 1) / 2;
@@ -14,6 +14,8 @@
 
 #include <pyclustering/parallel/parallel.hpp>
 
+#include <pyclustering/utils/simd.hpp>
+
 
 using namespace pyclustering::parallel;
 
@@ -33,6 +35,8 @@ const std::size_t        kmedoids::INVALID_INDEX             = std::numeric_limi
 
 const double             kmedoids::NOTHING_TO_SWAP           = std::numeric_limits<double>::max();
 
+constexpr std::size_t    kmedoids::DISTANCE_BLOCK;
+
 
 kmedoids::appropriate_cluster::appropriate_cluster(const std::size_t p_index, const double p_distance_first_medoid, const double p_distance_second_medoid) :
     m_index(p_index),
@@ -45,7 +49,6 @@ kmedoids::kmedoids(const medoid_sequence & p_initial_medoids,
                    const double p_tolerance,
                    const std::size_t p_itermax,
                    const distance_metric<point> & p_metric) :
-    m_data_ptr(nullptr),
     m_result_ptr(nullptr),
     m_initial_medoids(p_initial_medoids),
     m_tolerance(p_tolerance),
@@ -63,9 +66,15 @@ void kmedoids::process(const dataset & p_data, kmedoids_data & p_result) {
 
 
 void kmedoids::process(const dataset & p_data, const data_t p_type, kmedoids_data & p_result) {
-    m_data_ptr = &p_data;
+    process(container::dense_dataset(p_data), p_type, p_result);
+}
+
+
+void kmedoids::process(const container::dense_dataset_view & p_data, const data_t p_type, kmedoids_data & p_result) {
+    m_data = p_data;
     m_result_ptr = (kmedoids_data *) &p_result;
     m_calculator = create_distance_calculator(p_type);
+    m_vectorized = (p_type == data_t::POINTS) && utils::simd::is_supported(m_metric.kind());
 
     medoid_sequence & medoids = m_result_ptr->medoids();
     medoids.assign(m_initial_medoids.begin(), m_initial_medoids.end());
@@ -98,7 +107,7 @@ void kmedoids::process(const dataset & p_data, const data_t p_type, kmedoids_dat
 
     erase_empty_clusters();
 
-    m_data_ptr = nullptr;
+    m_data = { };
     m_result_ptr = nullptr;
 }
 
@@ -110,13 +119,13 @@ double kmedoids::update_clusters() {
     clusters.clear();
     clusters.resize(medoids.size());
 
-    std::vector<appropriate_cluster> cluster_markers(m_data_ptr->size());
-    parallel_for(std::size_t(0), m_data_ptr->size(), [this, &medoids, &cluster_markers](const std::size_t p_index) {
+    std::vector<appropriate_cluster> cluster_markers(m_data.size());
+    parallel_for(std::size_t(0), m_data.size(), [this, &medoids, &cluster_markers](const std::size_t p_index) {
         cluster_markers[p_index] = find_appropriate_cluster(p_index, medoids);
     });
 
     double total_deviation = 0.0;
-    for (std::size_t index_point = 0; index_point < m_data_ptr->size(); index_point++) {
+    for (std::size_t index_point = 0; index_point < m_data.size(); index_point++) {
         const std::size_t index_optim = cluster_markers[index_point].m_index;
 
         total_deviation += cluster_markers[index_point].m_distance_to_first_medoid;
@@ -134,13 +143,16 @@ double kmedoids::update_clusters() {
 
 kmedoids::distance_calculator kmedoids::create_distance_calculator(const data_t p_type) {
     if (p_type == data_t::POINTS) {
-        return [this](const std::size_t index1, const std::size_t index2) {
-          return m_metric((*m_data_ptr)[index1], (*m_data_ptr)[index2]); 
-        };
+        /* the kernel of the metric is captured by the calculator to avoid the second indirect call per distance */
+        return utils::metric::visit(m_metric, [this](const auto & p_distance) -> distance_calculator {
+            return [this, p_distance](const std::size_t index1, const std::size_t index2) {
+                return p_distance(m_data[index1], m_data[index2]);
+            };
+        });
     }
     else if (p_type == data_t::DISTANCE_MATRIX) {
         return [this](const std::size_t index1, const std::size_t index2) {
-          return (*m_data_ptr)[index1][index2];
+          return m_data.row(index1)[index2];
         };
     }
     else {
@@ -189,7 +201,7 @@ double kmedoids::swap_medoids() {
     pyclustering::parallel::parallel_for(std::size_t(0), cluster_chunks.size(), [this, &cluster_chunks, &medoids](std::size_t index_cluster) {
         optimal_chunk & chunk = cluster_chunks[index_cluster];
 
-        for (std::size_t candidate_medoid_index = 0; candidate_medoid_index < m_data_ptr->size(); candidate_medoid_index++) {
+        for (std::size_t candidate_medoid_index = 0; candidate_medoid_index < m_data.size(); candidate_medoid_index++) {
             const bool is_already_medoid = std::find(medoids.cbegin(), medoids.cend(), candidate_medoid_index) != medoids.cend();
             if (is_already_medoid || (m_distance_first_medoid[candidate_medoid_index] == 0.0)) {
                 continue;
@@ -222,8 +234,8 @@ double kmedoids::swap_medoids() {
 
 double kmedoids::calculate_swap_cost(const std::size_t p_index_candidate, const std::size_t p_index_cluster) const {
 #if PARALLEL_KMEDOIDS_CALCULATE_SWAP_COST
-    std::vector<double> point_cost(m_data_ptr->size(), 0);
-    pyclustering::parallel::parallel_for(std::size_t(0), m_data_ptr->size(), [this, &p_index_candidate, &p_index_cluster, &point_cost](std::size_t p_index) {
+    std::vector<double> point_cost(m_data.size(), 0);
+    pyclustering::parallel::parallel_for(std::size_t(0), m_data.size(), [this, &p_index_candidate, &p_index_cluster, &point_cost](std::size_t p_index) {
         if (p_index != p_index_candidate) {
             const double candidate_distance = m_calculator(p_index, p_index_candidate);
             if (m_labels[p_index] == p_index_cluster) {
@@ -239,17 +251,25 @@ double kmedoids::calculate_swap_cost(const std::size_t p_index_candidate, const
     return cost - m_distance_first_medoid[p_index_candidate];
 #else
     double cost = 0.0;
-    for (std::size_t index_point = 0; index_point < m_data_ptr->size(); ++index_point) {
-        if (index_point == p_index_candidate) {
-            continue;
-        }
+    double distances[DISTANCE_BLOCK];
 
-        const double candidate_distance = m_calculator(index_point, p_index_candidate);
-        if (m_labels[index_point] == p_index_cluster) {
-            cost += std::min(candidate_distance, m_distance_second_medoid[index_point]) - m_distance_first_medoid[index_point];
-        }
-        else if (candidate_distance < m_distance_first_medoid[index_point]) {
-            cost += candidate_distance - m_distance_first_medoid[index_point];
+    for (std::size_t block_begin = 0; block_begin < m_data.size(); block_begin += DISTANCE_BLOCK) {
+        const std::size_t amount = std::min(DISTANCE_BLOCK, m_data.size() - block_begin);
+        calculate_distances(p_index_candidate, block_begin, amount, distances);
+
+        for (std::size_t i = 0; i < amount; i++) {
+            const std::size_t index_point = block_begin + i;
+            if (index_point == p_index_candidate) {
+                continue;
+            }
+
+            const double candidate_distance = distances[i];
+            if (m_labels[index_point] == p_index_cluster) {
+                cost += std::min(candidate_distance, m_distance_second_medoid[index_point]) - m_distance_first_medoid[index_point];
+            }
+            else if (candidate_distance < m_distance_first_medoid[index_point]) {
+                cost += candidate_distance - m_distance_first_medoid[index_point];
+            }
         }
     }
 
@@ -258,6 +278,18 @@ double kmedoids::calculate_swap_cost(const std::size_t p_index_candidate, const
 }
 
 
+void kmedoids::calculate_distances(const std::size_t p_index, const std::size_t p_begin, const std::size_t p_amount, double * p_result) const {
+    if (m_vectorized) {
+        utils::simd::distance(m_metric.kind(), m_data.row(p_index), m_data.row(p_begin), p_amount, m_data.dimension(), m_data.stride(), p_result);
+    }
+    else {
+        for (std::size_t i = 0; i < p_amount; i++) {
+            p_result[i] = m_calculator(p_begin + i, p_index);
+        }
+    }
+}
+
+
 void kmedoids::erase_empty_clusters() {
     auto & clusters = m_result_ptr->clusters();
     auto & medoids = m_result_ptr->medoids();
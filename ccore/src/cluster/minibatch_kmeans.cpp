@@ -0,0 +1,372 @@
+/*!
+
+@authors Andrei Novikov (pyclustering@yandex.ru)
+@date 2014-2020
+@copyright BSD-3-Clause
+
+*/
+
+
+#include <pyclustering/cluster/minibatch_kmeans.hpp>
+
+#include <pyclustering/cluster/blocked_assignment.hpp>
+#include <pyclustering/cluster/kmeans_plus_plus.hpp>
+
+#include <pyclustering/parallel/parallel.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <limits>
+#include <stdexcept>
+
+
+using namespace pyclustering::parallel;
+
+
+namespace pyclustering {
+
+namespace clst {
+
+
+const double            minibatch_kmeans::DEFAULT_TOLERANCE         = 0.001;
+
+const std::size_t       minibatch_kmeans::DEFAULT_ITERMAX           = 100;
+
+const std::size_t       minibatch_kmeans::DEFAULT_BATCH_SIZE        = 1024;
+
+const std::size_t       minibatch_kmeans::DEFAULT_RESERVOIR_SIZE    = 10000;
+
+const std::size_t       minibatch_kmeans::DEFAULT_WARM_UP_SIZE      = 100000;
+
+
+minibatch_kmeans::minibatch_kmeans(const std::size_t p_amount_clusters,
+                                   const std::size_t p_batch_size,
+                                   const std::size_t p_reservoir_size,
+                                   const std::size_t p_warm_up_size,
+                                   const double p_tolerance,
+                                   const std::size_t p_itermax,
+                                   const distance_metric<point> & p_metric,
+                                   const long long p_random_state) :
+    m_amount_clusters(p_amount_clusters),
+    m_batch_size(p_batch_size),
+    m_reservoir_size(p_reservoir_size),
+    m_warm_up_size(p_warm_up_size),
+    m_tolerance(p_tolerance),
+    m_itermax(p_itermax),
+    m_metric(p_metric),
+    m_random_state(p_random_state)
+{
+    initialize_random_generator();
+}
+
+
+minibatch_kmeans::minibatch_kmeans(const dataset & p_initial_centers,
+                                   const std::size_t p_batch_size,
+                                   const double p_tolerance,
+                                   const std::size_t p_itermax,
+                                   const distance_metric<point> & p_metric,
+                                   const long long p_random_state) :
+    m_amount_clusters(p_initial_centers.size()),
+    m_batch_size(p_batch_size),
+    m_reservoir_size(p_initial_centers.size()),
+    m_warm_up_size(p_initial_centers.size()),
+    m_tolerance(p_tolerance),
+    m_itermax(p_itermax),
+    m_metric(p_metric),
+    m_random_state(p_random_state),
+    m_centers(p_initial_centers),
+    m_counts(p_initial_centers.size(), 0)
+{
+    initialize_random_generator();
+}
+
+
+void minibatch_kmeans::process(const dataset & p_data, kmeans_data & p_result) {
+    process(container::dense_dataset(p_data), p_result);
+}
+
+
+void minibatch_kmeans::process(const container::dense_dataset_view & p_data, kmeans_data & p_result) {
+    verify();
+
+    if (p_data.empty()) {
+        throw std::invalid_argument("Input data is empty.");
+    }
+
+    if (!is_initialized()) {
+        sample_to_reservoir(p_data, 0, p_data.size());
+        initialize_centers();
+    }
+    else if (p_data.dimension() != m_centers.front().size()) {
+        throw std::invalid_argument("Dimension of the input data and dimension of the cluster centers must be the same.");
+    }
+
+    if (p_result.is_observed()) {
+        kmeans_data initial_result;
+        extract_clusters(p_data, initial_result);
+
+        p_result.evolution_centers().push_back(m_centers);
+        p_result.evolution_clusters().push_back(initial_result.clusters());
+    }
+
+    std::uniform_int_distribution<std::size_t> distribution(0, p_data.size() - 1);
+    container::dense_dataset batch(std::min(m_batch_size, p_data.size()), p_data.dimension());
+
+    double current_change = std::numeric_limits<double>::max();
+    for (std::size_t iteration = 0; (iteration < m_itermax) && (current_change > m_tolerance); iteration++) {
+        for (std::size_t i = 0; i < batch.size(); i++) {
+            const double * row = p_data.row(distribution(m_generator));
+            std::copy(row, row + p_data.dimension(), batch.row(i));
+        }
+
+        current_change = update_centers(batch);
+
+        if (p_result.is_observed()) {
+            kmeans_data iteration_result;
+            extract_clusters(p_data, iteration_result);
+
+            p_result.evolution_centers().push_back(m_centers);
+            p_result.evolution_clusters().push_back(iteration_result.clusters());
+        }
+    }
+
+    extract_clusters(p_data, p_result);
+}
+
+
+void minibatch_kmeans::process(const batch_source & p_source, kmeans_data & p_result) {
+    verify();
+
+    dataset batch;
+    while (p_source(batch)) {
+        partial_fit(batch);
+
+        if (p_result.is_observed() && is_initialized()) {
+            p_result.evolution_centers().push_back(m_centers);
+        }
+
+        batch.clear();
+    }
+
+    if (!is_initialized()) {
+        initialize_centers();   /* the source is over before the warm-up */
+
+        if (p_result.is_observed()) {
+            p_result.evolution_centers().push_back(m_centers);
+        }
+    }
+
+    p_result.clusters().clear();
+    p_result.centers() = m_centers;
+}
+
+
+void minibatch_kmeans::partial_fit(const dataset & p_batch) {
+    partial_fit(container::dense_dataset(p_batch));
+}
+
+
+void minibatch_kmeans::partial_fit(const container::dense_dataset_view & p_batch) {
+    verify();
+
+    if (p_batch.empty()) {
+        return;
+    }
+
+    if (is_initialized() && (p_batch.dimension() != m_centers.front().size())) {
+        throw std::invalid_argument("Dimension of the batch and dimension of the cluster centers must be the same.");
+    }
+
+    if (!m_reservoir.empty() && (p_batch.dimension() != m_reservoir.front().size())) {
+        throw std::invalid_argument("Dimension of the batch and dimension of previous batches must be the same.");
+    }
+
+    if (is_initialized()) {
+        update_centers(p_batch);
+        return;
+    }
+
+    /* the whole batch is offered to the reservoir, points of the reservoir are used as the first batch */
+    sample_to_reservoir(p_batch, 0, p_batch.size());
+    if (m_amount_seen >= m_warm_up_size) {
+        initialize_centers();
+    }
+}
+
+
+void minibatch_kmeans::predict(const container::dense_dataset_view & p_data, index_sequence & p_labels) const {
+    if (m_centers.empty()) {
+        throw std::invalid_argument("Centers are not initialized.");
+    }
+
+    if (!p_data.empty() && (p_data.dimension() != m_centers.front().size())) {
+        throw std::invalid_argument("Dimension of the input data and dimension of the cluster centers must be the same.");
+    }
+
+    p_labels.assign(p_data.size(), 0);
+
+    if (blocked_assignment::is_applicable(m_metric)) {
+        const blocked_assignment assignment(m_centers);
+        const std::size_t block = blocked_assignment::POINT_BLOCK;
+
+        parallel_for(std::size_t(0), p_data.size(), block, [&p_data, &p_labels, &assignment, block](const std::size_t p_begin) {
+            assignment.assign(p_data, p_begin, std::min(p_begin + block, p_data.size()), p_labels);
+        });
+
+        return;
+    }
+
+    visit(m_metric, [this, &p_data, &p_labels](const auto & p_distance) {
+        parallel_for(std::size_t(0), p_data.size(), [this, &p_data, &p_labels, &p_distance](const std::size_t p_index) {
+            const container::point_view current_point = p_data[p_index];
+
+            double minimum_distance = std::numeric_limits<double>::max();
+            for (std::size_t index_center = 0; index_center < m_centers.size(); index_center++) {
+                const double distance = p_distance(current_point, container::point_view(m_centers[index_center]));
+                if (distance < minimum_distance) {
+                    minimum_distance = distance;
+                    p_labels[p_index] = index_center;
+                }
+            }
+        });
+    });
+}
+
+
+const dataset & minibatch_kmeans::get_centers() const {
+    return m_centers;
+}
+
+
+bool minibatch_kmeans::is_initialized() const {
+    return !m_centers.empty();
+}
+
+
+void minibatch_kmeans::verify() const {
+    if (m_amount_clusters == 0) {
+        throw std::invalid_argument("Amount of clusters should be greater than 0.");
+    }
+
+    if (m_batch_size == 0) {
+        throw std::invalid_argument("Batch size should be greater than 0.");
+    }
+
+    if (m_reservoir_size < m_amount_clusters) {
+        throw std::invalid_argument("Reservoir size '" + std::to_string(m_reservoir_size) +
+            "' should not be less than amount of clusters '" + std::to_string(m_amount_clusters) + "'.");
+    }
+
+    if (m_warm_up_size < m_reservoir_size) {
+        throw std::invalid_argument("Warm-up size '" + std::to_string(m_warm_up_size) +
+            "' should not be less than reservoir size '" + std::to_string(m_reservoir_size) + "'.");
+    }
+}
+
+
+void minibatch_kmeans::initialize_random_generator() {
+    if (m_random_state == RANDOM_STATE_CURRENT_TIME) {
+        m_generator.seed(static_cast<unsigned int>(std::chrono::system_clock::now().time_since_epoch().count()));
+    }
+    else {
+        m_generator.seed(static_cast<unsigned int>(m_random_state));
+    }
+}
+
+
+void minibatch_kmeans::sample_to_reservoir(const container::dense_dataset_view & p_data, const std::size_t p_begin, const std::size_t p_end) {
+    /* reservoir sampling (algorithm R): each offered point is in the reservoir with the same probability */
+    for (std::size_t index_point = p_begin; index_point < p_end; index_point++) {
+        m_amount_seen++;
+
+        if (m_reservoir.size() < m_reservoir_size) {
+            m_reservoir.push_back(p_data[index_point].to_point());
+        }
+        else {
+            const std::size_t index_replace = std::uniform_int_distribution<std::size_t>(0, m_amount_seen - 1)(m_generator);
+            if (index_replace < m_reservoir_size) {
+                m_reservoir[index_replace] = p_data[index_point].to_point();
+            }
+        }
+    }
+}
+
+
+void minibatch_kmeans::initialize_centers() {
+    if (m_reservoir.size() < m_amount_clusters) {
+        throw std::invalid_argument("Amount of points '" + std::to_string(m_reservoir.size()) +
+            "' is less than amount of clusters '" + std::to_string(m_amount_clusters) + "'.");
+    }
+
+    const distance_metric<point> & metric = m_metric;
+    kmeans_plus_plus(m_amount_clusters, 1, [&metric](const point & p1, const point & p2) { return metric(p1, p2); }, m_random_state)
+        .initialize(m_reservoir, m_centers);
+
+    m_counts.assign(m_centers.size(), 0);
+
+    update_centers(container::dense_dataset(m_reservoir));
+
+    m_reservoir.clear();
+    m_reservoir.shrink_to_fit();
+}
+
+
+double minibatch_kmeans::update_centers(const container::dense_dataset_view & p_batch) {
+    index_sequence labels;
+    predict(p_batch, labels);
+
+    const dataset previous_centers = m_centers;
+
+    /* each point moves its center with the learning rate that is inversely proportional to the amount of points of the center */
+    for (std::size_t index_point = 0; index_point < p_batch.size(); index_point++) {
+        const std::size_t index_center = labels[index_point];
+        const double learning_rate = 1.0 / static_cast<double>(++m_counts[index_center]);
+
+        const double * current_point = p_batch.row(index_point);
+        point & center = m_centers[index_center];
+
+        for (std::size_t dimension = 0; dimension < center.size(); dimension++) {
+            center[dimension] += learning_rate * (current_point[dimension] - center[dimension]);
+        }
+    }
+
+    double maximum_change = 0.0;
+    for (std::size_t index_center = 0; index_center < m_centers.size(); index_center++) {
+        maximum_change = std::max(maximum_change, m_metric(previous_centers[index_center], m_centers[index_center]));
+    }
+
+    return maximum_change;
+}
+
+
+void minibatch_kmeans::extract_clusters(const container::dense_dataset_view & p_data, kmeans_data & p_result) const {
+    index_sequence labels;
+    predict(p_data, labels);
+
+    cluster_sequence clusters(m_centers.size());
+    for (std::size_t index_point = 0; index_point < labels.size(); index_point++) {
+        clusters[labels[index_point]].push_back(index_point);
+    }
+
+    p_result.clusters().clear();
+    p_result.centers().clear();
+    p_result.wce() = 0.0;
+
+    for (std::size_t index_cluster = 0; index_cluster < clusters.size(); index_cluster++) {
+        if (clusters[index_cluster].empty()) {
+            continue;
+        }
+
+        for (const auto index_point : clusters[index_cluster]) {
+            p_result.wce() += m_metric(p_data[index_point], m_centers[index_cluster]);
+        }
+
+        p_result.clusters().push_back(std::move(clusters[index_cluster]));
+        p_result.centers().push_back(m_centers[index_cluster]);
+    }
+}
+
+
+}
+
+}
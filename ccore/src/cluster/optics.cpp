@@ -9,13 +9,16 @@
 #include <pyclustering/cluster/optics.hpp>
 #include <pyclustering/cluster/ordering_analyser.hpp>
 
+#include <pyclustering/parallel/parallel.hpp>
+
 #include <algorithm>
 #include <cmath>
 #include <limits>
 #include <map>
 #include <string>
 
-#include <pyclustering/container/kdtree_searcher.hpp>
+
+using namespace pyclustering::parallel;
 
 
 namespace pyclustering {
@@ -27,17 +30,21 @@ const double      optics::NONE_DISTANCE = optics_descriptor::NONE_DISTANCE;
 
 const std::size_t optics::INVALID_INDEX = std::numeric_limits<std::size_t>::max();
 
+const std::size_t optics::NO_GENERATION = std::numeric_limits<std::size_t>::max();
+
 
-optics::optics(const double p_radius, const std::size_t p_neighbors) : optics() { 
+optics::optics(const double p_radius, const std::size_t p_neighbors, const distance_metric<point> & p_metric) : optics() { 
     m_radius = p_radius;
     m_neighbors = p_neighbors;
+    m_metric = p_metric;
 }
 
 
-optics::optics(const double p_radius, const std::size_t p_neighbors, const std::size_t p_amount_clusters) : optics() { 
+optics::optics(const double p_radius, const std::size_t p_neighbors, const std::size_t p_amount_clusters, const distance_metric<point> & p_metric) : optics() { 
     m_radius = p_radius;
     m_neighbors = p_neighbors;
     m_amount_clusters = p_amount_clusters;
+    m_metric = p_metric;
 }
 
 
@@ -47,9 +54,19 @@ void optics::process(const dataset & p_data, optics_data & p_result) {
 
 
 void optics::process(const dataset & p_data, const data_t p_type, optics_data & p_result) {
-    m_data_ptr    = &p_data;
+    process(container::dense_dataset(p_data), p_type, p_result);
+}
+
+
+void optics::process(const container::dense_dataset_view & p_data, const data_t p_type, optics_data & p_result, const std::size_t p_generation) {
+    m_data        = p_data;
     m_result_ptr  = &p_result;
     m_type        = p_type;
+    m_generation  = p_generation;
+
+    if (m_generation == NO_GENERATION) {
+        clear_neighborhoods();      /* neighborhoods might be left by a call that has been interrupted by exception */
+    }
 
     calculate_cluster_result();
 
@@ -64,8 +81,12 @@ void optics::process(const dataset & p_data, const data_t p_type, optics_data &
 
     m_result_ptr->set_radius(m_radius);
 
-    m_data_ptr    = nullptr;
+    m_data        = { };
     m_result_ptr  = nullptr;
+
+    if (m_generation == NO_GENERATION) {
+        clear_neighborhoods();      /* the data is not identified, so its neighborhoods could not be reused */
+    }
 }
 
 
@@ -77,15 +98,13 @@ void optics::calculate_cluster_result() {
 
 
 void optics::initialize() {
-    if (m_type == data_t::POINTS) {
-        create_kdtree();
-    }
+    create_neighborhoods();
 
     m_optics_objects = &(m_result_ptr->optics_objects());
     if (m_optics_objects->empty()) {
-        m_optics_objects->reserve(m_data_ptr->size());
+        m_optics_objects->reserve(m_data.size());
 
-        for (std::size_t i = 0; i < m_data_ptr->size(); i++) {
+        for (std::size_t i = 0; i < m_data.size(); i++) {
             m_optics_objects->emplace_back(i, optics::NONE_DISTANCE, optics::NONE_DISTANCE);
         }
     }
@@ -95,6 +114,7 @@ void optics::initialize() {
 
 
     m_ordered_database.clear();
+    m_order_seed = container::indexed_heap(m_data.size());
 
     m_result_ptr->clusters().clear();
     m_result_ptr->noise().clear();
@@ -108,52 +128,55 @@ void optics::allocate_clusters() {
         }
     }
 
+    index_sequence & object_ordering = m_result_ptr->object_ordering();
+    object_ordering.clear();
+    object_ordering.reserve(m_ordered_database.size());
+
+    for (const auto optics_object : m_ordered_database) {
+        object_ordering.push_back(optics_object->m_index);
+    }
+
     extract_clusters();
 }
 
 
 void optics::expand_cluster_order(optics_descriptor & p_object) {
     p_object.m_processed = true;
-
-    neighbors_collection neighbors;
-    get_neighbors(p_object.m_index, neighbors);
+    p_object.m_core_distance = get_core_distance(p_object.m_index, m_radius);
 
     m_ordered_database.push_back(&p_object);
 
-    if (neighbors.size() >= m_neighbors) {
-        p_object.m_core_distance = get_core_distance(neighbors);
-
-        std::multiset<optics_descriptor *, optics_pointer_descriptor_less> order_seed;
-        update_order_seed(p_object, neighbors, order_seed);
+    if (p_object.m_core_distance != optics::NONE_DISTANCE) {
+        update_order_seed(p_object);
 
-        while(!order_seed.empty()) {
-            optics_descriptor * descriptor = *(order_seed.begin());
-            order_seed.erase(order_seed.begin());
+        while(!m_order_seed.empty()) {
+            optics_descriptor * descriptor = &(m_optics_objects->at(m_order_seed.pop()));
 
-            get_neighbors(descriptor->m_index, neighbors);
             descriptor->m_processed = true;
+            descriptor->m_core_distance = get_core_distance(descriptor->m_index, m_radius);
 
             m_ordered_database.push_back(descriptor);
 
-            if (neighbors.size() >= m_neighbors) {
-                descriptor->m_core_distance = get_core_distance(neighbors);
-                update_order_seed(*descriptor, neighbors, order_seed);
-            }
-            else {
-                descriptor->m_core_distance = optics::NONE_DISTANCE;
+            if (descriptor->m_core_distance != optics::NONE_DISTANCE) {
+                update_order_seed(*descriptor);
             }
         }
     }
-    else {
-        p_object.m_core_distance = optics::NONE_DISTANCE;
-    }
 }
 
 
-void optics::update_order_seed(const optics_descriptor & p_object, const neighbors_collection & p_neighbors, std::multiset<optics_descriptor *, optics_pointer_descriptor_less> & order_seed) {
-    for (auto & descriptor : p_neighbors) {
-        std::size_t index_neighbor = descriptor.m_index;
-        double current_reachability_distance = descriptor.m_reachability_distance;
+void optics::update_order_seed(const optics_descriptor & p_object) {
+    const double bound = get_bound(m_radius);
+    const std::size_t * neighbors = m_neighborhoods.neighbors(p_object.m_index);
+    const double * values = m_neighborhoods.distances(p_object.m_index);
+
+    for (std::size_t i = 0; i < m_neighborhoods.amount_neighbors(p_object.m_index); i++) {
+        if (values[i] > bound) {
+            continue;
+        }
+
+        const std::size_t index_neighbor = neighbors[i];
+        const double current_reachability_distance = get_distance(values[i]);
 
         optics_descriptor & optics_object = m_optics_objects->at(index_neighbor);
         if (!optics_object.m_processed) {
@@ -161,18 +184,12 @@ void optics::update_order_seed(const optics_descriptor & p_object, const neighbo
 
             if (optics_object.m_reachability_distance == optics::NONE_DISTANCE) {
                 optics_object.m_reachability_distance = reachable_distance;
-                order_seed.insert(&optics_object);
+                m_order_seed.push(optics_object.m_index, reachable_distance);
             }
             else {
                 if (reachable_distance < optics_object.m_reachability_distance) {
                     optics_object.m_reachability_distance = reachable_distance;
-
-                    auto object_iterator = std::find_if(order_seed.begin(), order_seed.end(), [&optics_object](optics_descriptor * obj) {
-                        return obj->m_index == optics_object.m_index;
-                    });
-
-                    order_seed.erase(object_iterator);
-                    order_seed.insert(&optics_object);
+                    m_order_seed.decrease(optics_object.m_index, reachable_distance);
                 }
             }
         }
@@ -203,57 +220,148 @@ void optics::extract_clusters() {
 }
 
 
-void optics::get_neighbors(const size_t p_index, neighbors_collection & p_neighbors) {
-    switch(m_type) {
-    case data_t::POINTS:
-        get_neighbors_from_points(p_index, p_neighbors);
-        break;
+void optics::create_neighborhoods() {
+    if ((m_type != data_t::POINTS) && (m_type != data_t::DISTANCE_MATRIX)) {
+        throw std::invalid_argument("Incorrect input data type is specified '" + std::to_string((unsigned) m_type) + "'");
+    }
+
+    if (has_neighborhoods()) {
+        return;
+    }
 
-    case data_t::DISTANCE_MATRIX:
-        get_neighbors_from_distance_matrix(p_index, p_neighbors);
-        break;
+    m_neighborhoods_radius = -1.0;     /* core distances of previous neighborhoods are not valid anymore */
 
-    default:
-        throw std::invalid_argument("Incorrect input data type is specified '" + std::to_string((unsigned) m_type) + "'");
+    if (m_type == data_t::POINTS) {
+        create_tree();
     }
+
+    m_neighborhoods.assign(m_data.size(), [this](const std::size_t p_index, std::vector<std::size_t> & p_neighbors, std::vector<double> & p_values) {
+        find_neighbors(p_index, p_neighbors, p_values);
+    });
+
+    m_core_distances.assign(m_data.size(), optics::NONE_DISTANCE);
+    parallel_for(std::size_t(0), m_data.size(), [this](const std::size_t p_index) {
+        m_core_distances[p_index] = get_core_distance(p_index, m_radius);
+    });
+
+    m_neighborhoods_radius = m_radius;
+    m_neighborhoods_type = m_type;
+    m_neighborhoods_generation = m_generation;
+    m_neighborhoods_size = m_data.size();
+    m_neighborhoods_dimension = m_data.dimension();
+
+    m_kdtree = container::kdtree_flat();
+    m_ball_tree = { };
 }
 
 
-void optics::get_neighbors_from_points(const std::size_t p_index, neighbors_collection & p_neighbors) {
-    p_neighbors.clear();
+void optics::clear_neighborhoods() {
+    m_neighborhoods = container::neighbor_graph();
+    m_core_distances = std::vector<double>();
 
-    container::kdtree_searcher searcher((*m_data_ptr)[p_index], m_kdtree.get_root(), m_radius);
+    m_neighborhoods_radius = -1.0;
+    m_neighborhoods_generation = NO_GENERATION;
+}
 
-    container::kdtree_searcher::rule_store rule = [&p_index, &p_neighbors](const container::kdnode::ptr & p_node, const double p_distance) {
-            if (p_index != (std::size_t) p_node->get_payload()) {
-                p_neighbors.emplace((std::size_t) p_node->get_payload(), std::sqrt(p_distance));
-            }
-        };
 
-    searcher.find_nearest(rule);
+bool optics::has_neighborhoods() const {
+    /* neighborhoods of the first pass are reused by the second one in scope of the same call regardless of generation */
+    return (m_neighborhoods_radius >= m_radius) && (m_neighborhoods_type == m_type) && (m_neighborhoods_generation == m_generation) &&
+        (m_neighborhoods_size == m_data.size()) && (m_neighborhoods_dimension == m_data.dimension());
 }
 
 
-void optics::get_neighbors_from_distance_matrix(const std::size_t p_index, neighbors_collection & p_neighbors) {
-    p_neighbors.clear();
+void optics::find_neighbors(const std::size_t p_index, std::vector<std::size_t> & p_neighbors, std::vector<double> & p_values) const {
+    struct neighbor_descriptor {
+        double          m_distance;
+        double          m_value;
+        std::size_t     m_index;
+    };
+
+    std::vector<neighbor_descriptor> neighbors;
 
-    const auto & distances = m_data_ptr->at(p_index);
-    for (std::size_t index_neighbor = 0; index_neighbor < distances.size(); index_neighbor++) {
-        const double candidate_distance = distances[index_neighbor];
-        if ( (candidate_distance <= m_radius) && (index_neighbor != p_index) ) {
-            p_neighbors.emplace(index_neighbor, candidate_distance);
+    if (m_type == data_t::DISTANCE_MATRIX) {
+        const container::point_view distances = m_data[p_index];
+        for (std::size_t index_neighbor = 0; index_neighbor < distances.size(); index_neighbor++) {
+            const double candidate_distance = distances[index_neighbor];
+            if ( (candidate_distance <= m_radius) && (index_neighbor != p_index) ) {
+                neighbors.push_back({ candidate_distance, candidate_distance, index_neighbor });
+            }
         }
     }
+    else if (m_metric.kind() == metric_kind::EUCLIDEAN) {
+        m_kdtree.find_nearest(m_data.row(p_index), m_radius, [p_index, &neighbors](const std::size_t p_neighbor, const double p_square_distance) {
+            if (p_index != p_neighbor) {
+                neighbors.push_back({ std::sqrt(p_square_distance), p_square_distance, p_neighbor });
+            }
+        });
+    }
+    else if (container::ball_tree::is_applicable(m_metric)) {
+        m_ball_tree.find_nearest(m_data.row(p_index), m_radius, [p_index, &neighbors](const std::size_t p_neighbor, const double p_distance) {
+            if (p_index != p_neighbor) {
+                neighbors.push_back({ p_distance, p_distance, p_neighbor });
+            }
+        });
+    }
+    else {
+        /* the tree might lose neighbors if the metric does not satisfy the triangle inequality */
+        visit(m_metric, [this, p_index, &neighbors](const auto & p_distance) {
+            const container::point_view point = m_data[p_index];
+            for (std::size_t index_neighbor = 0; index_neighbor < m_data.size(); index_neighbor++) {
+                const double candidate_distance = p_distance(point, m_data[index_neighbor]);
+                if ( (candidate_distance <= m_radius) && (index_neighbor != p_index) ) {
+                    neighbors.push_back({ candidate_distance, candidate_distance, index_neighbor });
+                }
+            }
+        });
+    }
+
+    /* neighbors with the same distance keep order of search like in a multiset */
+    std::stable_sort(neighbors.begin(), neighbors.end(), [](const neighbor_descriptor & p_neighbor1, const neighbor_descriptor & p_neighbor2) {
+        return p_neighbor1.m_distance < p_neighbor2.m_distance;
+    });
+
+    for (const auto & neighbor : neighbors) {
+        p_neighbors.push_back(neighbor.m_index);
+        p_values.push_back(neighbor.m_value);
+    }
+}
+
+
+double optics::get_bound(const double p_radius) const {
+    /* square distances are compared with square radius, so neighbors are the same as neighbors that are found by KD-tree */
+    const bool is_square = (m_type == data_t::POINTS) && (m_metric.kind() == metric_kind::EUCLIDEAN);
+    return is_square ? p_radius * p_radius : p_radius;
+}
+
+
+double optics::get_distance(const double p_value) const {
+    const bool is_square = (m_type == data_t::POINTS) && (m_metric.kind() == metric_kind::EUCLIDEAN);
+    return is_square ? std::sqrt(p_value) : p_value;
 }
 
 
-double optics::get_core_distance(const neighbors_collection & p_neighbors) const {
-    auto iter = p_neighbors.cbegin();
-    for (std::size_t index = 0; index < (m_neighbors - 1); ++index) {
-        ++iter;
+double optics::get_core_distance(const std::size_t p_index, const double p_radius) const {
+    if (m_neighbors == 0) {
+        return 0.0;
     }
 
-    return iter->m_reachability_distance;
+    if ((p_radius == m_neighborhoods_radius) && !m_core_distances.empty()) {
+        return m_core_distances[p_index];
+    }
+
+    /* the core distance is the distance to the last neighbor from the minimum amount of neighbors in the radius */
+    const double bound = get_bound(p_radius);
+    const double * values = m_neighborhoods.distances(p_index);
+
+    std::size_t amount_neighbors = 0;
+    for (std::size_t i = 0; i < m_neighborhoods.amount_neighbors(p_index); i++) {
+        if ((values[i] <= bound) && (++amount_neighbors == m_neighbors)) {
+            return get_distance(values[i]);
+        }
+    }
+
+    return optics::NONE_DISTANCE;
 }
 
 
@@ -274,13 +382,13 @@ void optics::calculate_ordering() {
 }
 
 
-void optics::create_kdtree() {
-    std::vector<void *> payload(m_data_ptr->size());
-    for (std::size_t index = 0; index < m_data_ptr->size(); index++) {
-        payload[index] = (void *)index;
+void optics::create_tree() {
+    if (m_metric.kind() == metric_kind::EUCLIDEAN) {
+        m_kdtree = container::kdtree_flat(m_data);
+    }
+    else if (container::ball_tree::is_applicable(m_metric)) {
+        m_ball_tree = container::ball_tree(m_data, m_metric);
     }
-
-    m_kdtree = container::kdtree_balanced(*m_data_ptr, payload);
 }
 
 
@@ -0,0 +1,276 @@
+/*!
+
+@authors Andrei Novikov (pyclustering@yandex.ru)
+@date 2014-2020
+@copyright BSD-3-Clause
+
+*/
+
+
+#include <pyclustering/cluster/optics_xi.hpp>
+
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+#include <string>
+
+
+namespace pyclustering {
+
+namespace clst {
+
+
+const std::size_t optics_xi::NO_PARENT = std::numeric_limits<std::size_t>::max();
+
+
+optics_xi::optics_xi(const double p_xi, const std::size_t p_minimum_samples) :
+    optics_xi(p_xi, p_minimum_samples, p_minimum_samples)
+{ }
+
+
+optics_xi::optics_xi(const double p_xi, const std::size_t p_minimum_samples, const std::size_t p_minimum_cluster_size) :
+    m_xi(p_xi),
+    m_minimum_samples(p_minimum_samples),
+    m_minimum_cluster_size(p_minimum_cluster_size)
+{ }
+
+
+void optics_xi::process(const optics_data & p_optics_result, optics_xi_data & p_result) const {
+    std::vector<double> reachability(p_optics_result.optics_objects().size());
+    for (const auto & optics_object : p_optics_result.optics_objects()) {
+        reachability[optics_object.m_index] = optics_object.m_reachability_distance;
+    }
+
+    process(p_optics_result.object_ordering(), reachability, p_result);
+}
+
+
+void optics_xi::process(const index_sequence & p_object_ordering, const std::vector<double> & p_reachability, optics_xi_data & p_result) const {
+    if ((m_xi <= 0.0) || (m_xi >= 1.0)) {
+        throw std::invalid_argument("Xi '" + std::to_string(m_xi) + "' should be in range (0, 1).");
+    }
+
+    if (p_object_ordering.size() != p_reachability.size()) {
+        throw std::invalid_argument("Amount of objects in the ordering '" + std::to_string(p_object_ordering.size()) +
+            "' is not equal to amount of reachability distances '" + std::to_string(p_reachability.size()) + "'.");
+    }
+
+    /* undefined reachability is infinite, the last element bounds the plot like an undefined one */
+    std::vector<double> plot(p_object_ordering.size() + 1, std::numeric_limits<double>::infinity());
+    for (std::size_t position = 0; position < p_object_ordering.size(); position++) {
+        const std::size_t index_object = p_object_ordering[position];
+        if (index_object >= p_reachability.size()) {
+            throw std::invalid_argument("Index of object '" + std::to_string(index_object) + "' in the ordering is out of range.");
+        }
+
+        if (p_reachability[index_object] != optics_descriptor::NONE_DISTANCE) {
+            plot[position] = p_reachability[index_object];
+        }
+    }
+
+    build_hierarchy(extract_intervals(plot), p_object_ordering, p_result);
+}
+
+
+std::vector<optics_xi::interval> optics_xi::extract_intervals(const std::vector<double> & p_plot) const {
+    const std::size_t length = p_plot.size() - 1;
+    const double xi_complement = 1.0 - m_xi;
+
+    std::vector<interval> intervals;
+    std::vector<steep_area> areas;
+    std::vector<interval> area_intervals;
+
+    std::size_t index = 0;          /* the first position that is not a part of the previous steep area */
+    std::size_t scanned = 0;        /* the first position that is not considered by the maximum in between */
+    double mib = 0.0;
+
+    for (std::size_t steep_index = 0; steep_index < length; steep_index++) {
+        const bool steep_down = is_steep_down(p_plot, steep_index);
+        if ((steep_index < index) || (!steep_down && !is_steep_up(p_plot, steep_index))) {
+            continue;
+        }
+
+        for (; scanned <= steep_index; scanned++) {
+            mib = std::max(mib, p_plot[scanned]);
+        }
+
+        filter_areas(areas, mib, p_plot);
+
+        if (steep_down) {
+            const std::size_t end = extend_area(p_plot, steep_index, false);
+            areas.push_back({ steep_index, end, 0.0 });
+
+            index = end + 1;
+            scanned = index;
+            mib = p_plot[index];
+            continue;
+        }
+
+        const std::size_t up_start = steep_index;
+        const std::size_t up_end = extend_area(p_plot, steep_index, true);
+
+        index = up_end + 1;
+        scanned = index;
+        mib = p_plot[index];
+
+        const double end_reachability = p_plot[up_end + 1];
+
+        area_intervals.clear();
+        for (const auto & area : areas) {
+            if (end_reachability * xi_complement < area.m_mib) {
+                continue;
+            }
+
+            /* boundaries are moved to the same level of reachability on both sides of the cluster */
+            std::size_t cluster_start = area.m_start;
+            std::size_t cluster_end = up_end;
+
+            const double start_reachability = p_plot[area.m_start];
+            if (start_reachability * xi_complement >= end_reachability) {
+                while ((p_plot[cluster_start + 1] > end_reachability) && (cluster_start < area.m_end)) {
+                    cluster_start++;
+                }
+            }
+            else if (end_reachability * xi_complement >= start_reachability) {
+                while ((p_plot[cluster_end - 1] > start_reachability) && (cluster_end > up_start)) {
+                    cluster_end--;
+                }
+            }
+
+            if ((cluster_end - cluster_start + 1 < m_minimum_cluster_size) || (cluster_start > area.m_end) || (cluster_end < up_start)) {
+                continue;
+            }
+
+            area_intervals.push_back({ cluster_start, cluster_end });
+        }
+
+        /* clusters of inner steep down areas are smaller, they are placed before clusters that contain them */
+        intervals.insert(intervals.end(), area_intervals.rbegin(), area_intervals.rend());
+    }
+
+    return intervals;
+}
+
+
+std::size_t optics_xi::extend_area(const std::vector<double> & p_plot, const std::size_t p_start, const bool p_upward) const {
+    const std::size_t length = p_plot.size() - 1;
+
+    std::size_t amount_non_steep = 0;
+    std::size_t end = p_start;
+
+    for (std::size_t index = p_start; index < length; index++) {
+        const double ratio = p_plot[index] / p_plot[index + 1];
+
+        const bool steep = p_upward ? is_steep_up(p_plot, index) : is_steep_down(p_plot, index);
+        const bool opposite = p_upward ? (ratio > 1.0) : (ratio < 1.0);
+
+        if (steep) {
+            amount_non_steep = 0;
+            end = index;
+        }
+        else if (opposite) {
+            break;
+        }
+        else if (++amount_non_steep > m_minimum_samples) {
+            break;
+        }
+    }
+
+    return end;
+}
+
+
+void optics_xi::filter_areas(std::vector<steep_area> & p_areas, const double p_mib, const std::vector<double> & p_plot) const {
+    if (p_mib == std::numeric_limits<double>::infinity()) {
+        p_areas.clear();
+        return;
+    }
+
+    const double xi_complement = 1.0 - m_xi;
+
+    auto iter_end = std::remove_if(p_areas.begin(), p_areas.end(), [p_mib, xi_complement, &p_plot](const steep_area & p_area) {
+        return p_mib > p_plot[p_area.m_start] * xi_complement;
+    });
+
+    p_areas.erase(iter_end, p_areas.end());
+
+    for (auto & area : p_areas) {
+        area.m_mib = std::max(area.m_mib, p_mib);
+    }
+}
+
+
+bool optics_xi::is_steep_down(const std::vector<double> & p_plot, const std::size_t p_index) const {
+    /* comparison is false for undefined ratio of two infinite or zero distances */
+    return p_plot[p_index] / p_plot[p_index + 1] >= 1.0 / (1.0 - m_xi);
+}
+
+
+bool optics_xi::is_steep_up(const std::vector<double> & p_plot, const std::size_t p_index) const {
+    return p_plot[p_index] / p_plot[p_index + 1] <= 1.0 - m_xi;
+}
+
+
+void optics_xi::build_hierarchy(const std::vector<interval> & p_intervals, const index_sequence & p_object_ordering, optics_xi_data & p_result) {
+    cluster_sequence & clusters = p_result.clusters();
+    index_sequence & hierarchy = p_result.hierarchy();
+
+    clusters.clear();
+    hierarchy.assign(p_intervals.size(), NO_PARENT);
+    p_result.noise().clear();
+
+    std::vector<int> coverage(p_object_ordering.size() + 1, 0);
+    for (const auto & current_interval : p_intervals) {
+        clusters.emplace_back(p_object_ordering.begin() + current_interval.m_start, p_object_ordering.begin() + current_interval.m_end + 1);
+
+        coverage[current_interval.m_start]++;
+        coverage[current_interval.m_end + 1]--;
+    }
+
+    int depth = 0;
+    for (std::size_t position = 0; position < p_object_ordering.size(); position++) {
+        depth += coverage[position];
+        if (depth == 0) {
+            p_result.noise().push_back(p_object_ordering[position]);
+        }
+    }
+
+    /* intervals are ordered by start and containing intervals are placed first, the stack keeps the path from the root */
+    std::vector<std::size_t> order(p_intervals.size());
+    for (std::size_t i = 0; i < order.size(); i++) {
+        order[i] = i;
+    }
+
+    std::sort(order.begin(), order.end(), [&p_intervals](const std::size_t p_index1, const std::size_t p_index2) {
+        const interval & interval1 = p_intervals[p_index1];
+        const interval & interval2 = p_intervals[p_index2];
+
+        if (interval1.m_start != interval2.m_start) {
+            return interval1.m_start < interval2.m_start;
+        }
+
+        if (interval1.m_end != interval2.m_end) {
+            return interval1.m_end > interval2.m_end;
+        }
+
+        return p_index1 > p_index2;     /* the same cluster that is extracted later is a parent */
+    });
+
+    std::vector<std::size_t> path;
+    for (const auto index_cluster : order) {
+        while (!path.empty() && (p_intervals[path.back()].m_end < p_intervals[index_cluster].m_end)) {
+            path.pop_back();
+        }
+
+        if (!path.empty()) {
+            hierarchy[index_cluster] = path.back();
+        }
+
+        path.push_back(index_cluster);
+    }
+}
+
+
+}
+
+}
@@ -25,12 +25,17 @@ void silhouette::process(const dataset & p_data, const cluster_sequence & p_clus
 
 
 void silhouette::process(const dataset & p_data, const cluster_sequence & p_clusters, const data_t & p_type, silhouette_data & p_result) {
-    m_data      = &p_data;
+    process(container::dense_dataset(p_data), p_clusters, p_type, p_result);
+}
+
+
+void silhouette::process(const container::dense_dataset_view & p_data, const cluster_sequence & p_clusters, const data_t & p_type, silhouette_data & p_result) {
+    m_data      = p_data;
     m_clusters  = &p_clusters;
     m_result    = &p_result;
     m_type      = p_type;
 
-    m_result->get_score().reserve(m_data->size());
+    m_result->get_score().reserve(m_data.size());
 
     for (std::size_t index_cluster = 0; index_cluster < m_clusters->size(); index_cluster++) {
         const auto & current_cluster = m_clusters->at(index_cluster);
@@ -53,17 +58,19 @@ double silhouette::calculate_score(const std::size_t p_index_point, const std::s
 
 
 void silhouette::calculate_dataset_difference(const std::size_t p_index_point, std::vector<double> & p_dataset_difference) const {
+    const container::point_view current_point = m_data[p_index_point];
     if (m_type == data_t::DISTANCE_MATRIX) {
-        p_dataset_difference = m_data->at(p_index_point);
+        p_dataset_difference.assign(current_point.begin(), current_point.end());
         return;
     }
 
-    p_dataset_difference.reserve(m_data->size());
+    p_dataset_difference.reserve(m_data.size());
 
-    const auto & current_point = m_data->at(p_index_point);
-    for (const auto & point : *m_data) {
-        p_dataset_difference.emplace_back(m_metric(current_point, point));
-    }
+    utils::metric::visit(m_metric, [this, &current_point, &p_dataset_difference](const auto & p_distance) {
+        for (std::size_t index_point = 0; index_point < m_data.size(); index_point++) {
+            p_dataset_difference.emplace_back(p_distance(current_point, m_data[index_point]));
+        }
+    });
 }
 
 
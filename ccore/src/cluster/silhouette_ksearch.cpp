@@ -93,6 +93,8 @@ void silhouette_ksearch::process(const dataset & p_data, silhouette_ksearch_data
 
     p_result.scores().reserve(m_kmax - m_kmin);
 
+    const container::dense_dataset dense_data(p_data);    /* silhouette is calculated for each K using the same data */
+
     for (std::size_t k = m_kmin; k < m_kmax; k++) {
         cluster_sequence clusters;
         m_allocator->allocate(k, p_data, m_random_state, clusters);
@@ -103,7 +105,7 @@ void silhouette_ksearch::process(const dataset & p_data, silhouette_ksearch_data
         }
         
         silhouette_data result;
-        silhouette().process(p_data, clusters, result);
+        silhouette().process(dense_data, clusters, data_t::POINTS, result);
 
         const auto & scores = result.get_score();
         const double score = std::accumulate(scores.begin(), scores.end(), 0.0) / static_cast<double>(scores.size());
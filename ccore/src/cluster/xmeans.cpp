@@ -61,6 +61,7 @@ xmeans::xmeans(const dataset & p_initial_centers, const std::size_t p_kmax, cons
 
 void xmeans::process(const dataset & p_data, xmeans_data & p_result) {
     m_ptr_data = &p_data;
+    m_dense_data = container::dense_dataset(p_data);    /* K-Means is performed many times for the same data */
     m_ptr_result = &p_result;
 
     m_ptr_result->centers() = m_initial_centers;
@@ -82,6 +83,8 @@ void xmeans::process(const dataset & p_data, xmeans_data & p_result) {
     }
 
     m_ptr_result->wce() = improve_parameters(clusters, centers, dummy);
+
+    m_dense_data = container::dense_dataset();
 }
 
 
@@ -105,7 +108,7 @@ void xmeans::set_mndl_beta_bound(const double p_beta) {
 
 double xmeans::improve_parameters(cluster_sequence & improved_clusters, dataset & improved_centers, const index_sequence & available_indexes) const {
     kmeans_data result;
-    kmeans(improved_centers, m_tolerance, kmeans::DEFAULT_ITERMAX, m_metric).process((*m_ptr_data), available_indexes, result);
+    kmeans(improved_centers, m_tolerance, kmeans::DEFAULT_ITERMAX, m_metric).process(m_dense_data, available_indexes, result);
 
     improved_centers = result.centers();
     improved_clusters = result.clusters();
@@ -0,0 +1,357 @@
+/*!
+
+@authors Andrei Novikov (pyclustering@yandex.ru)
+@date 2014-2020
+@copyright BSD-3-Clause
+
+*/
+
+
+#include <pyclustering/container/ball_tree.hpp>
+
+#include <pyclustering/parallel/parallel.hpp>
+
+#include <limits>
+#include <numeric>
+#include <stdexcept>
+
+
+using namespace pyclustering::parallel;
+using namespace pyclustering::utils::metric;
+
+
+namespace pyclustering {
+
+namespace container {
+
+
+const std::size_t ball_tree::DEFAULT_LEAF_SIZE = 16;
+
+constexpr std::size_t ball_tree::MAXIMUM_DEPTH;
+
+const std::size_t ball_tree::PARALLEL_BUILD_SIZE = 8192;
+
+const double ball_tree::DISTANCE_TOLERANCE = 1e-10;
+
+constexpr std::size_t ball_tree::DISTANCE_BLOCK;
+
+
+ball_tree::ball_tree(const dataset & p_data, const distance_metric<point> & p_metric, const std::size_t p_leaf_size) :
+    m_leaf_size(p_leaf_size),
+    m_metric(p_metric)
+{
+    build(dense_dataset(p_data));
+}
+
+
+ball_tree::ball_tree(const dense_dataset_view & p_data, const distance_metric<point> & p_metric, const std::size_t p_leaf_size) :
+    m_leaf_size(p_leaf_size),
+    m_metric(p_metric)
+{
+    build(p_data);
+}
+
+
+bool ball_tree::is_applicable(const distance_metric<point> & p_metric) {
+    switch (p_metric.kind()) {
+    case metric_kind::EUCLIDEAN:
+    case metric_kind::EUCLIDEAN_SQUARE:
+    case metric_kind::MANHATTAN:
+    case metric_kind::CHEBYSHEV:
+    case metric_kind::CANBERRA:
+    case metric_kind::GOWER:
+        return true;
+
+    case metric_kind::MINKOWSKI:
+        return p_metric.degree() >= 1.0;
+
+    default:
+        return false;
+    }
+}
+
+
+void ball_tree::find_nearest(const point & p_point, const double p_radius, std::vector<std::size_t> & p_indexes, std::vector<double> & p_distances) const {
+    p_indexes.clear();
+    p_distances.clear();
+
+    find_nearest(p_point.data(), p_radius, [&p_indexes, &p_distances](const std::size_t p_index, const double p_distance) {
+        p_indexes.push_back(p_index);
+        p_distances.push_back(p_distance);
+    });
+}
+
+
+void ball_tree::find_nearest(const std::vector<std::size_t> & p_queries, const double p_radius, neighbor_graph & p_graph, const bool p_store_distances) const {
+    p_graph.assign(p_queries.size(), [this, &p_queries, p_radius, p_store_distances](const std::size_t p_query, std::vector<std::size_t> & p_neighbors, std::vector<double> & p_distances) {
+        find_nearest(m_points.row(m_positions[p_queries[p_query]]), p_radius, [&p_neighbors, &p_distances, p_store_distances](const std::size_t p_index, const double p_distance) {
+            p_neighbors.push_back(p_index);
+            if (p_store_distances) {
+                p_distances.push_back(p_distance);
+            }
+        });
+    });
+}
+
+
+void ball_tree::find_nearest(const double p_radius, neighbor_graph & p_graph, const bool p_store_distances) const {
+    std::vector<std::size_t> queries(size());
+    std::iota(queries.begin(), queries.end(), 0);
+
+    find_nearest(queries, p_radius, p_graph, p_store_distances);
+}
+
+
+void ball_tree::find_k_nearest(const double * p_point, const std::size_t p_k, const double p_max_radius, std::vector<std::size_t> & p_indexes, std::vector<double> & p_distances) const {
+    p_indexes.clear();
+    p_distances.clear();
+
+    if ((p_k == 0) || m_nodes.empty()) {
+        return;
+    }
+
+    const point_view query(p_point, m_points.dimension());
+    const double radius = m_square ? std::sqrt(p_max_radius) : p_max_radius;
+
+    std::vector<std::pair<double, std::size_t>> heap;     /* max-heap of the nearest points by distance */
+    heap.reserve(p_k);
+
+    visit(m_metric, [this, &query, p_k, radius, &heap](const auto & p_distance) {
+        const auto lower_bound = [this, &query, &p_distance](const std::size_t p_index_node) {
+            return std::max(0.0, p_distance(query, m_centers[p_index_node]) / (1.0 + DISTANCE_TOLERANCE) - m_nodes[p_index_node].m_radius);
+        };
+
+        /* each entry is a node and distance to its ball that is a lower bound for its points */
+        std::pair<std::size_t, double> stack[MAXIMUM_DEPTH + 1];
+        std::size_t stack_size = 0;
+        stack[stack_size++] = { 0, lower_bound(0) };
+
+        while (stack_size > 0) {
+            const auto entry = stack[--stack_size];
+            const double bound = (heap.size() < p_k) ? radius : heap.front().first;
+            if (entry.second > bound) {
+                continue;
+            }
+
+            const node & current = m_nodes[entry.first];
+            if (current.m_right == 0) {
+                double distances[DISTANCE_BLOCK];
+                for (std::size_t block_begin = current.m_begin; block_begin < current.m_end; block_begin += DISTANCE_BLOCK) {
+                    const std::size_t amount = std::min(DISTANCE_BLOCK, current.m_end - block_begin);
+                    calculate_distances(query, block_begin, amount, p_distance, distances);
+
+                    for (std::size_t i = 0; i < amount; i++) {
+                        if (distances[i] > radius) {
+                            continue;
+                        }
+
+                        const auto neighbor = std::make_pair(distances[i], m_indexes[block_begin + i]);
+                        if (heap.size() < p_k) {
+                            heap.push_back(neighbor);
+                            std::push_heap(heap.begin(), heap.end());
+                        }
+                        else if (neighbor < heap.front()) {
+                            std::pop_heap(heap.begin(), heap.end());
+                            heap.back() = neighbor;
+                            std::push_heap(heap.begin(), heap.end());
+                        }
+                    }
+                }
+
+                continue;
+            }
+
+            /* the farthest child is pushed first, so the nearest child is visited first */
+            const std::size_t index_left = entry.first + 1;
+            const double left_bound = lower_bound(index_left);
+            const double right_bound = lower_bound(current.m_right);
+
+            if (left_bound < right_bound) {
+                stack[stack_size++] = { current.m_right, right_bound };
+                stack[stack_size++] = { index_left, left_bound };
+            }
+            else {
+                stack[stack_size++] = { index_left, left_bound };
+                stack[stack_size++] = { current.m_right, right_bound };
+            }
+        }
+    });
+
+    std::sort_heap(heap.begin(), heap.end());
+
+    p_indexes.reserve(heap.size());
+    p_distances.reserve(heap.size());
+    for (const auto & neighbor : heap) {
+        p_distances.push_back(m_square ? neighbor.first * neighbor.first : neighbor.first);
+        p_indexes.push_back(neighbor.second);
+    }
+}
+
+
+std::size_t ball_tree::size() const {
+    return m_points.size();
+}
+
+
+std::size_t ball_tree::dimension() const {
+    return m_points.dimension();
+}
+
+
+bool ball_tree::empty() const {
+    return m_points.empty();
+}
+
+
+std::size_t ball_tree::get_leaf_size() const {
+    return m_leaf_size;
+}
+
+
+void ball_tree::build(const dense_dataset_view & p_data) {
+    if (m_leaf_size == 0) {
+        throw std::invalid_argument("Leaf size of ball tree should be greater than 0.");
+    }
+
+    /* square Euclidean distance does not satisfy the triangle inequality, balls are built by Euclidean distance */
+    if (m_metric.kind() == metric_kind::EUCLIDEAN_SQUARE) {
+        m_metric = distance_metric_factory<point>::euclidean();
+        m_square = true;
+    }
+
+    m_vectorized = utils::simd::is_supported(m_metric.kind());
+
+    if (p_data.empty()) {
+        return;
+    }
+
+    m_indexes.resize(p_data.size());
+    std::iota(m_indexes.begin(), m_indexes.end(), 0);
+
+    m_nodes.reserve(2 * (p_data.size() / m_leaf_size) + 1);
+    create_node(p_data, 0, p_data.size(), m_nodes);
+
+    m_points = dense_dataset(p_data.size(), p_data.dimension());
+    m_positions.resize(p_data.size());
+    parallel_for(std::size_t(0), m_indexes.size(), [this, &p_data](const std::size_t p_index) {
+        const double * source = p_data.row(m_indexes[p_index]);
+        std::copy(source, source + p_data.dimension(), m_points.row(p_index));
+        m_positions[m_indexes[p_index]] = p_index;
+    });
+
+    create_balls();
+}
+
+
+std::size_t ball_tree::create_node(const dense_dataset_view & p_data, const std::size_t p_begin, const std::size_t p_end, std::vector<node> & p_nodes) {
+    const std::size_t index_node = p_nodes.size();
+    p_nodes.emplace_back();
+    p_nodes[index_node].m_begin = p_begin;
+    p_nodes[index_node].m_end = p_end;
+
+    if (p_end - p_begin <= m_leaf_size) {
+        return index_node;
+    }
+
+    std::vector<double> minimum(p_data.dimension(), std::numeric_limits<double>::max());
+    std::vector<double> maximum(p_data.dimension(), std::numeric_limits<double>::lowest());
+    for (std::size_t i = p_begin; i < p_end; i++) {
+        const double * current_point = p_data.row(m_indexes[i]);
+        for (std::size_t index_dimension = 0; index_dimension < p_data.dimension(); index_dimension++) {
+            minimum[index_dimension] = std::min(minimum[index_dimension], current_point[index_dimension]);
+            maximum[index_dimension] = std::max(maximum[index_dimension], current_point[index_dimension]);
+        }
+    }
+
+    std::size_t discriminator = 0;
+    double widest_spread = 0.0;
+    for (std::size_t index_dimension = 0; index_dimension < p_data.dimension(); index_dimension++) {
+        if (maximum[index_dimension] - minimum[index_dimension] > widest_spread) {
+            widest_spread = maximum[index_dimension] - minimum[index_dimension];
+            discriminator = index_dimension;
+        }
+    }
+
+    if (widest_spread == 0.0) {
+        return index_node;      /* all points are the same, they cannot be split */
+    }
+
+    const std::size_t median = p_begin + (p_end - p_begin) / 2;
+    std::nth_element(m_indexes.begin() + p_begin, m_indexes.begin() + median, m_indexes.begin() + p_end,
+        [&p_data, discriminator](const std::size_t p_index1, const std::size_t p_index2) {
+            return p_data.row(p_index1)[discriminator] < p_data.row(p_index2)[discriminator];
+        });
+
+    std::size_t index_right = 0;
+    if (p_end - p_begin >= PARALLEL_BUILD_SIZE) {
+        /* sub-trees are built to separate arrays, then they are appended, so indexes of the right sub-tree are shifted */
+        std::vector<node> children[2];
+        parallel_for(std::size_t(0), std::size_t(2), [this, &p_data, &children, p_begin, median, p_end](const std::size_t p_side) {
+            if (p_side == 0) {
+                create_node(p_data, p_begin, median, children[0]);
+            }
+            else {
+                create_node(p_data, median, p_end, children[1]);
+            }
+        });
+
+        for (auto & child : children) {
+            const std::size_t offset = p_nodes.size();
+            for (auto & child_node : child) {
+                if (child_node.m_right != 0) {
+                    child_node.m_right += offset;
+                }
+            }
+
+            p_nodes.insert(p_nodes.end(), child.begin(), child.end());
+        }
+
+        index_right = index_node + 1 + children[0].size();
+    }
+    else {
+        create_node(p_data, p_begin, median, p_nodes);
+        index_right = create_node(p_data, median, p_end, p_nodes);
+    }
+
+    p_nodes[index_node].m_right = index_right;
+
+    return index_node;
+}
+
+
+void ball_tree::create_balls() {
+    const std::size_t dimension = m_points.dimension();
+    m_centers = dense_dataset(m_nodes.size(), dimension);
+
+    /* points of a node are contiguous in tree order, so each ball is calculated independently */
+    visit(m_metric, [this, dimension](const auto & p_distance) {
+        parallel_for(std::size_t(0), m_nodes.size(), [this, dimension, &p_distance](const std::size_t p_index_node) {
+            node & current = m_nodes[p_index_node];
+            double * center = m_centers.row(p_index_node);
+
+            for (std::size_t index_point = current.m_begin; index_point < current.m_end; index_point++) {
+                const double * current_point = m_points.row(index_point);
+                for (std::size_t index_dimension = 0; index_dimension < dimension; index_dimension++) {
+                    center[index_dimension] += current_point[index_dimension];
+                }
+            }
+
+            const double amount_points = static_cast<double>(current.m_end - current.m_begin);
+            for (std::size_t index_dimension = 0; index_dimension < dimension; index_dimension++) {
+                center[index_dimension] /= amount_points;
+            }
+
+            double radius = 0.0;
+            for (std::size_t index_point = current.m_begin; index_point < current.m_end; index_point++) {
+                radius = std::max(radius, p_distance(m_centers[p_index_node], m_points[index_point]));
+            }
+
+            current.m_radius = radius;
+        });
+    });
+}
+
+
+}
+
+}
@@ -0,0 +1,80 @@
+/*!
+
+@authors Andrei Novikov (pyclustering@yandex.ru)
+@date 2014-2020
+@copyright BSD-3-Clause
+
+*/
+
+
+#include <pyclustering/container/concurrent_disjoint_set.hpp>
+
+#include <utility>
+
+
+namespace pyclustering {
+
+namespace container {
+
+
+concurrent_disjoint_set::concurrent_disjoint_set(const std::size_t p_size) :
+    m_parents(p_size)
+{
+    for (std::size_t i = 0; i < p_size; i++) {
+        m_parents[i].store(i, std::memory_order_relaxed);
+    }
+}
+
+
+std::size_t concurrent_disjoint_set::find(const std::size_t p_element) {
+    std::size_t element = p_element;
+    std::size_t parent = m_parents[element].load(std::memory_order_acquire);
+
+    while (parent != element) {
+        /* the grandparent is not greater than the parent, so halving keeps parents decreasing */
+        std::size_t grandparent = m_parents[parent].load(std::memory_order_acquire);
+        if (grandparent != parent) {
+            m_parents[element].compare_exchange_weak(parent, grandparent, std::memory_order_acq_rel, std::memory_order_acquire);
+        }
+
+        element = parent;
+        parent = m_parents[element].load(std::memory_order_acquire);
+    }
+
+    return element;
+}
+
+
+bool concurrent_disjoint_set::unite(const std::size_t p_element1, const std::size_t p_element2) {
+    std::size_t root1 = p_element1;
+    std::size_t root2 = p_element2;
+
+    while (true) {
+        root1 = find(root1);
+        root2 = find(root2);
+
+        if (root1 == root2) {
+            return false;
+        }
+
+        if (root1 < root2) {
+            std::swap(root1, root2);
+        }
+
+        /* the greater root is linked to the smaller one if it is still a root */
+        std::size_t expected = root1;
+        if (m_parents[root1].compare_exchange_strong(expected, root2, std::memory_order_acq_rel, std::memory_order_acquire)) {
+            return true;
+        }
+    }
+}
+
+
+std::size_t concurrent_disjoint_set::size() const {
+    return m_parents.size();
+}
+
+
+}
+
+}
@@ -0,0 +1,92 @@
+/*!
+
+@authors Andrei Novikov (pyclustering@yandex.ru)
+@date 2014-2020
+@copyright BSD-3-Clause
+
+*/
+
+
+#include <pyclustering/container/dense_dataset.hpp>
+
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+
+
+namespace pyclustering {
+
+namespace container {
+
+
+dense_dataset_view::dense_dataset_view(const double * p_data, const std::size_t p_size, const std::size_t p_dimension, const std::size_t p_stride) :
+    m_data(p_data),
+    m_size(p_size),
+    m_dimension(p_dimension),
+    m_stride((p_stride == 0) ? p_dimension : p_stride)
+{
+    if (m_stride < m_dimension) {
+        throw std::invalid_argument("Stride '" + std::to_string(m_stride) + "' should not be less than dimension '" + std::to_string(m_dimension) + "'.");
+    }
+}
+
+
+dataset dense_dataset_view::to_dataset() const {
+    dataset result;
+    result.reserve(m_size);
+
+    for (std::size_t i = 0; i < m_size; i++) {
+        const double * coordinates = row(i);
+        result.emplace_back(coordinates, coordinates + m_dimension);
+    }
+
+    return result;
+}
+
+
+const std::size_t dense_dataset::ROW_ALIGNMENT = 64;
+
+
+dense_dataset::dense_dataset(const std::size_t p_size, const std::size_t p_dimension, const bool p_aligned) {
+    allocate(p_size, p_dimension, p_aligned);
+}
+
+
+dense_dataset::dense_dataset(const dataset & p_data, const bool p_aligned) {
+    const std::size_t dimension = p_data.empty() ? 0 : p_data.front().size();
+    allocate(p_data.size(), dimension, p_aligned);
+
+    for (std::size_t i = 0; i < p_data.size(); i++) {
+        if (p_data[i].size() != dimension) {
+            throw std::invalid_argument("Point '" + std::to_string(i) + "' has dimension '" + std::to_string(p_data[i].size())
+                + "' that is different from dimension '" + std::to_string(dimension) + "' of the first point.");
+        }
+
+        std::copy(p_data[i].begin(), p_data[i].end(), row(i));
+    }
+}
+
+
+dense_dataset::dense_dataset(const dense_dataset_view & p_data, const bool p_aligned) {
+    allocate(p_data.size(), p_data.dimension(), p_aligned);
+
+    for (std::size_t i = 0; i < p_data.size(); i++) {
+        std::copy(p_data.row(i), p_data.row(i) + m_dimension, row(i));
+    }
+}
+
+
+void dense_dataset::allocate(const std::size_t p_size, const std::size_t p_dimension, const bool p_aligned) {
+    const std::size_t row_elements = ROW_ALIGNMENT / sizeof(double);
+
+    m_size = p_size;
+    m_dimension = p_dimension;
+    m_stride = p_aligned ? ((p_dimension + row_elements - 1) / row_elements) * row_elements : p_dimension;
+
+    m_buffer.assign(m_size * m_stride, 0.0);
+}
+
+
+}
+
+}
@@ -0,0 +1,68 @@
+/*!
+
+@authors Andrei Novikov (pyclustering@yandex.ru)
+@date 2014-2020
+@copyright BSD-3-Clause
+
+*/
+
+
+#include <pyclustering/container/disjoint_set.hpp>
+
+#include <numeric>
+#include <utility>
+
+
+namespace pyclustering {
+
+namespace container {
+
+
+disjoint_set::disjoint_set(const std::size_t p_size) :
+    m_parents(p_size)
+{
+    std::iota(m_parents.begin(), m_parents.end(), 0);
+}
+
+
+std::size_t disjoint_set::find(const std::size_t p_element) {
+    std::size_t element = p_element;
+    while (m_parents[element] != element) {
+        m_parents[element] = m_parents[m_parents[element]];
+        element = m_parents[element];
+    }
+
+    return element;
+}
+
+
+bool disjoint_set::unite(const std::size_t p_element1, const std::size_t p_element2) {
+    std::size_t root1 = find(p_element1);
+    std::size_t root2 = find(p_element2);
+    if (root1 == root2) {
+        return false;
+    }
+
+    if (root2 < root1) {
+        std::swap(root1, root2);
+    }
+
+    m_parents[root2] = root1;
+    return true;
+}
+
+
+std::size_t disjoint_set::append() {
+    m_parents.push_back(m_parents.size());
+    return m_parents.size() - 1;
+}
+
+
+std::size_t disjoint_set::size() const {
+    return m_parents.size();
+}
+
+
+}
+
+}
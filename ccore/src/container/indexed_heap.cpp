@@ -0,0 +1,152 @@
+/*!
+
+@authors Andrei Novikov (pyclustering@yandex.ru)
+@date 2014-2020
+@copyright BSD-3-Clause
+
+*/
+
+
+#include <pyclustering/container/indexed_heap.hpp>
+
+#include <algorithm>
+#include <limits>
+
+
+namespace pyclustering {
+
+namespace container {
+
+
+const std::size_t indexed_heap::ARITY = 4;
+
+const std::size_t indexed_heap::NO_POSITION = std::numeric_limits<std::size_t>::max();
+
+
+indexed_heap::indexed_heap(const std::size_t p_capacity) :
+    m_positions(p_capacity, NO_POSITION)
+{
+    m_entries.reserve(p_capacity);
+}
+
+
+void indexed_heap::push(const std::size_t p_element, const double p_key) {
+    m_entries.push_back({ p_key, m_sequence++, p_element });
+    m_positions[p_element] = m_entries.size() - 1;
+
+    sift_up(m_entries.size() - 1);
+}
+
+
+void indexed_heap::decrease(const std::size_t p_element, const double p_key) {
+    const std::size_t position = m_positions[p_element];
+
+    /* the element is placed after elements with the same key like an inserted one */
+    m_entries[position].m_key = p_key;
+    m_entries[position].m_sequence = m_sequence++;
+
+    sift_up(position);
+}
+
+
+std::size_t indexed_heap::pop() {
+    const std::size_t element = m_entries.front().m_element;
+    m_positions[element] = NO_POSITION;
+
+    const entry last = m_entries.back();
+    m_entries.pop_back();
+
+    if (!m_entries.empty()) {
+        place(0, last);
+        sift_down(0);
+    }
+
+    return element;
+}
+
+
+std::size_t indexed_heap::top() const {
+    return m_entries.front().m_element;
+}
+
+
+bool indexed_heap::contains(const std::size_t p_element) const {
+    return m_positions[p_element] != NO_POSITION;
+}
+
+
+bool indexed_heap::empty() const {
+    return m_entries.empty();
+}
+
+
+std::size_t indexed_heap::size() const {
+    return m_entries.size();
+}
+
+
+bool indexed_heap::less(const entry & p_entry1, const entry & p_entry2) const {
+    if (p_entry1.m_key != p_entry2.m_key) {
+        return p_entry1.m_key < p_entry2.m_key;
+    }
+
+    return p_entry1.m_sequence < p_entry2.m_sequence;
+}
+
+
+void indexed_heap::place(const std::size_t p_position, const entry & p_entry) {
+    m_entries[p_position] = p_entry;
+    m_positions[p_entry.m_element] = p_position;
+}
+
+
+void indexed_heap::sift_up(std::size_t p_position) {
+    const entry current = m_entries[p_position];
+
+    while (p_position > 0) {
+        const std::size_t parent = (p_position - 1) / ARITY;
+        if (!less(current, m_entries[parent])) {
+            break;
+        }
+
+        place(p_position, m_entries[parent]);
+        p_position = parent;
+    }
+
+    place(p_position, current);
+}
+
+
+void indexed_heap::sift_down(std::size_t p_position) {
+    const entry current = m_entries[p_position];
+
+    while (true) {
+        const std::size_t first_child = p_position * ARITY + 1;
+        if (first_child >= m_entries.size()) {
+            break;
+        }
+
+        const std::size_t last_child = std::min(first_child + ARITY, m_entries.size());
+
+        std::size_t smallest = first_child;
+        for (std::size_t child = first_child + 1; child < last_child; child++) {
+            if (less(m_entries[child], m_entries[smallest])) {
+                smallest = child;
+            }
+        }
+
+        if (!less(m_entries[smallest], current)) {
+            break;
+        }
+
+        place(p_position, m_entries[smallest]);
+        p_position = smallest;
+    }
+
+    place(p_position, current);
+}
+
+
+}
+
+}
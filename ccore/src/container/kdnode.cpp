@@ -55,12 +55,17 @@ void kdnode::set_discriminator(const std::size_t disc) {
 }
 
 
-kdnode::ptr kdnode::get_left() const {
+void kdnode::set_removed(const bool p_removed) {
+    m_removed = p_removed;
+}
+
+
+const kdnode::ptr & kdnode::get_left() const {
     return m_left;
 }
 
 
-kdnode::ptr kdnode::get_right() const {
+const kdnode::ptr & kdnode::get_right() const {
     return m_right;
 }
 
@@ -88,7 +93,7 @@ kdnode::ptr kdnode::find_node(const point & p_point, const search_node_rule & p_
 
     while (cur_node != nullptr) {
         if (*cur_node <= p_point) {
-            if (p_rule(*cur_node)) {    /* Less or equal - check if equal. */
+            if (!cur_node->is_removed() && p_rule(*cur_node)) {    /* Less or equal - check if equal. */
                 return cur_node;
             }
 
@@ -128,6 +133,11 @@ std::size_t kdnode::get_discriminator() const {
 }
 
 
+bool kdnode::is_removed() const {
+    return m_removed;
+}
+
+
 std::size_t kdnode::get_dimension() const {
     return m_data.size();
 }
@@ -8,8 +8,9 @@
 
 #include <pyclustering/container/kdtree.hpp>
 
-#include <limits>
-#include <stack>
+#include <cmath>
+#include <stdexcept>
+#include <utility>
 
 
 namespace pyclustering {
@@ -17,63 +18,52 @@ namespace pyclustering {
 namespace container {
 
 
+const double kdtree::REBALANCE_FACTOR = 0.7;
+
+
 kdtree::kdtree(const dataset & p_data, const std::vector<void *> & p_payloads) :
     kdtree_balanced(p_data, p_payloads)
 { }
 
 
 kdnode::ptr kdtree::insert(const std::vector<double> & p_point, void * p_payload) {
-    kdnode::ptr inserted_kdnode;
+    kdnode::ptr node = std::make_shared<kdnode>(p_point, p_payload, nullptr, nullptr, nullptr, 0);
 
-    if (m_root == nullptr) {
-        kdnode::ptr node = std::make_shared<kdnode>(p_point, p_payload, nullptr, nullptr, nullptr, 0);
+    if (link(node) > get_maximum_depth()) {
+        rebalance(node);
+    }
+
+    return node;
+}
 
-        m_root = node;
-        m_dimension = node->get_dimension();
 
-        inserted_kdnode = std::move(node);
+std::vector<kdnode::ptr> kdtree::insert(const dataset & p_points, const std::vector<void *> & p_payloads) {
+    std::vector<kdnode::ptr> nodes(p_points.size());
+    for (std::size_t i = 0; i < p_points.size(); i++) {
+        nodes[i] = std::make_shared<kdnode>(p_points[i], p_payloads.empty() ? nullptr : p_payloads[i], nullptr, nullptr, nullptr, 0);
     }
-    else {
-        kdnode::ptr cur_node = m_root;
-
-        while(true) {
-            /* If new node is greater or equal than current node then check right leaf */
-            if (*cur_node <= p_point) {
-                if (cur_node->get_right() == nullptr) {
-                    std::size_t discriminator = cur_node->get_discriminator() + 1;
-                    if (discriminator >= m_dimension) {
-                        discriminator = 0;
-                    }
-
-                    cur_node->set_right(std::make_shared<kdnode>(p_point, p_payload, nullptr, nullptr, cur_node, discriminator));
-                    inserted_kdnode = cur_node->get_right();
-                    break;
-                }
-                else {
-                    cur_node = cur_node->get_right();
-                }
-            }
-            /* If new node is less than current then check left leaf */
-            else {
-                if (cur_node->get_left() == nullptr) {
-                    std::size_t discriminator = cur_node->get_discriminator() + 1;
-                    if (discriminator >= m_dimension) {
-                        discriminator = 0;
-                    }
-
-                    cur_node->set_left(std::make_shared<kdnode>(p_point, p_payload, nullptr, nullptr, cur_node, discriminator));
-                    inserted_kdnode = cur_node->get_left();
-                    break;
-                }
-                else {
-                    cur_node = cur_node->get_left();
-                }
+
+    if (nodes.empty()) {
+        return nodes;
+    }
+
+    if (nodes.size() < m_size) {
+        for (auto & node : nodes) {
+            if (link(node) > get_maximum_depth()) {
+                rebalance(node);
             }
         }
     }
+    else {
+        if (m_root == nullptr) {
+            m_dimension = p_points.front().size();
+        }
 
-    m_size++;
-    return inserted_kdnode;
+        m_size += nodes.size();
+        rebuild(m_root, std::vector<kdnode::ptr>(nodes));
+    }
+
+    return nodes;
 }
 
 
@@ -98,112 +88,197 @@ void kdtree::remove(const std::vector<double> & p_point, const void * p_payload)
 
 
 void kdtree::remove(kdnode::ptr & p_node_for_remove) {
-    kdnode::ptr parent = p_node_for_remove->get_parent();
-    kdnode::ptr node = recursive_remove(p_node_for_remove);
+    erase(p_node_for_remove);
 
-    if (parent == nullptr) {
-        m_root = node;
+    if (m_removed > m_size) {
+        rebuild(m_root);
+    }
+}
 
-        /* if tree is almost destroyed */
-        if (node != nullptr) {
-            node->set_parent(nullptr);
-        }
 
-        m_size--;
+void kdtree::remove(const std::vector<kdnode::ptr> & p_nodes) {
+    for (const auto & node : p_nodes) {
+        erase(node);
     }
-    else {
-        if (parent->get_left() == p_node_for_remove) {
-            parent->set_left(node);
+
+    if (m_removed > m_size) {
+        rebuild(m_root);
+    }
+}
+
+
+std::size_t kdtree::link(const kdnode::ptr & p_node) {
+    m_size++;
+
+    if (m_root == nullptr) {
+        m_root = p_node;
+        m_dimension = p_node->get_dimension();
+        return 0;
+    }
+
+    std::size_t depth = 1;
+    for (kdnode::ptr cur_node = m_root; ; depth++) {
+        /* If new node is greater or equal than current node then check right leaf, otherwise - left leaf */
+        const bool is_right = (*cur_node <= p_node->get_data());
+        const kdnode::ptr & child = is_right ? cur_node->get_right() : cur_node->get_left();
+
+        if (child != nullptr) {
+            cur_node = child;
+            continue;
+        }
+
+        std::size_t discriminator = cur_node->get_discriminator() + 1;
+        if (discriminator >= m_dimension) {
+            discriminator = 0;
         }
-        else if (parent->get_right() == p_node_for_remove) {
-            parent->set_right(node);
+
+        p_node->set_parent(cur_node);
+        p_node->set_discriminator(discriminator);
+
+        if (is_right) {
+            cur_node->set_right(p_node);
         }
         else {
-            throw std::runtime_error("Structure of KD Tree is corrupted");
+            cur_node->set_left(p_node);
         }
 
-        m_size--;
+        return depth;
     }
 }
 
 
-kdnode::ptr kdtree::recursive_remove(kdnode::ptr & p_node) {
-    if ( (p_node->get_right() == nullptr) && (p_node->get_left() == nullptr) ) {
-        return nullptr;
+void kdtree::erase(const kdnode::ptr & p_node) {
+    if (p_node->is_removed()) {
+        return;
     }
 
-    std::size_t discriminator = p_node->get_discriminator();
+    p_node->set_removed(true);
+    m_size--;
+    m_removed++;
 
-    /* Check if only left branch exist */
-    if (p_node->get_right() == nullptr) {
-        p_node->set_right(p_node->get_left());
-        p_node->set_left(nullptr);
-    }
+    /* removed leaves do not split the space, so they are unlinked (their removed parents might become leaves) */
+    kdnode::ptr node = p_node;
+    while ((node != nullptr) && node->is_removed() && (node->get_left() == nullptr) && (node->get_right() == nullptr)) {
+        kdnode::ptr parent = node->get_parent();
 
-    /* Find minimal node in line with coordinate that is defined by discriminator */
-    kdnode::ptr minimal_node = find_minimal_node(p_node->get_right(), discriminator);
-    kdnode::ptr parent = minimal_node->get_parent();
+        if (parent == nullptr) {
+            m_root = nullptr;
+        }
+        else if (parent->get_left() == node) {
+            parent->set_left(nullptr);
+        }
+        else if (parent->get_right() == node) {
+            parent->set_right(nullptr);
+        }
+        else {
+            throw std::runtime_error("Structure of KD Tree is corrupted");
+        }
 
-    if (parent->get_left() == minimal_node) {
-        parent->set_left(recursive_remove(minimal_node));
-    }
-    else if (parent->get_right() == minimal_node) {
-        parent->set_right(recursive_remove(minimal_node));
-    }
-    else {
-        throw std::runtime_error("Structure of KD Tree is corrupted");
+        node->set_parent(nullptr);
+        m_removed--;
+
+        node = parent;
     }
+}
 
-    minimal_node->set_parent(p_node->get_parent());
-    minimal_node->set_discriminator(p_node->get_discriminator());
-    minimal_node->set_right(p_node->get_right());
-    minimal_node->set_left(p_node->get_left());
 
-    /* Update parent for successors of previous parent */
-    if (minimal_node->get_right() != nullptr) {
-        minimal_node->get_right()->set_parent(minimal_node);
-    }
+void kdtree::rebalance(const kdnode::ptr & p_node) {
+    std::size_t size = 1;
+    kdnode::ptr child = p_node;
 
-    if (minimal_node->get_left() != nullptr) {
-        minimal_node->get_left()->set_parent(minimal_node);
-    }
+    for (kdnode::ptr parent = p_node->get_parent(); parent != nullptr; child = parent, parent = parent->get_parent()) {
+        const kdnode::ptr & sibling = (parent->get_left() == child) ? parent->get_right() : parent->get_left();
+        const std::size_t parent_size = size + 1 + count_nodes(sibling);
 
-    return minimal_node;
+        if (static_cast<double>(size) > REBALANCE_FACTOR * static_cast<double>(parent_size)) {
+            rebuild(parent);
+            return;
+        }
+
+        size = parent_size;
+    }
 }
 
 
-kdnode::ptr kdtree::find_minimal_node(const kdnode::ptr & p_cur_node, std::size_t p_discriminator) {
-    std::stack<kdnode::ptr> stack;
-    kdnode::ptr minimal_node = p_cur_node;
-    kdnode::ptr cursor = p_cur_node;
-    std::vector<kdnode::ptr> candidates;
-    bool is_done = false;
+void kdtree::rebuild(const kdnode::ptr & p_node, std::vector<kdnode::ptr> && p_appended) {
+    std::vector<kdnode::ptr> nodes = std::move(p_appended);
 
-    while (!is_done) {
-        if (cursor != nullptr) {
-            stack.push(cursor);
-            cursor = cursor->get_left();
-        }
-        else {
-            if (!stack.empty()) {
-                cursor = stack.top();
-                candidates.push_back(cursor);
-                stack.pop();
-                cursor = cursor->get_right();
+    kdnode::ptr parent = nullptr;
+    std::size_t discriminator = 0;
+
+    if (p_node != nullptr) {
+        parent = p_node->get_parent();
+        discriminator = p_node->get_discriminator();
+
+        std::vector<kdnode::ptr> stack = { p_node };
+        while (!stack.empty()) {
+            kdnode::ptr node = std::move(stack.back());
+            stack.pop_back();
+
+            if (node->get_left() != nullptr) {
+                stack.push_back(node->get_left());
+            }
+
+            if (node->get_right() != nullptr) {
+                stack.push_back(node->get_right());
+            }
+
+            if (node->is_removed()) {
+                m_removed--;
+
+                node->set_left(nullptr);
+                node->set_right(nullptr);
+                node->set_parent(nullptr);
             }
             else {
-                is_done = true;
+                nodes.push_back(std::move(node));
             }
         }
     }
 
-    for (size_t i = 0; i < candidates.size(); i++) {
-        if (candidates[i]->get_value(p_discriminator) <= minimal_node->get_value(p_discriminator)) {
-            minimal_node = candidates[i];
+    /* the discriminator of the sub-tree root is kept, so the rebuilt sub-tree is consistent with its ancestors */
+    kdnode::ptr root = create_tree(nodes.begin(), nodes.end(), parent, discriminator);
+
+    if (parent == nullptr) {
+        m_root = root;
+    }
+    else if (parent->get_left() == p_node) {
+        parent->set_left(root);
+    }
+    else {
+        parent->set_right(root);
+    }
+}
+
+
+std::size_t kdtree::get_maximum_depth() const {
+    const double amount_nodes = static_cast<double>(m_size + m_removed);
+    return static_cast<std::size_t>(std::log(amount_nodes) / std::log(1.0 / REBALANCE_FACTOR));
+}
+
+
+std::size_t kdtree::count_nodes(const kdnode::ptr & p_node) {
+    if (p_node == nullptr) {
+        return 0;
+    }
+
+    std::size_t amount = 0;
+    std::vector<const kdnode *> stack = { p_node.get() };
+    while (!stack.empty()) {
+        const kdnode * node = stack.back();
+        stack.pop_back();
+        amount++;
+
+        if (node->get_left() != nullptr) {
+            stack.push_back(node->get_left().get());
+        }
+
+        if (node->get_right() != nullptr) {
+            stack.push_back(node->get_right().get());
         }
     }
 
-    return minimal_node;
+    return amount;
 }
 
 
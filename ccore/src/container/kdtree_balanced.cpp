@@ -7,12 +7,13 @@
 */
 
 #include <pyclustering/container/kdtree_balanced.hpp>
-#include <pyclustering/utils/algorithm.hpp>
+
+#include <pyclustering/parallel/parallel.hpp>
 
 #include <algorithm>
 
 
-using namespace pyclustering::utils::algorithm;
+using namespace pyclustering::parallel;
 
 
 namespace pyclustering {
@@ -20,6 +21,9 @@ namespace pyclustering {
 namespace container {
 
 
+const std::size_t kdtree_balanced::PARALLEL_BUILD_SIZE = 8192;
+
+
 kdtree_balanced::kdtree_balanced(const dataset & p_data, const std::vector<void *> & p_payloads) {
     if (p_data.empty()) { return; }
 
@@ -33,36 +37,69 @@ kdtree_balanced::kdtree_balanced(const dataset & p_data, const std::vector<void
     }
 
     m_dimension = p_data[0].size();
+    m_size = nodes.size();
+    m_root = create_tree(nodes.begin(), nodes.end(), nullptr, 0);
+}
+
+
+kdtree_balanced::kdtree_balanced(const dense_dataset_view & p_data, const std::vector<void *> & p_payloads) {
+    if (p_data.empty()) { return; }
+
+    std::vector<kdnode::ptr> nodes(p_data.size());
+    for (std::size_t i = 0; i < p_data.size(); i++) {
+        nodes[i] = std::make_shared<kdnode>(p_data[i].to_point(), nullptr, nullptr, nullptr, nullptr, 0);
+
+        if (!p_payloads.empty()) {
+            nodes[i]->set_payload(p_payloads[i]);
+        }
+    }
+
+    m_dimension = p_data.dimension();
+    m_size = nodes.size();
     m_root = create_tree(nodes.begin(), nodes.end(), nullptr, 0);
 }
 
 
 kdnode::ptr kdtree_balanced::create_tree(std::vector<kdnode::ptr>::iterator p_begin, std::vector<kdnode::ptr>::iterator p_end, const kdnode::ptr & p_parent, const std::size_t p_depth) {
-    const int length = static_cast<int>(std::distance(p_begin, p_end));
+    const std::size_t length = static_cast<std::size_t>(std::distance(p_begin, p_end));
     if (length == 0) {
         return nullptr;
     }
 
     const std::size_t discriminator = p_depth % m_dimension;
-    const int median = length / 2;
-
-    std::sort(p_begin, p_end, [discriminator](const kdnode::ptr & p1, const kdnode::ptr & p2) {
+    const auto less = [discriminator](const kdnode::ptr & p1, const kdnode::ptr & p2) {
         return p1->get_data()[discriminator] < p2->get_data()[discriminator];
-    });
+    };
 
-    auto median_iter = find_left_element(p_begin, p_begin + median + 1, 
-        [discriminator](const kdnode::ptr & p1, const kdnode::ptr & p2) {
-            return p1->get_data()[discriminator] < p2->get_data()[discriminator];
-        }
-    );
+    /* the median is selected in linear time, then nodes that are equal to it are moved to the right side of the
+       left part, so the left sub-tree contains only nodes that are less than the median node */
+    auto median_iter = p_begin + length / 2;
+    std::nth_element(p_begin, median_iter, p_end, less);
+
+    const kdnode::ptr median_node = *median_iter;
+    median_iter = std::partition(p_begin, median_iter, [&median_node, &less](const kdnode::ptr & p_node) {
+        return less(p_node, median_node);
+    });
 
     kdnode::ptr new_node = *median_iter;
     new_node->set_parent(p_parent);
     new_node->set_discriminator(discriminator);
-    new_node->set_left(create_tree(p_begin, median_iter, new_node, p_depth + 1));
-    new_node->set_right(create_tree(median_iter + 1, p_end, new_node, p_depth + 1));
 
-    m_size++;
+    if (length >= PARALLEL_BUILD_SIZE) {
+        parallel_for(std::size_t(0), std::size_t(2), [this, p_begin, p_end, median_iter, &new_node, p_depth](const std::size_t p_side) {
+            if (p_side == 0) {
+                new_node->set_left(create_tree(p_begin, median_iter, new_node, p_depth + 1));
+            }
+            else {
+                new_node->set_right(create_tree(median_iter + 1, p_end, new_node, p_depth + 1));
+            }
+        });
+    }
+    else {
+        new_node->set_left(create_tree(p_begin, median_iter, new_node, p_depth + 1));
+        new_node->set_right(create_tree(median_iter + 1, p_end, new_node, p_depth + 1));
+    }
+
     return new_node;
 }
 
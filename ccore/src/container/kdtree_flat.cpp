@@ -0,0 +1,321 @@
+/*!
+
+@authors Andrei Novikov (pyclustering@yandex.ru)
+@date 2014-2020
+@copyright BSD-3-Clause
+
+*/
+
+
+#include <pyclustering/container/kdtree_flat.hpp>
+
+#include <pyclustering/parallel/parallel.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <stdexcept>
+#include <utility>
+
+
+using namespace pyclustering::parallel;
+
+
+namespace pyclustering {
+
+namespace container {
+
+
+const std::size_t kdtree_flat::DEFAULT_LEAF_SIZE = 16;
+
+const std::size_t kdtree_flat::NO_LABEL = std::numeric_limits<std::size_t>::max();
+
+constexpr std::size_t kdtree_flat::MAXIMUM_DEPTH;
+
+const std::size_t kdtree_flat::PARALLEL_BUILD_SIZE = 8192;
+
+
+kdtree_flat::kdtree_flat(const dataset & p_data, const std::size_t p_leaf_size) :
+    m_leaf_size(p_leaf_size)
+{
+    build(dense_dataset(p_data));
+}
+
+
+kdtree_flat::kdtree_flat(const dense_dataset_view & p_data, const std::size_t p_leaf_size) :
+    m_leaf_size(p_leaf_size)
+{
+    build(p_data);
+}
+
+
+void kdtree_flat::find_nearest(const point & p_point, const double p_radius, std::vector<std::size_t> & p_indexes, std::vector<double> & p_square_distances) const {
+    p_indexes.clear();
+    p_square_distances.clear();
+
+    find_nearest(p_point.data(), p_radius, [&p_indexes, &p_square_distances](const std::size_t p_index, const double p_square_distance) {
+        p_indexes.push_back(p_index);
+        p_square_distances.push_back(p_square_distance);
+    });
+}
+
+
+void kdtree_flat::find_nearest(const std::vector<std::size_t> & p_queries, const double p_radius, neighbor_graph & p_graph, const bool p_store_distances) const {
+    p_graph.assign(p_queries.size(), [this, &p_queries, p_radius, p_store_distances](const std::size_t p_query, std::vector<std::size_t> & p_neighbors, std::vector<double> & p_distances) {
+        find_nearest(m_points.row(m_positions[p_queries[p_query]]), p_radius, [&p_neighbors, &p_distances, p_store_distances](const std::size_t p_index, const double p_square_distance) {
+            p_neighbors.push_back(p_index);
+            if (p_store_distances) {
+                p_distances.push_back(std::sqrt(p_square_distance));
+            }
+        });
+    });
+}
+
+
+void kdtree_flat::find_nearest(const double p_radius, neighbor_graph & p_graph, const bool p_store_distances) const {
+    std::vector<std::size_t> queries(size());
+    std::iota(queries.begin(), queries.end(), 0);
+
+    find_nearest(queries, p_radius, p_graph, p_store_distances);
+}
+
+
+void kdtree_flat::find_k_nearest(const double * p_point, const std::size_t p_k, const double p_max_radius, std::vector<std::size_t> & p_indexes, std::vector<double> & p_square_distances) const {
+    p_indexes.clear();
+    p_square_distances.clear();
+
+    if ((p_k == 0) || m_nodes.empty()) {
+        return;
+    }
+
+    const double square_radius = p_max_radius * p_max_radius;
+    const std::size_t dimension = m_points.dimension();
+
+    std::vector<std::pair<double, std::size_t>> heap;     /* max-heap of the nearest points by square distance */
+    heap.reserve(p_k);
+
+    /* each entry is a node and square distance to its splitting plane that is a lower bound for its points */
+    std::pair<std::size_t, double> stack[MAXIMUM_DEPTH + 1];
+    std::size_t stack_size = 0;
+    stack[stack_size++] = { 0, 0.0 };
+
+    while (stack_size > 0) {
+        const auto entry = stack[--stack_size];
+        const double bound = (heap.size() < p_k) ? square_radius : heap.front().first;
+        if (entry.second > bound) {
+            continue;
+        }
+
+        const node & current = m_nodes[entry.first];
+        if (current.m_right == 0) {
+            for (std::size_t index_point = current.m_begin; index_point < current.m_end; index_point++) {
+                const double * candidate = m_points.row(index_point);
+
+                double square_distance = 0.0;
+                for (std::size_t index_dimension = 0; index_dimension < dimension; index_dimension++) {
+                    const double difference = p_point[index_dimension] - candidate[index_dimension];
+                    square_distance += difference * difference;
+                }
+
+                if (square_distance > square_radius) {
+                    continue;
+                }
+
+                const auto neighbor = std::make_pair(square_distance, m_indexes[index_point]);
+                if (heap.size() < p_k) {
+                    heap.push_back(neighbor);
+                    std::push_heap(heap.begin(), heap.end());
+                }
+                else if (neighbor < heap.front()) {
+                    std::pop_heap(heap.begin(), heap.end());
+                    heap.back() = neighbor;
+                    std::push_heap(heap.begin(), heap.end());
+                }
+            }
+
+            continue;
+        }
+
+        /* the farthest child is pushed first, so the nearest child is visited first */
+        const std::size_t index_left = entry.first + 1;
+        const double difference = p_point[current.m_discriminator] - current.m_value;
+        const double plane_distance = difference * difference;
+
+        if (difference < 0.0) {
+            stack[stack_size++] = { current.m_right, plane_distance };
+            stack[stack_size++] = { index_left, entry.second };
+        }
+        else {
+            stack[stack_size++] = { index_left, plane_distance };
+            stack[stack_size++] = { current.m_right, entry.second };
+        }
+    }
+
+    std::sort_heap(heap.begin(), heap.end());
+
+    p_indexes.reserve(heap.size());
+    p_square_distances.reserve(heap.size());
+    for (const auto & neighbor : heap) {
+        p_square_distances.push_back(neighbor.first);
+        p_indexes.push_back(neighbor.second);
+    }
+}
+
+
+void kdtree_flat::label_nodes(const std::vector<std::size_t> & p_labels, std::vector<std::size_t> & p_node_labels) const {
+    p_node_labels.resize(m_nodes.size());
+
+    /* children are placed after their parent, so they are labeled first */
+    for (std::size_t index_node = m_nodes.size(); index_node-- > 0;) {
+        const node & current = m_nodes[index_node];
+
+        if (current.m_right == 0) {
+            std::size_t label = p_labels[m_indexes[current.m_begin]];
+            for (std::size_t index_point = current.m_begin + 1; (index_point < current.m_end) && (label != NO_LABEL); index_point++) {
+                if (p_labels[m_indexes[index_point]] != label) {
+                    label = NO_LABEL;
+                }
+            }
+
+            p_node_labels[index_node] = label;
+        }
+        else {
+            const std::size_t label = p_node_labels[index_node + 1];
+            p_node_labels[index_node] = (label == p_node_labels[current.m_right]) ? label : NO_LABEL;
+        }
+    }
+}
+
+
+std::size_t kdtree_flat::size() const {
+    return m_points.size();
+}
+
+
+std::size_t kdtree_flat::dimension() const {
+    return m_points.dimension();
+}
+
+
+bool kdtree_flat::empty() const {
+    return m_points.empty();
+}
+
+
+std::size_t kdtree_flat::get_leaf_size() const {
+    return m_leaf_size;
+}
+
+
+void kdtree_flat::build(const dense_dataset_view & p_data) {
+    if (m_leaf_size == 0) {
+        throw std::invalid_argument("Leaf size of KD-tree should be greater than 0.");
+    }
+
+    if (p_data.empty()) {
+        return;
+    }
+
+    m_indexes.resize(p_data.size());
+    std::iota(m_indexes.begin(), m_indexes.end(), 0);
+
+    m_nodes.reserve(2 * (p_data.size() / m_leaf_size) + 1);
+    create_node(p_data, 0, p_data.size(), m_nodes);
+
+    /* points are stored in tree order, therefore points of a leaf are neighbours in memory */
+    m_points = dense_dataset(p_data.size(), p_data.dimension());
+    m_positions.resize(p_data.size());
+    parallel_for(std::size_t(0), m_indexes.size(), [this, &p_data](const std::size_t p_index) {
+        const double * source = p_data.row(m_indexes[p_index]);
+        std::copy(source, source + p_data.dimension(), m_points.row(p_index));
+        m_positions[m_indexes[p_index]] = p_index;
+    });
+}
+
+
+std::size_t kdtree_flat::create_node(const dense_dataset_view & p_data, const std::size_t p_begin, const std::size_t p_end, std::vector<node> & p_nodes) {
+    const std::size_t index_node = p_nodes.size();
+    p_nodes.emplace_back();
+    p_nodes[index_node].m_begin = p_begin;
+    p_nodes[index_node].m_end = p_end;
+
+    if (p_end - p_begin <= m_leaf_size) {
+        return index_node;
+    }
+
+    /* the dimension with the widest spread is split, so that the tree adapts to skewed data */
+    std::vector<double> minimum(p_data.dimension(), std::numeric_limits<double>::max());
+    std::vector<double> maximum(p_data.dimension(), std::numeric_limits<double>::lowest());
+    for (std::size_t i = p_begin; i < p_end; i++) {
+        const double * current_point = p_data.row(m_indexes[i]);
+        for (std::size_t index_dimension = 0; index_dimension < p_data.dimension(); index_dimension++) {
+            minimum[index_dimension] = std::min(minimum[index_dimension], current_point[index_dimension]);
+            maximum[index_dimension] = std::max(maximum[index_dimension], current_point[index_dimension]);
+        }
+    }
+
+    std::size_t discriminator = 0;
+    double widest_spread = 0.0;
+    for (std::size_t index_dimension = 0; index_dimension < p_data.dimension(); index_dimension++) {
+        if (maximum[index_dimension] - minimum[index_dimension] > widest_spread) {
+            widest_spread = maximum[index_dimension] - minimum[index_dimension];
+            discriminator = index_dimension;
+        }
+    }
+
+    if (widest_spread == 0.0) {
+        return index_node;      /* all points are the same, they cannot be split */
+    }
+
+    const std::size_t median = p_begin + (p_end - p_begin) / 2;
+    std::nth_element(m_indexes.begin() + p_begin, m_indexes.begin() + median, m_indexes.begin() + p_end,
+        [&p_data, discriminator](const std::size_t p_index1, const std::size_t p_index2) {
+            return p_data.row(p_index1)[discriminator] < p_data.row(p_index2)[discriminator];
+        });
+
+    /* points before the median are not greater than the splitting value, points after it are not less */
+    const double value = p_data.row(m_indexes[median])[discriminator];
+
+    std::size_t index_right = 0;
+    if (p_end - p_begin >= PARALLEL_BUILD_SIZE) {
+        /* sub-trees are built to separate arrays, then they are appended, so indexes of the right sub-tree are shifted */
+        std::vector<node> children[2];
+        parallel_for(std::size_t(0), std::size_t(2), [this, &p_data, &children, p_begin, median, p_end](const std::size_t p_side) {
+            if (p_side == 0) {
+                create_node(p_data, p_begin, median, children[0]);
+            }
+            else {
+                create_node(p_data, median, p_end, children[1]);
+            }
+        });
+
+        for (auto & child : children) {
+            const std::size_t offset = p_nodes.size();
+            for (auto & child_node : child) {
+                if (child_node.m_right != 0) {
+                    child_node.m_right += offset;
+                }
+            }
+
+            p_nodes.insert(p_nodes.end(), child.begin(), child.end());
+        }
+
+        index_right = index_node + 1 + children[0].size();
+    }
+    else {
+        create_node(p_data, p_begin, median, p_nodes);
+        index_right = create_node(p_data, median, p_end, p_nodes);
+    }
+
+    p_nodes[index_node].m_value = value;
+    p_nodes[index_node].m_discriminator = discriminator;
+    p_nodes[index_node].m_right = index_right;
+
+    return index_node;
+}
+
+
+}
+
+}
@@ -8,11 +8,6 @@
 
 #include <pyclustering/container/kdtree_searcher.hpp>
 
-#include <pyclustering/utils/metric.hpp>
-
-
-using namespace pyclustering::utils::metric;
-
 
 namespace pyclustering {
 
@@ -29,101 +24,84 @@ void kdtree_searcher::initialize(const std::vector<double> & point, const kdnode
     m_sqrt_distance = radius_search * radius_search;
 
     m_initial_node = node;
-    m_search_point = point;
+    m_search_point.assign(point.begin(), point.end());
 }
 
 
-void kdtree_searcher::recursive_nearest_nodes(const kdnode::ptr & node) const {
-    double minimum = node->get_value() - m_distance;
-    double maximum = node->get_value() + m_distance;
-
-    if (node->get_right() != nullptr) {
-        if (m_search_point[node->get_discriminator()] >= minimum) {
-            recursive_nearest_nodes(node->get_right());
-        }
-    }
-
-    if (node->get_left() != nullptr) {
-        if (m_search_point[node->get_discriminator()] < maximum) {
-            recursive_nearest_nodes(node->get_left());
-        }
-    }
+void kdtree_searcher::find_nearest_nodes(std::vector<double> & p_distances, std::vector<kdnode::ptr> & p_nearest_nodes) const {
+    p_distances.clear();
+    p_nearest_nodes.clear();
 
-    m_proc(node);
+    find_nearest([&p_distances, &p_nearest_nodes](const kdnode::ptr & p_node, const double p_distance) {
+        p_nearest_nodes.push_back(p_node);
+        p_distances.push_back(p_distance);
+    });
 }
 
 
-void kdtree_searcher::store_if_reachable(const kdnode::ptr & node) const {
-    double candidate_distance = euclidean_distance_square(m_search_point, node->get_data());
-    if (candidate_distance <= m_sqrt_distance) {
-        m_nearest_nodes.push_back(node);
-        m_nodes_distance.push_back(candidate_distance);
-    }
-}
+kdnode::ptr kdtree_searcher::find_nearest_node() const {
+    const kdnode::ptr * nearest_node = nullptr;
+    double nearest_distance = m_sqrt_distance;
 
+    traverse([&nearest_distance]() { return nearest_distance; },
+        [&nearest_node, &nearest_distance](const kdnode::ptr & p_node, const double p_distance) {
+            nearest_node = &p_node;
+            nearest_distance = p_distance;
+        });
 
-void kdtree_searcher::store_best_if_reachable(const kdnode::ptr & node) const {
-    double candidate_distance = euclidean_distance_square(m_search_point, node->get_data());
-    if (candidate_distance <= m_nodes_distance[0]) {
-        m_nearest_nodes[0] = node;
-        m_nodes_distance[0] = candidate_distance;
-    }
+    return (nearest_node == nullptr) ? nullptr : *nearest_node;
 }
 
 
-void kdtree_searcher::store_user_nodes_if_reachable(const kdnode::ptr & node) const {
-    double candidate_distance = euclidean_distance_square(m_search_point, node->get_data());
-    if (candidate_distance <= m_sqrt_distance) {
-        m_user_rule(node, candidate_distance);
-    }
-}
+void kdtree_searcher::find_k_nearest(const std::size_t p_k, const double p_max_radius, std::vector<std::size_t> & p_indexes, std::vector<double> & p_distances) const {
+    p_indexes.clear();
+    p_distances.clear();
 
+    if (p_k == 0) {
+        return;
+    }
 
-void kdtree_searcher::find_nearest_nodes(std::vector<double> & p_distances, std::vector<kdnode::ptr> & p_nearest_nodes) const {
-    m_proc = std::bind(&kdtree_searcher::store_if_reachable, this, std::placeholders::_1);
-    recursive_nearest_nodes(m_initial_node);
-
-    p_distances = std::move(m_nodes_distance);
-    p_nearest_nodes = std::move(m_nearest_nodes);
-
-    clear();
-}
-
-
-void kdtree_searcher::find_nearest(const rule_store & p_store_rule) const {
-    m_proc = std::bind(&kdtree_searcher::store_user_nodes_if_reachable, this, std::placeholders::_1);
-    m_user_rule = p_store_rule;
-    recursive_nearest_nodes(m_initial_node);
-
-    clear();
+    const double square_radius = p_max_radius * p_max_radius;
+
+    m_heap.clear();
+    traverse([this, p_k, square_radius]() { return (m_heap.size() < p_k) ? square_radius : m_heap.front().first; },
+        [this, p_k](const kdnode::ptr & p_node, const double p_distance) {
+            const auto candidate = std::make_pair(p_distance, reinterpret_cast<std::size_t>(p_node->get_payload()));
+
+            if (m_heap.size() < p_k) {
+                m_heap.push_back(candidate);
+                std::push_heap(m_heap.begin(), m_heap.end());
+            }
+            else if (candidate < m_heap.front()) {
+                std::pop_heap(m_heap.begin(), m_heap.end());
+                m_heap.back() = candidate;
+                std::push_heap(m_heap.begin(), m_heap.end());
+            }
+        });
+
+    std::sort_heap(m_heap.begin(), m_heap.end());
+
+    p_indexes.reserve(m_heap.size());
+    p_distances.reserve(m_heap.size());
+    for (const auto & neighbor : m_heap) {
+        p_distances.push_back(neighbor.first);
+        p_indexes.push_back(neighbor.second);
+    }
 }
 
 
-kdnode::ptr kdtree_searcher::find_nearest_node() const {
-    m_nearest_nodes = { nullptr };
-    m_nodes_distance = { std::numeric_limits<double>::max() };
-
-    m_proc = std::bind(&kdtree_searcher::store_best_if_reachable, this, std::placeholders::_1);
-    recursive_nearest_nodes(m_initial_node);
-
-    kdnode::ptr node = m_nearest_nodes.front();
-
-    clear();
+double kdtree_searcher::cell_distance(const std::size_t p_dimension, const double p_offset) const {
+    /* the sum is calculated in the same order as the distance to a point, so it is never greater than distance to a point of the cell */
+    double result = 0.0;
+    for (std::size_t index_dimension = 0; index_dimension < m_search_point.size(); index_dimension++) {
+        const double offset = (index_dimension == p_dimension) ? p_offset : m_offsets[index_dimension];
+        result += offset * offset;
+    }
 
-    return node;
+    return result;
 }
 
 
-void kdtree_searcher::clear() const {
-    m_nodes_distance = {};
-    m_nearest_nodes = {};
-    m_nearest_points = {};
-
-    m_user_rule = nullptr;
-    m_proc = nullptr;
 }
 
-
 }
-
-}
\ No newline at end of file
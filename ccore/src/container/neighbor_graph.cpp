@@ -0,0 +1,74 @@
+/*!
+
+@authors Andrei Novikov (pyclustering@yandex.ru)
+@date 2014-2020
+@copyright BSD-3-Clause
+
+*/
+
+
+#include <pyclustering/container/neighbor_graph.hpp>
+
+
+namespace pyclustering {
+
+namespace container {
+
+
+const std::size_t neighbor_graph::QUERY_BLOCK_SIZE = 256;
+
+
+std::size_t neighbor_graph::size() const { return m_offsets.size() - 1; }
+
+
+bool neighbor_graph::empty() const { return size() == 0; }
+
+
+std::size_t neighbor_graph::amount_neighbors(const std::size_t p_index) const {
+    return m_offsets[p_index + 1] - m_offsets[p_index];
+}
+
+
+const std::size_t * neighbor_graph::neighbors(const std::size_t p_index) const {
+    return m_neighbors.data() + m_offsets[p_index];
+}
+
+
+bool neighbor_graph::has_distances() const {
+    return m_distances.size() == m_neighbors.size();
+}
+
+
+const double * neighbor_graph::distances(const std::size_t p_index) const {
+    return m_distances.data() + m_offsets[p_index];
+}
+
+
+std::vector<std::size_t> & neighbor_graph::offsets() { return m_offsets; }
+
+
+const std::vector<std::size_t> & neighbor_graph::offsets() const { return m_offsets; }
+
+
+std::vector<std::size_t> & neighbor_graph::neighbors() { return m_neighbors; }
+
+
+const std::vector<std::size_t> & neighbor_graph::neighbors() const { return m_neighbors; }
+
+
+std::vector<double> & neighbor_graph::distances() { return m_distances; }
+
+
+const std::vector<double> & neighbor_graph::distances() const { return m_distances; }
+
+
+void neighbor_graph::clear() {
+    m_offsets.assign(1, 0);
+    m_neighbors.clear();
+    m_distances.clear();
+}
+
+
+}
+
+}
@@ -9,31 +9,76 @@
 #include <pyclustering/interface/dbscan_interface.h>
 
 #include <pyclustering/cluster/dbscan.hpp>
+#include <pyclustering/cluster/dbscan_incremental.hpp>
+
+#include <stdexcept>
+#include <string>
 
 
 pyclustering_package * dbscan_algorithm(const pyclustering_package * const p_sample, 
                                         const double p_radius,
                                         const size_t p_minumum_neighbors,
-                                        const size_t p_data_type)
+                                        const size_t p_data_type,
+                                        const unsigned int p_engine) try
 {
-    pyclustering::dataset input_dataset;
-    p_sample->extract(input_dataset);
+    if (p_engine > static_cast<unsigned int>(pyclustering::clst::dbscan_engine::PARALLEL)) {
+        throw std::invalid_argument("Unknown DBSCAN engine '" + std::to_string(p_engine) + "' is specified.");
+    }
 
-    pyclustering::clst::dbscan solver(p_radius, p_minumum_neighbors);
+    pyclustering::container::dense_dataset storage;
+    const pyclustering::container::dense_dataset_view input_dataset = p_sample->view(storage);
+
+    pyclustering::clst::dbscan solver(p_radius, p_minumum_neighbors,
+        pyclustering::utils::metric::distance_metric_factory<pyclustering::point>::euclidean(), (pyclustering::clst::dbscan_engine) p_engine);
 
     pyclustering::clst::dbscan_data output_result;
 
     solver.process(input_dataset, (pyclustering::clst::data_t) p_data_type, output_result);
 
-    pyclustering_package * package = new pyclustering_package(pyclustering_data_t::PYCLUSTERING_TYPE_LIST);
-    package->size = output_result.size() + 1;   /* the last for noise */
-    package->data = new pyclustering_package * [package->size + 1];
+    return create_package_clusters(output_result.clusters(), output_result.noise());
+}
+catch (std::exception & p_exception) {
+    return create_package(p_exception.what());
+}
+
+
+void * dbscan_incremental_create(const double p_radius, const size_t p_minumum_neighbors) {
+    return new pyclustering::clst::dbscan_incremental(p_radius, p_minumum_neighbors);
+}
+
+
+void dbscan_incremental_destroy(const void * p_pointer) {
+    delete (pyclustering::clst::dbscan_incremental *) p_pointer;
+}
 
-    for (std::size_t i = 0; i < package->size - 1; i++) {
-        ((pyclustering_package **) package->data)[i] = create_package(&output_result[i]);
-    }
 
-    ((pyclustering_package **) package->data)[package->size - 1] = create_package(&output_result.noise());
+pyclustering_package * dbscan_incremental_insert(const void * p_pointer, const pyclustering_package * const p_sample) try {
+    pyclustering::dataset input_dataset;
+    p_sample->extract(input_dataset);
+
+    std::vector<std::size_t> indexes = ((pyclustering::clst::dbscan_incremental *) p_pointer)->insert(input_dataset);
+    return create_package(&indexes);
+}
+catch (std::exception & p_exception) {
+    return create_package(p_exception.what());
+}
+
+
+pyclustering_package * dbscan_incremental_remove(const void * p_pointer, const pyclustering_package * const p_indexes) try {
+    std::vector<std::size_t> indexes;
+    p_indexes->extract(indexes);
+
+    ((pyclustering::clst::dbscan_incremental *) p_pointer)->remove(indexes);
+    return nullptr;
+}
+catch (std::exception & p_exception) {
+    return create_package(p_exception.what());
+}
+
+
+pyclustering_package * dbscan_incremental_get_clusters(const void * p_pointer) {
+    pyclustering::clst::dbscan_data output_result;
+    ((pyclustering::clst::dbscan_incremental *) p_pointer)->get_clusters(output_result);
 
-    return package;
+    return create_package_clusters(output_result.clusters(), output_result.noise());
 }
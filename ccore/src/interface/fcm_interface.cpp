@@ -18,9 +18,10 @@ pyclustering_package * fcm_algorithm(const pyclustering_package * const p_sample
                                      const double p_tolerance,
                                      const std::size_t p_itermax)
 {
-    pyclustering::dataset data, centers;
+    pyclustering::container::dense_dataset storage;
+    const pyclustering::container::dense_dataset_view data = p_sample->view(storage);
 
-    p_sample->extract(data);
+    pyclustering::dataset centers;
     p_centers->extract(centers);
 
     pyclustering::clst::fcm algorithm(centers, p_m, p_tolerance, p_itermax);
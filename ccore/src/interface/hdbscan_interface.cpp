@@ -0,0 +1,28 @@
+/*!
+
+@authors Andrei Novikov (pyclustering@yandex.ru)
+@date 2014-2020
+@copyright BSD-3-Clause
+
+*/
+
+#include <pyclustering/interface/hdbscan_interface.h>
+
+#include <pyclustering/cluster/hdbscan.hpp>
+
+
+pyclustering_package * hdbscan_algorithm(const pyclustering_package * const p_sample,
+                                         const size_t p_minimum_neighbors,
+                                         const size_t p_minimum_cluster_size) try
+{
+    pyclustering::container::dense_dataset storage;
+    const pyclustering::container::dense_dataset_view input_dataset = p_sample->view(storage);
+
+    pyclustering::clst::hdbscan_data output_result;
+    pyclustering::clst::hdbscan(p_minimum_neighbors, p_minimum_cluster_size).process(input_dataset, output_result);
+
+    return create_package_clusters(output_result.clusters(), output_result.noise());
+}
+catch (std::exception & p_exception) {
+    return create_package(p_exception.what());
+}
@@ -21,11 +21,13 @@ pyclustering_package * kmeans_algorithm(const pyclustering_package * const p_sam
                                         const double p_tolerance, 
                                         const std::size_t p_itermax,
                                         const bool p_observe,
-                                        const void * const p_metric)
+                                        const void * const p_metric,
+                                        const unsigned int p_acceleration)
 {
-    pyclustering::dataset data, centers;
+    pyclustering::container::dense_dataset storage;
+    const pyclustering::container::dense_dataset_view data = p_sample->view(storage);
 
-    p_sample->extract(data);
+    pyclustering::dataset centers;
     p_initial_centers->extract(centers);
 
     distance_metric<pyclustering::point> * metric = ((distance_metric<pyclustering::point> *) p_metric);
@@ -35,7 +37,7 @@ pyclustering_package * kmeans_algorithm(const pyclustering_package * const p_sam
         metric = &default_metric;
     }
 
-    pyclustering::clst::kmeans algorithm(centers, p_tolerance, p_itermax, *metric);
+    pyclustering::clst::kmeans algorithm(centers, p_tolerance, p_itermax, *metric, (pyclustering::clst::kmeans_acceleration) p_acceleration);
 
     pyclustering::clst::kmeans_data output_result(p_observe);
     algorithm.process(data, output_result);
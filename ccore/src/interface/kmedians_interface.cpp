@@ -17,9 +17,10 @@ pyclustering_package * kmedians_algorithm(const pyclustering_package * const p_s
                                           const std::size_t p_itermax,
                                           const void * const p_metric)
 {
-    pyclustering::dataset data, medians;
+    pyclustering::container::dense_dataset storage;
+    const pyclustering::container::dense_dataset_view data = p_sample->view(storage);
 
-    p_sample->extract(data);
+    pyclustering::dataset medians;
     p_initial_medians->extract(medians);
 
     distance_metric<pyclustering::point> * metric = ((distance_metric<pyclustering::point> *) p_metric);
@@ -36,8 +36,8 @@ try
 
     pyclustering::clst::kmedoids algorithm(medoids, p_tolerance, p_itermax, *metric);
 
-    pyclustering::dataset input_dataset;
-    p_sample->extract(input_dataset);
+    pyclustering::container::dense_dataset storage;
+    const pyclustering::container::dense_dataset_view input_dataset = p_sample->view(storage);
 
     pyclustering::clst::kmedoids_data output_result;
     algorithm.process(input_dataset, (pyclustering::clst::data_t) p_type, output_result);
@@ -69,7 +69,8 @@ void * metric_create(const std::size_t p_type,
         }
 
         case USER_DEFINED: {
-            auto functor_wrapper = [p_solver](const point & p1, const point & p2) {
+            /* points and views of points are packed directly, so views are not copied to temporary points */
+            auto functor_wrapper = [p_solver](const auto & p1, const auto & p2) {
                 pyclustering_package * point1 = create_package(&p1);
                 pyclustering_package * point2 = create_package(&p2);
 
@@ -81,7 +82,7 @@ void * metric_create(const std::size_t p_type,
                 return distance;
             };
 
-            distance_metric<point> metric = distance_metric_factory<point>::user_defined(functor_wrapper);
+            distance_metric<point> metric = distance_metric_factory<point>::user_defined(functor_wrapper, functor_wrapper);
             return new distance_metric<point>(std::move(metric));
         }
 
@@ -10,6 +10,7 @@
 #include <pyclustering/interface/optics_interface.h>
 
 #include <pyclustering/cluster/optics.hpp>
+#include <pyclustering/cluster/optics_xi.hpp>
 
 
 pyclustering_package * optics_algorithm(const pyclustering_package * const p_sample,
@@ -18,8 +19,8 @@ pyclustering_package * optics_algorithm(const pyclustering_package * const p_sam
                                         const size_t p_amount_clusters,
                                         const size_t p_data_type)
 {
-    pyclustering::dataset input_dataset;
-    p_sample->extract(input_dataset);
+    pyclustering::container::dense_dataset storage;
+    const pyclustering::container::dense_dataset_view input_dataset = p_sample->view(storage);
 
     pyclustering::clst::optics solver(p_radius, p_minumum_neighbors, p_amount_clusters);
 
@@ -54,6 +55,37 @@ pyclustering_package * optics_algorithm(const pyclustering_package * const p_sam
     ((pyclustering_package **) package->data)[OPTICS_PACKAGE_INDEX_OPTICS_OBJECTS_INDEX] = package_object_indexes;
     ((pyclustering_package **) package->data)[OPTICS_PACKAGE_INDEX_OPTICS_OBJECTS_CORE_DISTANCE] = package_core_distance;
     ((pyclustering_package **) package->data)[OPTICS_PACKAGE_INDEX_OPTICS_OBJECTS_REACHABILITY_DISTANCE] = package_reachability_distance;
+    ((pyclustering_package **) package->data)[OPTICS_PACKAGE_INDEX_OBJECT_ORDERING] = create_package(&output_result.object_ordering());
 
     return package;
+}
+
+
+pyclustering_package * optics_xi_extract(const pyclustering_package * const p_object_ordering,
+                                         const pyclustering_package * const p_reachability_distances,
+                                         const double p_xi,
+                                         const size_t p_minimum_samples,
+                                         const size_t p_minimum_cluster_size) try
+{
+    pyclustering::clst::index_sequence object_ordering;
+    p_object_ordering->extract(object_ordering);
+
+    std::vector<double> reachability_distances;
+    p_reachability_distances->extract(reachability_distances);
+
+    pyclustering::clst::optics_xi_data output_result;
+    pyclustering::clst::optics_xi(p_xi, p_minimum_samples, p_minimum_cluster_size).process(object_ordering, reachability_distances, output_result);
+
+    pyclustering_package * package = new pyclustering_package(pyclustering_data_t::PYCLUSTERING_TYPE_LIST);
+    package->size = OPTICS_XI_PACKAGE_SIZE;
+    package->data = new pyclustering_package * [OPTICS_XI_PACKAGE_SIZE];
+
+    ((pyclustering_package **) package->data)[OPTICS_XI_PACKAGE_INDEX_CLUSTERS] = create_package(&output_result.clusters());
+    ((pyclustering_package **) package->data)[OPTICS_XI_PACKAGE_INDEX_NOISE] = create_package(&output_result.noise());
+    ((pyclustering_package **) package->data)[OPTICS_XI_PACKAGE_INDEX_HIERARCHY] = create_package(&output_result.hierarchy());
+
+    return package;
+}
+catch (std::exception & p_exception) {
+    return create_package(p_exception.what());
 }
\ No newline at end of file
@@ -9,7 +9,24 @@
 
 #include <pyclustering/interface/pyclustering_interface.h>
 
+#include <pyclustering/parallel/concurrency.hpp>
+
 
 void free_pyclustering_package(pyclustering_package * package) {
     delete package;
 }
+
+
+void pyclustering_set_threads(const std::size_t p_threads) {
+    pyclustering::parallel::set_amount_threads(p_threads);
+}
+
+
+std::size_t pyclustering_get_threads() {
+    return pyclustering::parallel::get_amount_threads();
+}
+
+
+bool pyclustering_set_affinity(const std::uint64_t p_mask) {
+    return pyclustering::parallel::set_affinity(p_mask);
+}
@@ -8,6 +8,7 @@
 
 #include <pyclustering/interface/pyclustering_package.hpp>
 
+#include <string>
 #include <type_traits>
 
 
@@ -53,6 +54,10 @@ pyclustering_package::~pyclustering_package() {
                 delete[] (wchar_t *) data;
                 break;
 
+            case pyclustering_data_t::PYCLUSTERING_TYPE_DOUBLE_MATRIX:
+                delete (pyclustering_matrix *) data;    /* the array is not owned by the package */
+                break;
+
             default:
                 /* Memory Leak */
                 break;
@@ -78,3 +83,66 @@ pyclustering_package * create_package_container(const std::size_t p_size) {
 
     return package;
 }
+
+
+pyclustering_package * create_package_clusters(const std::vector<std::vector<std::size_t>> & p_clusters, const std::vector<std::size_t> & p_noise) {
+    pyclustering_package * package = create_package_container(p_clusters.size() + 1);   /* the last for noise */
+
+    for (std::size_t i = 0; i < p_clusters.size(); i++) {
+        ((pyclustering_package **) package->data)[i] = create_package(&p_clusters[i]);
+    }
+
+    ((pyclustering_package **) package->data)[p_clusters.size()] = create_package(&p_noise);
+
+    return package;
+}
+
+
+pyclustering_package * create_package_matrix(const double * p_data, const std::size_t p_rows, const std::size_t p_columns, const std::size_t p_stride) {
+    pyclustering_matrix * matrix = new pyclustering_matrix();
+    matrix->rows = p_rows;
+    matrix->columns = p_columns;
+    matrix->stride = (p_stride == 0) ? p_columns : p_stride;
+    matrix->data = (double *) p_data;
+
+    pyclustering_package * package = new pyclustering_package(pyclustering_data_t::PYCLUSTERING_TYPE_DOUBLE_MATRIX);
+    package->size = p_rows;
+    package->data = matrix;
+
+    return package;
+}
+
+
+pyclustering::container::dense_dataset_view pyclustering_package::view(pyclustering::container::dense_dataset & storage) const {
+    if (type == pyclustering_data_t::PYCLUSTERING_TYPE_DOUBLE_MATRIX) {
+        const pyclustering_matrix * matrix = (const pyclustering_matrix *) data;
+        return pyclustering::container::dense_dataset_view(matrix->data, matrix->rows, matrix->columns, matrix->stride);
+    }
+
+    if (size == 0) {
+        storage = pyclustering::container::dense_dataset();
+        return storage;
+    }
+
+    if (type != pyclustering_data_t::PYCLUSTERING_TYPE_LIST) {
+        throw std::invalid_argument("pyclustering_package::view() [" + std::to_string(__LINE__) + "]: package is not two-dimensional.");
+    }
+
+    const std::size_t dimension = at<pyclustering_package *>(0)->size;
+    storage = pyclustering::container::dense_dataset(size, dimension);
+
+    for (std::size_t i = 0; i < size; i++) {
+        const pyclustering_package * package = at<pyclustering_package *>(i);
+        if (package->size != dimension) {
+            throw std::invalid_argument("pyclustering_package::view() [" + std::to_string(__LINE__) + "]: row '" + std::to_string(i) + "' has size '"
+                + std::to_string(package->size) + "' that is different from size '" + std::to_string(dimension) + "' of the first row.");
+        }
+
+        double * row = storage.row(i);
+        for (std::size_t j = 0; j < dimension; j++) {
+            row[j] = package->at<double>(j);
+        }
+    }
+
+    return storage;
+}
@@ -32,8 +32,8 @@ pyclustering_package * silhouette_algorithm(
     const void * const p_metric,
     const std::size_t p_data_type)
 {
-    pyclustering::dataset data;
-    p_sample->extract(data);
+    pyclustering::container::dense_dataset storage;
+    const pyclustering::container::dense_dataset_view data = p_sample->view(storage);
 
     pyclustering::clst::cluster_sequence clusters;
     p_clusters->extract(clusters);
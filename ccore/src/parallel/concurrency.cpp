@@ -0,0 +1,198 @@
+/*!
+
+@authors Andrei Novikov (pyclustering@yandex.ru)
+@date 2014-2020
+@copyright BSD-3-Clause
+
+*/
+
+
+#include <pyclustering/parallel/concurrency.hpp>
+
+#include <pyclustering/parallel/work_stealing_executor.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <string>
+#include <thread>
+
+#if defined(__linux__)
+#include <sched.h>
+#endif
+
+
+namespace pyclustering {
+
+namespace parallel {
+
+
+static std::atomic<std::size_t>     g_amount_threads = { 0 };
+static std::atomic<std::uint64_t>   g_affinity = { 0 };
+
+
+#if defined(__linux__)
+static std::size_t get_affinity_processors() {
+    cpu_set_t cpu_set;
+    CPU_ZERO(&cpu_set);
+
+    if (sched_getaffinity(0, sizeof(cpu_set), &cpu_set) != 0) {
+        return 0;
+    }
+
+    return static_cast<std::size_t>(CPU_COUNT(&cpu_set));
+}
+
+
+static std::size_t get_quota_processors(const double p_quota, const double p_period) {
+    if ((p_quota <= 0.0) || (p_period <= 0.0)) {
+        return 0;   /* there is no quota */
+    }
+
+    return std::max(static_cast<std::size_t>(std::ceil(p_quota / p_period)), std::size_t(1));
+}
+
+
+static std::string get_cgroup_v2_path() {
+    std::ifstream file("/proc/self/cgroup");
+
+    std::string line;
+    while (std::getline(file, line)) {
+        if (line.compare(0, 3, "0::") == 0) {
+            return line.substr(3);
+        }
+    }
+
+    return std::string();
+}
+
+
+static std::size_t get_cgroup_v2_processors(std::string p_path) {
+    /* 'cpu.max' contains '<quota> <period>' where quota is 'max' if the group is not limited, but its parent (for
+       example, a slice of a container) might be limited, so the smallest quota of the hierarchy is used. */
+    if (p_path == "/") {
+        p_path.clear();
+    }
+
+    std::size_t amount_processors = 0;
+    while (true) {
+        std::ifstream file("/sys/fs/cgroup" + p_path + "/cpu.max");
+
+        std::string quota;
+        double period = 0.0;
+        if ((file >> quota >> period) && (quota != "max")) {
+            const std::size_t limit = get_quota_processors(std::strtod(quota.c_str(), nullptr), period);
+            if ((limit > 0) && ((amount_processors == 0) || (limit < amount_processors))) {
+                amount_processors = limit;
+            }
+        }
+
+        const std::size_t position = p_path.find_last_of('/');
+        if (p_path.empty() || (position == std::string::npos)) {
+            break;
+        }
+
+        p_path.erase(position);     /* the root group is processed with the empty path */
+    }
+
+    return amount_processors;
+}
+
+
+static std::size_t get_cgroup_processors() {
+    if (std::ifstream("/sys/fs/cgroup/cgroup.controllers").is_open()) {
+        return get_cgroup_v2_processors(get_cgroup_v2_path());
+    }
+
+    /* cgroup v1: quota is equal to '-1' if it is not specified. */
+    for (const char * path : { "/sys/fs/cgroup/cpu", "/sys/fs/cgroup/cpu,cpuacct" }) {
+        std::ifstream file_quota(std::string(path) + "/cpu.cfs_quota_us");
+        std::ifstream file_period(std::string(path) + "/cpu.cfs_period_us");
+
+        double quota = 0.0, period = 0.0;
+        if ((file_quota >> quota) && (file_period >> period)) {
+            return get_quota_processors(quota, period);
+        }
+    }
+
+    return 0;
+}
+#endif
+
+
+static std::size_t detect_available_processors() {
+    std::size_t amount_processors = std::thread::hardware_concurrency();
+
+#if defined(__linux__)
+    for (const std::size_t limit : { get_affinity_processors(), get_cgroup_processors() }) {
+        if ((limit > 0) && ((amount_processors == 0) || (limit < amount_processors))) {
+            amount_processors = limit;
+        }
+    }
+#endif
+
+    return std::max(amount_processors, std::size_t(1));
+}
+
+
+static std::size_t get_mask_processors(std::uint64_t p_mask) {
+    std::size_t amount_processors = 0;
+    for (; p_mask != 0; p_mask &= (p_mask - 1)) {
+        amount_processors++;
+    }
+
+    return amount_processors;
+}
+
+
+std::size_t get_available_processors() {
+    static const std::size_t amount_processors = detect_available_processors();
+    return amount_processors;
+}
+
+
+std::size_t get_amount_threads() {
+    const std::size_t amount_threads = g_amount_threads.load();
+    if (amount_threads > 0) {
+        return amount_threads;
+    }
+
+    const std::uint64_t mask = g_affinity.load();
+    if (mask != 0) {
+        return std::max(std::min(get_mask_processors(mask), get_available_processors()), std::size_t(1));
+    }
+
+    return get_available_processors();
+}
+
+
+std::size_t get_amount_workers() {
+    return get_amount_threads() - 1;
+}
+
+
+void set_amount_threads(const std::size_t p_threads) {
+    g_amount_threads = p_threads;
+}
+
+
+bool set_affinity(const std::uint64_t p_mask) {
+    if (!work_stealing_executor::instance().set_affinity(p_mask)) {
+        return false;
+    }
+
+    g_affinity = p_mask;
+    return true;
+}
+
+
+std::uint64_t get_affinity() {
+    return g_affinity.load();
+}
+
+
+}
+
+}
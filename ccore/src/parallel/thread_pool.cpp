@@ -9,6 +9,7 @@
 
 #include <pyclustering/parallel/thread_pool.hpp>
 
+#include <pyclustering/parallel/concurrency.hpp>
 #include <pyclustering/parallel/task.hpp>
 
 
@@ -17,14 +18,13 @@ namespace pyclustering {
 namespace parallel {
 
 
-const std::size_t   thread_pool::DEFAULT_AMOUNT_THREADS = 4;
+const std::size_t thread_pool::DEFAULT_AMOUNT_THREADS = 4;
 
-const std::size_t   thread_pool::DEFAULT_POOL_SIZE =
-        (std::thread::hardware_concurrency() > 1) ? std::thread::hardware_concurrency() : DEFAULT_AMOUNT_THREADS;
+const runtime_amount<get_amount_threads> thread_pool::DEFAULT_POOL_SIZE = { };
 
 
 thread_pool::thread_pool() {
-    initialize(DEFAULT_POOL_SIZE);
+    initialize(default_size());
 }
 
 
@@ -83,6 +83,11 @@ task::ptr thread_pool::add_task_if_free(const task::proc & p_raw_task) {
 }
 
 
+std::size_t thread_pool::default_size() {
+    return get_amount_threads();
+}
+
+
 std::size_t thread_pool::size() const {
     return m_pool.size();
 }
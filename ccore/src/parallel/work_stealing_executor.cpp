@@ -0,0 +1,389 @@
+/*!
+
+@authors Andrei Novikov (pyclustering@yandex.ru)
+@date 2014-2020
+@copyright BSD-3-Clause
+
+*/
+
+
+#include <pyclustering/parallel/work_stealing_executor.hpp>
+
+#include <pyclustering/parallel/concurrency.hpp>
+
+#include <algorithm>
+#include <iterator>
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#elif defined(WIN32) || (_WIN32) || (_WIN64)
+#define NOMINMAX
+#include <windows.h>
+#endif
+
+
+namespace pyclustering {
+
+namespace parallel {
+
+
+/* Executor and queue that are owned by the current thread if it is a worker. */
+static thread_local const work_stealing_executor * t_executor = nullptr;
+static thread_local std::size_t t_queue = 0;
+
+
+thread_local work_stealing_executor::concurrency_budget * work_stealing_executor::s_budget = nullptr;
+
+
+const std::size_t work_stealing_executor::MINIMUM_THREADS = 1024;
+
+
+work_stealing_executor::work_stealing_executor(const std::size_t p_capacity) :
+    m_capacity(p_capacity)
+{
+    /* The last queue is an injection queue for threads that are not workers of the executor, queues of workers
+       are created when workers are started. */
+    m_queues.resize(m_capacity + 1);
+    m_queues.back().reset(new job_queue());
+}
+
+
+work_stealing_executor::~work_stealing_executor() {
+    {
+        std::lock_guard<std::mutex> guard(m_sleep_mutex);
+        m_stop = true;
+    }
+
+    m_sleep_cond.notify_all();
+
+    std::lock_guard<std::mutex> guard(m_workers_mutex);
+    for (auto & worker : m_workers) {
+        if (worker.joinable()) {
+            worker.join();
+        }
+    }
+}
+
+
+work_stealing_executor & work_stealing_executor::instance() {
+    /* Workers and their queues are created on demand, so the capacity does not depend on the amount of threads
+       that is set when the executor is created: it might be increased later by 'set_amount_threads'. */
+    static work_stealing_executor executor(std::max(static_cast<std::size_t>(std::thread::hardware_concurrency()), MINIMUM_THREADS) - 1);
+
+    return executor;
+}
+
+
+void work_stealing_executor::execute(const std::size_t p_amount_chunks, const chunk_task & p_task, const std::size_t p_concurrency) {
+    if (p_amount_chunks == 0) {
+        return;
+    }
+
+    /* Nested regions share the budget of the top-level region. */
+    concurrency_budget root_budget;
+    root_budget.m_limit = std::max(p_concurrency, std::size_t(1));
+
+    concurrency_budget * const previous_budget = s_budget;
+    concurrency_budget * const budget = previous_budget ? previous_budget : &root_budget;
+
+    struct budget_guard {
+        concurrency_budget * m_previous;
+        ~budget_guard() { s_budget = m_previous; }
+    } guard_budget = { previous_budget };
+
+    s_budget = budget;
+
+    if ((p_amount_chunks == 1) || (m_capacity == 0) || (budget->m_limit == 1)) {
+        execute_sequentially(p_amount_chunks, p_task);
+        return;
+    }
+
+    if (budget == &root_budget) {
+        reserve(std::min(budget->m_limit - 1, p_amount_chunks - 1));
+    }
+
+    job_group group;
+    group.m_task = &p_task;
+    group.m_budget = budget;
+    group.m_pending = p_amount_chunks;
+
+    const std::size_t index_queue = get_current_queue();
+    job_queue & queue = *m_queues[index_queue];
+
+    m_queued += p_amount_chunks - 1;
+
+    /* The first chunk is processed by the current thread without queueing. */
+    {
+        std::lock_guard<spinlock> guard(queue.m_lock);
+        for (std::size_t i = p_amount_chunks - 1; i > 0; i--) {
+            queue.m_jobs.push_back({ &group, i, false });
+        }
+    }
+
+    wake_up_workers();
+
+    execute_job({ &group, 0, false });
+
+    /* Help to process jobs until the group is completed instead of blocking. */
+    while (group.m_pending.load(std::memory_order_acquire) != 0) {
+        job next_job;
+        if (try_get_job(index_queue, next_job)) {
+            execute_job(next_job);
+        }
+        else {
+            std::this_thread::yield();
+        }
+    }
+
+    if (group.m_error) {
+        std::rethrow_exception(group.m_error);
+    }
+}
+
+
+std::size_t work_stealing_executor::size() const {
+    return m_capacity;
+}
+
+
+bool work_stealing_executor::set_affinity(const std::uint64_t p_mask) {
+    std::lock_guard<std::mutex> guard(m_workers_mutex);
+
+    for (auto & worker : m_workers) {
+        if (!bind_thread(worker, p_mask)) {
+            return false;
+        }
+    }
+
+    m_affinity = p_mask;
+    return true;
+}
+
+
+bool work_stealing_executor::in_parallel_region() {
+    return s_budget != nullptr;
+}
+
+
+std::size_t work_stealing_executor::region_concurrency() {
+    return s_budget ? s_budget->m_limit : 0;
+}
+
+
+void work_stealing_executor::reserve(const std::size_t p_workers) {
+    const std::size_t amount_workers = std::min(p_workers, m_capacity);
+    if (m_started.load() >= amount_workers) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> guard(m_workers_mutex);
+    while (m_workers.size() < amount_workers) {
+        m_queues[m_workers.size()].reset(new job_queue());   /* it is visible to other threads when 'm_started' is updated */
+        m_workers.emplace_back(&work_stealing_executor::run, this, m_workers.size());
+        if (m_affinity != 0) {
+            bind_thread(m_workers.back(), m_affinity);
+        }
+    }
+
+    m_started = m_workers.size();
+}
+
+
+void work_stealing_executor::run(const std::size_t p_worker) {
+    t_executor = this;
+    t_queue = p_worker;
+
+    while (true) {
+        const std::size_t epoch = m_epoch.load();
+
+        job next_job;
+        if (try_get_job(p_worker, next_job)) {
+            execute_job(next_job);
+            continue;
+        }
+
+        /* Sleep until new jobs are queued or any concurrency budget is released. */
+        std::unique_lock<std::mutex> guard(m_sleep_mutex);
+        m_sleep_cond.wait(guard, [this, epoch]() { return m_stop || (m_epoch.load() != epoch); });
+
+        if (m_stop) {
+            return;
+        }
+    }
+}
+
+
+bool work_stealing_executor::try_get_job(const std::size_t p_queue, job & p_job) {
+    if (m_queued.load(std::memory_order_acquire) == 0) {
+        return false;
+    }
+
+    if (try_pop_back(*m_queues[p_queue], p_job)) {
+        return true;
+    }
+
+    /* Steal the oldest (the biggest remaining) work from other queues starting from the neighbour. */
+    const std::size_t amount_started = m_started.load();
+    for (std::size_t i = 0; i < amount_started; i++) {
+        const std::size_t index_victim = (p_queue + 1 + i) % amount_started;
+        if ((index_victim != p_queue) && try_pop_front(*m_queues[index_victim], p_job)) {
+            return true;
+        }
+    }
+
+    return (p_queue != m_capacity) && try_pop_front(*m_queues[m_capacity], p_job);
+}
+
+
+bool work_stealing_executor::try_pop_back(job_queue & p_queue, job & p_job) {
+    std::lock_guard<spinlock> guard(p_queue.m_lock);
+
+    const concurrency_budget * saturated = nullptr;
+    for (auto iter = p_queue.m_jobs.rbegin(); iter != p_queue.m_jobs.rend(); ++iter) {
+        if (try_acquire(*iter, saturated)) {
+            p_job = *iter;
+            p_queue.m_jobs.erase(std::next(iter).base());
+            m_queued--;
+
+            return true;
+        }
+    }
+
+    return false;
+}
+
+
+bool work_stealing_executor::try_pop_front(job_queue & p_queue, job & p_job) {
+    std::lock_guard<spinlock> guard(p_queue.m_lock);
+
+    const concurrency_budget * saturated = nullptr;
+    for (auto iter = p_queue.m_jobs.begin(); iter != p_queue.m_jobs.end(); ++iter) {
+        if (try_acquire(*iter, saturated)) {
+            p_job = *iter;
+            p_queue.m_jobs.erase(iter);
+            m_queued--;
+
+            return true;
+        }
+    }
+
+    return false;
+}
+
+
+bool work_stealing_executor::try_acquire(job & p_job, const concurrency_budget * & p_saturated) {
+    concurrency_budget & budget = *p_job.m_group->m_budget;
+    if (&budget == p_saturated) {
+        return false;   /* jobs of the same region are usually placed together, the budget is not checked again */
+    }
+
+    if (&budget == s_budget) {
+        p_job.m_acquired = false;   /* the current thread already processes the region */
+        return true;
+    }
+
+    std::size_t active = budget.m_active.load();
+    while (active < budget.m_limit) {
+        if (budget.m_active.compare_exchange_weak(active, active + 1)) {
+            p_job.m_acquired = true;
+            return true;
+        }
+    }
+
+    p_saturated = &budget;
+    return false;
+}
+
+
+void work_stealing_executor::execute_job(const job & p_job) {
+    job_group & group = *p_job.m_group;
+
+    concurrency_budget * const previous_budget = s_budget;
+    s_budget = group.m_budget;
+
+    try {
+        (*group.m_task)(p_job.m_index);
+    }
+    catch (...) {
+        std::lock_guard<spinlock> guard(group.m_error_lock);
+        if (!group.m_error) {
+            group.m_error = std::current_exception();
+        }
+    }
+
+    s_budget = previous_budget;
+
+    const bool budget_released = p_job.m_acquired;
+    if (budget_released) {
+        group.m_budget->m_active--;
+    }
+
+    group.m_pending.fetch_sub(1, std::memory_order_acq_rel);
+
+    if (budget_released && (m_queued.load() > 0)) {
+        wake_up_workers();
+    }
+}
+
+
+void work_stealing_executor::wake_up_workers() {
+    m_epoch++;
+
+    {
+        std::lock_guard<std::mutex> guard(m_sleep_mutex);   /* prevents lost wake-up of a worker that is going to sleep */
+    }
+
+    m_sleep_cond.notify_all();
+}
+
+
+void work_stealing_executor::execute_sequentially(const std::size_t p_amount_chunks, const chunk_task & p_task) {
+    for (std::size_t i = 0; i < p_amount_chunks; i++) {
+        p_task(i);
+    }
+}
+
+
+std::size_t work_stealing_executor::get_current_queue() const {
+    return (t_executor == this) ? t_queue : m_capacity;
+}
+
+
+bool work_stealing_executor::bind_thread(std::thread & p_thread, const std::uint64_t p_mask) {
+#if defined(__linux__)
+    cpu_set_t cpu_set;
+    CPU_ZERO(&cpu_set);
+
+    if (p_mask == 0) {
+        if (sched_getaffinity(0, sizeof(cpu_set), &cpu_set) != 0) {
+            return false;
+        }
+    }
+    else {
+        for (std::size_t i = 0; i < 64; i++) {
+            if (p_mask & (std::uint64_t(1) << i)) {
+                CPU_SET(i, &cpu_set);
+            }
+        }
+    }
+
+    return pthread_setaffinity_np(p_thread.native_handle(), sizeof(cpu_set), &cpu_set) == 0;
+#elif defined(WIN32) || (_WIN32) || (_WIN64)
+    DWORD_PTR process_mask = 0, system_mask = 0;
+    if (!GetProcessAffinityMask(GetCurrentProcess(), &process_mask, &system_mask)) {
+        return false;
+    }
+
+    const DWORD_PTR thread_mask = (p_mask == 0) ? process_mask : static_cast<DWORD_PTR>(p_mask);
+    return SetThreadAffinityMask(p_thread.native_handle(), thread_mask) != 0;
+#else
+    (void) p_thread;
+    return p_mask == 0;     /* the affinity is not supported by the system */
+#endif
+}
+
+
+}
+
+}
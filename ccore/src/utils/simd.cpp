@@ -0,0 +1,725 @@
+/*!
+
+@authors Andrei Novikov (pyclustering@yandex.ru)
+@date 2014-2020
+@copyright BSD-3-Clause
+
+*/
+
+
+#include <pyclustering/utils/simd.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <stdexcept>
+#include <string>
+
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+    #define PYCLUSTERING_SIMD_X86
+    #include <immintrin.h>
+    #if defined(_MSC_VER)
+        #include <intrin.h>
+    #endif
+#elif defined(__aarch64__) || defined(_M_ARM64)
+    #define PYCLUSTERING_SIMD_NEON
+    #include <arm_neon.h>
+#endif
+
+
+/* Vectorized kernels are compiled for their instruction set regardless of compiler flags of the library, the kernel
+   is used only if the processor supports the instruction set (MSVC allows intrinsics without any attributes). */
+#if defined(__GNUC__) || defined(__clang__)
+    #define PYCLUSTERING_TARGET_AVX2    __attribute__((target("avx2,fma")))
+    #define PYCLUSTERING_TARGET_AVX512  __attribute__((target("avx512f")))
+#else
+    #define PYCLUSTERING_TARGET_AVX2
+    #define PYCLUSTERING_TARGET_AVX512
+#endif
+
+
+using namespace pyclustering::utils::metric;
+
+
+namespace pyclustering {
+
+namespace utils {
+
+namespace simd {
+
+
+/* Calculates distance (or its part) over coordinates [p_begin; p_end) without vector instructions, it is used
+   by the scalar implementation and by vectorized kernels for the rest coordinates. */
+template <metric_kind Kind, typename TypeValue>
+inline TypeValue scalar_distance(TypeValue p_partial, const TypeValue * p_point1, const TypeValue * p_point2, const std::size_t p_begin, const std::size_t p_end) {
+    for (std::size_t i = p_begin; i < p_end; i++) {
+        const TypeValue difference = p_point1[i] - p_point2[i];
+
+        switch (Kind) {
+        case metric_kind::EUCLIDEAN_SQUARE:
+            p_partial += difference * difference;
+            break;
+
+        case metric_kind::MANHATTAN:
+            p_partial += std::abs(difference);
+            break;
+
+        case metric_kind::CHEBYSHEV:
+            p_partial = std::max(p_partial, std::abs(difference));
+            break;
+
+        case metric_kind::CANBERRA: {
+            const TypeValue divider = std::abs(p_point1[i]) + std::abs(p_point2[i]);
+            if (divider != 0) {
+                p_partial += std::abs(difference) / divider;
+            }
+            break;
+        }
+
+        default:
+            break;
+        }
+    }
+
+    return p_partial;
+}
+
+
+template <typename TypeValue>
+using batch_kernel = void (*)(const TypeValue *, const TypeValue *, const std::size_t, const std::size_t, const std::size_t, TypeValue *);
+
+
+template <typename TypeValue>
+struct kernel_set {
+    batch_kernel<TypeValue>     m_euclidean_square  = nullptr;
+    batch_kernel<TypeValue>     m_manhattan         = nullptr;
+    batch_kernel<TypeValue>     m_chebyshev         = nullptr;
+    batch_kernel<TypeValue>     m_canberra          = nullptr;
+};
+
+
+struct kernel_table {
+    kernel_set<double>  m_double;
+    kernel_set<float>   m_float;
+};
+
+
+template <typename TypeKernel, typename TypeValue>
+kernel_set<TypeValue> create_kernel_set() {
+    kernel_set<TypeValue> result;
+
+    result.m_euclidean_square   = &TypeKernel::template calculate<metric_kind::EUCLIDEAN_SQUARE>;
+    result.m_manhattan          = &TypeKernel::template calculate<metric_kind::MANHATTAN>;
+    result.m_chebyshev          = &TypeKernel::template calculate<metric_kind::CHEBYSHEV>;
+    result.m_canberra           = &TypeKernel::template calculate<metric_kind::CANBERRA>;
+
+    return result;
+}
+
+
+template <template <typename> class TypeKernel, template <typename> class TypeOperations>
+kernel_table create_kernel_table() {
+    kernel_table result;
+
+    result.m_double = create_kernel_set<TypeKernel<TypeOperations<double>>, double>();
+    result.m_float  = create_kernel_set<TypeKernel<TypeOperations<float>>, float>();
+
+    return result;
+}
+
+
+template <typename TypeValue>
+struct scalar_operations {
+    using value = TypeValue;
+};
+
+
+template <typename TypeOperations>
+struct scalar_kernel {
+    using value = typename TypeOperations::value;
+
+    template <metric_kind Kind>
+    static void calculate(const value * p_point, const value * p_points, const std::size_t p_amount, const std::size_t p_dimension, const std::size_t p_stride, value * p_result) {
+        for (std::size_t index_point = 0; index_point < p_amount; index_point++) {
+            p_result[index_point] = scalar_distance<Kind>(value(0), p_point, p_points + index_point * p_stride, 0, p_dimension);
+        }
+    }
+};
+
+
+#if defined(PYCLUSTERING_SIMD_X86)
+
+template <typename TypeValue>
+struct avx2_operations;
+
+
+template <>
+struct avx2_operations<double> {
+    using value     = double;
+    using vector    = __m256d;
+
+    enum { WIDTH = 4 };
+
+    PYCLUSTERING_TARGET_AVX2 static vector zero() { return _mm256_setzero_pd(); }
+
+    PYCLUSTERING_TARGET_AVX2 static vector load(const value * p_data) { return _mm256_loadu_pd(p_data); }
+
+    PYCLUSTERING_TARGET_AVX2 static vector abs(const vector p_value) { return _mm256_andnot_pd(_mm256_set1_pd(-0.0), p_value); }
+
+    template <metric_kind Kind>
+    PYCLUSTERING_TARGET_AVX2 static vector step(const vector p_partial, const vector p_point1, const vector p_point2) {
+        const vector difference = _mm256_sub_pd(p_point1, p_point2);
+
+        switch (Kind) {
+        case metric_kind::EUCLIDEAN_SQUARE:
+            return _mm256_fmadd_pd(difference, difference, p_partial);
+        case metric_kind::MANHATTAN:
+            return _mm256_add_pd(p_partial, abs(difference));
+        case metric_kind::CHEBYSHEV:
+            return _mm256_max_pd(p_partial, abs(difference));
+        default: {
+            const vector divider = _mm256_add_pd(abs(p_point1), abs(p_point2));
+            const vector non_zero = _mm256_cmp_pd(divider, zero(), _CMP_NEQ_OQ);
+            return _mm256_add_pd(p_partial, _mm256_and_pd(non_zero, _mm256_div_pd(abs(difference), divider)));
+        }
+        }
+    }
+
+    template <metric_kind Kind>
+    PYCLUSTERING_TARGET_AVX2 static value reduce(const vector p_partial) {
+        const __m128d low = _mm256_castpd256_pd128(p_partial);
+        const __m128d high = _mm256_extractf128_pd(p_partial, 1);
+
+        if (Kind == metric_kind::CHEBYSHEV) {
+            const __m128d result = _mm_max_pd(low, high);
+            return _mm_cvtsd_f64(_mm_max_sd(result, _mm_unpackhi_pd(result, result)));
+        }
+
+        const __m128d result = _mm_add_pd(low, high);
+        return _mm_cvtsd_f64(_mm_add_sd(result, _mm_unpackhi_pd(result, result)));
+    }
+};
+
+
+template <>
+struct avx2_operations<float> {
+    using value     = float;
+    using vector    = __m256;
+
+    enum { WIDTH = 8 };
+
+    PYCLUSTERING_TARGET_AVX2 static vector zero() { return _mm256_setzero_ps(); }
+
+    PYCLUSTERING_TARGET_AVX2 static vector load(const value * p_data) { return _mm256_loadu_ps(p_data); }
+
+    PYCLUSTERING_TARGET_AVX2 static vector abs(const vector p_value) { return _mm256_andnot_ps(_mm256_set1_ps(-0.0f), p_value); }
+
+    template <metric_kind Kind>
+    PYCLUSTERING_TARGET_AVX2 static vector step(const vector p_partial, const vector p_point1, const vector p_point2) {
+        const vector difference = _mm256_sub_ps(p_point1, p_point2);
+
+        switch (Kind) {
+        case metric_kind::EUCLIDEAN_SQUARE:
+            return _mm256_fmadd_ps(difference, difference, p_partial);
+        case metric_kind::MANHATTAN:
+            return _mm256_add_ps(p_partial, abs(difference));
+        case metric_kind::CHEBYSHEV:
+            return _mm256_max_ps(p_partial, abs(difference));
+        default: {
+            const vector divider = _mm256_add_ps(abs(p_point1), abs(p_point2));
+            const vector non_zero = _mm256_cmp_ps(divider, zero(), _CMP_NEQ_OQ);
+            return _mm256_add_ps(p_partial, _mm256_and_ps(non_zero, _mm256_div_ps(abs(difference), divider)));
+        }
+        }
+    }
+
+    template <metric_kind Kind>
+    PYCLUSTERING_TARGET_AVX2 static value reduce(const vector p_partial) {
+        const __m128 low = _mm256_castps256_ps128(p_partial);
+        const __m128 high = _mm256_extractf128_ps(p_partial, 1);
+
+        if (Kind == metric_kind::CHEBYSHEV) {
+            __m128 result = _mm_max_ps(low, high);
+            result = _mm_max_ps(result, _mm_movehl_ps(result, result));
+            return _mm_cvtss_f32(_mm_max_ss(result, _mm_shuffle_ps(result, result, 1)));
+        }
+
+        __m128 result = _mm_add_ps(low, high);
+        result = _mm_add_ps(result, _mm_movehl_ps(result, result));
+        return _mm_cvtss_f32(_mm_add_ss(result, _mm_shuffle_ps(result, result, 1)));
+    }
+};
+
+
+template <typename TypeOperations>
+struct avx2_kernel {
+    using value = typename TypeOperations::value;
+
+    template <metric_kind Kind>
+    PYCLUSTERING_TARGET_AVX2 static void calculate(const value * p_point, const value * p_points, const std::size_t p_amount, const std::size_t p_dimension, const std::size_t p_stride, value * p_result) {
+        const std::size_t vector_end = p_dimension - p_dimension % TypeOperations::WIDTH;
+
+        for (std::size_t index_point = 0; index_point < p_amount; index_point++) {
+            const value * other = p_points + index_point * p_stride;
+
+            typename TypeOperations::vector partial = TypeOperations::zero();
+            for (std::size_t i = 0; i < vector_end; i += TypeOperations::WIDTH) {
+                partial = TypeOperations::template step<Kind>(partial, TypeOperations::load(p_point + i), TypeOperations::load(other + i));
+            }
+
+            const value result = TypeOperations::template reduce<Kind>(partial);
+            p_result[index_point] = scalar_distance<Kind>(result, p_point, other, vector_end, p_dimension);
+        }
+    }
+};
+
+
+template <typename TypeValue>
+struct avx512_operations;
+
+
+template <>
+struct avx512_operations<double> {
+    using value     = double;
+    using vector    = __m512d;
+
+    enum { WIDTH = 8 };
+
+    /* masked forms are used where GCC implements unmasked intrinsics through an undefined pass-through operand,
+       that is reported by '-Wmaybe-uninitialized' */
+    enum : __mmask8 { FULL_MASK = 0xFF, HALF_MASK = 0x0F };
+
+    PYCLUSTERING_TARGET_AVX512 static vector zero() { return _mm512_setzero_pd(); }
+
+    PYCLUSTERING_TARGET_AVX512 static vector load(const value * p_data) { return _mm512_loadu_pd(p_data); }
+
+    template <metric_kind Kind>
+    PYCLUSTERING_TARGET_AVX512 static vector step(const vector p_partial, const vector p_point1, const vector p_point2) {
+        const vector difference = _mm512_sub_pd(p_point1, p_point2);
+
+        switch (Kind) {
+        case metric_kind::EUCLIDEAN_SQUARE:
+            return _mm512_fmadd_pd(difference, difference, p_partial);
+        case metric_kind::MANHATTAN:
+            return _mm512_add_pd(p_partial, _mm512_abs_pd(difference));
+        case metric_kind::CHEBYSHEV:
+            return _mm512_mask_max_pd(p_partial, FULL_MASK, p_partial, _mm512_abs_pd(difference));
+        default: {
+            const vector divider = _mm512_add_pd(_mm512_abs_pd(p_point1), _mm512_abs_pd(p_point2));
+            const __mmask8 non_zero = _mm512_cmp_pd_mask(divider, zero(), _CMP_NEQ_OQ);
+            return _mm512_add_pd(p_partial, _mm512_maskz_div_pd(non_zero, _mm512_abs_pd(difference), divider));
+        }
+        }
+    }
+
+    template <metric_kind Kind>
+    PYCLUSTERING_TARGET_AVX512 static value reduce(const vector p_partial) {
+        const __m256d low = _mm512_maskz_extractf64x4_pd(HALF_MASK, p_partial, 0);
+        const __m256d high = _mm512_maskz_extractf64x4_pd(HALF_MASK, p_partial, 1);
+
+        const __m256d half = (Kind == metric_kind::CHEBYSHEV) ? _mm256_max_pd(low, high) : _mm256_add_pd(low, high);
+        return avx2_operations<double>::reduce<Kind>(half);
+    }
+};
+
+
+template <>
+struct avx512_operations<float> {
+    using value     = float;
+    using vector    = __m512;
+
+    enum { WIDTH = 16 };
+
+    enum : __mmask16 { FULL_MASK = 0xFFFF };
+    enum : __mmask8 { HALF_MASK = 0x0F };
+
+    PYCLUSTERING_TARGET_AVX512 static vector zero() { return _mm512_setzero_ps(); }
+
+    PYCLUSTERING_TARGET_AVX512 static vector load(const value * p_data) { return _mm512_loadu_ps(p_data); }
+
+    template <metric_kind Kind>
+    PYCLUSTERING_TARGET_AVX512 static vector step(const vector p_partial, const vector p_point1, const vector p_point2) {
+        const vector difference = _mm512_sub_ps(p_point1, p_point2);
+
+        switch (Kind) {
+        case metric_kind::EUCLIDEAN_SQUARE:
+            return _mm512_fmadd_ps(difference, difference, p_partial);
+        case metric_kind::MANHATTAN:
+            return _mm512_add_ps(p_partial, _mm512_abs_ps(difference));
+        case metric_kind::CHEBYSHEV:
+            return _mm512_mask_max_ps(p_partial, FULL_MASK, p_partial, _mm512_abs_ps(difference));
+        default: {
+            const vector divider = _mm512_add_ps(_mm512_abs_ps(p_point1), _mm512_abs_ps(p_point2));
+            const __mmask16 non_zero = _mm512_cmp_ps_mask(divider, zero(), _CMP_NEQ_OQ);
+            return _mm512_add_ps(p_partial, _mm512_maskz_div_ps(non_zero, _mm512_abs_ps(difference), divider));
+        }
+        }
+    }
+
+    template <metric_kind Kind>
+    PYCLUSTERING_TARGET_AVX512 static value reduce(const vector p_partial) {
+        const __m256 low = _mm256_castpd_ps(_mm512_maskz_extractf64x4_pd(HALF_MASK, _mm512_castps_pd(p_partial), 0));
+        const __m256 high = _mm256_castpd_ps(_mm512_maskz_extractf64x4_pd(HALF_MASK, _mm512_castps_pd(p_partial), 1));
+
+        const __m256 half = (Kind == metric_kind::CHEBYSHEV) ? _mm256_max_ps(low, high) : _mm256_add_ps(low, high);
+        return avx2_operations<float>::reduce<Kind>(half);
+    }
+};
+
+
+template <typename TypeOperations>
+struct avx512_kernel {
+    using value = typename TypeOperations::value;
+
+    template <metric_kind Kind>
+    PYCLUSTERING_TARGET_AVX512 static void calculate(const value * p_point, const value * p_points, const std::size_t p_amount, const std::size_t p_dimension, const std::size_t p_stride, value * p_result) {
+        const std::size_t vector_end = p_dimension - p_dimension % TypeOperations::WIDTH;
+
+        for (std::size_t index_point = 0; index_point < p_amount; index_point++) {
+            const value * other = p_points + index_point * p_stride;
+
+            typename TypeOperations::vector partial = TypeOperations::zero();
+            for (std::size_t i = 0; i < vector_end; i += TypeOperations::WIDTH) {
+                partial = TypeOperations::template step<Kind>(partial, TypeOperations::load(p_point + i), TypeOperations::load(other + i));
+            }
+
+            const value result = TypeOperations::template reduce<Kind>(partial);
+            p_result[index_point] = scalar_distance<Kind>(result, p_point, other, vector_end, p_dimension);
+        }
+    }
+};
+
+#endif
+
+
+#if defined(PYCLUSTERING_SIMD_NEON)
+
+template <typename TypeValue>
+struct neon_operations;
+
+
+template <>
+struct neon_operations<double> {
+    using value     = double;
+    using vector    = float64x2_t;
+
+    enum { WIDTH = 2 };
+
+    static vector zero() { return vdupq_n_f64(0.0); }
+
+    static vector load(const value * p_data) { return vld1q_f64(p_data); }
+
+    template <metric_kind Kind>
+    static vector step(const vector p_partial, const vector p_point1, const vector p_point2) {
+        const vector difference = vsubq_f64(p_point1, p_point2);
+
+        switch (Kind) {
+        case metric_kind::EUCLIDEAN_SQUARE:
+            return vfmaq_f64(p_partial, difference, difference);
+        case metric_kind::MANHATTAN:
+            return vaddq_f64(p_partial, vabsq_f64(difference));
+        case metric_kind::CHEBYSHEV:
+            return vmaxq_f64(p_partial, vabsq_f64(difference));
+        default: {
+            const vector divider = vaddq_f64(vabsq_f64(p_point1), vabsq_f64(p_point2));
+            const vector ratio = vdivq_f64(vabsq_f64(difference), divider);
+            return vaddq_f64(p_partial, vbslq_f64(vceqq_f64(divider, zero()), zero(), ratio));
+        }
+        }
+    }
+
+    template <metric_kind Kind>
+    static value reduce(const vector p_partial) {
+        return (Kind == metric_kind::CHEBYSHEV) ? vmaxvq_f64(p_partial) : vaddvq_f64(p_partial);
+    }
+};
+
+
+template <>
+struct neon_operations<float> {
+    using value     = float;
+    using vector    = float32x4_t;
+
+    enum { WIDTH = 4 };
+
+    static vector zero() { return vdupq_n_f32(0.0f); }
+
+    static vector load(const value * p_data) { return vld1q_f32(p_data); }
+
+    template <metric_kind Kind>
+    static vector step(const vector p_partial, const vector p_point1, const vector p_point2) {
+        const vector difference = vsubq_f32(p_point1, p_point2);
+
+        switch (Kind) {
+        case metric_kind::EUCLIDEAN_SQUARE:
+            return vfmaq_f32(p_partial, difference, difference);
+        case metric_kind::MANHATTAN:
+            return vaddq_f32(p_partial, vabsq_f32(difference));
+        case metric_kind::CHEBYSHEV:
+            return vmaxq_f32(p_partial, vabsq_f32(difference));
+        default: {
+            const vector divider = vaddq_f32(vabsq_f32(p_point1), vabsq_f32(p_point2));
+            const vector ratio = vdivq_f32(vabsq_f32(difference), divider);
+            return vaddq_f32(p_partial, vbslq_f32(vceqq_f32(divider, zero()), zero(), ratio));
+        }
+        }
+    }
+
+    template <metric_kind Kind>
+    static value reduce(const vector p_partial) {
+        return (Kind == metric_kind::CHEBYSHEV) ? vmaxvq_f32(p_partial) : vaddvq_f32(p_partial);
+    }
+};
+
+
+template <typename TypeOperations>
+struct neon_kernel {
+    using value = typename TypeOperations::value;
+
+    template <metric_kind Kind>
+    static void calculate(const value * p_point, const value * p_points, const std::size_t p_amount, const std::size_t p_dimension, const std::size_t p_stride, value * p_result) {
+        const std::size_t vector_end = p_dimension - p_dimension % TypeOperations::WIDTH;
+
+        for (std::size_t index_point = 0; index_point < p_amount; index_point++) {
+            const value * other = p_points + index_point * p_stride;
+
+            typename TypeOperations::vector partial = TypeOperations::zero();
+            for (std::size_t i = 0; i < vector_end; i += TypeOperations::WIDTH) {
+                partial = TypeOperations::template step<Kind>(partial, TypeOperations::load(p_point + i), TypeOperations::load(other + i));
+            }
+
+            const value result = TypeOperations::template reduce<Kind>(partial);
+            p_result[index_point] = scalar_distance<Kind>(result, p_point, other, vector_end, p_dimension);
+        }
+    }
+};
+
+#endif
+
+
+static instruction_set detect_instruction_set() {
+#if defined(PYCLUSTERING_SIMD_X86)
+    #if defined(__GNUC__) || defined(__clang__)
+        __builtin_cpu_init();   /* the check takes into account whether the OS saves extended registers */
+
+        if (__builtin_cpu_supports("avx512f")) {
+            return instruction_set::AVX512;
+        }
+
+        if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) {
+            return instruction_set::AVX2;
+        }
+    #elif defined(_MSC_VER)
+        int registers[4] = { 0 };
+        __cpuid(registers, 0);
+        if (registers[0] < 7) {
+            return instruction_set::SCALAR;
+        }
+
+        __cpuid(registers, 1);
+        const bool os_xsave = (registers[2] & (1 << 27)) != 0;
+        const bool fma = (registers[2] & (1 << 12)) != 0;
+        if (!os_xsave) {
+            return instruction_set::SCALAR;
+        }
+
+        const unsigned long long xcr0 = _xgetbv(0);
+        const bool ymm_enabled = (xcr0 & 0x06) == 0x06;
+        const bool zmm_enabled = (xcr0 & 0xE6) == 0xE6;
+
+        __cpuidex(registers, 7, 0);
+        const bool avx2 = (registers[1] & (1 << 5)) != 0;
+        const bool avx512f = (registers[1] & (1 << 16)) != 0;
+
+        if (avx512f && zmm_enabled) {
+            return instruction_set::AVX512;
+        }
+
+        if (avx2 && fma && ymm_enabled) {
+            return instruction_set::AVX2;
+        }
+    #endif
+
+    return instruction_set::SCALAR;
+#elif defined(PYCLUSTERING_SIMD_NEON)
+    return instruction_set::NEON;   /* Advanced SIMD is a mandatory part of AArch64 */
+#else
+    return instruction_set::SCALAR;
+#endif
+}
+
+
+static const kernel_table & get_kernel_table(const instruction_set p_set) {
+    static const kernel_table scalar_table = create_kernel_table<scalar_kernel, scalar_operations>();
+
+    switch (p_set) {
+#if defined(PYCLUSTERING_SIMD_X86)
+    case instruction_set::AVX2: {
+        static const kernel_table avx2_table = create_kernel_table<avx2_kernel, avx2_operations>();
+        return avx2_table;
+    }
+
+    case instruction_set::AVX512: {
+        static const kernel_table avx512_table = create_kernel_table<avx512_kernel, avx512_operations>();
+        return avx512_table;
+    }
+#endif
+
+#if defined(PYCLUSTERING_SIMD_NEON)
+    case instruction_set::NEON: {
+        static const kernel_table neon_table = create_kernel_table<neon_kernel, neon_operations>();
+        return neon_table;
+    }
+#endif
+
+    default:
+        return scalar_table;
+    }
+}
+
+
+static std::atomic<instruction_set> & current_instruction_set() {
+    static std::atomic<instruction_set> current(get_supported_instruction_set());
+    return current;
+}
+
+
+template <typename TypeValue>
+const kernel_set<TypeValue> & get_kernel_set(const kernel_table & p_table);
+
+template <>
+const kernel_set<double> & get_kernel_set<double>(const kernel_table & p_table) { return p_table.m_double; }
+
+template <>
+const kernel_set<float> & get_kernel_set<float>(const kernel_table & p_table) { return p_table.m_float; }
+
+
+template <typename TypeValue>
+batch_kernel<TypeValue> get_kernel(const metric_kind p_kind) {
+    const kernel_set<TypeValue> & kernels = get_kernel_set<TypeValue>(get_kernel_table(current_instruction_set().load()));
+
+    switch (p_kind) {
+    case metric_kind::EUCLIDEAN:
+    case metric_kind::EUCLIDEAN_SQUARE:
+        return kernels.m_euclidean_square;
+
+    case metric_kind::MANHATTAN:
+        return kernels.m_manhattan;
+
+    case metric_kind::CHEBYSHEV:
+        return kernels.m_chebyshev;
+
+    case metric_kind::CANBERRA:
+        return kernels.m_canberra;
+
+    default:
+        throw std::invalid_argument("Metric (code: '" + std::to_string(static_cast<int>(p_kind)) + "') does not have vectorized implementation.");
+    }
+}
+
+
+instruction_set get_supported_instruction_set() {
+    static const instruction_set supported = detect_instruction_set();
+    return supported;
+}
+
+
+instruction_set get_instruction_set() {
+    return current_instruction_set().load();
+}
+
+
+bool set_instruction_set(const instruction_set p_set) {
+    const instruction_set supported = get_supported_instruction_set();
+
+    bool applicable = false;
+    switch (p_set) {
+    case instruction_set::SCALAR:
+        applicable = true;
+        break;
+
+    case instruction_set::AVX2:
+        applicable = (supported == instruction_set::AVX2) || (supported == instruction_set::AVX512);
+        break;
+
+    default:
+        applicable = (supported == p_set);
+        break;
+    }
+
+    if (applicable) {
+        current_instruction_set() = p_set;
+    }
+
+    return applicable;
+}
+
+
+bool is_supported(const metric_kind p_kind) {
+    switch (p_kind) {
+    case metric_kind::EUCLIDEAN:
+    case metric_kind::EUCLIDEAN_SQUARE:
+    case metric_kind::MANHATTAN:
+    case metric_kind::CHEBYSHEV:
+    case metric_kind::CANBERRA:
+        return true;
+
+    default:
+        return false;
+    }
+}
+
+
+template <typename TypeValue>
+TypeValue distance(const metric_kind p_kind, const TypeValue * p_point1, const TypeValue * p_point2, const std::size_t p_dimension) {
+    TypeValue result = 0;
+    distance(p_kind, p_point1, p_point2, 1, p_dimension, p_dimension, &result);
+    return result;
+}
+
+
+template <typename TypeValue>
+void distance(const metric_kind p_kind, const TypeValue * p_point, const TypeValue * p_points, const std::size_t p_amount,
+    const std::size_t p_dimension, const std::size_t p_stride, TypeValue * p_result)
+{
+    get_kernel<TypeValue>(p_kind)(p_point, p_points, p_amount, p_dimension, p_stride, p_result);
+
+    if (p_kind == metric_kind::EUCLIDEAN) {
+        for (std::size_t i = 0; i < p_amount; i++) {
+            p_result[i] = std::sqrt(p_result[i]);
+        }
+    }
+}
+
+
+template <typename TypeValue>
+void distance_matrix(const metric_kind p_kind,
+    const TypeValue * p_points1, const std::size_t p_amount1, const std::size_t p_stride1,
+    const TypeValue * p_points2, const std::size_t p_amount2, const std::size_t p_stride2,
+    const std::size_t p_dimension, TypeValue * p_result)
+{
+    for (std::size_t i = 0; i < p_amount1; i++) {
+        distance(p_kind, p_points1 + i * p_stride1, p_points2, p_amount2, p_dimension, p_stride2, p_result + i * p_amount2);
+    }
+}
+
+
+template double distance<double>(const metric_kind, const double *, const double *, const std::size_t);
+
+template float distance<float>(const metric_kind, const float *, const float *, const std::size_t);
+
+template void distance<double>(const metric_kind, const double *, const double *, const std::size_t, const std::size_t, const std::size_t, double *);
+
+template void distance<float>(const metric_kind, const float *, const float *, const std::size_t, const std::size_t, const std::size_t, float *);
+
+template void distance_matrix<double>(const metric_kind, const double *, const std::size_t, const std::size_t, const double *, const std::size_t, const std::size_t, const std::size_t, double *);
+
+template void distance_matrix<float>(const metric_kind, const float *, const std::size_t, const std::size_t, const float *, const std::size_t, const std::size_t, const std::size_t, float *);
+
+
+}
+
+}
+
+}
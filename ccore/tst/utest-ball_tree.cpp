@@ -0,0 +1,273 @@
+/*!
+
+@authors Andrei Novikov (pyclustering@yandex.ru)
+@date 2014-2020
+@copyright BSD-3-Clause
+
+*/
+
+
+#include <gtest/gtest.h>
+
+#include "samples.hpp"
+
+#include <pyclustering/container/ball_tree.hpp>
+
+#include <pyclustering/utils/metric.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <random>
+#include <stdexcept>
+#include <utility>
+
+
+using namespace pyclustering;
+using namespace pyclustering::container;
+using namespace pyclustering::utils::metric;
+
+
+static dataset create_random_data(const std::size_t p_size, const std::size_t p_dimension, const unsigned int p_seed) {
+    std::mt19937 generator(p_seed);
+    std::uniform_real_distribution<double> distribution(-10.0, 10.0);
+
+    dataset data(p_size, point(p_dimension));
+    for (auto & current_point : data) {
+        for (auto & coordinate : current_point) {
+            coordinate = distribution(generator);
+        }
+    }
+
+    return data;
+}
+
+
+static void template_find_nearest(const dataset & p_data, const distance_metric<point> & p_metric, const double p_radius, const std::size_t p_leaf_size) {
+    const ball_tree tree(p_data, p_metric, p_leaf_size);
+    ASSERT_EQ(p_data.size(), tree.size());
+
+    for (const auto & search_point : p_data) {
+        std::vector<std::size_t> expected_indexes;
+        for (std::size_t i = 0; i < p_data.size(); i++) {
+            if (p_metric(search_point, p_data[i]) <= p_radius) {
+                expected_indexes.push_back(i);
+            }
+        }
+
+        std::vector<std::size_t> actual_indexes;
+        std::vector<double> actual_distances;
+        tree.find_nearest(search_point, p_radius, actual_indexes, actual_distances);
+
+        ASSERT_EQ(actual_indexes.size(), actual_distances.size());
+        for (std::size_t i = 0; i < actual_indexes.size(); i++) {
+            ASSERT_DOUBLE_EQ(p_metric(search_point, p_data[actual_indexes[i]]), actual_distances[i]);
+        }
+
+        std::sort(actual_indexes.begin(), actual_indexes.end());
+        ASSERT_EQ(expected_indexes, actual_indexes);
+    }
+}
+
+
+static void template_find_k_nearest(const dataset & p_data, const distance_metric<point> & p_metric, const std::size_t p_k, const double p_max_radius, const std::size_t p_leaf_size) {
+    const ball_tree tree(p_data, p_metric, p_leaf_size);
+
+    for (const auto & search_point : p_data) {
+        std::vector<std::pair<double, std::size_t>> expected;
+        for (std::size_t i = 0; i < p_data.size(); i++) {
+            const double distance = p_metric(search_point, p_data[i]);
+            if (distance <= p_max_radius) {
+                expected.emplace_back(distance, i);
+            }
+        }
+
+        std::sort(expected.begin(), expected.end());
+        expected.resize(std::min(expected.size(), p_k));
+
+        std::vector<std::size_t> actual_indexes;
+        std::vector<double> actual_distances;
+        tree.find_k_nearest(search_point.data(), p_k, p_max_radius, actual_indexes, actual_distances);
+
+        ASSERT_EQ(expected.size(), actual_indexes.size());
+        ASSERT_EQ(expected.size(), actual_distances.size());
+        for (std::size_t i = 0; i < expected.size(); i++) {
+            ASSERT_DOUBLE_EQ(expected[i].first, actual_distances[i]);
+        }
+    }
+}
+
+
+TEST(utest_ball_tree, find_nearest_simple_01) {
+    auto data = simple_sample_factory::create_sample(SAMPLE_SIMPLE::SAMPLE_SIMPLE_01);
+    template_find_nearest(*data, distance_metric_factory<point>::euclidean(), 0.7, 1);
+    template_find_nearest(*data, distance_metric_factory<point>::manhattan(), 0.7, 4);
+    template_find_nearest(*data, distance_metric_factory<point>::chebyshev(), 10.0, 2);
+}
+
+TEST(utest_ball_tree, find_nearest_fcps_lsun) {
+    auto data = fcps_sample_factory::create_sample(FCPS_SAMPLE::LSUN);
+    template_find_nearest(*data, distance_metric_factory<point>::manhattan(), 0.4, ball_tree::DEFAULT_LEAF_SIZE);
+    template_find_nearest(*data, distance_metric_factory<point>::chebyshev(), 0.3, 1);
+}
+
+TEST(utest_ball_tree, find_nearest_random_manhattan) {
+    const dataset data = create_random_data(500, 3, 5);
+    template_find_nearest(data, distance_metric_factory<point>::manhattan(), 3.0, 1);
+    template_find_nearest(data, distance_metric_factory<point>::manhattan(), 3.0, 7);
+}
+
+TEST(utest_ball_tree, find_nearest_random_minkowski) {
+    const dataset data = create_random_data(500, 4, 7);
+    template_find_nearest(data, distance_metric_factory<point>::minkowski(4.0), 3.0, 5);
+}
+
+TEST(utest_ball_tree, find_nearest_random_canberra) {
+    const dataset data = create_random_data(300, 2, 9);
+    template_find_nearest(data, distance_metric_factory<point>::canberra(), 0.5, 3);
+}
+
+TEST(utest_ball_tree, find_nearest_random_high_dimension) {
+    /* distances to points of leaves are calculated by vectorized kernels including the rest coordinates */
+    const dataset data = create_random_data(300, 19, 21);
+    template_find_nearest(data, distance_metric_factory<point>::euclidean(), 40.0, 6);
+    template_find_nearest(data, distance_metric_factory<point>::manhattan(), 130.0, 6);
+    template_find_nearest(data, distance_metric_factory<point>::chebyshev(), 12.0, 70);
+    template_find_nearest(data, distance_metric_factory<point>::canberra(), 12.0, 6);
+    template_find_k_nearest(data, distance_metric_factory<point>::manhattan(), 9, 150.0, 70);
+}
+
+TEST(utest_ball_tree, find_nearest_random_gower) {
+    const dataset data = create_random_data(300, 3, 13);
+    template_find_nearest(data, distance_metric_factory<point>::gower({ 20.0, 20.0, 20.0 }), 0.1, 4);
+}
+
+TEST(utest_ball_tree, find_nearest_random_user_defined) {
+    const dataset data = create_random_data(300, 2, 15);
+    const auto metric = distance_metric_factory<point>::user_defined([](const point & p1, const point & p2) {
+        return std::abs(p1[0] - p2[0]) + 2.0 * std::abs(p1[1] - p2[1]);
+    });
+
+    template_find_nearest(data, metric, 2.0, 4);
+}
+
+TEST(utest_ball_tree, find_nearest_euclidean_square) {
+    const dataset data = create_random_data(500, 2, 21);
+    template_find_nearest(data, distance_metric_factory<point>::euclidean_square(), 1.5, 4);
+}
+
+TEST(utest_ball_tree, find_nearest_same_points) {
+    const dataset data(100, { 0.1, 0.7 });
+    template_find_nearest(data, distance_metric_factory<point>::manhattan(), 0.0, 4);
+    template_find_nearest(data, distance_metric_factory<point>::euclidean(), 0.0, 4);
+}
+
+TEST(utest_ball_tree, find_nearest_large_with_duplicates) {
+    std::mt19937 generator(11);
+    std::uniform_int_distribution<int> distribution(0, 50);
+
+    dataset data(20000, point(3));
+    for (auto & current_point : data) {
+        for (auto & coordinate : current_point) {
+            coordinate = static_cast<double>(distribution(generator));
+        }
+    }
+
+    const auto metric = distance_metric_factory<point>::manhattan();
+    const ball_tree tree(data, metric);
+
+    for (std::size_t index_query = 0; index_query < data.size(); index_query += 97) {
+        std::size_t expected = 0;
+        for (const auto & candidate : data) {
+            if (metric(data[index_query], candidate) <= 3.0) {
+                expected++;
+            }
+        }
+
+        std::size_t actual = 0;
+        tree.find_nearest(data[index_query].data(), 3.0, [&actual](const std::size_t, const double) { actual++; });
+        ASSERT_EQ(expected, actual);
+    }
+}
+
+TEST(utest_ball_tree, find_k_nearest_simple_01) {
+    auto data = simple_sample_factory::create_sample(SAMPLE_SIMPLE::SAMPLE_SIMPLE_01);
+    template_find_k_nearest(*data, distance_metric_factory<point>::manhattan(), 1, 10.0, 1);
+    template_find_k_nearest(*data, distance_metric_factory<point>::chebyshev(), 3, 10.0, 2);
+    template_find_k_nearest(*data, distance_metric_factory<point>::manhattan(), 3, 0.5, 4);
+    template_find_k_nearest(*data, distance_metric_factory<point>::euclidean(), 20, 100.0, 1);
+}
+
+TEST(utest_ball_tree, find_k_nearest_random) {
+    const dataset data = create_random_data(400, 3, 3);
+    template_find_k_nearest(data, distance_metric_factory<point>::manhattan(), 7, std::numeric_limits<double>::max(), 4);
+    template_find_k_nearest(data, distance_metric_factory<point>::euclidean_square(), 5, 4.0, 8);
+}
+
+TEST(utest_ball_tree, find_nearest_batch) {
+    const dataset data = create_random_data(3000, 2, 17);
+    const ball_tree tree(data, distance_metric_factory<point>::chebyshev());
+
+    std::vector<std::size_t> queries(data.size());
+    std::iota(queries.rbegin(), queries.rend(), 0);
+
+    neighbor_graph graph;
+    tree.find_nearest(queries, 0.5, graph);
+    ASSERT_EQ(queries.size(), graph.size());
+
+    for (std::size_t i = 0; i < queries.size(); i++) {
+        std::vector<std::size_t> expected_indexes;
+        std::vector<double> expected_distances;
+        tree.find_nearest(data[queries[i]], 0.5, expected_indexes, expected_distances);
+
+        ASSERT_EQ(expected_indexes.size(), graph.amount_neighbors(i));
+        for (std::size_t j = 0; j < expected_indexes.size(); j++) {
+            ASSERT_EQ(expected_indexes[j], graph.neighbors(i)[j]);
+            ASSERT_EQ(expected_distances[j], graph.distances(i)[j]);
+        }
+    }
+
+    tree.find_nearest(0.5, graph);
+    ASSERT_EQ(data.size(), graph.size());
+    ASSERT_TRUE(graph.has_distances());
+
+    neighbor_graph graph_without_distances;
+    tree.find_nearest(0.5, graph_without_distances, false);
+    ASSERT_FALSE(graph_without_distances.has_distances());
+    ASSERT_EQ(graph.offsets(), graph_without_distances.offsets());
+    ASSERT_EQ(graph.neighbors(), graph_without_distances.neighbors());
+}
+
+TEST(utest_ball_tree, empty_tree) {
+    const ball_tree tree(dataset{ }, distance_metric_factory<point>::manhattan());
+    ASSERT_TRUE(tree.empty());
+    ASSERT_EQ(0U, tree.size());
+
+    std::vector<std::size_t> indexes;
+    std::vector<double> distances;
+    tree.find_nearest({ 0.0, 0.0 }, 1.0, indexes, distances);
+    ASSERT_TRUE(indexes.empty());
+
+    const point search_point = { 0.0, 0.0 };
+    tree.find_k_nearest(search_point.data(), 2, 1.0, indexes, distances);
+    ASSERT_TRUE(indexes.empty());
+}
+
+TEST(utest_ball_tree, is_applicable) {
+    ASSERT_TRUE(ball_tree::is_applicable(distance_metric_factory<point>::euclidean()));
+    ASSERT_TRUE(ball_tree::is_applicable(distance_metric_factory<point>::euclidean_square()));
+    ASSERT_TRUE(ball_tree::is_applicable(distance_metric_factory<point>::manhattan()));
+    ASSERT_TRUE(ball_tree::is_applicable(distance_metric_factory<point>::chebyshev()));
+    ASSERT_TRUE(ball_tree::is_applicable(distance_metric_factory<point>::minkowski(1.0)));
+    ASSERT_TRUE(ball_tree::is_applicable(distance_metric_factory<point>::canberra()));
+    ASSERT_TRUE(ball_tree::is_applicable(distance_metric_factory<point>::gower({ 1.0 })));
+
+    ASSERT_FALSE(ball_tree::is_applicable(distance_metric_factory<point>::minkowski(0.5)));
+    ASSERT_FALSE(ball_tree::is_applicable(distance_metric_factory<point>::chi_square()));
+    ASSERT_FALSE(ball_tree::is_applicable(distance_metric_factory<point>::user_defined([](const point &, const point &) { return 0.0; })));
+}
+
+TEST(utest_ball_tree, incorrect_leaf_size) {
+    ASSERT_THROW(ball_tree(dataset({ { 1.0 } }), distance_metric_factory<point>::manhattan(), 0), std::invalid_argument);
+}
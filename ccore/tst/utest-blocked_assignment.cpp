@@ -0,0 +1,189 @@
+/*!
+
+@authors Andrei Novikov (pyclustering@yandex.ru)
+@date 2014-2020
+@copyright BSD-3-Clause
+
+*/
+
+
+#include <gtest/gtest.h>
+
+#include <pyclustering/cluster/blocked_assignment.hpp>
+
+#include <pyclustering/utils/metric.hpp>
+
+#include <cmath>
+#include <limits>
+#include <vector>
+
+
+using namespace pyclustering;
+using namespace pyclustering::clst;
+using namespace pyclustering::utils::metric;
+
+
+static dataset create_points(const std::size_t p_amount, const std::size_t p_dimension, const double p_shift) {
+    dataset result(p_amount, point(p_dimension));
+    for (std::size_t i = 0; i < p_amount; i++) {
+        for (std::size_t j = 0; j < p_dimension; j++) {
+            result[i][j] = std::sin(static_cast<double>(i * p_dimension + j) * 0.7 + p_shift) * 5.0;
+        }
+    }
+
+    return result;
+}
+
+
+static std::size_t find_nearest(const point & p_point, const dataset & p_centers) {
+    std::size_t index_nearest = 0;
+    double distance_nearest = std::numeric_limits<double>::max();
+    for (std::size_t i = 0; i < p_centers.size(); i++) {
+        const double distance = euclidean_distance_square(p_point, p_centers[i]);
+        if (distance < distance_nearest) {
+            distance_nearest = distance;
+            index_nearest = i;
+        }
+    }
+
+    return index_nearest;
+}
+
+
+static void template_assign(const std::size_t p_amount_points, const std::size_t p_amount_centers, const std::size_t p_dimension) {
+    const dataset data = create_points(p_amount_points, p_dimension, 0.0);
+    const dataset centers = create_points(p_amount_centers, p_dimension, 0.4);
+
+    const container::dense_dataset dense(data);
+    const blocked_assignment assignment(centers);
+    ASSERT_EQ(p_amount_centers, assignment.size());
+
+    index_sequence labels(data.size(), centers.size());
+    assignment.assign(dense, 0, data.size(), labels);
+
+    std::vector<double> distances(data.size() * centers.size(), -1.0);
+    assignment.distances(dense, 0, data.size(), distances.data());
+
+    for (std::size_t i = 0; i < data.size(); i++) {
+        ASSERT_EQ(find_nearest(data[i], centers), labels[i]);
+
+        for (std::size_t j = 0; j < centers.size(); j++) {
+            const double expected = euclidean_distance_square(data[i], centers[j]);
+            ASSERT_NEAR(expected, distances[i * centers.size() + j], 1e-9 * (1.0 + expected));
+        }
+    }
+}
+
+
+TEST(utest_blocked_assignment, assign_tile_sizes) {
+    template_assign(8, 4, 2);
+}
+
+TEST(utest_blocked_assignment, assign_partial_tiles) {
+    template_assign(7, 3, 3);
+    template_assign(13, 5, 1);
+}
+
+TEST(utest_blocked_assignment, assign_several_blocks) {
+    template_assign(blocked_assignment::POINT_BLOCK * 2 + 5, 11, 7);
+}
+
+TEST(utest_blocked_assignment, assign_single_center) {
+    template_assign(21, 1, 4);
+}
+
+
+TEST(utest_blocked_assignment, assign_range) {
+    const dataset data = create_points(150, 3, 0.0);
+    const dataset centers = create_points(6, 3, 0.9);
+
+    const container::dense_dataset dense(data);
+    const blocked_assignment assignment(centers);
+
+    const std::size_t unassigned = centers.size();
+    index_sequence labels(data.size(), unassigned);
+    assignment.assign(dense, 10, 77, labels);
+
+    for (std::size_t i = 0; i < data.size(); i++) {
+        if ((i < 10) || (i >= 77)) {
+            ASSERT_EQ(unassigned, labels[i]);
+        }
+        else {
+            ASSERT_EQ(find_nearest(data[i], centers), labels[i]);
+        }
+    }
+}
+
+
+TEST(utest_blocked_assignment, assign_indexes) {
+    const dataset data = create_points(100, 2, 0.0);
+    const dataset centers = create_points(5, 2, 0.2);
+
+    const container::dense_dataset dense(data);
+    const blocked_assignment assignment(centers);
+
+    index_sequence indexes;
+    for (std::size_t i = 1; i < data.size(); i += 3) {
+        indexes.push_back(i);
+    }
+
+    const std::size_t unassigned = centers.size();
+    index_sequence labels(data.size(), unassigned);
+    assignment.assign(dense, indexes, 0, indexes.size(), labels);
+
+    for (std::size_t i = 0; i < data.size(); i++) {
+        if (i % 3 == 1) {
+            ASSERT_EQ(find_nearest(data[i], centers), labels[i]);
+        }
+        else {
+            ASSERT_EQ(unassigned, labels[i]);
+        }
+    }
+}
+
+
+TEST(utest_blocked_assignment, points_are_centers) {
+    const dataset data = { { 1e6 + 0.1, 1e6 + 0.2 }, { -3.0, 4.0 }, { 1e6 + 0.1, 1e6 + 0.2 }, { 0.0, 0.0 } };
+    const dataset centers = { { 0.0, 0.0 }, { 1e6 + 0.1, 1e6 + 0.2 }, { -3.0, 4.0 } };
+
+    const container::dense_dataset dense(data);
+    const blocked_assignment assignment(centers);
+
+    index_sequence labels(data.size());
+    assignment.assign(dense, 0, data.size(), labels);
+    ASSERT_EQ(index_sequence({ 1, 2, 1, 0 }), labels);
+
+    std::vector<double> distances(data.size() * centers.size());
+    assignment.distances(dense, 0, data.size(), distances.data());
+
+    ASSERT_EQ(0.0, distances[0 * centers.size() + 1]);
+    ASSERT_EQ(0.0, distances[1 * centers.size() + 2]);
+    ASSERT_EQ(0.0, distances[2 * centers.size() + 1]);
+    ASSERT_EQ(0.0, distances[3 * centers.size() + 0]);
+}
+
+
+TEST(utest_blocked_assignment, large_offset) {
+    const double offset = 1.7e9;
+    const dataset data = { { offset + 9.0, offset }, { offset + 11.0, offset }, { offset - 1.0, offset }, { offset + 21.0, offset } };
+    const dataset centers = { { offset, offset }, { offset + 20.0, offset } };
+
+    const container::dense_dataset dense(data);
+    const blocked_assignment assignment(centers);
+
+    index_sequence labels(data.size());
+    assignment.assign(dense, 0, data.size(), labels);
+    ASSERT_EQ(index_sequence({ 0, 1, 0, 1 }), labels);
+
+    index_sequence labels_by_indexes(data.size());
+    assignment.assign(dense, index_sequence({ 3, 2, 1, 0 }), 0, data.size(), labels_by_indexes);
+    ASSERT_EQ(labels, labels_by_indexes);
+}
+
+
+TEST(utest_blocked_assignment, euclidean_metrics_only) {
+    ASSERT_TRUE(blocked_assignment::is_applicable(distance_metric_factory<point>::euclidean()));
+    ASSERT_TRUE(blocked_assignment::is_applicable(distance_metric_factory<point>::euclidean_square()));
+    ASSERT_FALSE(blocked_assignment::is_applicable(distance_metric_factory<point>::manhattan()));
+    ASSERT_FALSE(blocked_assignment::is_applicable(distance_metric_factory<point>::chebyshev()));
+}
@@ -0,0 +1,93 @@
+/*!
+
+@authors Andrei Novikov (pyclustering@yandex.ru)
+@date 2014-2020
+@copyright BSD-3-Clause
+
+*/
+
+
+#include <gtest/gtest.h>
+
+#include <pyclustering/container/concurrent_disjoint_set.hpp>
+#include <pyclustering/container/disjoint_set.hpp>
+
+#include <pyclustering/parallel/parallel.hpp>
+
+#include <random>
+#include <utility>
+#include <vector>
+
+
+using namespace pyclustering::container;
+using namespace pyclustering::parallel;
+
+
+TEST(utest_concurrent_disjoint_set, initial_sets) {
+    concurrent_disjoint_set sets(5);
+    ASSERT_EQ(5U, sets.size());
+
+    for (std::size_t i = 0; i < sets.size(); i++) {
+        ASSERT_EQ(i, sets.find(i));
+    }
+}
+
+
+TEST(utest_concurrent_disjoint_set, unite_smallest_representative) {
+    concurrent_disjoint_set sets(6);
+
+    ASSERT_TRUE(sets.unite(4, 5));
+    ASSERT_TRUE(sets.unite(5, 2));
+    ASSERT_FALSE(sets.unite(2, 4));
+    ASSERT_TRUE(sets.unite(3, 1));
+
+    ASSERT_EQ(2U, sets.find(4));
+    ASSERT_EQ(2U, sets.find(5));
+    ASSERT_EQ(1U, sets.find(3));
+    ASSERT_EQ(0U, sets.find(0));
+
+    ASSERT_TRUE(sets.unite(5, 3));
+    for (std::size_t i = 1; i < sets.size(); i++) {
+        ASSERT_EQ(1U, sets.find(i));
+    }
+}
+
+
+TEST(utest_concurrent_disjoint_set, parallel_unions) {
+    const std::size_t size = 20000;
+
+    std::mt19937 generator(1);
+    std::uniform_int_distribution<std::size_t> distribution(0, size - 1);
+
+    std::vector<std::pair<std::size_t, std::size_t>> pairs(15000);
+    for (auto & current_pair : pairs) {
+        current_pair = { distribution(generator), distribution(generator) };
+    }
+
+    disjoint_set expected_sets(size);
+    for (const auto & current_pair : pairs) {
+        expected_sets.unite(current_pair.first, current_pair.second);
+    }
+
+    concurrent_disjoint_set actual_sets(size);
+    std::vector<char> merged(pairs.size(), 0);
+    parallel_for(std::size_t(0), pairs.size(), [&pairs, &actual_sets, &merged](const std::size_t p_index) {
+        merged[p_index] = actual_sets.unite(pairs[p_index].first, pairs[p_index].second) ? 1 : 0;
+    });
+
+    /* each successful union reduces amount of sets by one regardless of order of unions */
+    std::size_t amount_merged = 0;
+    for (const auto flag : merged) {
+        amount_merged += flag;
+    }
+
+    std::size_t amount_sets = 0;
+    for (std::size_t i = 0; i < size; i++) {
+        ASSERT_EQ(expected_sets.find(i), actual_sets.find(i));
+        if (actual_sets.find(i) == i) {
+            amount_sets++;
+        }
+    }
+
+    ASSERT_EQ(size - amount_merged, amount_sets);
+}
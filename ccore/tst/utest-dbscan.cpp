@@ -11,12 +11,19 @@
 
 #include <pyclustering/cluster/dbscan.hpp>
 
+#include <pyclustering/container/kdtree_flat.hpp>
+
 #include <pyclustering/utils/metric.hpp>
 
 #include "samples.hpp"
 
 #include "utenv_check.hpp"
 
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
 
 using namespace pyclustering;
 using namespace pyclustering::clst;
@@ -267,3 +274,431 @@ TEST(utest_dbscan, noise_cluster_allocation_sample_simple_02_distance_matrix) {
     const std::vector<size_t> expected_clusters_length = { 10 };
     template_noise_allocation_distance_matrix(simple_sample_factory::create_sample(SAMPLE_SIMPLE::SAMPLE_SIMPLE_02), 2.0, 9, expected_clusters_length, 13);
 }
+
+
+static void template_metric_process_data(const std::shared_ptr<dataset> & p_data,
+        const double p_radius,
+        const size_t p_neighbors,
+        const distance_metric<point> & p_metric)
+{
+    dbscan_data expected_result;
+    dataset matrix;
+    distance_matrix(*p_data, p_metric, matrix);
+    dbscan(p_radius, p_neighbors).process(matrix, data_t::DISTANCE_MATRIX, expected_result);
+
+    dbscan_data actual_result;
+    dbscan(p_radius, p_neighbors, p_metric).process(*p_data, actual_result);
+
+    /* neighbors are found in other order, so points of clusters are compared without order */
+    cluster_sequence expected_clusters = expected_result.clusters();
+    cluster_sequence actual_clusters = actual_result.clusters();
+    for (auto & current_cluster : expected_clusters) { std::sort(current_cluster.begin(), current_cluster.end()); }
+    for (auto & current_cluster : actual_clusters) { std::sort(current_cluster.begin(), current_cluster.end()); }
+
+    ASSERT_EQ(expected_result.noise(), actual_result.noise());
+    ASSERT_EQ(expected_clusters, actual_clusters);
+}
+
+
+TEST(utest_dbscan, allocation_sample_simple_01_manhattan) {
+    template_metric_process_data(simple_sample_factory::create_sample(SAMPLE_SIMPLE::SAMPLE_SIMPLE_01), 0.7, 2, distance_metric_factory<point>::manhattan());
+}
+
+
+TEST(utest_dbscan, allocation_sample_simple_03_chebyshev) {
+    template_metric_process_data(simple_sample_factory::create_sample(SAMPLE_SIMPLE::SAMPLE_SIMPLE_03), 0.5, 3, distance_metric_factory<point>::chebyshev());
+}
+
+
+TEST(utest_dbscan, allocation_lsun_user_defined) {
+    const auto metric = distance_metric_factory<point>::user_defined([](const point & p1, const point & p2) {
+        return std::abs(p1[0] - p2[0]) + 2.0 * std::abs(p1[1] - p2[1]);
+    });
+
+    template_metric_process_data(fcps_sample_factory::create_sample(FCPS_SAMPLE::LSUN), 0.4, 4, metric);
+}
+
+
+TEST(utest_dbscan, allocation_lsun_user_defined_without_triangle_inequality) {
+    const auto metric = distance_metric_factory<point>::user_defined([](const point & p1, const point & p2) {
+        const double distance = std::abs(p1[0] - p2[0]) + std::abs(p1[1] - p2[1]);
+        return distance * distance;
+    });
+
+    template_metric_process_data(fcps_sample_factory::create_sample(FCPS_SAMPLE::LSUN), 0.2, 4, metric);
+}
+
+
+TEST(utest_dbscan, allocation_lsun_chi_square) {
+    template_metric_process_data(fcps_sample_factory::create_sample(FCPS_SAMPLE::LSUN), 0.1, 4, distance_metric_factory<point>::chi_square());
+}
+
+
+TEST(utest_dbscan, allocation_sample_simple_04_euclidean_square) {
+    template_metric_process_data(simple_sample_factory::create_sample(SAMPLE_SIMPLE::SAMPLE_SIMPLE_04), 0.49, 3, distance_metric_factory<point>::euclidean_square());
+}
+
+
+static void template_grid_process_data(const dataset & p_data, const double p_radius, const size_t p_neighbors) {
+    dbscan_data expected_result;
+    dbscan(p_radius, p_neighbors).process(p_data, expected_result);
+
+    dbscan_data actual_result;
+    dbscan(p_radius, p_neighbors, distance_metric_factory<point>::euclidean(), dbscan_engine::GRID).process(p_data, actual_result);
+
+    /* clusters are the same and in the same order, points of clusters that are found by the grid are ordered */
+    cluster_sequence expected_clusters = expected_result.clusters();
+    for (auto & current_cluster : expected_clusters) { std::sort(current_cluster.begin(), current_cluster.end()); }
+
+    ASSERT_EQ(expected_result.noise(), actual_result.noise());
+    ASSERT_EQ(expected_clusters, actual_result.clusters());
+}
+
+
+static dataset create_random_data(const std::size_t p_size, const std::size_t p_dimension, const unsigned int p_seed, const bool p_integer) {
+    std::mt19937 generator(p_seed);
+    std::uniform_real_distribution<double> distribution(0.0, 20.0);
+
+    dataset data(p_size, point(p_dimension));
+    for (auto & current_point : data) {
+        for (auto & coordinate : current_point) {
+            coordinate = p_integer ? std::floor(distribution(generator)) : distribution(generator);
+        }
+    }
+
+    return data;
+}
+
+
+TEST(utest_dbscan, grid_simple_samples) {
+    template_grid_process_data(*simple_sample_factory::create_sample(SAMPLE_SIMPLE::SAMPLE_SIMPLE_01), 0.5, 2);
+    template_grid_process_data(*simple_sample_factory::create_sample(SAMPLE_SIMPLE::SAMPLE_SIMPLE_02), 1.0, 2);
+    template_grid_process_data(*simple_sample_factory::create_sample(SAMPLE_SIMPLE::SAMPLE_SIMPLE_03), 0.7, 3);
+    template_grid_process_data(*simple_sample_factory::create_sample(SAMPLE_SIMPLE::SAMPLE_SIMPLE_04), 0.7, 3);
+    template_grid_process_data(*simple_sample_factory::create_sample(SAMPLE_SIMPLE::SAMPLE_SIMPLE_05), 0.7, 3);
+    template_grid_process_data(*simple_sample_factory::create_sample(SAMPLE_SIMPLE::SAMPLE_SIMPLE_07), 0.5, 3);
+    template_grid_process_data(*simple_sample_factory::create_sample(SAMPLE_SIMPLE::SAMPLE_SIMPLE_08), 0.5, 3);
+}
+
+
+TEST(utest_dbscan, grid_one_dimension) {
+    template_grid_process_data(*simple_sample_factory::create_sample(SAMPLE_SIMPLE::SAMPLE_SIMPLE_07), 0.5, 2);
+    template_grid_process_data(create_random_data(500, 1, 1, true), 1.0, 4);
+}
+
+
+TEST(utest_dbscan, grid_fcps) {
+    template_grid_process_data(*fcps_sample_factory::create_sample(FCPS_SAMPLE::LSUN), 0.3, 4);
+    template_grid_process_data(*fcps_sample_factory::create_sample(FCPS_SAMPLE::HEPTA), 0.5, 3);
+    template_grid_process_data(*fcps_sample_factory::create_sample(FCPS_SAMPLE::TETRA), 0.4, 5);
+}
+
+
+TEST(utest_dbscan, grid_random_borders) {
+    /* border points that are reached by several clusters are assigned to the first of them */
+    template_grid_process_data(create_random_data(3000, 2, 3, false), 0.3, 4);
+    template_grid_process_data(create_random_data(3000, 3, 5, false), 1.0, 6);
+    template_grid_process_data(create_random_data(2000, 4, 7, false), 2.0, 5);
+}
+
+
+TEST(utest_dbscan, grid_integer_lattice) {
+    /* many neighbors are located exactly on the connectivity radius */
+    template_grid_process_data(create_random_data(2000, 2, 9, true), 1.0, 3);
+    template_grid_process_data(create_random_data(3000, 3, 11, true), 1.0, 2);
+    template_grid_process_data(create_random_data(1000, 2, 13, true), 2.0, 0);
+}
+
+
+TEST(utest_dbscan, grid_dense_cells) {
+    dataset data;
+    for (std::size_t i = 0; i < 200; i++) {
+        data.push_back({ 1.0, 1.0 });
+        data.push_back({ 1.0 + 0.01 * static_cast<double>(i % 7), 5.0 });
+    }
+
+    data.push_back({ 3.0, 3.0 });
+
+    template_grid_process_data(data, 0.5, 10);
+    template_grid_process_data(data, 10.0, 500);
+}
+
+
+static void template_grid_not_applicable(const dataset & p_data, const double p_radius, const size_t p_neighbors, const distance_metric<point> & p_metric) {
+    dbscan_data expected_result;
+    dbscan(p_radius, p_neighbors, p_metric).process(p_data, expected_result);
+
+    dbscan_data actual_result;
+    dbscan(p_radius, p_neighbors, p_metric, dbscan_engine::GRID).process(p_data, actual_result);
+
+    ASSERT_EQ(expected_result.clusters(), actual_result.clusters());
+    ASSERT_EQ(expected_result.noise(), actual_result.noise());
+}
+
+
+TEST(utest_dbscan, grid_not_applicable) {
+    /* the tree is used for data that cannot be processed by the grid */
+    template_grid_not_applicable(create_random_data(500, 6, 15, false), 8.0, 3, distance_metric_factory<point>::euclidean());
+    template_grid_not_applicable(*simple_sample_factory::create_sample(SAMPLE_SIMPLE::SAMPLE_SIMPLE_01), 0.0, 0, distance_metric_factory<point>::euclidean());
+    template_grid_not_applicable(*simple_sample_factory::create_sample(SAMPLE_SIMPLE::SAMPLE_SIMPLE_01), 0.7, 2, distance_metric_factory<point>::manhattan());
+}
+
+
+TEST(utest_dbscan, grid_empty_data) {
+    dbscan_data result;
+    dbscan(1.0, 2, distance_metric_factory<point>::euclidean(), dbscan_engine::GRID).process(dataset(), result);
+
+    ASSERT_TRUE(result.clusters().empty());
+    ASSERT_TRUE(result.noise().empty());
+}
+
+
+static void template_parallel_process_data(const dataset & p_data, const double p_radius, const size_t p_neighbors, const distance_metric<point> & p_metric = distance_metric_factory<point>::euclidean()) {
+    dbscan_data expected_result;
+    dbscan(p_radius, p_neighbors, p_metric).process(p_data, expected_result);
+
+    dbscan_data actual_result;
+    dbscan(p_radius, p_neighbors, p_metric, dbscan_engine::PARALLEL).process(p_data, actual_result);
+
+    /* clusters are the same and in the same order, points of clusters that are merged in parallel are ordered */
+    cluster_sequence expected_clusters = expected_result.clusters();
+    for (auto & current_cluster : expected_clusters) { std::sort(current_cluster.begin(), current_cluster.end()); }
+
+    ASSERT_EQ(expected_result.noise(), actual_result.noise());
+    ASSERT_EQ(expected_clusters, actual_result.clusters());
+}
+
+
+static void template_parallel_process_distance_matrix(const dataset & p_data, const double p_radius, const size_t p_neighbors) {
+    dataset matrix;
+    distance_matrix(p_data, matrix);
+
+    dbscan_data expected_result;
+    dbscan(p_radius, p_neighbors).process(matrix, data_t::DISTANCE_MATRIX, expected_result);
+
+    dbscan_data actual_result;
+    dbscan(p_radius, p_neighbors, distance_metric_factory<point>::euclidean(), dbscan_engine::PARALLEL).process(matrix, data_t::DISTANCE_MATRIX, actual_result);
+
+    cluster_sequence expected_clusters = expected_result.clusters();
+    for (auto & current_cluster : expected_clusters) { std::sort(current_cluster.begin(), current_cluster.end()); }
+
+    ASSERT_EQ(expected_result.noise(), actual_result.noise());
+    ASSERT_EQ(expected_clusters, actual_result.clusters());
+}
+
+
+TEST(utest_dbscan, parallel_simple_samples) {
+    template_parallel_process_data(*simple_sample_factory::create_sample(SAMPLE_SIMPLE::SAMPLE_SIMPLE_01), 0.5, 2);
+    template_parallel_process_data(*simple_sample_factory::create_sample(SAMPLE_SIMPLE::SAMPLE_SIMPLE_02), 1.0, 2);
+    template_parallel_process_data(*simple_sample_factory::create_sample(SAMPLE_SIMPLE::SAMPLE_SIMPLE_03), 0.7, 3);
+    template_parallel_process_data(*simple_sample_factory::create_sample(SAMPLE_SIMPLE::SAMPLE_SIMPLE_04), 0.7, 3);
+    template_parallel_process_data(*simple_sample_factory::create_sample(SAMPLE_SIMPLE::SAMPLE_SIMPLE_05), 0.7, 3);
+    template_parallel_process_data(*simple_sample_factory::create_sample(SAMPLE_SIMPLE::SAMPLE_SIMPLE_07), 0.5, 3);
+    template_parallel_process_data(*simple_sample_factory::create_sample(SAMPLE_SIMPLE::SAMPLE_SIMPLE_08), 0.5, 3);
+}
+
+
+TEST(utest_dbscan, parallel_fcps) {
+    template_parallel_process_data(*fcps_sample_factory::create_sample(FCPS_SAMPLE::LSUN), 0.3, 4);
+    template_parallel_process_data(*fcps_sample_factory::create_sample(FCPS_SAMPLE::HEPTA), 0.5, 3);
+    template_parallel_process_data(*fcps_sample_factory::create_sample(FCPS_SAMPLE::TETRA), 0.4, 5);
+}
+
+
+TEST(utest_dbscan, parallel_random_borders) {
+    /* border points that are reached by several clusters are assigned to the first of them */
+    template_parallel_process_data(create_random_data(3000, 2, 3, false), 0.3, 4);
+    template_parallel_process_data(create_random_data(2000, 6, 15, false), 6.0, 5);
+    template_parallel_process_data(create_random_data(2000, 2, 9, true), 1.0, 3);
+    template_parallel_process_data(create_random_data(1000, 2, 13, true), 2.0, 0);
+}
+
+
+TEST(utest_dbscan, parallel_metrics) {
+    template_parallel_process_data(*simple_sample_factory::create_sample(SAMPLE_SIMPLE::SAMPLE_SIMPLE_01), 0.7, 2, distance_metric_factory<point>::manhattan());
+    template_parallel_process_data(*simple_sample_factory::create_sample(SAMPLE_SIMPLE::SAMPLE_SIMPLE_03), 0.7, 3, distance_metric_factory<point>::chebyshev());
+    template_parallel_process_data(create_random_data(2000, 3, 5, true), 2.0, 4, distance_metric_factory<point>::manhattan());
+}
+
+
+TEST(utest_dbscan, parallel_distance_matrix) {
+    template_parallel_process_distance_matrix(*simple_sample_factory::create_sample(SAMPLE_SIMPLE::SAMPLE_SIMPLE_01), 0.5, 2);
+    template_parallel_process_distance_matrix(*simple_sample_factory::create_sample(SAMPLE_SIMPLE::SAMPLE_SIMPLE_04), 0.7, 3);
+    template_parallel_process_distance_matrix(create_random_data(500, 2, 17, false), 1.0, 3);
+}
+
+
+TEST(utest_dbscan, parallel_empty_data) {
+    dbscan_data result;
+    dbscan(1.0, 2, distance_metric_factory<point>::euclidean(), dbscan_engine::PARALLEL).process(dataset(), result);
+
+    ASSERT_TRUE(result.clusters().empty());
+    ASSERT_TRUE(result.noise().empty());
+}
+
+
+static dataset create_dense_blobs(const std::size_t p_size, const std::size_t p_dimension, const std::size_t p_amount_blobs, const unsigned int p_seed) {
+    std::mt19937 generator(p_seed);
+    std::normal_distribution<double> distribution(0.0, 1.0);
+
+    dataset data(p_size, point(p_dimension));
+    for (std::size_t i = 0; i < p_size; i++) {
+        const double center = 10.0 * static_cast<double>(i % p_amount_blobs);
+        for (auto & coordinate : data[i]) {
+            coordinate = center + distribution(generator);
+        }
+    }
+
+    return data;
+}
+
+
+/* Original cluster expansion that checks each neighbor by linear search in the queue, clusters and order of their points should not be changed. */
+static void expand_clusters_by_search(const std::vector<std::vector<std::size_t>> & p_neighborhoods, const std::size_t p_neighbors, cluster_sequence & p_clusters, noise & p_noise) {
+    std::vector<bool> visited(p_neighborhoods.size(), false);
+    std::vector<bool> belong(p_neighborhoods.size(), false);
+
+    for (std::size_t i = 0; i < p_neighborhoods.size(); i++) {
+        if (visited[i]) {
+            continue;
+        }
+
+        visited[i] = true;
+
+        std::vector<std::size_t> queue = p_neighborhoods[i];
+        if (queue.size() < p_neighbors) {
+            continue;
+        }
+
+        cluster allocated_cluster = { i };
+        belong[i] = true;
+
+        for (std::size_t k = 0; k < queue.size(); k++) {
+            const std::size_t index_neighbor = queue[k];
+            if (!visited[index_neighbor]) {
+                visited[index_neighbor] = true;
+
+                const auto & neighbor_neighbors = p_neighborhoods[index_neighbor];
+                if (neighbor_neighbors.size() >= p_neighbors) {
+                    for (const auto index : neighbor_neighbors) {
+                        if (std::find(queue.begin(), queue.end(), index) == queue.end()) {
+                            queue.push_back(index);
+                        }
+                    }
+                }
+            }
+
+            if (!belong[index_neighbor]) {
+                allocated_cluster.push_back(index_neighbor);
+                belong[index_neighbor] = true;
+            }
+        }
+
+        p_clusters.push_back(std::move(allocated_cluster));
+    }
+
+    for (std::size_t i = 0; i < p_neighborhoods.size(); i++) {
+        if (!belong[i]) {
+            p_noise.push_back(i);
+        }
+    }
+}
+
+
+static std::vector<std::vector<std::size_t>> create_tree_neighborhoods(const dataset & p_data, const double p_radius) {
+    container::neighbor_graph graph;
+    container::kdtree_flat(p_data).find_nearest(p_radius, graph, false);
+
+    /* neighbors are in the same order as neighbors that are found by DBSCAN, the point itself is excluded */
+    std::vector<std::vector<std::size_t>> neighborhoods(p_data.size());
+    for (std::size_t i = 0; i < p_data.size(); i++) {
+        const std::size_t * neighbors = graph.neighbors(i);
+        for (std::size_t j = 0; j < graph.amount_neighbors(i); j++) {
+            if (neighbors[j] != i) {
+                neighborhoods[i].push_back(neighbors[j]);
+            }
+        }
+    }
+
+    return neighborhoods;
+}
+
+
+static void template_dense_expansion(const dataset & p_data, const double p_radius, const std::size_t p_neighbors) {
+    cluster_sequence expected_clusters;
+    noise expected_noise;
+    expand_clusters_by_search(create_tree_neighborhoods(p_data, p_radius), p_neighbors, expected_clusters, expected_noise);
+    ASSERT_FALSE(expected_clusters.empty());
+    ASSERT_FALSE(expected_noise.empty());
+
+    dbscan_data actual_result;
+    dbscan(p_radius, p_neighbors).process(p_data, actual_result);
+
+    ASSERT_EQ(expected_clusters, actual_result.clusters());
+    ASSERT_EQ(expected_noise, actual_result.noise());
+
+    /* neighbors in rows of distance matrix are ordered by indexes */
+    dataset matrix;
+    distance_matrix(p_data, distance_metric_factory<point>::euclidean(), matrix);
+
+    std::vector<std::vector<std::size_t>> neighborhoods(p_data.size());
+    for (std::size_t i = 0; i < matrix.size(); i++) {
+        for (std::size_t j = 0; j < matrix[i].size(); j++) {
+            if ((i != j) && (matrix[i][j] <= p_radius)) {
+                neighborhoods[i].push_back(j);
+            }
+        }
+    }
+
+    expected_clusters.clear();
+    expected_noise.clear();
+    expand_clusters_by_search(neighborhoods, p_neighbors, expected_clusters, expected_noise);
+
+    dbscan_data actual_matrix_result;
+    dbscan(p_radius, p_neighbors).process(matrix, data_t::DISTANCE_MATRIX, actual_matrix_result);
+
+    ASSERT_EQ(expected_clusters, actual_matrix_result.clusters());
+    ASSERT_EQ(expected_noise, actual_matrix_result.noise());
+}
+
+
+TEST(utest_dbscan, dense_blobs_expansion_order) {
+    template_dense_expansion(create_dense_blobs(1500, 2, 3, 1), 0.3, 5);
+    template_dense_expansion(create_dense_blobs(1200, 3, 4, 3), 0.5, 10);
+    template_dense_expansion(create_dense_blobs(800, 2, 2, 5), 0.15, 3);
+}
+
+
+#ifdef UT_PERFORMANCE_SESSION
+#include <chrono>
+
+TEST(performance_dbscan, dense_blobs) {
+    const dataset points = create_dense_blobs(50000, 3, 4, 7);
+    const double radius = 0.5;
+    const std::size_t neighbors = 10;
+
+    auto start = std::chrono::system_clock::now();
+
+    cluster_sequence expected_clusters;
+    noise expected_noise;
+    expand_clusters_by_search(create_tree_neighborhoods(points, radius), neighbors, expected_clusters, expected_noise);
+
+    auto end = std::chrono::system_clock::now();
+
+    std::chrono::duration<double> difference = end - start;
+    std::cout << "Clustering time (expansion by linear search): '" << difference.count() << "' sec." << std::endl;
+
+    start = std::chrono::system_clock::now();
+
+    dbscan_data actual_result;
+    dbscan(radius, neighbors).process(points, actual_result);
+
+    end = std::chrono::system_clock::now();
+
+    difference = end - start;
+    std::cout << "Clustering time: '" << difference.count() << "' sec." << std::endl;
+
+    ASSERT_EQ(expected_clusters, actual_result.clusters());
+    ASSERT_EQ(expected_noise, actual_result.noise());
+}
+#endif
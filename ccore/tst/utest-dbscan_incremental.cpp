@@ -0,0 +1,222 @@
+/*!
+
+@authors Andrei Novikov (pyclustering@yandex.ru)
+@date 2014-2020
+@copyright BSD-3-Clause
+
+*/
+
+
+#include <gtest/gtest.h>
+
+#include <pyclustering/cluster/dbscan.hpp>
+#include <pyclustering/cluster/dbscan_incremental.hpp>
+
+#include "samples.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <random>
+
+
+using namespace pyclustering;
+using namespace pyclustering::clst;
+
+
+using point_storage = std::map<std::size_t, point>;
+
+
+static void assert_batch_result(dbscan_incremental & p_solver, const point_storage & p_points, const double p_radius, const std::size_t p_neighbors) {
+    ASSERT_EQ(p_points.size(), p_solver.size());
+
+    /* indexes are increasing, so the order of clusters and of points is the same as in the batch data */
+    dataset data;
+    std::vector<std::size_t> indexes;
+    for (const auto & entry : p_points) {
+        indexes.push_back(entry.first);
+        data.push_back(entry.second);
+    }
+
+    dbscan_data batch_result;
+    dbscan(p_radius, p_neighbors).process(data, batch_result);
+
+    cluster_sequence expected_clusters = batch_result.clusters();
+    for (auto & current_cluster : expected_clusters) {
+        for (auto & index_point : current_cluster) { index_point = indexes[index_point]; }
+        std::sort(current_cluster.begin(), current_cluster.end());
+    }
+
+    noise expected_noise = batch_result.noise();
+    for (auto & index_point : expected_noise) { index_point = indexes[index_point]; }
+
+    dbscan_data actual_result;
+    p_solver.get_clusters(actual_result);
+
+    ASSERT_EQ(expected_clusters, actual_result.clusters());
+    ASSERT_EQ(expected_noise, actual_result.noise());
+}
+
+
+static void template_random_updates(const std::size_t p_dimension, const double p_radius, const std::size_t p_neighbors, const bool p_integer, const unsigned int p_seed) {
+    std::mt19937 generator(p_seed);
+    std::uniform_real_distribution<double> coordinate_distribution(0.0, 10.0);
+
+    dbscan_incremental solver(p_radius, p_neighbors);
+    point_storage points;
+
+    for (std::size_t step = 0; step < 40; step++) {
+        /* the amount of points grows at first and then it is kept */
+        const std::size_t amount_insertions = (step < 10) ? 60 : 25;
+        for (std::size_t i = 0; i < amount_insertions; i++) {
+            point current_point(p_dimension);
+            for (auto & coordinate : current_point) {
+                coordinate = p_integer ? std::floor(coordinate_distribution(generator)) : coordinate_distribution(generator);
+            }
+
+            const std::size_t index = solver.insert(current_point);
+            ASSERT_EQ(0U, points.count(index));
+            points[index] = current_point;
+        }
+
+        const std::size_t amount_removals = (step < 10) ? 20 : 25;
+        for (std::size_t i = 0; (i < amount_removals) && !points.empty(); i++) {
+            auto iter = points.begin();
+            std::advance(iter, std::uniform_int_distribution<std::size_t>(0, points.size() - 1)(generator));
+
+            solver.remove(iter->first);
+            points.erase(iter);
+        }
+
+        assert_batch_result(solver, points, p_radius, p_neighbors);
+    }
+}
+
+
+TEST(utest_dbscan_incremental, random_updates_2d) {
+    template_random_updates(2, 0.5, 3, false, 1);
+    template_random_updates(2, 0.8, 5, false, 2);
+}
+
+
+TEST(utest_dbscan_incremental, random_updates_3d) {
+    template_random_updates(3, 1.5, 4, false, 3);
+}
+
+
+TEST(utest_dbscan_incremental, random_updates_lattice) {
+    /* many neighbors are located exactly on the connectivity radius */
+    template_random_updates(2, 1.0, 3, true, 4);
+    template_random_updates(2, 1.0, 0, true, 5);
+    template_random_updates(2, 2.0, 1, true, 6);
+}
+
+
+TEST(utest_dbscan_incremental, insert_sample) {
+    const auto sample = simple_sample_factory::create_sample(SAMPLE_SIMPLE::SAMPLE_SIMPLE_03);
+
+    dbscan_incremental solver(0.7, 3);
+    const std::vector<std::size_t> indexes = solver.insert(*sample);
+
+    point_storage points;
+    for (std::size_t i = 0; i < indexes.size(); i++) {
+        ASSERT_EQ(i, indexes[i]);
+        points[indexes[i]] = (*sample)[i];
+    }
+
+    assert_batch_result(solver, points, 0.7, 3);
+}
+
+
+TEST(utest_dbscan_incremental, merge_and_split_chain) {
+    dbscan_incremental solver(1.0, 2);
+    point_storage points;
+
+    /* two separate chains */
+    for (std::size_t i = 0; i < 5; i++) {
+        points[solver.insert({ static_cast<double>(i), 0.0 })] = { static_cast<double>(i), 0.0 };
+        points[solver.insert({ static_cast<double>(i) + 6.0, 0.0 })] = { static_cast<double>(i) + 6.0, 0.0 };
+    }
+
+    dbscan_data result;
+    solver.get_clusters(result);
+    ASSERT_EQ(2U, result.clusters().size());
+
+    /* a bridge merges the chains */
+    const std::size_t bridge = solver.insert({ 5.0, 0.0 });
+    points[bridge] = { 5.0, 0.0 };
+
+    solver.get_clusters(result);
+    ASSERT_EQ(1U, result.clusters().size());
+    ASSERT_EQ(11U, result.clusters()[0].size());
+    assert_batch_result(solver, points, 1.0, 2);
+
+    /* the cluster is split again when the bridge is removed */
+    solver.remove(bridge);
+    points.erase(bridge);
+
+    solver.get_clusters(result);
+    ASSERT_EQ(2U, result.clusters().size());
+    assert_batch_result(solver, points, 1.0, 2);
+
+    /* the index of the removed point is reused */
+    ASSERT_EQ(bridge, solver.insert({ 5.0, 0.0 }));
+    points[bridge] = { 5.0, 0.0 };
+    assert_batch_result(solver, points, 1.0, 2);
+}
+
+
+TEST(utest_dbscan_incremental, remove_all_points) {
+    dbscan_incremental solver(0.5, 2);
+    const auto sample = simple_sample_factory::create_sample(SAMPLE_SIMPLE::SAMPLE_SIMPLE_01);
+    const std::vector<std::size_t> indexes = solver.insert(*sample);
+
+    for (const auto index_point : indexes) {
+        ASSERT_TRUE(solver.contains(index_point));
+        ASSERT_EQ((*sample)[index_point], solver.get_point(index_point));
+
+        solver.remove(index_point);
+        ASSERT_FALSE(solver.contains(index_point));
+    }
+
+    dbscan_data result;
+    solver.get_clusters(result);
+
+    ASSERT_EQ(0U, solver.size());
+    ASSERT_TRUE(result.clusters().empty());
+    ASSERT_TRUE(result.noise().empty());
+}
+
+
+TEST(utest_dbscan_incremental, incorrect_arguments) {
+    dbscan_incremental solver(0.5, 2);
+    ASSERT_THROW(solver.insert(point()), std::invalid_argument);
+
+    const std::size_t index = solver.insert({ 1.0, 2.0 });
+    ASSERT_THROW(solver.insert({ 1.0, 2.0, 3.0 }), std::invalid_argument);
+    ASSERT_THROW(solver.remove(index + 1), std::invalid_argument);
+    ASSERT_THROW(solver.get_point(index + 1), std::invalid_argument);
+
+    solver.remove(index);
+    ASSERT_THROW(solver.remove(index), std::invalid_argument);
+}
+
+
+TEST(utest_dbscan_incremental, incorrect_batch_arguments) {
+    dbscan_incremental solver(0.5, 2);
+    ASSERT_THROW(solver.insert(dataset({ { 1.0, 2.0 }, { 1.0 } })), std::invalid_argument);
+    ASSERT_EQ(0U, solver.size());
+
+    const std::vector<std::size_t> indexes = solver.insert(dataset({ { 1.0, 2.0 }, { 1.1, 2.0 }, { 1.2, 2.0 } }));
+    ASSERT_THROW(solver.insert(dataset({ { 1.3, 2.0 }, { 1.0, 2.0, 3.0 } })), std::invalid_argument);
+    ASSERT_EQ(3U, solver.size());
+
+    /* batch is not applied partially */
+    ASSERT_THROW(solver.remove(std::vector<std::size_t>({ indexes[0], indexes[2] + 1 })), std::invalid_argument);
+    ASSERT_THROW(solver.remove(std::vector<std::size_t>({ indexes[0], indexes[1], indexes[0] })), std::invalid_argument);
+    ASSERT_EQ(3U, solver.size());
+
+    solver.remove(std::vector<std::size_t>({ indexes[0], indexes[1] }));
+    ASSERT_EQ(1U, solver.size());
+    ASSERT_TRUE(solver.contains(indexes[2]));
+}
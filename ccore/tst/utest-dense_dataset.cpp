@@ -0,0 +1,237 @@
+/*!
+
+@authors Andrei Novikov (pyclustering@yandex.ru)
+@date 2014-2020
+@copyright BSD-3-Clause
+
+*/
+
+
+#include <gtest/gtest.h>
+
+#include "samples.hpp"
+
+#include <pyclustering/container/dense_dataset.hpp>
+
+#include <pyclustering/cluster/dbscan.hpp>
+#include <pyclustering/cluster/fcm.hpp>
+#include <pyclustering/cluster/kmeans.hpp>
+#include <pyclustering/cluster/kmedians.hpp>
+#include <pyclustering/cluster/kmedoids.hpp>
+#include <pyclustering/cluster/optics.hpp>
+#include <pyclustering/cluster/silhouette.hpp>
+
+#include <pyclustering/utils/metric.hpp>
+
+#include <cstdint>
+#include <stdexcept>
+
+
+using namespace pyclustering;
+using namespace pyclustering::clst;
+using namespace pyclustering::container;
+using namespace pyclustering::utils::metric;
+
+
+static void template_dense_layout(const dataset & p_data, const bool p_aligned) {
+    dense_dataset dense(p_data, p_aligned);
+
+    ASSERT_EQ(p_data.size(), dense.size());
+    ASSERT_EQ(p_data.empty(), dense.empty());
+    ASSERT_EQ(p_data.empty() ? 0U : p_data[0].size(), dense.dimension());
+    ASSERT_GE(dense.stride(), dense.dimension());
+
+    for (std::size_t i = 0; i < p_data.size(); i++) {
+        if (p_aligned) {
+            ASSERT_EQ(0U, reinterpret_cast<std::uintptr_t>(dense.row(i)) % dense_dataset::ROW_ALIGNMENT);
+        }
+
+        ASSERT_EQ(p_data[i], dense[i].to_point());
+        ASSERT_EQ(p_data[i], dense.view()[i].to_point());
+    }
+
+    ASSERT_EQ(p_data, dense.to_dataset());
+    ASSERT_EQ(p_data, dense_dataset(dense.view()).to_dataset());
+}
+
+
+TEST(utest_dense_dataset, empty) {
+    template_dense_layout({ }, false);
+}
+
+TEST(utest_dense_dataset, one_point) {
+    template_dense_layout({ { 1.0, 2.0, 3.0 } }, false);
+}
+
+TEST(utest_dense_dataset, several_points) {
+    template_dense_layout({ { 1.0, 2.0 }, { 3.0, 4.0 }, { 5.0, 6.0 } }, false);
+}
+
+TEST(utest_dense_dataset, several_points_aligned) {
+    template_dense_layout({ { 1.0, 2.0 }, { 3.0, 4.0 }, { 5.0, 6.0 } }, true);
+}
+
+TEST(utest_dense_dataset, wide_points_aligned) {
+    template_dense_layout({ { 1, 2, 3, 4, 5, 6, 7, 8, 9 }, { 9, 8, 7, 6, 5, 4, 3, 2, 1 } }, true);
+}
+
+TEST(utest_dense_dataset, sample_simple_01) {
+    template_dense_layout(*simple_sample_factory::create_sample(SAMPLE_SIMPLE::SAMPLE_SIMPLE_01), false);
+}
+
+TEST(utest_dense_dataset, sample_simple_01_aligned) {
+    template_dense_layout(*simple_sample_factory::create_sample(SAMPLE_SIMPLE::SAMPLE_SIMPLE_01), true);
+}
+
+
+TEST(utest_dense_dataset, different_dimensions) {
+    ASSERT_THROW(dense_dataset({ { 1.0, 2.0 }, { 1.0 } }), std::invalid_argument);
+}
+
+
+TEST(utest_dense_dataset, strided_view) {
+    const std::vector<double> buffer = { 1.0, 2.0, -1.0, 3.0, 4.0, -1.0 };
+    dense_dataset_view view(buffer.data(), 2, 2, 3);
+
+    ASSERT_EQ(2U, view.size());
+    ASSERT_EQ(2U, view.dimension());
+    ASSERT_EQ(3U, view.stride());
+    ASSERT_EQ(dataset({ { 1.0, 2.0 }, { 3.0, 4.0 } }), view.to_dataset());
+
+    ASSERT_THROW(dense_dataset_view(buffer.data(), 2, 3, 2), std::invalid_argument);
+}
+
+
+static void template_view_metric(const distance_metric<point> & p_metric) {
+    const dataset data = { { 1.0, 2.0, 3.0 }, { -4.0, 0.5, 6.0 } };
+    const dense_dataset dense(data, true);
+
+    const distance_metric<point> user_metric = distance_metric_factory<point>::user_defined(
+        [&p_metric](const point & p1, const point & p2) { return p_metric(p1, p2); });
+
+    ASSERT_DOUBLE_EQ(p_metric(data[0], data[1]), p_metric(dense[0], dense[1]));
+    ASSERT_DOUBLE_EQ(p_metric(data[0], data[1]), p_metric(dense[0], data[1]));
+    ASSERT_DOUBLE_EQ(p_metric(data[0], data[1]), user_metric(dense[0], dense[1]));
+}
+
+
+TEST(utest_dense_dataset, metric_euclidean) {
+    template_view_metric(distance_metric_factory<point>::euclidean());
+}
+
+TEST(utest_dense_dataset, metric_euclidean_square) {
+    template_view_metric(distance_metric_factory<point>::euclidean_square());
+}
+
+TEST(utest_dense_dataset, metric_manhattan) {
+    template_view_metric(distance_metric_factory<point>::manhattan());
+}
+
+TEST(utest_dense_dataset, metric_chebyshev) {
+    template_view_metric(distance_metric_factory<point>::chebyshev());
+}
+
+TEST(utest_dense_dataset, metric_minkowski) {
+    template_view_metric(distance_metric_factory<point>::minkowski(3.0));
+}
+
+TEST(utest_dense_dataset, metric_canberra) {
+    template_view_metric(distance_metric_factory<point>::canberra());
+}
+
+TEST(utest_dense_dataset, metric_chi_square) {
+    template_view_metric(distance_metric_factory<point>::chi_square());
+}
+
+TEST(utest_dense_dataset, metric_gower) {
+    template_view_metric(distance_metric_factory<point>::gower({ 5.0, 1.5, 3.0 }));
+}
+
+
+TEST(utest_dense_dataset, kmeans_same_as_dataset) {
+    const dataset data = *simple_sample_factory::create_sample(SAMPLE_SIMPLE::SAMPLE_SIMPLE_03);
+    const dataset centers = { { 0.2, 0.1 }, { 4.0, 1.0 }, { 2.0, 2.0 }, { 2.3, 3.9 } };
+
+    kmeans_data expected, actual;
+    kmeans(centers).process(data, expected);
+    kmeans(centers).process(dense_dataset(data, true), actual);
+
+    ASSERT_EQ(expected.clusters(), actual.clusters());
+    ASSERT_EQ(expected.centers(), actual.centers());
+    ASSERT_DOUBLE_EQ(expected.wce(), actual.wce());
+}
+
+
+TEST(utest_dense_dataset, kmedians_same_as_dataset) {
+    const dataset data = *simple_sample_factory::create_sample(SAMPLE_SIMPLE::SAMPLE_SIMPLE_03);
+    const dataset medians = { { 0.2, 0.1 }, { 4.0, 1.0 }, { 2.0, 2.0 }, { 2.3, 3.9 } };
+
+    kmedians_data expected, actual;
+    kmedians(medians).process(data, expected);
+    kmedians(medians).process(dense_dataset(data), actual);
+
+    ASSERT_EQ(expected.clusters(), actual.clusters());
+    ASSERT_EQ(expected.medians(), actual.medians());
+}
+
+
+TEST(utest_dense_dataset, kmedoids_same_as_dataset) {
+    const dataset data = *simple_sample_factory::create_sample(SAMPLE_SIMPLE::SAMPLE_SIMPLE_03);
+
+    kmedoids_data expected, actual;
+    kmedoids({ 4, 12, 25, 37 }).process(data, expected);
+    kmedoids({ 4, 12, 25, 37 }).process(dense_dataset(data), data_t::POINTS, actual);
+
+    ASSERT_EQ(expected.clusters(), actual.clusters());
+    ASSERT_EQ(expected.medoids(), actual.medoids());
+}
+
+
+TEST(utest_dense_dataset, fcm_same_as_dataset) {
+    const dataset data = *simple_sample_factory::create_sample(SAMPLE_SIMPLE::SAMPLE_SIMPLE_01);
+    const dataset centers = { { 3.7, 5.5 }, { 6.7, 7.5 } };
+
+    fcm_data expected, actual;
+    fcm(centers).process(data, expected);
+    fcm(centers).process(dense_dataset(data), actual);
+
+    ASSERT_EQ(expected.clusters(), actual.clusters());
+    ASSERT_EQ(expected.membership(), actual.membership());
+}
+
+
+TEST(utest_dense_dataset, dbscan_same_as_dataset) {
+    const dataset data = *simple_sample_factory::create_sample(SAMPLE_SIMPLE::SAMPLE_SIMPLE_02);
+
+    dbscan_data expected, actual;
+    dbscan(2.0, 9).process(data, expected);
+    dbscan(2.0, 9).process(dense_dataset(data), data_t::POINTS, actual);
+
+    ASSERT_EQ(expected.clusters(), actual.clusters());
+    ASSERT_EQ(expected.noise(), actual.noise());
+}
+
+
+TEST(utest_dense_dataset, optics_same_as_dataset) {
+    const dataset data = *simple_sample_factory::create_sample(SAMPLE_SIMPLE::SAMPLE_SIMPLE_02);
+
+    optics_data expected, actual;
+    optics(2.0, 5).process(data, expected);
+    optics(2.0, 5).process(dense_dataset(data), data_t::POINTS, actual);
+
+    ASSERT_EQ(expected.clusters(), actual.clusters());
+    ASSERT_EQ(expected.noise(), actual.noise());
+    ASSERT_EQ(expected.cluster_ordering(), actual.cluster_ordering());
+}
+
+
+TEST(utest_dense_dataset, silhouette_same_as_dataset) {
+    const dataset data = *simple_sample_factory::create_sample(SAMPLE_SIMPLE::SAMPLE_SIMPLE_01);
+    const cluster_sequence clusters = { { 0, 1, 2, 3, 4 }, { 5, 6, 7, 8, 9 } };
+
+    silhouette_data expected, actual;
+    silhouette().process(data, clusters, expected);
+    silhouette().process(dense_dataset(data), clusters, data_t::POINTS, actual);
+
+    ASSERT_EQ(expected.get_score(), actual.get_score());
+}
@@ -0,0 +1,97 @@
+/*!
+
+@authors Andrei Novikov (pyclustering@yandex.ru)
+@date 2014-2020
+@copyright BSD-3-Clause
+
+*/
+
+
+#include <gtest/gtest.h>
+
+#include <pyclustering/container/disjoint_set.hpp>
+
+#include <random>
+#include <vector>
+
+
+using namespace pyclustering::container;
+
+
+TEST(utest_disjoint_set, initial_sets) {
+    disjoint_set sets(5);
+    ASSERT_EQ(5U, sets.size());
+
+    for (std::size_t i = 0; i < sets.size(); i++) {
+        ASSERT_EQ(i, sets.find(i));
+    }
+}
+
+
+TEST(utest_disjoint_set, unite_smallest_representative) {
+    disjoint_set sets(6);
+
+    ASSERT_TRUE(sets.unite(4, 5));
+    ASSERT_TRUE(sets.unite(5, 2));
+    ASSERT_FALSE(sets.unite(2, 4));
+    ASSERT_TRUE(sets.unite(3, 1));
+
+    ASSERT_EQ(2U, sets.find(4));
+    ASSERT_EQ(2U, sets.find(5));
+    ASSERT_EQ(1U, sets.find(3));
+    ASSERT_EQ(0U, sets.find(0));
+
+    ASSERT_TRUE(sets.unite(5, 3));
+    for (std::size_t i = 1; i < sets.size(); i++) {
+        ASSERT_EQ(1U, sets.find(i));
+    }
+}
+
+
+TEST(utest_disjoint_set, random_unions) {
+    const std::size_t size = 1000;
+    disjoint_set sets(size);
+    std::vector<std::size_t> labels(size);
+    for (std::size_t i = 0; i < size; i++) {
+        labels[i] = i;
+    }
+
+    std::mt19937 generator(1);
+    std::uniform_int_distribution<std::size_t> distribution(0, size - 1);
+
+    for (std::size_t step = 0; step < 700; step++) {
+        const std::size_t element1 = distribution(generator);
+        const std::size_t element2 = distribution(generator);
+
+        const std::size_t label1 = labels[element1];
+        const std::size_t label2 = labels[element2];
+        ASSERT_EQ(label1 != label2, sets.unite(element1, element2));
+
+        /* reference labels are the smallest elements of sets */
+        const std::size_t label = std::min(label1, label2);
+        for (auto & current_label : labels) {
+            if ((current_label == label1) || (current_label == label2)) {
+                current_label = label;
+            }
+        }
+    }
+
+    for (std::size_t i = 0; i < size; i++) {
+        ASSERT_EQ(labels[i], sets.find(i));
+    }
+}
+
+
+TEST(utest_disjoint_set, append_elements) {
+    disjoint_set sets;
+    ASSERT_EQ(0U, sets.size());
+
+    ASSERT_EQ(0U, sets.append());
+    ASSERT_EQ(1U, sets.append());
+    ASSERT_TRUE(sets.unite(1, 0));
+
+    ASSERT_EQ(2U, sets.append());
+    ASSERT_EQ(3U, sets.size());
+    ASSERT_EQ(0U, sets.find(1));
+    ASSERT_EQ(2U, sets.find(2));
+}
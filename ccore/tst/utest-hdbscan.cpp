@@ -0,0 +1,173 @@
+/*!
+
+@authors Andrei Novikov (pyclustering@yandex.ru)
+@date 2014-2020
+@copyright BSD-3-Clause
+
+*/
+
+
+#include <gtest/gtest.h>
+
+#include <pyclustering/cluster/hdbscan.hpp>
+
+#include "samples.hpp"
+
+#include "utenv_check.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+
+using namespace pyclustering;
+using namespace pyclustering::clst;
+
+
+static void template_hdbscan_sample(const std::shared_ptr<dataset> & p_data,
+        const std::size_t p_neighbors,
+        const std::size_t p_minimum_cluster_size,
+        const std::vector<std::size_t> & p_expected_cluster_length,
+        const std::size_t p_expected_noise_length)
+{
+    hdbscan_data result;
+    hdbscan(p_neighbors, p_minimum_cluster_size).process(*p_data, result);
+
+    ASSERT_CLUSTER_NOISE_SIZES(*p_data, result.clusters(), p_expected_cluster_length, result.noise(), p_expected_noise_length);
+    ASSERT_EQ(result.clusters().size(), result.stability().size());
+    ASSERT_EQ(p_data->size(), result.core_distances().size());
+
+    /* clusters are ordered by their smallest point */
+    for (std::size_t index_cluster = 1; index_cluster < result.clusters().size(); index_cluster++) {
+        ASSERT_LT(result.clusters()[index_cluster - 1].front(), result.clusters()[index_cluster].front());
+    }
+}
+
+
+TEST(utest_hdbscan, allocation_sample_simple_01) {
+    template_hdbscan_sample(simple_sample_factory::create_sample(SAMPLE_SIMPLE::SAMPLE_SIMPLE_01), 3, 5, { 5, 5 }, 0);
+}
+
+
+TEST(utest_hdbscan, allocation_sample_simple_03) {
+    template_hdbscan_sample(simple_sample_factory::create_sample(SAMPLE_SIMPLE::SAMPLE_SIMPLE_03), 3, 5, { 10, 10, 10, 30 }, 0);
+}
+
+
+TEST(utest_hdbscan, allocation_sample_lsun) {
+    template_hdbscan_sample(fcps_sample_factory::create_sample(FCPS_SAMPLE::LSUN), 5, 10, { 100, 100, 202 }, 1);
+}
+
+
+TEST(utest_hdbscan, allocation_sample_target) {
+    template_hdbscan_sample(fcps_sample_factory::create_sample(FCPS_SAMPLE::TARGET), 3, 5, { 363, 395 }, 12);
+}
+
+
+TEST(utest_hdbscan, allocation_sample_hepta) {
+    template_hdbscan_sample(fcps_sample_factory::create_sample(FCPS_SAMPLE::HEPTA), 3, 5, { 30, 30, 30, 30, 30, 30, 32 }, 0);
+}
+
+
+TEST(utest_hdbscan, core_distances) {
+    const auto data = simple_sample_factory::create_sample(SAMPLE_SIMPLE::SAMPLE_SIMPLE_03);
+    const std::size_t neighbors = 4;
+
+    hdbscan_data result;
+    hdbscan(neighbors, 5).process(*data, result);
+
+    for (std::size_t i = 0; i < data->size(); i++) {
+        std::vector<double> distances;
+        for (const auto & other : *data) {
+            double distance = 0.0;
+            for (std::size_t dimension = 0; dimension < other.size(); dimension++) {
+                distance += std::pow((*data)[i][dimension] - other[dimension], 2);
+            }
+
+            distances.push_back(distance);
+        }
+
+        std::sort(distances.begin(), distances.end());
+        ASSERT_DOUBLE_EQ(std::sqrt(distances[neighbors]), result.core_distances()[i]);
+    }
+}
+
+
+TEST(utest_hdbscan, dataset_and_view) {
+    const auto data = fcps_sample_factory::create_sample(FCPS_SAMPLE::LSUN);
+
+    hdbscan_data expected_result;
+    hdbscan(5, 10).process(*data, expected_result);
+
+    const container::dense_dataset dense_data(*data);
+    hdbscan_data actual_result;
+    hdbscan(5, 10).process(dense_data, actual_result);
+
+    ASSERT_EQ(expected_result.clusters(), actual_result.clusters());
+    ASSERT_EQ(expected_result.noise(), actual_result.noise());
+    ASSERT_EQ(expected_result.stability(), actual_result.stability());
+}
+
+
+TEST(utest_hdbscan, same_solver_several_times) {
+    const auto data = simple_sample_factory::create_sample(SAMPLE_SIMPLE::SAMPLE_SIMPLE_03);
+
+    hdbscan solver(3, 5);
+    hdbscan_data expected_result;
+    solver.process(*data, expected_result);
+
+    hdbscan_data actual_result;
+    solver.process(*data, actual_result);
+    solver.process(*data, actual_result);
+
+    ASSERT_EQ(expected_result.clusters(), actual_result.clusters());
+    ASSERT_EQ(expected_result.noise(), actual_result.noise());
+}
+
+
+TEST(utest_hdbscan, identical_points) {
+    const dataset data(20, { 1.0, 1.0 });
+
+    hdbscan_data result;
+    hdbscan(3, 5).process(data, result);
+
+    std::size_t total_size = result.noise().size();
+    for (const auto & cluster : result.clusters()) {
+        total_size += cluster.size();
+    }
+
+    ASSERT_EQ(data.size(), total_size);
+}
+
+
+TEST(utest_hdbscan, one_point) {
+    hdbscan_data result;
+    hdbscan(3, 5).process(dataset({ { 1.0, 2.0 } }), result);
+
+    ASSERT_TRUE(result.clusters().empty());
+    ASSERT_EQ(noise({ 0 }), result.noise());
+}
+
+
+TEST(utest_hdbscan, empty_data) {
+    hdbscan_data result;
+    hdbscan(3, 5).process(dataset(), result);
+
+    ASSERT_TRUE(result.clusters().empty());
+    ASSERT_TRUE(result.noise().empty());
+}
+
+
+TEST(utest_hdbscan, not_finite_coordinates) {
+    hdbscan_data result;
+    ASSERT_THROW(hdbscan(1, 2).process(dataset({ { 1.0, 1.0 }, { 2.0, std::numeric_limits<double>::infinity() }, { 3.0, 3.0 } }), result), std::invalid_argument);
+    ASSERT_THROW(hdbscan(1, 2).process(dataset({ { 1.0, 1.0 }, { 2.0, 2.0 }, { -std::numeric_limits<double>::infinity(), 3.0 } }), result), std::invalid_argument);
+    ASSERT_THROW(hdbscan(1, 2).process(dataset({ { std::numeric_limits<double>::quiet_NaN(), 1.0 }, { 2.0, 2.0 } }), result), std::invalid_argument);
+}
+
+
+TEST(utest_hdbscan, incorrect_minimum_cluster_size) {
+    hdbscan_data result;
+    ASSERT_THROW(hdbscan(3, 1).process(dataset({ { 1.0 }, { 2.0 } }), result), std::invalid_argument);
+}
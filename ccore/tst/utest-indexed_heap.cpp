@@ -0,0 +1,135 @@
+/*!
+
+@authors Andrei Novikov (pyclustering@yandex.ru)
+@date 2014-2020
+@copyright BSD-3-Clause
+
+*/
+
+
+#include <gtest/gtest.h>
+
+#include <pyclustering/container/indexed_heap.hpp>
+
+#include <random>
+#include <set>
+#include <tuple>
+#include <vector>
+
+
+using namespace pyclustering::container;
+
+
+TEST(utest_indexed_heap, empty_heap) {
+    indexed_heap heap(3);
+
+    ASSERT_TRUE(heap.empty());
+    ASSERT_EQ(0U, heap.size());
+    ASSERT_FALSE(heap.contains(0));
+}
+
+
+TEST(utest_indexed_heap, push_pop_order) {
+    indexed_heap heap(5);
+    heap.push(3, 0.5);
+    heap.push(0, 2.0);
+    heap.push(4, 0.1);
+    heap.push(1, 1.0);
+
+    ASSERT_EQ(4U, heap.size());
+    ASSERT_TRUE(heap.contains(1));
+    ASSERT_FALSE(heap.contains(2));
+    ASSERT_EQ(4U, heap.top());
+
+    ASSERT_EQ(4U, heap.pop());
+    ASSERT_FALSE(heap.contains(4));
+    ASSERT_EQ(3U, heap.pop());
+    ASSERT_EQ(1U, heap.pop());
+    ASSERT_EQ(0U, heap.pop());
+    ASSERT_TRUE(heap.empty());
+}
+
+
+TEST(utest_indexed_heap, decrease_key) {
+    indexed_heap heap(4);
+    heap.push(0, 1.0);
+    heap.push(1, 2.0);
+    heap.push(2, 3.0);
+    heap.push(3, 4.0);
+
+    heap.decrease(3, 0.5);
+    ASSERT_EQ(3U, heap.top());
+
+    heap.decrease(2, 1.5);
+    ASSERT_EQ(3U, heap.pop());
+    ASSERT_EQ(0U, heap.pop());
+    ASSERT_EQ(2U, heap.pop());
+    ASSERT_EQ(1U, heap.pop());
+}
+
+
+TEST(utest_indexed_heap, equal_keys_order) {
+    /* elements with equal keys are extracted in order of insertion or decrease of key */
+    indexed_heap heap(6);
+    heap.push(5, 1.0);
+    heap.push(2, 1.0);
+    heap.push(4, 3.0);
+    heap.push(0, 1.0);
+
+    heap.decrease(4, 1.0);
+    heap.decrease(2, 1.0);
+
+    ASSERT_EQ(5U, heap.pop());
+    ASSERT_EQ(0U, heap.pop());
+    ASSERT_EQ(4U, heap.pop());
+    ASSERT_EQ(2U, heap.pop());
+}
+
+
+TEST(utest_indexed_heap, random_operations) {
+    const std::size_t capacity = 500;
+    indexed_heap heap(capacity);
+
+    /* reference is ordered by key and then by number of the operation like the heap */
+    std::set<std::tuple<double, std::size_t, std::size_t>> reference;
+    std::vector<std::pair<double, std::size_t>> state(capacity, { 0.0, 0 });
+    std::vector<char> contained(capacity, 0);
+    std::size_t sequence = 0;
+
+    std::mt19937 generator(1);
+    std::uniform_int_distribution<std::size_t> element_distribution(0, capacity - 1);
+    std::uniform_int_distribution<int> key_distribution(0, 50);
+    std::uniform_int_distribution<int> operation_distribution(0, 2);
+
+    for (std::size_t step = 0; step < 20000; step++) {
+        const std::size_t element = element_distribution(generator);
+        const int operation = operation_distribution(generator);
+
+        if ((operation == 0) && !reference.empty()) {
+            const auto expected = *reference.begin();
+            reference.erase(reference.begin());
+            contained[std::get<2>(expected)] = 0;
+
+            ASSERT_EQ(std::get<2>(expected), heap.pop());
+        }
+        else if (!contained[element]) {
+            const double key = static_cast<double>(key_distribution(generator));
+            heap.push(element, key);
+
+            state[element] = { key, sequence++ };
+            reference.emplace(key, state[element].second, element);
+            contained[element] = 1;
+        }
+        else {
+            const double key = static_cast<double>(key_distribution(generator)) * state[element].first / 50.0;
+            heap.decrease(element, key);
+
+            reference.erase(std::make_tuple(state[element].first, state[element].second, element));
+            state[element] = { key, sequence++ };
+            reference.emplace(key, state[element].second, element);
+        }
+
+        ASSERT_EQ(reference.size(), heap.size());
+        ASSERT_EQ(contained[element] != 0, heap.contains(element));
+    }
+}
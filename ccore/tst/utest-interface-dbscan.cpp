@@ -22,8 +22,90 @@ using namespace pyclustering;
 TEST(utest_interface_dbscan, dbscan_algorithm) {
     std::shared_ptr<pyclustering_package> sample = pack(dataset({ { 1.0, 1.0 }, { 1.1, 1.0 }, { 1.2, 1.4 }, { 10.0, 10.3 }, { 10.1, 10.2 }, { 10.2, 10.4 } }));
 
-    pyclustering_package * result = dbscan_algorithm(sample.get(), 4, 2, 0);
+    pyclustering_package * result = dbscan_algorithm(sample.get(), 4, 2, 0, 0);
     ASSERT_EQ(3U, result->size); /* allocated clustes + noise */
 
     delete result;
-}
\ No newline at end of file
+}
+
+TEST(utest_interface_dbscan, dbscan_algorithm_grid) {
+    std::shared_ptr<pyclustering_package> sample = pack(dataset({ { 1.0, 1.0 }, { 1.1, 1.0 }, { 1.2, 1.4 }, { 10.0, 10.3 }, { 10.1, 10.2 }, { 10.2, 10.4 }, { 20.0, 20.0 } }));
+
+    pyclustering_package * result = dbscan_algorithm(sample.get(), 1.0, 2, 0, 1);
+    ASSERT_EQ(3U, result->size); /* allocated clustes + noise */
+    ASSERT_EQ(1U, ((pyclustering_package **) result->data)[2]->size);
+
+    delete result;
+}
+
+TEST(utest_interface_dbscan, dbscan_algorithm_parallel) {
+    std::shared_ptr<pyclustering_package> sample = pack(dataset({ { 1.0, 1.0 }, { 1.1, 1.0 }, { 1.2, 1.4 }, { 10.0, 10.3 }, { 10.1, 10.2 }, { 10.2, 10.4 }, { 20.0, 20.0 } }));
+
+    pyclustering_package * result = dbscan_algorithm(sample.get(), 1.0, 2, 0, 2);
+    ASSERT_EQ(3U, result->size); /* allocated clustes + noise */
+    ASSERT_EQ(1U, ((pyclustering_package **) result->data)[2]->size);
+
+    delete result;
+}
+
+TEST(utest_interface_dbscan, dbscan_algorithm_unknown_engine) {
+    std::shared_ptr<pyclustering_package> sample = pack(dataset({ { 1.0, 1.0 }, { 1.1, 1.0 }, { 1.2, 1.4 } }));
+
+    pyclustering_package * error = dbscan_algorithm(sample.get(), 1.0, 2, 0, 3);
+    ASSERT_EQ(PYCLUSTERING_TYPE_CHAR, error->type);
+
+    delete error;
+}
+
+TEST(utest_interface_dbscan, dbscan_incremental) {
+    void * solver = dbscan_incremental_create(1.0, 2);
+
+    std::shared_ptr<pyclustering_package> sample = pack(dataset({ { 1.0, 1.0 }, { 1.1, 1.0 }, { 1.2, 1.4 }, { 10.0, 10.3 }, { 10.1, 10.2 }, { 10.2, 10.4 }, { 20.0, 20.0 } }));
+    pyclustering_package * indexes = dbscan_incremental_insert(solver, sample.get());
+    ASSERT_EQ(7U, indexes->size);
+    ASSERT_EQ(6U, indexes->at<std::size_t>(6));
+
+    pyclustering_package * result = dbscan_incremental_get_clusters(solver);
+    ASSERT_EQ(3U, result->size); /* allocated clustes + noise */
+    ASSERT_EQ(1U, ((pyclustering_package **) result->data)[2]->size);
+    delete result;
+
+    std::shared_ptr<pyclustering_package> removed = pack(std::vector<std::size_t>({ 0, 1 }));
+    ASSERT_EQ(nullptr, dbscan_incremental_remove(solver, removed.get()));
+
+    result = dbscan_incremental_get_clusters(solver);
+    ASSERT_EQ(2U, result->size);
+    ASSERT_EQ(2U, ((pyclustering_package **) result->data)[1]->size);   /* the remaining point of the first cluster is noise */
+    delete result;
+
+    delete indexes;
+    dbscan_incremental_destroy(solver);
+}
+
+TEST(utest_interface_dbscan, dbscan_incremental_incorrect_arguments) {
+    void * solver = dbscan_incremental_create(1.0, 2);
+
+    std::shared_ptr<pyclustering_package> sample = pack(dataset({ { 1.0, 1.0 }, { 1.1, 1.0 }, { 1.2, 1.4 } }));
+    pyclustering_package * indexes = dbscan_incremental_insert(solver, sample.get());
+    ASSERT_EQ(PYCLUSTERING_TYPE_SIZE_T, indexes->type);
+    delete indexes;
+
+    std::shared_ptr<pyclustering_package> incorrect_sample = pack(dataset({ { 2.0, 2.0, 2.0 } }));
+    pyclustering_package * error = dbscan_incremental_insert(solver, incorrect_sample.get());
+    ASSERT_EQ(PYCLUSTERING_TYPE_CHAR, error->type);
+    delete error;
+
+    /* the first index exists, but nothing is removed because of the second one */
+    std::shared_ptr<pyclustering_package> removed = pack(std::vector<std::size_t>({ 0, 10 }));
+    error = dbscan_incremental_remove(solver, removed.get());
+    ASSERT_NE(nullptr, error);
+    ASSERT_EQ(PYCLUSTERING_TYPE_CHAR, error->type);
+    delete error;
+
+    pyclustering_package * result = dbscan_incremental_get_clusters(solver);
+    ASSERT_EQ(2U, result->size);
+    ASSERT_EQ(3U, ((pyclustering_package **) result->data)[0]->size);
+    delete result;
+
+    dbscan_incremental_destroy(solver);
+}
@@ -0,0 +1,48 @@
+/*!
+
+@authors Andrei Novikov (pyclustering@yandex.ru)
+@date 2014-2020
+@copyright BSD-3-Clause
+
+*/
+
+#include <gtest/gtest.h>
+
+#include <pyclustering/interface/hdbscan_interface.h>
+#include <pyclustering/interface/pyclustering_package.hpp>
+
+#include "utenv_utils.hpp"
+
+#include <limits>
+#include <memory>
+
+
+using namespace pyclustering;
+
+
+TEST(utest_interface_hdbscan, hdbscan_algorithm) {
+    std::shared_ptr<pyclustering_package> sample = pack(dataset({ { 1.0, 1.0 }, { 1.1, 1.0 }, { 1.2, 1.4 }, { 10.0, 10.3 }, { 10.1, 10.2 }, { 10.2, 10.4 }, { 30.0, 30.0 } }));
+
+    pyclustering_package * result = hdbscan_algorithm(sample.get(), 1, 3);
+    ASSERT_EQ(3U, result->size); /* allocated clustes + noise */
+    ASSERT_EQ(3U, ((pyclustering_package **) result->data)[0]->size);
+    ASSERT_EQ(1U, ((pyclustering_package **) result->data)[2]->size);
+
+    delete result;
+}
+
+TEST(utest_interface_hdbscan, hdbscan_algorithm_incorrect_arguments) {
+    std::shared_ptr<pyclustering_package> sample = pack(dataset({ { 1.0, 1.0 }, { 1.1, 1.0 }, { 1.2, 1.4 } }));
+
+    pyclustering_package * result = hdbscan_algorithm(sample.get(), 1, 1);
+    ASSERT_EQ(PYCLUSTERING_TYPE_CHAR, result->type);
+
+    delete result;
+
+    std::shared_ptr<pyclustering_package> infinite_sample = pack(dataset({ { 1.0, 1.0 }, { 1.1, std::numeric_limits<double>::infinity() }, { 1.2, 1.4 } }));
+
+    result = hdbscan_algorithm(infinite_sample.get(), 1, 2);
+    ASSERT_EQ(PYCLUSTERING_TYPE_CHAR, result->type);
+
+    delete result;
+}
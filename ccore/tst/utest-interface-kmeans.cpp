@@ -9,6 +9,7 @@
 #include <gtest/gtest.h>
 
 #include <pyclustering/interface/kmeans_interface.h>
+#include <pyclustering/cluster/kmeans.hpp>
 #include <pyclustering/interface/pyclustering_package.hpp>
 
 #include <pyclustering/utils/metric.hpp>
@@ -16,6 +17,7 @@
 #include "utenv_utils.hpp"
 
 #include <memory>
+#include <vector>
 
 
 using namespace pyclustering;
@@ -28,14 +30,47 @@ TEST(utest_interface_kmeans, kmeans_api) {
 
     distance_metric<point> metric = distance_metric_factory<point>::euclidean_square();
 
-    pyclustering_package * kmeans_result = kmeans_algorithm(sample.get(), centers.get(), 0.001, 200, false, &metric);
+    pyclustering_package * kmeans_result = kmeans_algorithm(sample.get(), centers.get(), 0.001, 200, false, &metric, 0);
     ASSERT_NE(nullptr, kmeans_result);
 
     delete kmeans_result;
     kmeans_result = nullptr;
 
-    kmeans_result = kmeans_algorithm(sample.get(), centers.get(), 0.1, 100, true, &metric);
+    kmeans_result = kmeans_algorithm(sample.get(), centers.get(), 0.1, 100, true, &metric, 0);
     ASSERT_NE(nullptr, kmeans_result);
 
     delete kmeans_result;
-}
\ No newline at end of file
+}
+
+
+TEST(utest_interface_kmeans, kmeans_api_matrix) {
+    const std::vector<double> buffer = { 1, 2, 3, 10, 11, 12 };
+    std::shared_ptr<pyclustering_package> sample(create_package_matrix(buffer.data(), buffer.size(), 1));
+    std::shared_ptr<pyclustering_package> centers = pack(dataset({ { 1 }, { 10 } }));
+
+    distance_metric<point> metric = distance_metric_factory<point>::euclidean_square();
+
+    std::shared_ptr<pyclustering_package> kmeans_result(kmeans_algorithm(sample.get(), centers.get(), 0.001, 200, false, &metric, 0));
+    ASSERT_NE(nullptr, kmeans_result);
+
+    std::vector<std::vector<std::size_t>> clusters;
+    ((pyclustering_package **) kmeans_result->data)[KMEANS_PACKAGE_INDEX_CLUSTERS]->extract(clusters);
+    ASSERT_EQ(std::vector<std::vector<std::size_t>>({ { 0, 1, 2 }, { 3, 4, 5 } }), clusters);
+}
+
+
+TEST(utest_interface_kmeans, kmeans_api_accelerated) {
+    std::shared_ptr<pyclustering_package> sample = pack(dataset({ { 1 }, { 2 }, { 3 }, { 10 }, { 11 }, { 12 } }));
+    std::shared_ptr<pyclustering_package> centers = pack(dataset({ { 1 }, { 10 } }));
+
+    distance_metric<point> metric = distance_metric_factory<point>::euclidean_square();
+
+    for (const auto acceleration : { pyclustering::clst::kmeans_acceleration::AUTO, pyclustering::clst::kmeans_acceleration::HAMERLY, pyclustering::clst::kmeans_acceleration::ELKAN }) {
+        std::shared_ptr<pyclustering_package> kmeans_result(kmeans_algorithm(sample.get(), centers.get(), 0.001, 200, true, &metric, static_cast<unsigned int>(acceleration)));
+        ASSERT_NE(nullptr, kmeans_result);
+
+        std::vector<std::vector<std::size_t>> clusters;
+        ((pyclustering_package **) kmeans_result->data)[KMEANS_PACKAGE_INDEX_CLUSTERS]->extract(clusters);
+        ASSERT_EQ(std::vector<std::vector<std::size_t>>({ { 0, 1, 2 }, { 3, 4, 5 } }), clusters);
+    }
+}
@@ -12,8 +12,11 @@
 
 #include <pyclustering/utils/metric.hpp>
 
+#include <pyclustering/container/dense_dataset.hpp>
+
 #include "utenv_utils.hpp"
 
+#include <cmath>
 #include <memory>
 
 
@@ -39,6 +42,34 @@ TEST(utest_interface_metric, euclidean) {
     metric_destroy(metric_pointer);
 }
 
+static double user_manhattan(const void * p_point1, const void * p_point2) {
+    point point1, point2;
+    ((const pyclustering_package *) p_point1)->extract(point1);
+    ((const pyclustering_package *) p_point2)->extract(point2);
+
+    return std::abs(point1[0] - point2[0]) + std::abs(point1[1] - point2[1]);
+}
+
+TEST(utest_interface_metric, user_defined) {
+    std::shared_ptr<pyclustering_package> arguments = pack(std::vector<double>());
+
+    void * metric_pointer = metric_create(metric_t::USER_DEFINED, arguments.get(), user_manhattan);
+
+    ASSERT_NE(nullptr, metric_pointer);
+
+    std::shared_ptr<pyclustering_package> point1 = pack(point({1.0, 1.0}));
+    std::shared_ptr<pyclustering_package> point2 = pack(point({2.0, 3.0}));
+
+    ASSERT_EQ(3.0, metric_calculate(metric_pointer, point1.get(), point2.get()));
+
+    /* views of points are passed to the user function without conversion to points */
+    const distance_metric<point> & metric = *((distance_metric<point> *) metric_pointer);
+    const container::dense_dataset points(dataset({ {1.0, 1.0}, {2.0, 3.0} }));
+    ASSERT_EQ(3.0, metric(points[0], points[1]));
+
+    metric_destroy(metric_pointer);
+}
+
 TEST(utest_interface_metric, gower) {
     std::shared_ptr<pyclustering_package> arguments = pack(std::vector<double>({1.0, 0.0}));
     double (*p_solver)(const void *, const void *) = nullptr;
@@ -26,4 +26,50 @@ TEST(utest_interface_optics, optics_algorithm) {
     ASSERT_EQ((std::size_t) OPTICS_PACKAGE_SIZE, result->size);
 
     delete result;
-}
\ No newline at end of file
+}
+
+TEST(utest_interface_optics, optics_xi_extract) {
+    std::shared_ptr<pyclustering_package> sample = pack(dataset({ { 1.0, 1.0 }, { 1.1, 1.0 }, { 1.2, 1.4 }, { 10.0, 10.3 }, { 10.1, 10.2 }, { 10.2, 10.4 } }));
+
+    pyclustering_package * optics_result = optics_algorithm(sample.get(), 20, 2, 0, 0);
+
+    pyclustering_package * object_ordering = ((pyclustering_package **) optics_result->data)[OPTICS_PACKAGE_INDEX_OBJECT_ORDERING];
+    pyclustering_package * reachability = ((pyclustering_package **) optics_result->data)[OPTICS_PACKAGE_INDEX_OPTICS_OBJECTS_REACHABILITY_DISTANCE];
+    ASSERT_EQ(6U, object_ordering->size);
+
+    pyclustering_package * result = optics_xi_extract(object_ordering, reachability, 0.1, 2, 2);
+    ASSERT_EQ((std::size_t) OPTICS_XI_PACKAGE_SIZE, result->size);
+
+    std::vector<std::vector<std::size_t>> clusters;
+    ((pyclustering_package **) result->data)[OPTICS_XI_PACKAGE_INDEX_CLUSTERS]->extract(clusters);
+
+    std::vector<std::size_t> hierarchy;
+    ((pyclustering_package **) result->data)[OPTICS_XI_PACKAGE_INDEX_HIERARCHY]->extract(hierarchy);
+
+    ASSERT_EQ(3U, clusters.size());
+    ASSERT_EQ(clusters.size(), hierarchy.size());
+
+    delete result;
+    delete optics_result;
+}
+
+TEST(utest_interface_optics, optics_xi_extract_incorrect_arguments) {
+    std::shared_ptr<pyclustering_package> object_ordering = pack(std::vector<std::size_t>({ 0, 1, 2 }));
+    std::shared_ptr<pyclustering_package> reachability = pack(std::vector<double>({ -1.0, 0.5, 0.5 }));
+    std::shared_ptr<pyclustering_package> short_reachability = pack(std::vector<double>({ -1.0, 0.5 }));
+    std::shared_ptr<pyclustering_package> incorrect_ordering = pack(std::vector<std::size_t>({ 0, 1, 3 }));
+
+    for (const double xi : { 0.0, 1.0 }) {
+        pyclustering_package * result = optics_xi_extract(object_ordering.get(), reachability.get(), xi, 2, 2);
+        ASSERT_EQ(PYCLUSTERING_TYPE_CHAR, result->type);
+        delete result;
+    }
+
+    pyclustering_package * result = optics_xi_extract(object_ordering.get(), short_reachability.get(), 0.1, 2, 2);
+    ASSERT_EQ(PYCLUSTERING_TYPE_CHAR, result->type);
+    delete result;
+
+    result = optics_xi_extract(incorrect_ordering.get(), reachability.get(), 0.1, 2, 2);
+    ASSERT_EQ(PYCLUSTERING_TYPE_CHAR, result->type);
+    delete result;
+}
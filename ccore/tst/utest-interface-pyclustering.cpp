@@ -9,10 +9,14 @@
 
 #include <gtest/gtest.h>
 
+#include <pyclustering/interface/pyclustering_interface.h>
 #include <pyclustering/interface/pyclustering_package.hpp>
 
+#include <pyclustering/parallel/concurrency.hpp>
+
 #include <cstring>
 #include <memory>
+#include <stdexcept>
 #include <vector>
 
 
@@ -241,4 +245,102 @@ TEST(utest_pyclustering, package_unpack_empty) {
 
 TEST(utest_pyclustering, package_unpack_two_dimension) {
     template_pack_unpack(std::vector<std::vector<double>>({ { 1.2, 2.4 }, { 3.6, 4.8, 5.0 }, { 6.0 } }));
-}
\ No newline at end of file
+}
+
+
+TEST(utest_pyclustering, package_matrix) {
+    const std::vector<double> buffer = { 1.0, 2.0, 3.0, 4.0, 5.0, 6.0 };
+
+    pyclustering_package * package = create_package_matrix(buffer.data(), 3, 2);
+    ASSERT_EQ(3U, package->size);
+    ASSERT_EQ(PYCLUSTERING_TYPE_DOUBLE_MATRIX, package->type);
+
+    for (std::size_t i = 0; i < 3; i++) {
+        for (std::size_t j = 0; j < 2; j++) {
+            ASSERT_EQ(buffer[i * 2 + j], package->at<double>(i, j));
+            ASSERT_EQ(static_cast<std::size_t>(buffer[i * 2 + j]), package->at<std::size_t>(i, j));
+            ASSERT_EQ(static_cast<float>(buffer[i * 2 + j]), package->at<float>(i, j));
+        }
+    }
+
+    std::vector<std::vector<double>> unpack_container;
+    package->extract(unpack_container);
+    ASSERT_EQ(std::vector<std::vector<double>>({ { 1.0, 2.0 }, { 3.0, 4.0 }, { 5.0, 6.0 } }), unpack_container);
+
+    delete package;
+}
+
+
+TEST(utest_pyclustering, package_matrix_view_zero_copy) {
+    const std::vector<double> buffer = { 1.0, 2.0, -1.0, 3.0, 4.0, -1.0 };
+
+    pyclustering_package * package = create_package_matrix(buffer.data(), 2, 2, 3);
+
+    pyclustering::container::dense_dataset storage;
+    const pyclustering::container::dense_dataset_view view = package->view(storage);
+
+    ASSERT_EQ(buffer.data(), view.data());
+    ASSERT_TRUE(storage.empty());
+    ASSERT_EQ(3U, view.stride());
+    ASSERT_EQ(pyclustering::dataset({ { 1.0, 2.0 }, { 3.0, 4.0 } }), view.to_dataset());
+
+    delete package;
+}
+
+
+TEST(utest_pyclustering, package_list_view) {
+    const std::vector<std::vector<double>> container = { { 1.0, 2.0 }, { 3.0, 4.0 }, { 5.0, 6.0 } };
+    pyclustering_package * package = create_package(&container);
+
+    pyclustering::container::dense_dataset storage;
+    const pyclustering::container::dense_dataset_view view = package->view(storage);
+
+    ASSERT_EQ(storage.data(), view.data());
+    ASSERT_EQ(container, view.to_dataset());
+
+    delete package;
+}
+
+
+TEST(utest_pyclustering, package_list_view_different_dimensions) {
+    const std::vector<std::vector<double>> container = { { 1.0, 2.0 }, { 3.0 } };
+    pyclustering_package * package = create_package(&container);
+
+    pyclustering::container::dense_dataset storage;
+    ASSERT_THROW(package->view(storage), std::invalid_argument);
+
+    delete package;
+}
+
+
+TEST(utest_pyclustering, set_get_threads) {
+    pyclustering_set_threads(3);
+    ASSERT_EQ(3U, pyclustering_get_threads());
+
+    pyclustering_set_threads(1);
+    ASSERT_EQ(1U, pyclustering_get_threads());
+
+    pyclustering_set_threads(0);
+    ASSERT_EQ(pyclustering::parallel::get_available_processors(), pyclustering_get_threads());
+    ASSERT_GE(pyclustering_get_threads(), 1U);
+}
+
+
+TEST(utest_pyclustering, reset_affinity) {
+#if defined(__linux__)
+    ASSERT_TRUE(pyclustering_set_affinity(0));
+#endif
+    ASSERT_EQ(0U, pyclustering::parallel::get_affinity());
+}
+
+
+TEST(utest_pyclustering, set_affinity_first_processor) {
+#if defined(__linux__)
+    ASSERT_TRUE(pyclustering_set_affinity(1));
+    ASSERT_EQ(1U, pyclustering::parallel::get_affinity());
+    ASSERT_EQ(1U, pyclustering_get_threads());
+
+    ASSERT_TRUE(pyclustering_set_affinity(0));
+    ASSERT_EQ(pyclustering::parallel::get_available_processors(), pyclustering_get_threads());
+#endif
+}
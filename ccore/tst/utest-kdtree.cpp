@@ -17,7 +17,11 @@
 #include <pyclustering/utils/metric.hpp>
 
 #include <algorithm>
+#include <cmath>
+#include <limits>
 #include <numeric>
+#include <random>
+#include <utility>
 
 
 using namespace pyclustering;
@@ -25,6 +29,40 @@ using namespace pyclustering::container;
 using namespace pyclustering::utils::metric;
 
 
+static void template_find_k_nearest(const dataset & p_data, const std::size_t p_k, const double p_max_radius) {
+    std::vector<void *> payload;
+    for (std::size_t i = 0; i < p_data.size(); i++) {
+        payload.push_back((void *)i);
+    }
+
+    const kdtree_balanced tree(p_data, payload);
+
+    for (const auto & search_point : p_data) {
+        std::vector<std::pair<double, std::size_t>> expected;
+        for (std::size_t i = 0; i < p_data.size(); i++) {
+            const double distance = euclidean_distance_square(search_point, p_data[i]);
+            if (distance <= p_max_radius * p_max_radius) {
+                expected.emplace_back(distance, i);
+            }
+        }
+
+        std::sort(expected.begin(), expected.end());
+        expected.resize(std::min(expected.size(), p_k));
+
+        std::vector<std::size_t> indexes;
+        std::vector<double> distances;
+        kdtree_searcher(search_point, tree.get_root(), 0.0).find_k_nearest(p_k, p_max_radius, indexes, distances);
+
+        ASSERT_EQ(expected.size(), indexes.size());
+        ASSERT_EQ(expected.size(), distances.size());
+        for (std::size_t i = 0; i < expected.size(); i++) {
+            ASSERT_EQ(expected[i].first, distances[i]);
+            ASSERT_EQ(expected[i].second, indexes[i]);
+        }
+    }
+}
+
+
 class utest_kdtree : public ::testing::Test {
 protected:
     virtual void SetUp() { }
@@ -587,3 +625,289 @@ TEST_F(utest_kdtree, balanced_tree_find_simple_12) {
     auto data = simple_sample_factory::create_sample(SAMPLE_SIMPLE::SAMPLE_SIMPLE_12);
     TemplateTestBalancedFind(*data);
 }
+
+
+TEST_F(utest_kdtree, balanced_tree_find_large_with_duplicates) {
+    std::mt19937 generator(11);
+    std::uniform_int_distribution<int> distribution(0, 50);
+
+    dataset data(20000, point(3));
+    for (auto & current_point : data) {
+        for (auto & coordinate : current_point) {
+            coordinate = static_cast<double>(distribution(generator));
+        }
+    }
+
+    TemplateTestBalancedFind(data);
+}
+
+
+static std::size_t get_height(const kdnode::ptr & p_node) {
+    if (p_node == nullptr) {
+        return 0;
+    }
+
+    return 1 + std::max(get_height(p_node->get_left()), get_height(p_node->get_right()));
+}
+
+
+static std::vector<std::size_t> find_payloads(const kdtree & p_tree, const point & p_point, const double p_radius) {
+    std::vector<std::size_t> payloads;
+    kdtree_searcher(p_point, p_tree.get_root(), p_radius).find_nearest([&payloads](const kdnode::ptr & p_node, const double) {
+        payloads.push_back((std::size_t) p_node->get_payload());
+    });
+
+    std::sort(payloads.begin(), payloads.end());
+    return payloads;
+}
+
+
+TEST_F(utest_kdtree, insert_sorted_points_balanced) {
+    const std::size_t amount_points = 5000;
+    for (std::size_t i = 0; i < amount_points; i++) {
+        const double coordinate = static_cast<double>(i);
+        tree.insert({ coordinate, coordinate }, (void *) i);
+    }
+
+    ASSERT_EQ(amount_points, tree.get_size());
+
+    const double maximum_height = std::log(static_cast<double>(amount_points)) / std::log(1.0 / kdtree::REBALANCE_FACTOR) + 1.0;
+    ASSERT_LE(static_cast<double>(get_height(tree.get_root())), maximum_height);
+
+    for (std::size_t i = 0; i < amount_points; i++) {
+        const double coordinate = static_cast<double>(i);
+        ASSERT_EQ(std::vector<std::size_t>({ i }), find_payloads(tree, { coordinate, coordinate }, 0.5));
+    }
+}
+
+
+TEST_F(utest_kdtree, bulk_insert_remove) {
+    std::mt19937 generator(3);
+    std::uniform_real_distribution<double> distribution(-10.0, 10.0);
+
+    dataset data(3000, point(2));
+    for (auto & current_point : data) {
+        for (auto & coordinate : current_point) {
+            coordinate = distribution(generator);
+        }
+    }
+
+    std::vector<kdnode::ptr> nodes;
+    for (std::size_t begin = 0; begin < data.size(); begin += 250) {
+        const dataset batch(data.begin() + begin, data.begin() + begin + 250);
+
+        std::vector<void *> payloads(batch.size());
+        for (std::size_t i = 0; i < batch.size(); i++) {
+            payloads[i] = (void *) (begin + i);
+        }
+
+        const auto batch_nodes = tree.insert(batch, payloads);
+        ASSERT_EQ(batch.size(), batch_nodes.size());
+        ASSERT_EQ(begin + batch.size(), tree.get_size());
+
+        nodes.insert(nodes.end(), batch_nodes.begin(), batch_nodes.end());
+    }
+
+    /* every point is removed except each third, removed points are not found anymore */
+    std::vector<kdnode::ptr> removed_nodes;
+    std::vector<bool> removed(data.size(), false);
+    for (std::size_t i = 0; i < data.size(); i++) {
+        if (i % 3 != 0) {
+            removed_nodes.push_back(nodes[i]);
+            removed[i] = true;
+        }
+    }
+
+    tree.remove(removed_nodes);
+    ASSERT_EQ(data.size() - removed_nodes.size(), tree.get_size());
+
+    for (std::size_t index_query = 0; index_query < data.size(); index_query += 7) {
+        std::vector<std::size_t> expected;
+        for (std::size_t i = 0; i < data.size(); i++) {
+            if (!removed[i] && (euclidean_distance_square(data[index_query], data[i]) <= 1.5 * 1.5)) {
+                expected.push_back(i);
+            }
+        }
+
+        ASSERT_EQ(expected, find_payloads(tree, data[index_query], 1.5));
+
+        kdnode::ptr node = tree.find_node(data[index_query], (void *) index_query);
+        ASSERT_EQ(removed[index_query] ? nullptr : nodes[index_query], node);
+    }
+}
+
+
+TEST_F(utest_kdtree, remove_internal_nodes_rebuild) {
+    dataset data;
+    for (std::size_t i = 0; i < 32; i++) {
+        for (std::size_t j = 0; j < 32; j++) {
+            data.push_back({ static_cast<double>(i), static_cast<double>(j) });
+        }
+    }
+
+    std::vector<void *> payloads(data.size());
+    for (std::size_t i = 0; i < data.size(); i++) {
+        payloads[i] = (void *) i;
+    }
+
+    tree = kdtree(data, payloads);
+    const std::size_t initial_height = get_height(tree.get_root());
+
+    /* removed nodes in the middle of the tree are kept as tombstones until they prevail */
+    for (std::size_t i = 0; i < data.size(); i++) {
+        if (i % 4 != 0) {
+            tree.remove(data[i], payloads[i]);
+            ASSERT_EQ(nullptr, tree.find_node(data[i], payloads[i]));
+        }
+    }
+
+    ASSERT_EQ(data.size() / 4, tree.get_size());
+    ASSERT_LE(get_height(tree.get_root()), initial_height);
+
+    for (std::size_t i = 0; i < data.size(); i += 4) {
+        ASSERT_EQ(std::vector<std::size_t>({ i }), find_payloads(tree, data[i], 0.5));
+    }
+
+    std::vector<std::size_t> expected;
+    for (std::size_t i = 0; i < data.size(); i += 4) {
+        expected.push_back(i);
+    }
+
+    ASSERT_EQ(expected, find_payloads(tree, { 16.0, 16.0 }, 100.0));
+}
+
+
+TEST(utest_kdtree_searcher, find_k_nearest_simple_01) {
+    auto data = simple_sample_factory::create_sample(SAMPLE_SIMPLE::SAMPLE_SIMPLE_01);
+    template_find_k_nearest(*data, 1, 10.0);
+    template_find_k_nearest(*data, 3, 10.0);
+    template_find_k_nearest(*data, 3, 0.5);
+    template_find_k_nearest(*data, 20, 100.0);
+}
+
+
+TEST(utest_kdtree_searcher, find_k_nearest_fcps_lsun) {
+    auto data = fcps_sample_factory::create_sample(FCPS_SAMPLE::LSUN);
+    template_find_k_nearest(*data, 5, std::numeric_limits<double>::max());
+    template_find_k_nearest(*data, 10, 0.2);
+}
+
+
+TEST(utest_kdtree_searcher, find_k_nearest_duplicates) {
+    std::mt19937 generator(3);
+    std::uniform_int_distribution<int> distribution(0, 4);
+
+    dataset data(300, point(2));
+    for (auto & current_point : data) {
+        for (auto & coordinate : current_point) {
+            coordinate = static_cast<double>(distribution(generator));
+        }
+    }
+
+    template_find_k_nearest(data, 7, 1.0);
+    template_find_k_nearest(data, 30, 2.0);
+}
+
+
+TEST(utest_kdtree_searcher, find_k_nearest_empty) {
+    std::vector<std::size_t> indexes = { 1 };
+    std::vector<double> distances = { 1.0 };
+
+    kdtree_searcher({ 0.0 }, nullptr, 1.0).find_k_nearest(3, 1.0, indexes, distances);
+    ASSERT_TRUE(indexes.empty());
+    ASSERT_TRUE(distances.empty());
+
+    const kdtree_balanced tree(dataset({ { 1.0 }, { 2.0 } }));
+    kdtree_searcher({ 0.0 }, tree.get_root(), 1.0).find_k_nearest(0, 1.0, indexes, distances);
+    ASSERT_TRUE(indexes.empty());
+}
+
+
+TEST(utest_kdtree_searcher, find_nearest_deep_tree) {
+    kdtree tree;
+
+    dataset data;
+    for (std::size_t i = 0; i < 10000; i++) {
+        data.push_back({ static_cast<double>(i) * 0.5, 1.0 });
+        tree.insert(data.back(), (void *) i);     /* sorted insertion creates a tree whose depth is equal to amount of points */
+    }
+
+    kdtree_searcher searcher;
+    std::vector<double> distances;
+    std::vector<kdnode::ptr> nodes;
+
+    for (const std::size_t index_query : { std::size_t(0), std::size_t(7777), std::size_t(9999) }) {
+        searcher.initialize(data[index_query], tree.get_root(), 1.0);
+        searcher.find_nearest_nodes(distances, nodes);
+
+        std::vector<std::size_t> actual_indexes;
+        for (const auto & node : nodes) {
+            actual_indexes.push_back((std::size_t) node->get_payload());
+        }
+
+        std::vector<std::size_t> expected_indexes;
+        for (std::size_t i = 0; i < data.size(); i++) {
+            if (euclidean_distance_square(data[index_query], data[i]) <= 1.0) {
+                expected_indexes.push_back(i);
+            }
+        }
+
+        std::sort(actual_indexes.begin(), actual_indexes.end());
+        ASSERT_EQ(expected_indexes, actual_indexes);
+        ASSERT_EQ(index_query, (std::size_t) searcher.find_nearest_node()->get_payload());
+
+        std::vector<std::size_t> k_indexes;
+        std::vector<double> k_distances;
+        searcher.find_k_nearest(1, 1.0, k_indexes, k_distances);
+        ASSERT_EQ(std::vector<std::size_t>({ index_query }), k_indexes);
+    }
+}
+
+
+TEST(utest_kdtree_searcher, find_nearest_reused_searcher) {
+    std::mt19937 generator(23);
+    std::uniform_real_distribution<double> distribution(-5.0, 5.0);
+
+    dataset data(1000, point(3));
+    for (auto & current_point : data) {
+        for (auto & coordinate : current_point) {
+            coordinate = distribution(generator);
+        }
+    }
+
+    std::vector<void *> payload;
+    for (std::size_t i = 0; i < data.size(); i++) {
+        payload.push_back((void *) i);
+    }
+
+    const kdtree_balanced tree(data, payload);
+
+    kdtree_searcher searcher;
+    for (std::size_t index_query = 0; index_query < data.size(); index_query++) {
+        searcher.initialize(data[index_query], tree.get_root(), 1.5);
+
+        std::vector<std::size_t> actual_indexes;
+        searcher.find_nearest([&actual_indexes](const kdnode::ptr & p_node, const double) {
+            actual_indexes.push_back((std::size_t) p_node->get_payload());
+        });
+
+        std::vector<std::size_t> expected_indexes;
+        for (std::size_t i = 0; i < data.size(); i++) {
+            if (euclidean_distance_square(data[index_query], data[i]) <= 1.5 * 1.5) {
+                expected_indexes.push_back(i);
+            }
+        }
+
+        std::sort(actual_indexes.begin(), actual_indexes.end());
+        ASSERT_EQ(expected_indexes, actual_indexes);
+    }
+}
+
+
+TEST(utest_kdtree_searcher, find_nearest_node_out_of_radius) {
+    const kdtree_balanced tree(dataset({ { 1.0, 1.0 }, { 2.0, 2.0 } }));
+
+    ASSERT_EQ(nullptr, kdtree_searcher({ 5.0, 5.0 }, tree.get_root(), 1.0).find_nearest_node());
+    ASSERT_EQ(nullptr, kdtree_searcher({ 5.0, 5.0 }, nullptr, 1.0).find_nearest_node());
+    ASSERT_EQ(point({ 2.0, 2.0 }), kdtree_searcher({ 5.0, 5.0 }, tree.get_root(), 5.0).find_nearest_node()->get_data());
+}
@@ -0,0 +1,328 @@
+/*!
+
+@authors Andrei Novikov (pyclustering@yandex.ru)
+@date 2014-2020
+@copyright BSD-3-Clause
+
+*/
+
+
+#include <gtest/gtest.h>
+
+#include "samples.hpp"
+
+#include <pyclustering/container/kdtree_flat.hpp>
+
+#include <pyclustering/utils/metric.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <random>
+#include <stdexcept>
+#include <utility>
+
+
+using namespace pyclustering;
+using namespace pyclustering::container;
+using namespace pyclustering::utils::metric;
+
+
+static void template_find_nearest(const dataset & p_data, const double p_radius, const std::size_t p_leaf_size, const std::size_t p_query_step = 1) {
+    const kdtree_flat tree(p_data, p_leaf_size);
+    ASSERT_EQ(p_data.size(), tree.size());
+
+    for (std::size_t index_query = 0; index_query < p_data.size(); index_query += p_query_step) {
+        const point & search_point = p_data[index_query];
+
+        std::vector<std::size_t> expected_indexes;
+        for (std::size_t i = 0; i < p_data.size(); i++) {
+            if (euclidean_distance_square(search_point, p_data[i]) <= p_radius * p_radius) {
+                expected_indexes.push_back(i);
+            }
+        }
+
+        std::vector<std::size_t> actual_indexes;
+        std::vector<double> actual_distances;
+        tree.find_nearest(search_point, p_radius, actual_indexes, actual_distances);
+
+        ASSERT_EQ(actual_indexes.size(), actual_distances.size());
+        for (std::size_t i = 0; i < actual_indexes.size(); i++) {
+            ASSERT_EQ(euclidean_distance_square(search_point, p_data[actual_indexes[i]]), actual_distances[i]);
+        }
+
+        std::sort(actual_indexes.begin(), actual_indexes.end());
+        ASSERT_EQ(expected_indexes, actual_indexes);
+    }
+}
+
+
+static double square_distance(const point & p_point1, const point & p_point2) {
+    double result = 0.0;
+    for (std::size_t i = 0; i < p_point1.size(); i++) {
+        const double difference = p_point1[i] - p_point2[i];
+        result += difference * difference;
+    }
+
+    return result;
+}
+
+
+static void template_find_k_nearest(const dataset & p_data, const std::size_t p_k, const double p_max_radius, const std::size_t p_leaf_size) {
+    const kdtree_flat tree(p_data, p_leaf_size);
+
+    for (const auto & search_point : p_data) {
+        std::vector<std::pair<double, std::size_t>> expected;
+        for (std::size_t i = 0; i < p_data.size(); i++) {
+            const double distance = square_distance(search_point, p_data[i]);
+            if (distance <= p_max_radius * p_max_radius) {
+                expected.emplace_back(distance, i);
+            }
+        }
+
+        std::sort(expected.begin(), expected.end());
+        expected.resize(std::min(expected.size(), p_k));
+
+        std::vector<std::size_t> indexes;
+        std::vector<double> distances;
+        tree.find_k_nearest(search_point.data(), p_k, p_max_radius, indexes, distances);
+
+        ASSERT_EQ(expected.size(), indexes.size());
+        ASSERT_EQ(expected.size(), distances.size());
+        for (std::size_t i = 0; i < expected.size(); i++) {
+            ASSERT_EQ(expected[i].first, distances[i]);
+            ASSERT_EQ(expected[i].second, indexes[i]);
+        }
+    }
+}
+
+
+TEST(utest_kdtree_flat, find_nearest_simple_01) {
+    auto data = simple_sample_factory::create_sample(SAMPLE_SIMPLE::SAMPLE_SIMPLE_01);
+    template_find_nearest(*data, 0.7, 1);
+    template_find_nearest(*data, 0.7, 4);
+    template_find_nearest(*data, 10.0, 2);
+}
+
+TEST(utest_kdtree_flat, find_nearest_simple_03) {
+    auto data = simple_sample_factory::create_sample(SAMPLE_SIMPLE::SAMPLE_SIMPLE_03);
+    template_find_nearest(*data, 0.5, 1);
+    template_find_nearest(*data, 1.5, 3);
+}
+
+TEST(utest_kdtree_flat, find_nearest_fcps_lsun) {
+    auto data = fcps_sample_factory::create_sample(FCPS_SAMPLE::LSUN);
+    template_find_nearest(*data, 0.3, kdtree_flat::DEFAULT_LEAF_SIZE);
+}
+
+TEST(utest_kdtree_flat, find_nearest_random) {
+    std::mt19937 generator(5);
+    std::uniform_real_distribution<double> distribution(-10.0, 10.0);
+
+    dataset data(500, point(3));
+    for (auto & current_point : data) {
+        for (auto & coordinate : current_point) {
+            coordinate = distribution(generator);
+        }
+    }
+
+    template_find_nearest(data, 2.0, 1);
+    template_find_nearest(data, 2.0, 7);
+}
+
+TEST(utest_kdtree_flat, find_nearest_large_with_duplicates) {
+    std::mt19937 generator(11);
+    std::uniform_int_distribution<int> distribution(0, 50);
+
+    dataset data(30000, point(3));
+    for (auto & current_point : data) {
+        for (auto & coordinate : current_point) {
+            coordinate = static_cast<double>(distribution(generator));
+        }
+    }
+
+    template_find_nearest(data, 3.0, kdtree_flat::DEFAULT_LEAF_SIZE, 97);
+    template_find_nearest(data, 3.0, 1, 97);
+}
+
+TEST(utest_kdtree_flat, find_nearest_same_points) {
+    const dataset data(100, { 1.0, 2.0 });
+    template_find_nearest(data, 0.0, 4);
+    template_find_nearest(data, 1.0, 4);
+}
+
+TEST(utest_kdtree_flat, find_nearest_dense_dataset) {
+    auto data = simple_sample_factory::create_sample(SAMPLE_SIMPLE::SAMPLE_SIMPLE_02);
+    const dense_dataset dense(*data);
+    const kdtree_flat tree(dense, 2);
+
+    std::size_t amount = 0;
+    tree.find_nearest(dense.row(0), 100.0, [&amount](const std::size_t, const double) { amount++; });
+    ASSERT_EQ(data->size(), amount);
+    ASSERT_EQ(data->front().size(), tree.dimension());
+}
+
+TEST(utest_kdtree_flat, find_k_nearest_simple_01) {
+    auto data = simple_sample_factory::create_sample(SAMPLE_SIMPLE::SAMPLE_SIMPLE_01);
+    template_find_k_nearest(*data, 1, 10.0, 1);
+    template_find_k_nearest(*data, 3, 10.0, 2);
+    template_find_k_nearest(*data, 3, 0.5, 4);
+    template_find_k_nearest(*data, 20, 100.0, 1);
+}
+
+TEST(utest_kdtree_flat, find_k_nearest_fcps_lsun) {
+    auto data = fcps_sample_factory::create_sample(FCPS_SAMPLE::LSUN);
+    template_find_k_nearest(*data, 5, std::numeric_limits<double>::max(), kdtree_flat::DEFAULT_LEAF_SIZE);
+    template_find_k_nearest(*data, 10, 0.2, 1);
+}
+
+TEST(utest_kdtree_flat, find_k_nearest_duplicates) {
+    std::mt19937 generator(3);
+    std::uniform_int_distribution<int> distribution(0, 4);
+
+    dataset data(300, point(2));
+    for (auto & current_point : data) {
+        for (auto & coordinate : current_point) {
+            coordinate = static_cast<double>(distribution(generator));
+        }
+    }
+
+    template_find_k_nearest(data, 7, 1.0, 1);
+    template_find_k_nearest(data, 30, 2.0, 8);
+}
+
+static void template_find_nearest_batch(const dataset & p_data, const std::vector<std::size_t> & p_queries, const double p_radius) {
+    const kdtree_flat tree(p_data, 4);
+
+    neighbor_graph graph;
+    tree.find_nearest(p_queries, p_radius, graph);
+
+    ASSERT_EQ(p_queries.size(), graph.size());
+    ASSERT_EQ(p_queries.size() + 1, graph.offsets().size());
+    ASSERT_EQ(graph.offsets().back(), graph.neighbors().size());
+    ASSERT_EQ(graph.offsets().back(), graph.distances().size());
+    ASSERT_TRUE(graph.has_distances());
+
+    for (std::size_t i = 0; i < p_queries.size(); i++) {
+        std::vector<std::size_t> expected_indexes;
+        std::vector<double> expected_distances;
+        tree.find_nearest(p_data[p_queries[i]], p_radius, expected_indexes, expected_distances);
+
+        ASSERT_EQ(expected_indexes.size(), graph.amount_neighbors(i));
+        for (std::size_t j = 0; j < expected_indexes.size(); j++) {
+            ASSERT_EQ(expected_indexes[j], graph.neighbors(i)[j]);
+            ASSERT_EQ(std::sqrt(expected_distances[j]), graph.distances(i)[j]);
+        }
+    }
+}
+
+
+TEST(utest_kdtree_flat, find_nearest_batch_simple_01) {
+    auto data = simple_sample_factory::create_sample(SAMPLE_SIMPLE::SAMPLE_SIMPLE_01);
+    template_find_nearest_batch(*data, { 0, 9, 5, 5 }, 0.7);
+    template_find_nearest_batch(*data, { }, 0.7);
+}
+
+TEST(utest_kdtree_flat, find_nearest_batch_random) {
+    std::mt19937 generator(17);
+    std::uniform_real_distribution<double> distribution(-10.0, 10.0);
+
+    dataset data(3000, point(2));
+    for (auto & current_point : data) {
+        for (auto & coordinate : current_point) {
+            coordinate = distribution(generator);
+        }
+    }
+
+    std::vector<std::size_t> queries(data.size());
+    std::iota(queries.rbegin(), queries.rend(), 0);
+
+    template_find_nearest_batch(data, queries, 1.0);
+}
+
+TEST(utest_kdtree_flat, find_nearest_batch_all_points) {
+    auto data = fcps_sample_factory::create_sample(FCPS_SAMPLE::LSUN);
+    const kdtree_flat tree(*data);
+
+    neighbor_graph graph;
+    tree.find_nearest(0.3, graph);
+    ASSERT_EQ(data->size(), graph.size());
+
+    for (std::size_t i = 0; i < data->size(); i++) {
+        const std::size_t * neighbors = graph.neighbors(i);
+        ASSERT_NE(neighbors + graph.amount_neighbors(i), std::find(neighbors, neighbors + graph.amount_neighbors(i), i));
+    }
+}
+
+TEST(utest_kdtree_flat, find_nearest_batch_without_distances) {
+    auto data = fcps_sample_factory::create_sample(FCPS_SAMPLE::LSUN);
+    const kdtree_flat tree(*data);
+
+    neighbor_graph expected_graph;
+    tree.find_nearest(0.3, expected_graph);
+
+    neighbor_graph graph;
+    tree.find_nearest(0.3, graph, false);
+
+    ASSERT_FALSE(graph.has_distances());
+    ASSERT_TRUE(graph.distances().empty());
+    ASSERT_EQ(expected_graph.offsets(), graph.offsets());
+    ASSERT_EQ(expected_graph.neighbors(), graph.neighbors());
+}
+
+TEST(utest_kdtree_flat, find_nearest_excluding_label) {
+    auto data = fcps_sample_factory::create_sample(FCPS_SAMPLE::LSUN);
+    const kdtree_flat tree(*data, 4);
+
+    /* points are labeled by stripes, so whole sub-trees have the same label */
+    std::vector<std::size_t> labels(data->size());
+    for (std::size_t i = 0; i < data->size(); i++) {
+        labels[i] = (std::size_t) std::floor((*data)[i][0]);
+    }
+
+    std::vector<std::size_t> node_labels;
+    tree.label_nodes(labels, node_labels);
+
+    for (std::size_t index_query = 0; index_query < data->size(); index_query++) {
+        const point & search_point = (*data)[index_query];
+
+        double expected_distance = std::numeric_limits<double>::infinity();
+        for (std::size_t i = 0; i < data->size(); i++) {
+            if (labels[i] != labels[index_query]) {
+                expected_distance = std::min(expected_distance, square_distance(search_point, (*data)[i]));
+            }
+        }
+
+        double actual_distance = std::numeric_limits<double>::infinity();
+        double bound = actual_distance;
+        tree.find_nearest_excluding(search_point.data(), bound, node_labels, labels[index_query],
+            [&labels, &actual_distance, &bound, index_query](const std::size_t p_index, const double p_distance) {
+                if ((labels[p_index] != labels[index_query]) && (p_distance < actual_distance)) {
+                    actual_distance = p_distance;
+                    bound = p_distance;
+                }
+            });
+
+        ASSERT_EQ(expected_distance, actual_distance);
+    }
+}
+
+TEST(utest_kdtree_flat, empty_tree) {
+    const kdtree_flat tree(dataset{ });
+    ASSERT_TRUE(tree.empty());
+    ASSERT_EQ(0U, tree.size());
+
+    std::vector<std::size_t> indexes;
+    std::vector<double> distances;
+    tree.find_nearest({ 0.0, 0.0 }, 1.0, indexes, distances);
+    ASSERT_TRUE(indexes.empty());
+
+    const point search_point = { 0.0, 0.0 };
+    tree.find_k_nearest(search_point.data(), 2, 1.0, indexes, distances);
+    ASSERT_TRUE(indexes.empty());
+}
+
+TEST(utest_kdtree_flat, incorrect_leaf_size) {
+    ASSERT_THROW(kdtree_flat(dataset({ { 1.0 } }), 0), std::invalid_argument);
+}
@@ -14,9 +14,13 @@
 #include <pyclustering/cluster/kmeans.hpp>
 
 #include <pyclustering/utils/metric.hpp>
+#include <pyclustering/utils/simd.hpp>
 
 #include "utenv_check.hpp"
 
+#include <memory>
+#include <random>
+
 
 using namespace pyclustering;
 using namespace pyclustering::clst;
@@ -318,6 +322,156 @@ TEST(utest_kmeans, itermax_10_simple02) {
 }
 
 
+static dataset_ptr create_uniform_sample(const std::size_t p_amount, const std::size_t p_dimension) {
+    std::mt19937 generator(p_amount * p_dimension);
+    std::uniform_real_distribution<double> distribution(0.0, 1.0);
+
+    dataset_ptr data = std::make_shared<dataset>(p_amount, point(p_dimension));
+    for (auto & current_point : *data) {
+        for (auto & coordinate : current_point) {
+            coordinate = distribution(generator);
+        }
+    }
+
+    return data;
+}
+
+
+static void
+template_kmeans_acceleration(
+    const dataset_ptr & p_data,
+    const dataset & p_start_centers,
+    const index_sequence & p_indexes,
+    const distance_metric<point> & p_metric = distance_metric_factory<point>::euclidean_square())
+{
+    kmeans_data expected_result(true);
+    kmeans(p_start_centers, 0.0001, kmeans::DEFAULT_ITERMAX, p_metric).process(*p_data, p_indexes, expected_result);
+
+    for (const auto acceleration : { kmeans_acceleration::AUTO, kmeans_acceleration::HAMERLY, kmeans_acceleration::ELKAN }) {
+        kmeans_data actual_result(true);
+        kmeans(p_start_centers, 0.0001, kmeans::DEFAULT_ITERMAX, p_metric, acceleration).process(*p_data, p_indexes, actual_result);
+
+        ASSERT_EQ(expected_result.clusters(), actual_result.clusters());
+        ASSERT_EQ(expected_result.centers().size(), actual_result.centers().size());
+        for (std::size_t i = 0; i < expected_result.centers().size(); i++) {
+            for (std::size_t j = 0; j < expected_result.centers()[i].size(); j++) {
+                ASSERT_NEAR(expected_result.centers()[i][j], actual_result.centers()[i][j], 1e-10);
+            }
+        }
+
+        ASSERT_NEAR(expected_result.wce(), actual_result.wce(), 1e-8 * expected_result.wce());
+        ASSERT_EQ(expected_result.evolution_clusters(), actual_result.evolution_clusters());
+    }
+}
+
+
+TEST(utest_kmeans, acceleration_sample_simple_01) {
+    dataset start_centers = { { 3.7, 5.5 },{ 6.7, 7.5 } };
+    template_kmeans_acceleration(simple_sample_factory::create_sample(SAMPLE_SIMPLE::SAMPLE_SIMPLE_01), start_centers, { });
+}
+
+TEST(utest_kmeans, acceleration_sample_simple_02_range) {
+    dataset start_centers = { { 3.5, 4.8 },{ 6.9, 7.0 },{ 7.5, 0.5 } };
+    index_sequence range = { 0, 1, 2, 3, 4, 10, 11, 12, 13, 15, 16, 17, 18, 19, 20 };
+    template_kmeans_acceleration(simple_sample_factory::create_sample(SAMPLE_SIMPLE::SAMPLE_SIMPLE_02), start_centers, range);
+}
+
+TEST(utest_kmeans, acceleration_empty_cluster) {
+    dataset start_centers = { { 3.5, 4.8 },{ 6.9, 7.0 },{ 7.5, 0.5 },{ 100.0, 100.0 } };
+    template_kmeans_acceleration(simple_sample_factory::create_sample(SAMPLE_SIMPLE::SAMPLE_SIMPLE_02), start_centers, { });
+}
+
+TEST(utest_kmeans, acceleration_many_clusters) {
+    auto data = create_uniform_sample(2000, 8);
+    dataset start_centers(data->begin(), data->begin() + 40);
+    template_kmeans_acceleration(data, start_centers, { });
+}
+
+TEST(utest_kmeans, acceleration_metrics) {
+    auto data = create_uniform_sample(600, 3);
+    dataset start_centers(data->begin(), data->begin() + 10);
+
+    template_kmeans_acceleration(data, start_centers, { }, distance_metric_factory<point>::euclidean());
+    template_kmeans_acceleration(data, start_centers, { }, distance_metric_factory<point>::manhattan());
+    template_kmeans_acceleration(data, start_centers, { }, distance_metric_factory<point>::chebyshev());
+}
+
+TEST(utest_kmeans, acceleration_itermax_0) {
+    dataset start_centers = { { 3.7, 5.5 },{ 6.7, 7.5 } };
+
+    kmeans_data output_result;
+    kmeans(start_centers, 0.0001, 0, distance_metric_factory<point>::euclidean_square(), kmeans_acceleration::ELKAN).process(*simple_sample_factory::create_sample(SAMPLE_SIMPLE::SAMPLE_SIMPLE_01), output_result);
+
+    ASSERT_TRUE(output_result.clusters().empty());
+    ASSERT_EQ(start_centers, output_result.centers());
+}
+
+
+TEST(utest_kmeans, large_offset_one_dimension) {
+    /* square norms are large, so the expansion of square Euclidean distance does not distinguish centers */
+    dataset data;
+    for (std::size_t i = 0; i < 10; i++) {
+        data.push_back({ 1.7e9 + static_cast<double>(i) * 0.1 });
+        data.push_back({ 1.7e9 + 20.0 + static_cast<double>(i) * 0.1 });
+    }
+
+    const dataset start_centers = { { 1.7e9 + 2.0 }, { 1.7e9 + 18.0 } };
+    for (const auto & metric : { distance_metric_factory<point>::euclidean(), distance_metric_factory<point>::euclidean_square(), distance_metric_factory<point>::manhattan() }) {
+        kmeans_data result;
+        kmeans(start_centers, 0.0001, kmeans::DEFAULT_ITERMAX, metric).process(data, result);
+
+        ASSERT_EQ(2U, result.clusters().size());
+        for (const auto & current_cluster : result.clusters()) {
+            ASSERT_EQ(10U, current_cluster.size());
+            for (const auto index_point : current_cluster) {
+                ASSERT_EQ(current_cluster.front() % 2, index_point % 2);
+            }
+        }
+    }
+}
+
+
+TEST(utest_kmeans, vectorized_metrics) {
+    using namespace pyclustering::utils;
+
+    auto data = create_uniform_sample(600, 13);
+    dataset start_centers(data->begin(), data->begin() + 10);
+
+    const simd::instruction_set supported_set = simd::get_instruction_set();
+    for (const auto & metric : { distance_metric_factory<point>::manhattan(), distance_metric_factory<point>::chebyshev(), distance_metric_factory<point>::canberra() }) {
+        kmeans_data expected_result;
+        simd::set_instruction_set(simd::instruction_set::SCALAR);
+        kmeans(start_centers, 0.0001, kmeans::DEFAULT_ITERMAX, metric).process(*data, expected_result);
+        simd::set_instruction_set(supported_set);
+
+        kmeans_data actual_result;
+        kmeans(start_centers, 0.0001, kmeans::DEFAULT_ITERMAX, metric).process(*data, actual_result);
+
+        ASSERT_EQ(expected_result.clusters(), actual_result.clusters());
+    }
+}
+
+
+#ifdef UT_PERFORMANCE_SESSION
+TEST(performance_kmeans, big_data_accelerated) {
+    auto points = create_uniform_sample(20000, 64);
+    dataset centers(points->begin(), points->begin() + 256);
+
+    for (const auto acceleration : { kmeans_acceleration::NONE, kmeans_acceleration::HAMERLY, kmeans_acceleration::ELKAN }) {
+        auto start = std::chrono::system_clock::now();
+
+        kmeans_data output_result(false);
+        kmeans(centers, 0.0001, 20, distance_metric_factory<point>::euclidean_square(), acceleration).process(*points, output_result);
+
+        auto end = std::chrono::system_clock::now();
+
+        std::chrono::duration<double> difference = end - start;
+        std::cout << "Clustering time (acceleration '" << static_cast<int>(acceleration) << "'): '" << difference.count() << "' sec." << std::endl;
+    }
+}
+#endif
+
+
 #ifdef UT_PERFORMANCE_SESSION
 TEST(performance_kmeans, big_data) {
     auto points = simple_sample_factory::create_random_sample(100000, 10);
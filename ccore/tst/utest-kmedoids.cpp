@@ -11,10 +11,13 @@
 #include <pyclustering/cluster/kmedoids.hpp>
 
 #include <pyclustering/utils/metric.hpp>
+#include <pyclustering/utils/simd.hpp>
 
 #include "samples.hpp"
 #include "utenv_check.hpp"
 
+#include <random>
+
 
 using namespace pyclustering;
 using namespace pyclustering::clst;
@@ -416,6 +419,37 @@ TEST(utest_kmedoids, itermax_10_simple02) {
 }
 
 
+TEST(utest_kmedoids, vectorized_metrics) {
+    using namespace pyclustering::utils;
+
+    std::mt19937 generator(11);
+    std::uniform_real_distribution<double> distribution(0.0, 3.0);
+
+    dataset data(300, point(13));
+    for (std::size_t index_point = 0; index_point < data.size(); index_point++) {
+        for (auto & coordinate : data[index_point]) {
+            coordinate = distribution(generator) + 5.0 * (index_point % 3);
+        }
+    }
+
+    const medoid_sequence start_medoids = { 0, 3, 6 };
+    const simd::instruction_set supported_set = simd::get_instruction_set();
+    for (const auto & metric : { distance_metric_factory<point>::manhattan(), distance_metric_factory<point>::chebyshev(), distance_metric_factory<point>::canberra() }) {
+        kmedoids_data expected_result;
+        simd::set_instruction_set(simd::instruction_set::SCALAR);
+        kmedoids(start_medoids, kmedoids::DEFAULT_TOLERANCE, kmedoids::DEFAULT_ITERMAX, metric).process(data, expected_result);
+        simd::set_instruction_set(supported_set);
+
+        kmedoids_data actual_result;
+        kmedoids(start_medoids, kmedoids::DEFAULT_TOLERANCE, kmedoids::DEFAULT_ITERMAX, metric).process(data, actual_result);
+
+        ASSERT_EQ(3U, actual_result.clusters().size());
+        ASSERT_EQ(expected_result.medoids(), actual_result.medoids());
+        ASSERT_EQ(expected_result.clusters(), actual_result.clusters());
+    }
+}
+
+
 //#define UT_PERFORMANCE_SESSION
 #ifdef UT_PERFORMANCE_SESSION
 
@@ -0,0 +1,231 @@
+/*!
+
+@authors Andrei Novikov (pyclustering@yandex.ru)
+@date 2014-2020
+@copyright BSD-3-Clause
+
+*/
+
+
+#include <gtest/gtest.h>
+
+#include "samples.hpp"
+
+#include <pyclustering/cluster/minibatch_kmeans.hpp>
+
+#include <pyclustering/utils/metric.hpp>
+
+#include "utenv_check.hpp"
+
+#include <algorithm>
+#include <random>
+#include <set>
+#include <stdexcept>
+#include <utility>
+
+
+using namespace pyclustering;
+using namespace pyclustering::clst;
+using namespace pyclustering::utils::metric;
+
+
+static dataset create_blobs(const std::size_t p_points_per_blob, const dataset & p_blob_centers) {
+    std::mt19937 generator(42);
+    std::uniform_real_distribution<double> distribution(-1.0, 1.0);
+
+    dataset data;
+    for (const auto & blob_center : p_blob_centers) {
+        for (std::size_t i = 0; i < p_points_per_blob; i++) {
+            point current_point = blob_center;
+            for (auto & coordinate : current_point) {
+                coordinate += distribution(generator);
+            }
+
+            data.push_back(std::move(current_point));
+        }
+    }
+
+    return data;
+}
+
+
+static void assert_blobs_separated(const minibatch_kmeans & p_algorithm, const std::size_t p_points_per_blob, const dataset & p_blob_centers) {
+    const dataset data = create_blobs(p_points_per_blob, p_blob_centers);
+
+    index_sequence labels;
+    p_algorithm.predict(container::dense_dataset(data), labels);
+    ASSERT_EQ(data.size(), labels.size());
+
+    std::set<std::size_t> blob_labels;
+    for (std::size_t index_blob = 0; index_blob < p_blob_centers.size(); index_blob++) {
+        const std::size_t label = labels[index_blob * p_points_per_blob];
+        for (std::size_t i = 0; i < p_points_per_blob; i++) {
+            ASSERT_EQ(label, labels[index_blob * p_points_per_blob + i]);
+        }
+
+        blob_labels.insert(label);
+    }
+
+    ASSERT_EQ(p_blob_centers.size(), blob_labels.size());
+}
+
+
+TEST(utest_minibatch_kmeans, allocation_sample_simple_01) {
+    dataset start_centers = { { 3.7, 5.5 },{ 6.7, 7.5 } };
+
+    kmeans_data result;
+    minibatch_kmeans(start_centers, 4, 0.0001, 200, distance_metric_factory<point>::euclidean_square(), 1000).process(*simple_sample_factory::create_sample(SAMPLE_SIMPLE::SAMPLE_SIMPLE_01), result);
+
+    ASSERT_CLUSTER_SIZES(*simple_sample_factory::create_sample(SAMPLE_SIMPLE::SAMPLE_SIMPLE_01), result.clusters(), { 5, 5 });
+    ASSERT_EQ(2U, result.centers().size());
+    ASSERT_GT(result.wce(), 0.0);
+}
+
+
+TEST(utest_minibatch_kmeans, allocation_seeded_blobs) {
+    const dataset blob_centers = { { 0.0, 0.0 }, { 20.0, 0.0 }, { 0.0, 20.0 } };
+    const dataset data = create_blobs(200, blob_centers);
+
+    kmeans_data result;
+    minibatch_kmeans algorithm(3, 64, 100, 100, 0.0, 50, distance_metric_factory<point>::euclidean_square(), 1000);
+    algorithm.process(data, result);
+
+    ASSERT_CLUSTER_SIZES(data, result.clusters(), { 200, 200, 200 });
+    assert_blobs_separated(algorithm, 10, blob_centers);
+}
+
+
+TEST(utest_minibatch_kmeans, allocation_manhattan) {
+    const dataset blob_centers = { { 0.0, 0.0, 0.0 }, { 20.0, 20.0, 20.0 } };
+    const dataset data = create_blobs(100, blob_centers);
+
+    kmeans_data result(true);
+    minibatch_kmeans(2, 32, 50, 50, 0.0, 20, distance_metric_factory<point>::manhattan(), 1000).process(data, result);
+
+    ASSERT_CLUSTER_SIZES(data, result.clusters(), { 100, 100 });
+    ASSERT_EQ(21U, result.evolution_centers().size());
+    ASSERT_EQ(21U, result.evolution_clusters().size());
+
+    for (std::size_t i = 0; i < result.evolution_centers().size(); i++) {
+        ASSERT_EQ(result.evolution_centers()[i].size(), result.evolution_clusters()[i].size());
+    }
+}
+
+
+TEST(utest_minibatch_kmeans, partial_fit) {
+    const dataset blob_centers = { { 0.0, 0.0 }, { 20.0, 0.0 }, { 0.0, 20.0 }, { 20.0, 20.0 } };
+    dataset data = create_blobs(500, blob_centers);
+    std::shuffle(data.begin(), data.end(), std::mt19937(7));
+
+    minibatch_kmeans algorithm(4, minibatch_kmeans::DEFAULT_BATCH_SIZE, 150, 250, minibatch_kmeans::DEFAULT_TOLERANCE,
+        minibatch_kmeans::DEFAULT_ITERMAX, distance_metric_factory<point>::euclidean_square(), 1000);
+
+    for (std::size_t begin = 0; begin < data.size(); begin += 100) {
+        algorithm.partial_fit(dataset(data.begin() + begin, data.begin() + begin + 100));
+        ASSERT_EQ(begin + 100 >= 250, algorithm.is_initialized());
+    }
+
+    ASSERT_EQ(4U, algorithm.get_centers().size());
+    assert_blobs_separated(algorithm, 10, blob_centers);
+}
+
+
+TEST(utest_minibatch_kmeans, partial_fit_reservoir_samples_warm_up) {
+    /* the stream starts by points of one blob, the reservoir should not be filled only by them */
+    const dataset blob_centers = { { 0.0, 0.0 }, { 20.0, 20.0 } };
+    const dataset data = create_blobs(400, blob_centers);
+
+    minibatch_kmeans algorithm(2, minibatch_kmeans::DEFAULT_BATCH_SIZE, 50, data.size(), minibatch_kmeans::DEFAULT_TOLERANCE,
+        minibatch_kmeans::DEFAULT_ITERMAX, distance_metric_factory<point>::euclidean_square(), 1000);
+
+    for (std::size_t begin = 0; begin < data.size(); begin += 40) {
+        ASSERT_FALSE(algorithm.is_initialized());
+        algorithm.partial_fit(dataset(data.begin() + begin, data.begin() + begin + 40));
+    }
+
+    ASSERT_TRUE(algorithm.is_initialized());
+    assert_blobs_separated(algorithm, 10, blob_centers);
+}
+
+
+TEST(utest_minibatch_kmeans, batch_source) {
+    const dataset blob_centers = { { 0.0, 0.0 }, { 20.0, 0.0 }, { 0.0, 20.0 } };
+    dataset data = create_blobs(300, blob_centers);
+    std::shuffle(data.begin(), data.end(), std::mt19937(7));
+
+    std::size_t position = 0;
+    const auto source = [&data, &position](dataset & p_batch) {
+        if (position >= data.size()) {
+            return false;
+        }
+
+        const std::size_t end = std::min(position + 64, data.size());
+        p_batch.assign(data.begin() + position, data.begin() + end);
+        position = end;
+        return true;
+    };
+
+    kmeans_data result(true);
+    minibatch_kmeans algorithm(3, minibatch_kmeans::DEFAULT_BATCH_SIZE, 200, 200, minibatch_kmeans::DEFAULT_TOLERANCE,
+        minibatch_kmeans::DEFAULT_ITERMAX, distance_metric_factory<point>::euclidean_square(), 1000);
+    algorithm.process(source, result);
+
+    ASSERT_TRUE(result.clusters().empty());
+    ASSERT_EQ(algorithm.get_centers(), result.centers());
+    ASSERT_FALSE(result.evolution_centers().empty());
+    assert_blobs_separated(algorithm, 10, blob_centers);
+}
+
+
+TEST(utest_minibatch_kmeans, batch_source_less_than_reservoir) {
+    const dataset blob_centers = { { 0.0, 0.0 }, { 20.0, 0.0 } };
+    const dataset data = create_blobs(50, blob_centers);
+
+    bool provided = false;
+    const auto source = [&data, &provided](dataset & p_batch) {
+        p_batch = data;
+        return !std::exchange(provided, true);
+    };
+
+    kmeans_data result;
+    minibatch_kmeans algorithm(2, minibatch_kmeans::DEFAULT_BATCH_SIZE, 1000, minibatch_kmeans::DEFAULT_WARM_UP_SIZE, minibatch_kmeans::DEFAULT_TOLERANCE,
+        minibatch_kmeans::DEFAULT_ITERMAX, distance_metric_factory<point>::euclidean_square(), 1000);
+    algorithm.process(source, result);
+
+    ASSERT_EQ(2U, result.centers().size());
+    assert_blobs_separated(algorithm, 10, blob_centers);
+}
+
+
+TEST(utest_minibatch_kmeans, incorrect_arguments) {
+    const dataset data = { { 1.0 }, { 2.0 }, { 3.0 } };
+
+    kmeans_data result;
+    ASSERT_THROW(minibatch_kmeans(0).process(data, result), std::invalid_argument);
+    ASSERT_THROW(minibatch_kmeans(2, 0).process(data, result), std::invalid_argument);
+    ASSERT_THROW(minibatch_kmeans(3, 10, 2).partial_fit(data), std::invalid_argument);
+    ASSERT_THROW(minibatch_kmeans(2, 10, 20, 10).partial_fit(data), std::invalid_argument);
+    ASSERT_THROW(minibatch_kmeans(4).process(data, result), std::invalid_argument);
+    ASSERT_THROW(minibatch_kmeans(dataset({ { 1.0, 2.0 } })).process(data, result), std::invalid_argument);
+
+    index_sequence labels = { 7, 8 };
+    ASSERT_THROW(minibatch_kmeans(2).predict(container::dense_dataset(data), labels), std::invalid_argument);
+    ASSERT_EQ(index_sequence({ 7, 8 }), labels);
+}
+
+
+TEST(utest_minibatch_kmeans, predict_incorrect_dimension) {
+    const dataset centers = { { 1.0, 1.0, 1.0 }, { 5.0, 5.0, 5.0 } };
+
+    /* blocked assignment and point-by-point assignment */
+    for (const auto & metric : { distance_metric_factory<point>::euclidean_square(), distance_metric_factory<point>::manhattan() }) {
+        minibatch_kmeans solver(centers, 2, 0.001, 10, metric);
+        solver.partial_fit(container::dense_dataset(dataset({ { 1.0, 1.0, 1.0 } })));
+        ASSERT_TRUE(solver.is_initialized());
+
+        index_sequence labels = { 7 };
+        ASSERT_THROW(solver.predict(container::dense_dataset(dataset({ { 1.0, 1.0 } })), labels), std::invalid_argument);
+        ASSERT_THROW(solver.predict(container::dense_dataset(dataset({ { 1.0, 1.0, 1.0, 1.0 } })), labels), std::invalid_argument);
+        ASSERT_EQ(index_sequence({ 7 }), labels);
+    }
+}
@@ -17,6 +17,8 @@
 #include "samples.hpp"
 #include "utenv_check.hpp"
 
+#include <algorithm>
+
 
 using namespace pyclustering;
 using namespace pyclustering::clst;
@@ -311,6 +313,210 @@ TEST(utest_optics, noise_cluster_allocation_sample_simple_02_distance_matrix) {
 }
 
 
+static void template_optics_metric_process_data(const std::shared_ptr<dataset> & p_data,
+        const double p_radius,
+        const size_t p_neighbors,
+        const distance_metric<point> & p_metric)
+{
+    optics_data expected_result;
+    dataset matrix;
+    distance_matrix(*p_data, p_metric, matrix);
+    optics(p_radius, p_neighbors).process(matrix, data_t::DISTANCE_MATRIX, expected_result);
+
+    optics_data actual_result;
+    optics(p_radius, p_neighbors, p_metric).process(*p_data, actual_result);
+
+    std::vector<std::size_t> expected_lengths, actual_lengths;
+    for (const auto & current_cluster : expected_result.clusters()) { expected_lengths.push_back(current_cluster.size()); }
+    for (const auto & current_cluster : actual_result.clusters()) { actual_lengths.push_back(current_cluster.size()); }
+
+    std::sort(expected_lengths.begin(), expected_lengths.end());
+    std::sort(actual_lengths.begin(), actual_lengths.end());
+    ASSERT_EQ(expected_lengths, actual_lengths);
+    ASSERT_EQ(expected_result.noise().size(), actual_result.noise().size());
+
+    for (std::size_t i = 0; i < p_data->size(); i++) {
+        ASSERT_DOUBLE_EQ(expected_result.optics_objects()[i].m_core_distance, actual_result.optics_objects()[i].m_core_distance);
+    }
+}
+
+
+TEST(utest_optics, allocation_sample_simple_01_manhattan) {
+    template_optics_metric_process_data(simple_sample_factory::create_sample(SAMPLE_SIMPLE::SAMPLE_SIMPLE_01), 0.7, 2, distance_metric_factory<point>::manhattan());
+}
+
+
+TEST(utest_optics, allocation_sample_simple_03_chebyshev) {
+    template_optics_metric_process_data(simple_sample_factory::create_sample(SAMPLE_SIMPLE::SAMPLE_SIMPLE_03), 0.5, 3, distance_metric_factory<point>::chebyshev());
+}
+
+
+TEST(utest_optics, allocation_lsun_minkowski) {
+    template_optics_metric_process_data(fcps_sample_factory::create_sample(FCPS_SAMPLE::LSUN), 0.4, 4, distance_metric_factory<point>::minkowski(4.0));
+}
+
+
+TEST(utest_optics, allocation_lsun_chi_square) {
+    template_optics_metric_process_data(fcps_sample_factory::create_sample(FCPS_SAMPLE::LSUN), 0.1, 4, distance_metric_factory<point>::chi_square());
+}
+
+
+static void template_optics_compare_results(const optics_data & p_expected, const optics_data & p_actual) {
+    ASSERT_EQ(p_expected.clusters(), p_actual.clusters());
+    ASSERT_EQ(p_expected.noise(), p_actual.noise());
+    ASSERT_EQ(p_expected.optics_objects().size(), p_actual.optics_objects().size());
+
+    for (std::size_t i = 0; i < p_expected.optics_objects().size(); i++) {
+        ASSERT_EQ(p_expected.optics_objects()[i].m_core_distance, p_actual.optics_objects()[i].m_core_distance);
+        ASSERT_EQ(p_expected.optics_objects()[i].m_reachability_distance, p_actual.optics_objects()[i].m_reachability_distance);
+    }
+}
+
+
+static void template_optics_adjusted_radius(const std::shared_ptr<dataset> & p_data,
+        const double p_radius,
+        const size_t p_neighbors,
+        const size_t p_amount_clusters,
+        const data_t p_type)
+{
+    dataset data = *p_data;
+    if (p_type == data_t::DISTANCE_MATRIX) {
+        distance_matrix(*p_data, data);
+    }
+
+    optics solver(p_radius, p_neighbors, p_amount_clusters);
+
+    optics_data actual_result;
+    solver.process(data, p_type, actual_result);
+
+    /* neighborhoods that are found for the initial radius are reused for the adjusted one (cluster-ordering is
+       calculated only for the initial radius) */
+    optics_data expected_result;
+    optics(actual_result.get_radius(), p_neighbors).process(data, p_type, expected_result);
+
+    template_optics_compare_results(expected_result, actual_result);
+
+    /* the algorithm keeps the adjusted radius, so neighborhoods of the same generation are reused by the next call */
+    const container::dense_dataset storage(data);
+    for (std::size_t i = 0; i < 2; i++) {
+        optics_data repeated_result;
+        solver.process(storage, p_type, repeated_result, 1);
+
+        template_optics_compare_results(expected_result, repeated_result);
+        ASSERT_EQ(expected_result.cluster_ordering(), repeated_result.cluster_ordering());
+    }
+}
+
+
+TEST(utest_optics, adjusted_radius_sample_simple_03) {
+    template_optics_adjusted_radius(simple_sample_factory::create_sample(SAMPLE_SIMPLE::SAMPLE_SIMPLE_03), 3.0, 3, 4, data_t::POINTS);
+}
+
+
+TEST(utest_optics, adjusted_radius_sample_simple_03_distance_matrix) {
+    template_optics_adjusted_radius(simple_sample_factory::create_sample(SAMPLE_SIMPLE::SAMPLE_SIMPLE_03), 3.0, 3, 4, data_t::DISTANCE_MATRIX);
+}
+
+
+TEST(utest_optics, adjusted_radius_sample_lsun) {
+    template_optics_adjusted_radius(fcps_sample_factory::create_sample(FCPS_SAMPLE::LSUN), 1.0, 3, 3, data_t::POINTS);
+}
+
+
+TEST(utest_optics, adjusted_radius_sample_lsun_manhattan) {
+    const auto data = fcps_sample_factory::create_sample(FCPS_SAMPLE::LSUN);
+
+    optics solver(1.0, 3, 3, distance_metric_factory<point>::manhattan());
+
+    optics_data actual_result;
+    solver.process(*data, actual_result);
+
+    optics_data expected_result;
+    optics(actual_result.get_radius(), 3, distance_metric_factory<point>::manhattan()).process(*data, expected_result);
+
+    template_optics_compare_results(expected_result, actual_result);
+}
+
+
+TEST(utest_optics, different_data_same_solver) {
+    const auto data_01 = simple_sample_factory::create_sample(SAMPLE_SIMPLE::SAMPLE_SIMPLE_01);
+    const auto data_02 = simple_sample_factory::create_sample(SAMPLE_SIMPLE::SAMPLE_SIMPLE_02);
+
+    optics solver(1.0, 2);
+
+    /* neighborhoods of the previous data are not used for another data */
+    optics_data first_result;
+    solver.process(*data_01, first_result);
+
+    optics_data actual_result;
+    solver.process(*data_02, actual_result);
+
+    optics_data expected_result;
+    optics(1.0, 2).process(*data_02, expected_result);
+
+    template_optics_compare_results(expected_result, actual_result);
+    ASSERT_EQ(expected_result.cluster_ordering(), actual_result.cluster_ordering());
+
+    dataset changed_data = *data_02;
+    changed_data.back()[0] += 10.0;
+
+    optics_data changed_result;
+    solver.process(changed_data, changed_result);
+
+    optics_data expected_changed_result;
+    optics(1.0, 2).process(changed_data, expected_changed_result);
+
+    template_optics_compare_results(expected_changed_result, changed_result);
+}
+
+
+static void template_optics_changed_in_place(const std::size_t p_first_generation, const std::size_t p_second_generation, const bool p_clear) {
+    const auto data = simple_sample_factory::create_sample(SAMPLE_SIMPLE::SAMPLE_SIMPLE_02);
+    container::dense_dataset storage(*data);
+
+    optics solver(1.0, 2);
+
+    optics_data first_result;
+    solver.process(storage, data_t::POINTS, first_result, p_first_generation);
+
+    /* data that is changed in place has the same location and shape */
+    dataset changed_data = *data;
+    for (std::size_t i = 0; i < changed_data.size(); i++) {
+        changed_data[i][0] *= 2.0;
+        storage.row(i)[0] *= 2.0;
+    }
+
+    if (p_clear) {
+        solver.clear_neighborhoods();
+    }
+
+    optics_data actual_result;
+    solver.process(storage, data_t::POINTS, actual_result, p_second_generation);
+
+    optics_data expected_result;
+    optics(1.0, 2).process(changed_data, expected_result);
+
+    template_optics_compare_results(expected_result, actual_result);
+    ASSERT_EQ(expected_result.cluster_ordering(), actual_result.cluster_ordering());
+}
+
+
+TEST(utest_optics, changed_in_place_without_generation) {
+    template_optics_changed_in_place(optics::NO_GENERATION, optics::NO_GENERATION, false);
+}
+
+
+TEST(utest_optics, changed_in_place_new_generation) {
+    template_optics_changed_in_place(1, 2, false);
+    template_optics_changed_in_place(1, optics::NO_GENERATION, false);
+}
+
+
+TEST(utest_optics, clear_neighborhoods) {
+    template_optics_changed_in_place(1, 1, true);
+}
+
+
 #ifdef UT_PERFORMANCE_SESSION
 #include <chrono>
 
@@ -0,0 +1,228 @@
+/*!
+
+@authors Andrei Novikov (pyclustering@yandex.ru)
+@date 2014-2020
+@copyright BSD-3-Clause
+
+*/
+
+
+#include <gtest/gtest.h>
+
+#include <pyclustering/cluster/optics.hpp>
+#include <pyclustering/cluster/optics_xi.hpp>
+
+#include "samples.hpp"
+
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+
+
+using namespace pyclustering;
+using namespace pyclustering::clst;
+
+
+static void assert_hierarchy(const optics_xi_data & p_result, const std::size_t p_amount_objects) {
+    const cluster_sequence & clusters = p_result.clusters();
+    const index_sequence & hierarchy = p_result.hierarchy();
+
+    ASSERT_EQ(clusters.size(), hierarchy.size());
+
+    std::vector<bool> covered(p_amount_objects, false);
+    for (std::size_t index_cluster = 0; index_cluster < clusters.size(); index_cluster++) {
+        ASSERT_FALSE(clusters[index_cluster].empty());
+
+        for (const auto index_object : clusters[index_cluster]) {
+            ASSERT_LT(index_object, p_amount_objects);
+            covered[index_object] = true;
+        }
+
+        /* a parent is placed after its child and contains all its objects */
+        const std::size_t index_parent = hierarchy[index_cluster];
+        if (index_parent != optics_xi::NO_PARENT) {
+            ASSERT_GT(index_parent, index_cluster);
+
+            cluster child = clusters[index_cluster];
+            cluster parent = clusters[index_parent];
+            std::sort(child.begin(), child.end());
+            std::sort(parent.begin(), parent.end());
+
+            ASSERT_TRUE(std::includes(parent.begin(), parent.end(), child.begin(), child.end()));
+            ASSERT_LT(child.size(), parent.size() + 1);
+        }
+    }
+
+    for (const auto index_object : p_result.noise()) {
+        ASSERT_FALSE(covered[index_object]);
+        covered[index_object] = true;
+    }
+
+    ASSERT_EQ(p_amount_objects, (std::size_t) std::count(covered.begin(), covered.end(), true));
+}
+
+
+static std::size_t amount_leaves(const optics_xi_data & p_result) {
+    std::vector<bool> has_children(p_result.clusters().size(), false);
+    for (const auto index_parent : p_result.hierarchy()) {
+        if (index_parent != optics_xi::NO_PARENT) {
+            has_children[index_parent] = true;
+        }
+    }
+
+    return (std::size_t) std::count(has_children.begin(), has_children.end(), false);
+}
+
+
+TEST(utest_optics_xi, two_valleys) {
+    /* objects are processed in reverse order */
+    const std::vector<double> plot = { optics::NONE_DISTANCE, 0.1, 0.1, 0.1, 0.1, 0.1, 5.0, 0.1, 0.1, 0.1, 0.1, 0.1 };
+
+    index_sequence object_ordering(plot.size());
+    std::vector<double> reachability(plot.size());
+    for (std::size_t position = 0; position < plot.size(); position++) {
+        object_ordering[position] = plot.size() - position - 1;
+        reachability[object_ordering[position]] = plot[position];
+    }
+
+    optics_xi_data result;
+    optics_xi(0.1, 2).process(object_ordering, reachability, result);
+
+    const cluster_sequence expected_clusters = {
+        { 11, 10, 9, 8, 7, 6 },
+        { 5, 4, 3, 2, 1, 0 },
+        { 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0 }
+    };
+
+    const index_sequence expected_hierarchy = { 2, 2, optics_xi::NO_PARENT };
+
+    ASSERT_EQ(expected_clusters, result.clusters());
+    ASSERT_EQ(expected_hierarchy, result.hierarchy());
+    ASSERT_TRUE(result.noise().empty());
+}
+
+
+TEST(utest_optics_xi, minimum_cluster_size) {
+    const std::vector<double> plot = { optics::NONE_DISTANCE, 0.1, 0.1, 0.1, 0.1, 0.1, 5.0, 0.1, 0.1, 0.1, 0.1, 0.1 };
+
+    index_sequence object_ordering(plot.size());
+    for (std::size_t position = 0; position < plot.size(); position++) {
+        object_ordering[position] = position;
+    }
+
+    optics_xi_data result;
+    optics_xi(0.1, 2, 7).process(object_ordering, plot, result);
+
+    const cluster_sequence expected_clusters = { { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11 } };
+
+    ASSERT_EQ(expected_clusters, result.clusters());
+    ASSERT_EQ(index_sequence({ optics_xi::NO_PARENT }), result.hierarchy());
+}
+
+
+TEST(utest_optics_xi, flat_plot_cluster) {
+    /* the plot is bounded by undefined reachability on both sides */
+    const std::vector<double> plot = { optics::NONE_DISTANCE, 1.0, 1.0, 1.0, 1.0 };
+    const index_sequence object_ordering = { 0, 1, 2, 3, 4 };
+
+    optics_xi_data result;
+    optics_xi(0.1, 2).process(object_ordering, plot, result);
+
+    ASSERT_EQ(cluster_sequence({ { 0, 1, 2, 3, 4 } }), result.clusters());
+    ASSERT_TRUE(result.noise().empty());
+}
+
+
+TEST(utest_optics_xi, undefined_reachability_noise) {
+    const std::vector<double> plot(5, optics::NONE_DISTANCE);
+    const index_sequence object_ordering = { 4, 3, 2, 1, 0 };
+
+    optics_xi_data result;
+    optics_xi(0.1, 2).process(object_ordering, plot, result);
+
+    ASSERT_TRUE(result.clusters().empty());
+    ASSERT_EQ(noise({ 4, 3, 2, 1, 0 }), result.noise());
+}
+
+
+TEST(utest_optics_xi, empty_ordering) {
+    optics_xi_data result;
+    optics_xi(0.1, 2).process(index_sequence(), std::vector<double>(), result);
+
+    ASSERT_TRUE(result.clusters().empty());
+    ASSERT_TRUE(result.noise().empty());
+    ASSERT_TRUE(result.hierarchy().empty());
+}
+
+
+static void template_optics_xi_sample(const std::shared_ptr<dataset> & p_data,
+        const double p_radius,
+        const std::size_t p_neighbors,
+        const double p_xi,
+        const std::size_t p_expected_clusters,
+        const std::size_t p_expected_leaves)
+{
+    optics_data optics_result;
+    optics(p_radius, p_neighbors).process(*p_data, optics_result);
+
+    ASSERT_EQ(p_data->size(), optics_result.object_ordering().size());
+
+    optics_xi_data result;
+    optics_xi(p_xi, p_neighbors).process(optics_result, result);
+
+    assert_hierarchy(result, p_data->size());
+    ASSERT_EQ(p_expected_clusters, result.clusters().size());
+    ASSERT_EQ(p_expected_leaves, amount_leaves(result));
+}
+
+
+TEST(utest_optics_xi, sample_simple_01) {
+    template_optics_xi_sample(simple_sample_factory::create_sample(SAMPLE_SIMPLE::SAMPLE_SIMPLE_01), 10.0, 3, 0.1, 3, 2);
+}
+
+
+TEST(utest_optics_xi, sample_simple_03) {
+    template_optics_xi_sample(simple_sample_factory::create_sample(SAMPLE_SIMPLE::SAMPLE_SIMPLE_03), 10.0, 8, 0.2, 6, 4);
+}
+
+
+TEST(utest_optics_xi, sample_lsun) {
+    template_optics_xi_sample(fcps_sample_factory::create_sample(FCPS_SAMPLE::LSUN), 10.0, 10, 0.2, 4, 3);
+}
+
+
+TEST(utest_optics_xi, several_granularities) {
+    const auto data = fcps_sample_factory::create_sample(FCPS_SAMPLE::LSUN);
+
+    optics_data optics_result;
+    optics(10.0, 5).process(*data, optics_result);
+
+    /* the same result of OPTICS is used for each granularity */
+    std::vector<std::size_t> amounts;
+    for (const double xi : { 0.5, 0.2, 0.05 }) {
+        optics_xi_data result;
+        optics_xi(xi, 5).process(optics_result, result);
+
+        assert_hierarchy(result, data->size());
+        amounts.push_back(result.clusters().size());
+    }
+
+    ASSERT_NE(amounts.front(), amounts.back());
+}
+
+
+TEST(utest_optics_xi, incorrect_xi) {
+    const std::vector<double> plot = { optics::NONE_DISTANCE, 1.0 };
+    const index_sequence object_ordering = { 0, 1 };
+
+    optics_xi_data result;
+    ASSERT_THROW(optics_xi(0.0, 2).process(object_ordering, plot, result), std::invalid_argument);
+    ASSERT_THROW(optics_xi(1.0, 2).process(object_ordering, plot, result), std::invalid_argument);
+}
+
+
+TEST(utest_optics_xi, incorrect_ordering) {
+    optics_xi_data result;
+    ASSERT_THROW(optics_xi(0.1, 2).process(index_sequence({ 0, 1 }), std::vector<double>({ 1.0 }), result), std::invalid_argument);
+    ASSERT_THROW(optics_xi(0.1, 2).process(index_sequence({ 0, 2 }), std::vector<double>({ 1.0, 1.0 }), result), std::invalid_argument);
+}
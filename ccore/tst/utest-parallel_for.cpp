@@ -10,8 +10,13 @@
 #include <gtest/gtest.h>
 
 #include <pyclustering/parallel/parallel.hpp>
+#include <pyclustering/parallel/thread_pool.hpp>
 
+#include <chrono>
+#include <mutex>
 #include <numeric>
+#include <set>
+#include <thread>
 
 
 using namespace pyclustering::parallel;
@@ -208,6 +213,25 @@ TEST(utest_parallel_for, sum_1000000_elements) {
 }
 
 
+TEST(utest_parallel_for, zero_step) {
+    std::size_t amount_calls = 0;
+    const auto task = [&amount_calls](const std::size_t) { amount_calls++; };
+
+    ASSERT_THROW(parallel_for(std::size_t(0), std::size_t(10), std::size_t(0), task), std::invalid_argument);
+    ASSERT_THROW(parallel_for(std::size_t(0), std::size_t(0), std::size_t(0), task, 1), std::invalid_argument);
+    ASSERT_EQ(0U, amount_calls);
+}
+
+
+TEST(utest_parallel_for, negative_step) {
+    std::size_t amount_calls = 0;
+    const auto task = [&amount_calls](const int) { amount_calls++; };
+
+    ASSERT_THROW(parallel_for(0, 10, -1, task), std::invalid_argument);
+    ASSERT_EQ(0U, amount_calls);
+}
+
+
 
 static void template_parallel_foreach_square(const std::size_t p_length, const std::size_t p_thread = -1) {
     std::vector<double> values(p_length);
@@ -322,3 +346,87 @@ TEST(utest_parallel_for_each, increase_length_to_500_thread_1) {
 TEST(utest_parallel_for_each, sum_1000000_elements) {
     template_parallel_foreach_sum(1000000);
 }
+
+
+TEST(utest_parallel_for, nested_loops) {
+    std::vector<std::vector<double>> results(50, std::vector<double>(100, 0.0));
+
+    parallel_for(std::size_t(0), results.size(), [&results](const std::size_t p_outer) {
+        parallel_for_each(results[p_outer].begin(), results[p_outer].end(), [p_outer](double & p_value) {
+            p_value = static_cast<double>(p_outer);
+        });
+    });
+
+    for (std::size_t i = 0; i < results.size(); i++) {
+        for (const double value : results[i]) {
+            ASSERT_EQ(static_cast<double>(i), value);
+        }
+    }
+}
+
+
+TEST(utest_parallel_for, configured_amount_threads) {
+    set_amount_threads(3);
+    ASSERT_EQ(3U, get_amount_threads());
+
+    template_parallel_square(1000);
+    template_parallel_foreach_square(1000);
+
+    set_amount_threads(0);
+    ASSERT_EQ(get_available_processors(), get_amount_threads());
+}
+
+
+TEST(utest_parallel_for, increased_amount_threads) {
+    set_amount_threads(1);
+    template_parallel_square(100);
+
+    /* workers are started on demand when the amount of threads is increased after the first parallel loop */
+    const std::size_t amount_threads = std::thread::hardware_concurrency() + 3;
+    set_amount_threads(amount_threads);
+
+    std::mutex mutex;
+    std::set<std::thread::id> threads;
+
+    parallel_for(std::size_t(0), amount_threads, [&mutex, &threads, amount_threads](const std::size_t) {
+        {
+            std::lock_guard<std::mutex> guard(mutex);
+            threads.insert(std::this_thread::get_id());
+        }
+
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+        while (std::chrono::steady_clock::now() < deadline) {
+            std::lock_guard<std::mutex> guard(mutex);
+            if (threads.size() == amount_threads) {
+                break;
+            }
+        }
+    });
+
+    set_amount_threads(0);
+    ASSERT_EQ(amount_threads, threads.size());
+}
+
+
+#if defined(__GNUC__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wdeprecated-declarations"
+#endif
+
+TEST(utest_parallel_for, deprecated_amount_constants) {
+    /* deprecated constants follow the configured amount of threads */
+    set_amount_threads(3);
+
+    ASSERT_EQ(2U, static_cast<std::size_t>(AMOUNT_THREADS));     /* the calling thread is not included */
+    ASSERT_EQ(2U, get_amount_workers());
+    ASSERT_EQ(3U, static_cast<std::size_t>(thread_pool::DEFAULT_POOL_SIZE));
+    ASSERT_EQ(get_available_processors(), static_cast<std::size_t>(AMOUNT_HARDWARE_THREADS));
+
+    template_parallel_square(1000, 1, AMOUNT_THREADS);
+
+    set_amount_threads(0);
+}
+
+#if defined(__GNUC__)
+#pragma GCC diagnostic pop
+#endif
@@ -31,7 +31,7 @@ static void template_create_delete_test(const std::size_t p_size) {
 
     if (p_size == AUTO_POOL_SIZE) {
         pool = new thread_pool();
-        expected_size = thread_pool::DEFAULT_POOL_SIZE;
+        expected_size = thread_pool::default_size();
     }
     else {
         pool = new thread_pool(p_size);
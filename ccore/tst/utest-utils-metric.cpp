@@ -11,6 +11,8 @@
 
 #include <pyclustering/definitions.hpp>
 
+#include <pyclustering/container/dense_dataset.hpp>
+
 #include <pyclustering/utils/metric.hpp>
 
 #include "utenv_check.hpp"
@@ -79,6 +81,23 @@ TEST(utest_metric, metric_factory_user_defined) {
    ASSERT_EQ(-5.0, metric({0.0, 0.0}, {0.0, 0.0}));
 }
 
+TEST(utest_metric, metric_factory_user_defined_views) {
+   const container::dense_dataset points(dataset({ {0.0, 0.0}, {1.0, 0.0} }));
+
+   distance_metric<point> metric = distance_metric_factory<point>::user_defined(
+      [](const point & p1, const point & p2) { return -5.0; },
+      [&points](const container::point_view & p1, const container::point_view & p2) {
+         /* views refer to coordinates of the dataset, they are not copied */
+         EXPECT_EQ(points.row(0), p1.data());
+         EXPECT_EQ(points.row(1), p2.data());
+         return -3.0;
+      });
+
+   ASSERT_EQ(metric_kind::USER_DEFINED, metric.kind());
+   ASSERT_EQ(-5.0, metric(point({0.0, 0.0}), point({1.0, 0.0})));
+   ASSERT_EQ(-3.0, metric(points[0], points[1]));
+}
+
 
 TEST(utest_metric, calculate_distance_matrix_01) {
     dataset points = { {0}, {2}, {4} };
@@ -89,4 +108,69 @@ TEST(utest_metric, calculate_distance_matrix_01) {
     dataset distance_matrix_expected = { { 0.0, 2.0, 4.0 }, { 2.0, 0.0, 2.0 }, { 4.0, 2.0, 0.0 } };
 
     ASSERT_EQ(distance_matrix, distance_matrix_expected);
-}
\ No newline at end of file
+}
+
+static void template_visit_metric(const distance_metric<point> & p_metric, const metric_kind p_kind) {
+   ASSERT_EQ(p_kind, p_metric.kind());
+
+   const dataset points = { { 1.0, 2.0, 3.0 }, { -4.0, 0.5, 6.0 }, { 0.0, 0.0, 0.0 } };
+   for (const auto & point1 : points) {
+      for (const auto & point2 : points) {
+         const double expected = p_metric(point1, point2);
+
+         ASSERT_DOUBLE_EQ(expected, visit(p_metric, [&point1, &point2](const auto & p_distance) {
+            return p_distance(point1, point2);
+         }));
+
+         ASSERT_DOUBLE_EQ(expected, visit(p_metric, [&point1, &point2](const auto & p_distance) {
+            return p_distance(container::point_view(point1), container::point_view(point2));
+         }));
+      }
+   }
+}
+
+TEST(utest_metric, visit_euclidean) {
+   template_visit_metric(distance_metric_factory<point>::euclidean(), metric_kind::EUCLIDEAN);
+}
+
+TEST(utest_metric, visit_euclidean_square) {
+   template_visit_metric(distance_metric_factory<point>::euclidean_square(), metric_kind::EUCLIDEAN_SQUARE);
+}
+
+TEST(utest_metric, visit_manhattan) {
+   template_visit_metric(distance_metric_factory<point>::manhattan(), metric_kind::MANHATTAN);
+}
+
+TEST(utest_metric, visit_chebyshev) {
+   template_visit_metric(distance_metric_factory<point>::chebyshev(), metric_kind::CHEBYSHEV);
+}
+
+TEST(utest_metric, visit_minkowski) {
+   template_visit_metric(distance_metric_factory<point>::minkowski(4.0), metric_kind::MINKOWSKI);
+}
+
+TEST(utest_metric, visit_canberra) {
+   template_visit_metric(distance_metric_factory<point>::canberra(), metric_kind::CANBERRA);
+}
+
+TEST(utest_metric, visit_chi_square) {
+   template_visit_metric(distance_metric_factory<point>::chi_square(), metric_kind::CHI_SQUARE);
+}
+
+TEST(utest_metric, visit_gower) {
+   template_visit_metric(distance_metric_factory<point>::gower({ 5.0, 1.5, 3.0 }), metric_kind::GOWER);
+}
+
+TEST(utest_metric, visit_user_defined) {
+   template_visit_metric(distance_metric_factory<point>::user_defined([](const point & p1, const point & p2) {
+      return euclidean_distance(p1, p2) + 1.0;
+   }), metric_kind::USER_DEFINED);
+}
+
+TEST(utest_metric, visit_after_copy) {
+   distance_metric<point> metric = distance_metric_factory<point>::euclidean();
+   metric = distance_metric_factory<point>::gower({ 2.0, 2.0 });
+
+   ASSERT_EQ(metric_kind::GOWER, metric.kind());
+   ASSERT_DOUBLE_EQ(1.0, visit(metric, [](const auto & p_distance) { return p_distance(point({ 0.0, 0.0 }), point({ 2.0, 2.0 })); }));
+}
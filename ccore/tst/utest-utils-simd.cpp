@@ -0,0 +1,213 @@
+/*!
+
+@authors Andrei Novikov (pyclustering@yandex.ru)
+@date 2014-2020
+@copyright BSD-3-Clause
+
+*/
+
+
+#include <gtest/gtest.h>
+
+#include <pyclustering/utils/metric.hpp>
+#include <pyclustering/utils/simd.hpp>
+
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+
+
+using namespace pyclustering;
+using namespace pyclustering::utils::metric;
+using namespace pyclustering::utils::simd;
+
+
+static std::vector<double> create_coordinates(const std::size_t p_amount, const double p_shift) {
+    std::vector<double> result(p_amount);
+    for (std::size_t i = 0; i < p_amount; i++) {
+        /* zero coordinates are included to check zero dividers of Canberra metric */
+        result[i] = (i % 5 == 0) ? 0.0 : std::sin(static_cast<double>(i) * 1.3 + p_shift) * 10.0;
+    }
+
+    return result;
+}
+
+
+static double reference_distance(const metric_kind p_kind, const point & p_point1, const point & p_point2) {
+    switch (p_kind) {
+    case metric_kind::EUCLIDEAN:
+        return euclidean_distance(p_point1, p_point2);
+    case metric_kind::EUCLIDEAN_SQUARE:
+        return euclidean_distance_square(p_point1, p_point2);
+    case metric_kind::MANHATTAN:
+        return manhattan_distance(p_point1, p_point2);
+    case metric_kind::CHEBYSHEV:
+        return chebyshev_distance(p_point1, p_point2);
+    case metric_kind::CANBERRA:
+        return canberra_distance(p_point1, p_point2);
+    default:
+        throw std::invalid_argument("Unsupported metric.");
+    }
+}
+
+
+class simd_instruction_set_guard {
+private:
+    instruction_set m_previous;
+
+public:
+    simd_instruction_set_guard() : m_previous(get_instruction_set()) { }
+
+    ~simd_instruction_set_guard() { set_instruction_set(m_previous); }
+};
+
+
+static void template_distance(const metric_kind p_kind) {
+    simd_instruction_set_guard guard;
+
+    for (const auto instructions : { instruction_set::SCALAR, instruction_set::NEON, instruction_set::AVX2, instruction_set::AVX512 }) {
+        if (!set_instruction_set(instructions)) {
+            continue;
+        }
+
+        ASSERT_EQ(instructions, get_instruction_set());
+
+        for (const std::size_t dimension : { 0, 1, 2, 3, 4, 7, 8, 9, 15, 16, 17, 31, 33, 64 }) {
+            const point point1 = create_coordinates(dimension, 0.0);
+            const point point2 = create_coordinates(dimension, 0.7);
+            const double expected = reference_distance(p_kind, point1, point2);
+
+            const double actual = distance(p_kind, point1.data(), point2.data(), dimension);
+            ASSERT_NEAR(expected, actual, 1e-9 * (1.0 + std::abs(expected)));
+
+            const std::vector<float> point1_float(point1.begin(), point1.end());
+            const std::vector<float> point2_float(point2.begin(), point2.end());
+
+            const float actual_float = distance(p_kind, point1_float.data(), point2_float.data(), dimension);
+            ASSERT_NEAR(expected, actual_float, 1e-4 * (1.0 + std::abs(expected)));
+        }
+    }
+}
+
+
+TEST(utest_simd, distance_euclidean) {
+    template_distance(metric_kind::EUCLIDEAN);
+}
+
+TEST(utest_simd, distance_euclidean_square) {
+    template_distance(metric_kind::EUCLIDEAN_SQUARE);
+}
+
+TEST(utest_simd, distance_manhattan) {
+    template_distance(metric_kind::MANHATTAN);
+}
+
+TEST(utest_simd, distance_chebyshev) {
+    template_distance(metric_kind::CHEBYSHEV);
+}
+
+TEST(utest_simd, distance_canberra) {
+    template_distance(metric_kind::CANBERRA);
+}
+
+
+static void template_batch_distance(const metric_kind p_kind, const std::size_t p_dimension) {
+    simd_instruction_set_guard guard;
+
+    const std::size_t stride = p_dimension + 3;
+    const std::size_t amount1 = 5, amount2 = 11;
+
+    const std::vector<double> points1 = create_coordinates(amount1 * stride, 0.3);
+    const std::vector<double> points2 = create_coordinates(amount2 * stride, 1.1);
+
+    for (const auto instructions : { instruction_set::SCALAR, instruction_set::NEON, instruction_set::AVX2, instruction_set::AVX512 }) {
+        if (!set_instruction_set(instructions)) {
+            continue;
+        }
+
+        std::vector<double> one_to_many(amount2, -1.0);
+        distance(p_kind, points1.data(), points2.data(), amount2, p_dimension, stride, one_to_many.data());
+
+        std::vector<double> many_to_many(amount1 * amount2, -1.0);
+        distance_matrix(p_kind, points1.data(), amount1, stride, points2.data(), amount2, stride, p_dimension, many_to_many.data());
+
+        for (std::size_t i = 0; i < amount1; i++) {
+            const point point1(points1.begin() + i * stride, points1.begin() + i * stride + p_dimension);
+
+            for (std::size_t j = 0; j < amount2; j++) {
+                const point point2(points2.begin() + j * stride, points2.begin() + j * stride + p_dimension);
+                const double expected = reference_distance(p_kind, point1, point2);
+
+                ASSERT_NEAR(expected, many_to_many[i * amount2 + j], 1e-9 * (1.0 + std::abs(expected)));
+                if (i == 0) {
+                    ASSERT_NEAR(expected, one_to_many[j], 1e-9 * (1.0 + std::abs(expected)));
+                }
+            }
+        }
+    }
+}
+
+
+TEST(utest_simd, batch_euclidean_square) {
+    template_batch_distance(metric_kind::EUCLIDEAN_SQUARE, 2);
+    template_batch_distance(metric_kind::EUCLIDEAN_SQUARE, 19);
+}
+
+TEST(utest_simd, batch_euclidean) {
+    template_batch_distance(metric_kind::EUCLIDEAN, 13);
+}
+
+TEST(utest_simd, batch_manhattan) {
+    template_batch_distance(metric_kind::MANHATTAN, 21);
+}
+
+TEST(utest_simd, batch_chebyshev) {
+    template_batch_distance(metric_kind::CHEBYSHEV, 23);
+}
+
+TEST(utest_simd, batch_canberra) {
+    template_batch_distance(metric_kind::CANBERRA, 25);
+}
+
+
+TEST(utest_simd, dense_dataset_view) {
+    const dataset data = { { 1.0, 2.0, 3.0 }, { -4.0, 0.5, 6.0 }, { 0.0, 0.0, 0.0 } };
+    const container::dense_dataset dense(data, true);
+
+    std::vector<double> distances(data.size());
+    distance(metric_kind::EUCLIDEAN, dense[1], dense, distances.data());
+
+    for (std::size_t i = 0; i < data.size(); i++) {
+        ASSERT_NEAR(euclidean_distance(data[1], data[i]), distances[i], 1e-12);
+    }
+
+    std::vector<double> matrix(data.size() * data.size());
+    distance_matrix(metric_kind::MANHATTAN, dense, dense, matrix.data());
+
+    for (std::size_t i = 0; i < data.size(); i++) {
+        for (std::size_t j = 0; j < data.size(); j++) {
+            ASSERT_NEAR(manhattan_distance(data[i], data[j]), matrix[i * data.size() + j], 1e-12);
+        }
+    }
+}
+
+
+TEST(utest_simd, unsupported_metric) {
+    const std::vector<double> point1 = { 1.0, 2.0 }, point2 = { 2.0, 1.0 };
+
+    ASSERT_FALSE(is_supported(metric_kind::GOWER));
+    ASSERT_FALSE(is_supported(metric_kind::USER_DEFINED));
+    ASSERT_THROW(distance(metric_kind::MINKOWSKI, point1.data(), point2.data(), 2), std::invalid_argument);
+}
+
+
+TEST(utest_simd, instruction_set) {
+    simd_instruction_set_guard guard;
+
+    ASSERT_EQ(get_supported_instruction_set(), get_instruction_set());
+    ASSERT_TRUE(set_instruction_set(instruction_set::SCALAR));
+    ASSERT_EQ(instruction_set::SCALAR, get_instruction_set());
+
+    ASSERT_TRUE(set_instruction_set(get_supported_instruction_set()));
+    ASSERT_EQ(get_supported_instruction_set(), get_instruction_set());
+}
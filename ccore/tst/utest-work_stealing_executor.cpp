@@ -0,0 +1,241 @@
+/*!
+
+@authors Andrei Novikov (pyclustering@yandex.ru)
+@date 2014-2020
+@copyright BSD-3-Clause
+
+*/
+
+
+#include <gtest/gtest.h>
+
+#include <pyclustering/parallel/work_stealing_executor.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <numeric>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+
+using namespace pyclustering::parallel;
+
+
+static void template_execute_chunks(const std::size_t p_size, const std::size_t p_chunks) {
+    work_stealing_executor executor(p_size);
+
+    std::vector<std::size_t> results(p_chunks, 0);
+    executor.execute(p_chunks, [&results](const std::size_t p_index) {
+        results[p_index] += p_index + 1;
+    });
+
+    for (std::size_t i = 0; i < p_chunks; i++) {
+        ASSERT_EQ(i + 1, results[i]);
+    }
+}
+
+
+TEST(utest_work_stealing_executor, no_workers_10_chunks) {
+    template_execute_chunks(0, 10);
+}
+
+TEST(utest_work_stealing_executor, one_worker_1_chunk) {
+    template_execute_chunks(1, 1);
+}
+
+TEST(utest_work_stealing_executor, one_worker_10_chunks) {
+    template_execute_chunks(1, 10);
+}
+
+TEST(utest_work_stealing_executor, four_workers_3_chunks) {
+    template_execute_chunks(4, 3);
+}
+
+TEST(utest_work_stealing_executor, four_workers_1000_chunks) {
+    template_execute_chunks(4, 1000);
+}
+
+TEST(utest_work_stealing_executor, twenty_workers_10000_chunks) {
+    template_execute_chunks(20, 10000);
+}
+
+
+TEST(utest_work_stealing_executor, reuse_executor) {
+    work_stealing_executor executor(4);
+
+    for (std::size_t attempt = 0; attempt < 100; attempt++) {
+        std::atomic<std::size_t> counter = { 0 };
+        executor.execute(50, [&counter](const std::size_t) {
+            counter++;
+        });
+
+        ASSERT_EQ(50U, counter.load());
+    }
+}
+
+
+TEST(utest_work_stealing_executor, nested_execution) {
+    work_stealing_executor executor(3);
+
+    std::vector<std::vector<std::size_t>> results(20, std::vector<std::size_t>(30, 0));
+    executor.execute(results.size(), [&executor, &results](const std::size_t p_outer) {
+        executor.execute(results[p_outer].size(), [&results, p_outer](const std::size_t p_inner) {
+            results[p_outer][p_inner] = p_outer * p_inner;
+        });
+    });
+
+    for (std::size_t i = 0; i < results.size(); i++) {
+        for (std::size_t j = 0; j < results[i].size(); j++) {
+            ASSERT_EQ(i * j, results[i][j]);
+        }
+    }
+}
+
+
+TEST(utest_work_stealing_executor, exception_propagation) {
+    work_stealing_executor executor(2);
+
+    std::atomic<std::size_t> counter = { 0 };
+    ASSERT_THROW(executor.execute(10, [&counter](const std::size_t p_index) {
+        counter++;
+        if (p_index == 5) {
+            throw std::runtime_error("chunk failure");
+        }
+    }), std::runtime_error);
+
+    ASSERT_EQ(10U, counter.load());
+}
+
+
+TEST(utest_work_stealing_executor, process_wide_instance) {
+    work_stealing_executor & executor = work_stealing_executor::instance();
+    ASSERT_EQ(&executor, &work_stealing_executor::instance());
+
+    std::vector<double> values(1000);
+    executor.execute(values.size(), [&values](const std::size_t p_index) {
+        values[p_index] = static_cast<double>(p_index);
+    });
+
+    ASSERT_EQ(999.0 * 1000.0 / 2.0, std::accumulate(values.begin(), values.end(), 0.0));
+}
+
+
+TEST(utest_work_stealing_executor, parallel_region_detection) {
+    work_stealing_executor executor(2);
+
+    ASSERT_FALSE(work_stealing_executor::in_parallel_region());
+    ASSERT_EQ(0U, work_stealing_executor::region_concurrency());
+
+    std::atomic<std::size_t> inside = { 0 };
+    std::atomic<std::size_t> inherited = { 0 };
+
+    executor.execute(10, [&executor, &inside, &inherited](const std::size_t) {
+        if (work_stealing_executor::in_parallel_region()) {
+            inside++;
+        }
+
+        executor.execute(5, [&inherited](const std::size_t) {
+            if (work_stealing_executor::region_concurrency() == 3) {
+                inherited++;
+            }
+        }, 100);    /* nested region uses budget of the top-level region */
+    }, 3);
+
+    ASSERT_EQ(10U, inside.load());
+    ASSERT_EQ(50U, inherited.load());
+    ASSERT_FALSE(work_stealing_executor::in_parallel_region());
+}
+
+
+static void template_concurrency_budget(const std::size_t p_size, const std::size_t p_budget) {
+    work_stealing_executor executor(p_size);
+
+    std::atomic<std::size_t> active = { 0 };
+    std::atomic<std::size_t> maximum_active = { 0 };
+
+    auto enter = [&active, &maximum_active]() {
+        const std::size_t current = ++active;
+        std::size_t maximum = maximum_active.load();
+        while ((current > maximum) && !maximum_active.compare_exchange_weak(maximum, current)) { }
+    };
+
+    executor.execute(8, [&executor, &active, &enter](const std::size_t) {
+        executor.execute(16, [&active, &enter](const std::size_t) {
+            enter();
+
+            volatile double value = 0.0;
+            for (std::size_t i = 0; i < 10000; i++) {
+                value = value + static_cast<double>(i);
+            }
+
+            active--;
+        });
+    }, p_budget);
+
+    ASSERT_LE(maximum_active.load(), p_budget);
+    ASSERT_GE(maximum_active.load(), 1U);
+}
+
+
+TEST(utest_work_stealing_executor, nested_budget_1) {
+    template_concurrency_budget(4, 1);
+}
+
+TEST(utest_work_stealing_executor, nested_budget_2) {
+    template_concurrency_budget(4, 2);
+}
+
+TEST(utest_work_stealing_executor, nested_budget_3) {
+    template_concurrency_budget(8, 3);
+}
+
+
+TEST(utest_work_stealing_executor, saturated_job_does_not_block_queue) {
+    work_stealing_executor executor(2);
+
+    const auto wait_for = [](const std::function<bool()> & p_condition) {
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+        while (!p_condition() && (std::chrono::steady_clock::now() < deadline)) {
+            std::this_thread::yield();
+        }
+
+        return p_condition();
+    };
+
+    /* the first region occupies its budget by blocked chunks, its last job stays at the front of the injection queue */
+    std::atomic<std::size_t> blocked = { 0 };
+    std::atomic<bool> released = { false };
+
+    std::thread first_caller([&executor, &blocked, &released]() {
+        executor.execute(3, [&blocked, &released](const std::size_t) {
+            blocked++;
+            while (!released.load()) {
+                std::this_thread::yield();
+            }
+        }, 2);
+    });
+
+    ASSERT_TRUE(wait_for([&blocked]() { return blocked.load() == 2; }));
+
+    /* the second region is queued behind it and should be processed by the free worker */
+    const std::thread::id caller_id = std::this_thread::get_id();
+    std::atomic<bool> processed_by_worker = { false };
+    std::atomic<bool> waited = { false };
+
+    executor.execute(3, [caller_id, &processed_by_worker, &waited, &wait_for](const std::size_t p_index) {
+        if (std::this_thread::get_id() != caller_id) {
+            processed_by_worker = true;
+        }
+        else if (p_index == 0) {
+            waited = wait_for([&processed_by_worker]() { return processed_by_worker.load(); });
+        }
+    }, 3);
+
+    released = true;
+    first_caller.join();
+
+    ASSERT_TRUE(waited.load());
+    ASSERT_EQ(3U, blocked.load());
+}
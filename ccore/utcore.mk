@@ -24,7 +24,7 @@ endif
 
 
 # Warnings.
-WARNING_FLAGS = -Wall -Wpedantic
+WARNING_FLAGS = -Wall -Wpedantic -Wvla
 
 
 # Toolchain arguments
@@ -64,10 +64,14 @@ class dbscan:
         @param[in] eps (double): Connectivity radius between points, points may be connected if distance between them less then the radius.
         @param[in] neighbors (uint): minimum number of shared neighbors that is required for establish links between points.
         @param[in] ccore (bool): if True than DLL CCORE (C++ solution) will be used for solving the problem.
-        @param[in] **kwargs: Arbitrary keyword arguments (available arguments: 'data_type').
+        @param[in] **kwargs: Arbitrary keyword arguments (available arguments: 'data_type', 'grid', 'parallel').
 
         <b>Keyword Args:</b><br>
             - data_type (string): Data type of input sample 'data' that is processed by the algorithm ('points', 'distance_matrix').
+            - grid (bool): If `True` then CCORE finds neighbors using grid of cells instead of KD-tree, it is recommended
+               for large data with dimension not greater than 4, other data is processed using KD-tree (by default: False).
+            - parallel (bool): If `True` then CCORE finds core points in parallel and merges them into clusters by
+               union-find, the result is the same as by sequential expansion of clusters (by default: False).
         
         """
         
@@ -81,6 +85,8 @@ class dbscan:
         self.__belong = None
 
         self.__data_type = kwargs.get('data_type', 'points')
+        self.__grid = kwargs.get('grid', False)
+        self.__parallel = kwargs.get('parallel', False)
 
         self.__clusters = []
         self.__noise = []
@@ -101,7 +107,7 @@ class dbscan:
 
         """
         return (self.__pointer_data, self.__eps, self.__sqrt_eps, self.__neighbors, self.__visited, self.__belong,
-                self.__data_type, self.__clusters, self.__noise, self.__ccore)
+                self.__data_type, self.__grid, self.__parallel, self.__clusters, self.__noise, self.__ccore)
 
 
     def __setstate__(self, state):
@@ -112,7 +118,7 @@ class dbscan:
 
         """
         self.__pointer_data, self.__eps, self.__sqrt_eps, self.__neighbors, self.__visited, self.__belong, \
-        self.__data_type, self.__clusters, self.__noise, self.__ccore = state
+        self.__data_type, self.__grid, self.__parallel, self.__clusters, self.__noise, self.__ccore = state
 
         self.__initialize_ccore_state(True)
 
@@ -129,7 +135,8 @@ class dbscan:
         """
         
         if self.__ccore is True:
-            (self.__clusters, self.__noise) = wrapper.dbscan(self.__pointer_data, self.__eps, self.__neighbors, self.__data_type)
+            (self.__clusters, self.__noise) = wrapper.dbscan(self.__pointer_data, self.__eps, self.__neighbors, self.__data_type,
+                                                         self.__grid, self.__parallel)
             
         else:
             if self.__data_type == 'points':
@@ -209,6 +216,9 @@ class dbscan:
         if self.__eps < 0:
             raise ValueError("Connectivity radius (current value: '%d') should be greater or equal to 0." % self.__eps)
 
+        if self.__grid and self.__parallel:
+            raise ValueError("Grid and parallel processing cannot be used together.")
+
 
     def __create_neighbor_searcher(self, data_type):
         """!
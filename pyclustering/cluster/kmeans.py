@@ -335,12 +335,15 @@ class kmeans:
         @param[in] initial_centers (array_like): Initial coordinates of centers of clusters that are represented by array_like data structure: [center1, center2, ...].
         @param[in] tolerance (double): Stop condition: if maximum value of change of centers of clusters is less than tolerance then algorithm stops processing.
         @param[in] ccore (bool): Defines should be CCORE library (C++ pyclustering library) used instead of Python code or not.
-        @param[in] **kwargs: Arbitrary keyword arguments (available arguments: 'observer', 'metric', 'itermax').
+        @param[in] **kwargs: Arbitrary keyword arguments (available arguments: 'observer', 'metric', 'itermax', 'accelerated').
         
         <b>Keyword Args:</b><br>
             - observer (kmeans_observer): Observer of the algorithm to collect information about clustering process on each iteration.
             - metric (distance_metric): Metric that is used for distance calculation between two points (by default euclidean square distance).
             - itermax (uint): Maximum number of iterations that is used for clustering process (by default: 200).
+            - accelerated (bool): If `True` then CCORE skips distance calculations using bounds that are based on triangle
+               inequality (Hamerly's or Elkan's method in line with amount of clusters), it is applicable for Euclidean,
+               square Euclidean, Manhattan and Chebyshev metrics (by default: False).
         
         @see center_initializer
         
@@ -354,6 +357,7 @@ class kmeans:
         self.__observer = kwargs.get('observer', None)
         self.__metric = copy.copy(kwargs.get('metric', distance_metric(type_metric.EUCLIDEAN_SQUARE)))
         self.__itermax = kwargs.get('itermax', 100)
+        self.__accelerated = kwargs.get('accelerated', False)
 
         if self.__metric.get_type() != type_metric.USER_DEFINED:
             self.__metric.enable_numpy_usage()
@@ -397,7 +401,7 @@ class kmeans:
         ccore_metric = metric_wrapper.create_instance(self.__metric)
 
         results = wrapper.kmeans(self.__pointer_data, self.__centers, self.__tolerance, self.__itermax,
-                                 (self.__observer is not None), ccore_metric.get_pointer())
+                                 (self.__observer is not None), ccore_metric.get_pointer(), self.__accelerated)
 
         self.__clusters = results[0]
         self.__centers = results[1]
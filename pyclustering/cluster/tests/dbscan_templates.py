@@ -27,12 +27,14 @@ class DbscanTestTemplates:
     @staticmethod
     def templateClusteringResults(path, radius, neighbors, expected_length_clusters, ccore, **kwargs):
         random_order = kwargs.get('random_order', False)
+        grid = kwargs.get('grid', False)
+        parallel = kwargs.get('parallel', False)
 
         sample = read_sample(path)
         if random_order:
             shuffle(sample)
          
-        dbscan_instance = dbscan(sample, radius, neighbors, ccore)
+        dbscan_instance = dbscan(sample, radius, neighbors, ccore, grid=grid, parallel=parallel)
         dbscan_instance.process()
          
         clusters = dbscan_instance.get_clusters()
@@ -49,6 +49,13 @@ class KmeansIntegrationTest(unittest.TestCase):
         metric = distance_metric(type_metric.CHEBYSHEV)
         KmeansTestTemplates.templateLengthProcessData(SIMPLE_SAMPLES.SAMPLE_SIMPLE1, [[3.7, 5.5], [6.7, 7.5]], [5, 5], True, metric=metric)
 
+    def testClusterAllocationSampleSimple1AcceleratedByCore(self):
+        KmeansTestTemplates.templateLengthProcessData(SIMPLE_SAMPLES.SAMPLE_SIMPLE1, [[3.7, 5.5], [6.7, 7.5]], [5, 5], True, accelerated=True)
+
+    def testClusterAllocationSampleSimple2AcceleratedManhattanByCore(self):
+        metric = distance_metric(type_metric.MANHATTAN)
+        KmeansTestTemplates.templateLengthProcessData(SIMPLE_SAMPLES.SAMPLE_SIMPLE2, [[3.5, 4.8], [6.9, 7.0], [7.5, 0.5]], [10, 5, 8], True, metric=metric, accelerated=True)
+
     def testClusterAllocationSampleSimple1Minkowski01ByCore(self):
         metric = distance_metric(type_metric.MINKOWSKI, degree=2)
         KmeansTestTemplates.templateLengthProcessData(SIMPLE_SAMPLES.SAMPLE_SIMPLE1, [[3.7, 5.5], [6.7, 7.5]], [5, 5], True, metric=metric)
@@ -32,8 +32,9 @@ class KmeansTestTemplates:
 
         metric = kwargs.get('metric', distance_metric(type_metric.EUCLIDEAN_SQUARE))
         itermax = kwargs.get('itermax', 200)
+        accelerated = kwargs.get('accelerated', False)
         
-        kmeans_instance = kmeans(sample, start_centers, 0.001, ccore, metric=metric, itermax=itermax)
+        kmeans_instance = kmeans(sample, start_centers, 0.001, ccore, metric=metric, itermax=itermax, accelerated=accelerated)
         kmeans_instance.process()
         
         clusters = kmeans_instance.get_clusters()
@@ -9,13 +9,13 @@
 """
 
 
-from ctypes import c_double, c_bool, c_size_t, POINTER
+from ctypes import c_double, c_bool, c_size_t, c_uint, POINTER
 
 from pyclustering.core.wrapper import ccore_library
 from pyclustering.core.pyclustering_package import pyclustering_package, package_extractor, package_builder
 
 
-def kmeans(sample, centers, tolerance, itermax, observe, metric_pointer):
+def kmeans(sample, centers, tolerance, itermax, observe, metric_pointer, accelerated=False):
     pointer_data = package_builder(sample, c_double).create()
     pointer_centers = package_builder(centers, c_double).create()
     
@@ -23,7 +23,7 @@ def kmeans(sample, centers, tolerance, itermax, observe, metric_pointer):
     
     ccore.kmeans_algorithm.restype = POINTER(pyclustering_package)
     package = ccore.kmeans_algorithm(pointer_data, pointer_centers, c_double(tolerance), c_size_t(itermax),
-                                     c_bool(observe), metric_pointer)
+                                     c_bool(observe), metric_pointer, c_uint(1 if accelerated else 0))
     
     result = package_extractor(package).extract()
     ccore.free_pyclustering_package(package)
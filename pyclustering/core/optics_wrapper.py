@@ -23,6 +23,7 @@ class optics_package_indexer:
     OPTICS_PACKAGE_INDEX_OPTICS_OBJECTS_INDEX = 4
     OPTICS_PACKAGE_INDEX_OPTICS_OBJECTS_CORE_DISTANCE = 5
     OPTICS_PACKAGE_INDEX_OPTICS_OBJECTS_REACHABILITY_DISTANCE = 6
+    OPTICS_PACKAGE_INDEX_OBJECT_ORDERING = 7
 
 
 def optics(sample, radius, minimum_neighbors, amount_clusters, data_type):
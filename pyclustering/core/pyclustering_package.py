@@ -35,6 +35,28 @@ class pyclustering_package(Structure):
 
 
 
+class pyclustering_matrix(Structure):
+    """!
+    @brief Descriptor of row-major matrix of doubles that is stored in 'pyclustering_package' with type
+            'PYCLUSTERING_TYPE_DOUBLE_MATRIX'.
+    @details Represents following C++ structure:
+
+            typedef struct pyclustering_matrix {
+                std::size_t      rows;
+                std::size_t      columns;
+                std::size_t      stride;
+                double *         data;
+            }
+
+    """
+
+    _fields_ = [("rows", c_size_t),
+                ("columns", c_size_t),
+                ("stride", c_size_t),
+                ("data", POINTER(c_double))]
+
+
+
 class pyclustering_type_data:
     """!
     @brief Contains constants that defines type of package.
@@ -51,6 +73,7 @@ class pyclustering_type_data:
     PYCLUSTERING_TYPE_SIZE_T = 7
     PYCLUSTERING_TYPE_WCHAR_T = 8
     PYCLUSTERING_TYPE_UNDEFINED = 9
+    PYCLUSTERING_TYPE_DOUBLE_MATRIX = 10
 
     __CTYPE_PYCLUSTERING_MAP = { 
         c_int: PYCLUSTERING_TYPE_INT,
@@ -147,6 +170,9 @@ class package_builder:
 
         if isinstance(dataset, numpy.matrix):
             return self.__create_package_numpy_matrix(dataset_package, dataset)
+
+        if self.__is_dense_numpy_array(dataset):
+            return self.__create_package_dense_matrix(dataset_package, dataset)
         
         dataset_package.size = len(dataset)
     
@@ -229,6 +255,51 @@ class package_builder:
         return pointer(dataset_package)
 
 
+    def __is_dense_numpy_array(self, dataset):
+        """!
+        @brief Checks whether two-dimensional numpy array should be packed as a matrix of doubles: arrays of floats are
+                packed as a matrix by default, arrays of other numeric types only if doubles are requested explicitly,
+                otherwise they keep their inferred type.
+
+        """
+        if not isinstance(dataset, numpy.ndarray) or (dataset.ndim != 2) or (dataset.shape[0] == 0):
+            return False
+
+        if self.__c_data_type is None:
+            return numpy.issubdtype(dataset.dtype, numpy.floating)
+
+        return (self.__c_data_type is c_double) and numpy.issubdtype(dataset.dtype, numpy.number)
+
+
+    def __create_package_dense_matrix(self, dataset_package, dataset):
+        """!
+        @brief Packs two-dimensional numpy array without copying when it is already a row-major array of doubles,
+                otherwise the array is converted to contiguous array of doubles once.
+
+        """
+        item_size = numpy.dtype(numpy.float64).itemsize
+        (row_stride, column_stride) = dataset.strides
+
+        if (dataset.dtype != numpy.float64) or (column_stride != item_size) or (row_stride % item_size != 0) or \
+                (row_stride < dataset.shape[1] * item_size):
+            dataset = numpy.ascontiguousarray(dataset, dtype=numpy.float64)
+            row_stride = dataset.strides[0]
+
+        matrix = pyclustering_matrix()
+        matrix.rows = dataset.shape[0]
+        matrix.columns = dataset.shape[1]
+        matrix.stride = row_stride // item_size
+        matrix.data = dataset.ctypes.data_as(POINTER(c_double))
+
+        dataset_package.size = matrix.rows
+        dataset_package.type = pyclustering_type_data.PYCLUSTERING_TYPE_DOUBLE_MATRIX
+        dataset_package.data = cast(pointer(matrix), POINTER(c_void_p))
+
+        # The package refers to memory of the array and the descriptor, they should live as long as the package.
+        dataset_package.matrix_source = (dataset, matrix)
+        return pointer(dataset_package)
+
+
     def __create_package_string(self, dataset_package, string_value):
         dataset_package.size = len(string_value)
         dataset_package.type = pyclustering_type_data.PYCLUSTERING_TYPE_CHAR
@@ -299,5 +370,14 @@ class package_extractor:
         if current_package.size == 0:
             return []
 
+        if type_package == pyclustering_type_data.PYCLUSTERING_TYPE_DOUBLE_MATRIX:
+            return self.__unpack_matrix(current_package)
+
         pointer_data = cast(current_package.data, POINTER(pyclustering_type_data.get_ctype(type_package)))
         return self.__unpack_data(pointer_package, pointer_data, type_package)
+
+
+    def __unpack_matrix(self, current_package):
+        matrix = cast(current_package.data, POINTER(pyclustering_matrix))[0]
+        return [[matrix.data[row * matrix.stride + column] for column in range(matrix.columns)]
+                for row in range(matrix.rows)]
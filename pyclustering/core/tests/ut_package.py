@@ -13,7 +13,7 @@ import unittest
 
 import numpy
 
-from pyclustering.core.pyclustering_package import package_builder, package_extractor
+from pyclustering.core.pyclustering_package import package_builder, package_extractor, pyclustering_type_data
 
 from ctypes import c_ulong, c_size_t, c_double, c_uint, c_float, c_char_p
 
@@ -129,6 +129,15 @@ class Test(unittest.TestCase):
     def testNumpyMatrixThreeColumns(self):
         self.templatePackUnpack(numpy.array([[1.1, 2.2, 3.3], [2.2, 3.3, 4.4], [3.3, 4.4, 5.5]]), c_double)
 
+    def testNumpyMatrixFloatIsDense(self):
+        package_pointer = package_builder(numpy.array([[1.0, 2.0], [3.0, 4.0]]), None).create()
+        self.assertEqual(pyclustering_type_data.PYCLUSTERING_TYPE_DOUBLE_MATRIX, package_pointer[0].type)
+
+    def testNumpyMatrixIntegerKeepsType(self):
+        package_pointer = package_builder(numpy.array([[1, 2], [3, 4]]), c_size_t).create()
+        self.assertEqual(pyclustering_type_data.PYCLUSTERING_TYPE_LIST, package_pointer[0].type)
+        self.assertEqual([[1, 2], [3, 4]], package_extractor(package_pointer).extract())
+
     def testString(self):
         self.templatePackUnpack("Test message number one".encode('utf-8'))
 